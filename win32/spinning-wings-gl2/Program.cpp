@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <memory>
@@ -133,9 +135,27 @@ namespace silnith::wings::gl2
         return static_cast<GLuint>(attributeLocation);
     }
 
-    void Program::useProgram(void) const
+    GLint Program::getUniformLocation(std::string const& uniformName) const
     {
-        glUseProgram(name);
+        /*
+         * Uniform locations are of type GLint, so no casting is necessary.
+         * Attempts to set a uniform variable using a location of -1 will be
+         * silently ignored.
+         */
+        GLint const uniformLocation{ glGetUniformLocation(name, uniformName.c_str()) };
+        if (uniformLocation < 0)
+        {
+            throw std::runtime_error{ "Uniform "s + uniformName + " not bound."s };
+        }
+        return uniformLocation;
+    }
+
+    void Program::useProgram(silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        if (stateCache.ChangeProgram(name))
+        {
+            glUseProgram(name);
+        }
     }
 
 }
@@ -1,11 +1,14 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <string>
 
 #include "FragmentShader.h"
+#include "GLStateCache.h"
 #include "VertexShader.h"
 
 namespace silnith::wings::gl2
@@ -72,10 +75,21 @@ namespace silnith::wings::gl2
         GLuint getAttributeLocation(std::string const& attributeName) const;
 
         /// <summary>
-        /// Installs the GLSL program as part of the current rendering state.
+        /// Returns the location of the specified uniform variable.
         /// </summary>
+        /// <param name="uniformName">The name of the uniform variable.</param>
+        /// <returns>The uniform location.</returns>
+        /// <exception cref="std::runtime_error">If the uniform name is not bound.</exception>
+        [[nodiscard]]
+        GLint getUniformLocation(std::string const& uniformName) const;
+
+        /// <summary>
+        /// Installs the GLSL program as part of the current rendering state,
+        /// unless the state cache shows that it already is.
+        /// </summary>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
         /// <exception cref="std::runtime_error">If the program could not be installed.</exception>
-        void useProgram(void) const;
+        void useProgram(silnith::wings::gl::GLStateCache& stateCache) const;
 
     private:
         /// <summary>
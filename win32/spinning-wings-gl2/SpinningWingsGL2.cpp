@@ -14,6 +14,7 @@
 
 #include <cassert>
 
+#include "Instrumentation.h"
 #include "WingsPixelFormat.h"
 #include "WingsViewGL2.h"
 
@@ -78,7 +79,10 @@ void CALLBACK AdvanceAnimation(HWND hWnd, UINT uMsg, UINT_PTR idEvent, DWORD dwT
 
 	assert(hglrc == wglGetCurrentContext());
 
-	wingsView->AdvanceAnimation();
+	{
+		silnith::wings::instrumentation::PhaseTimer const tickTimer{ silnith::wings::instrumentation::Phase::Tick };
+		wingsView->AdvanceAnimation();
+	}
 
 	HRGN constexpr hRegion{ nullptr };
 	BOOL constexpr eraseBackground{ FALSE };
@@ -290,7 +294,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		wingsView->DrawFrame();
+		{
+			silnith::wings::instrumentation::PhaseTimer const frameTimer{ silnith::wings::instrumentation::Phase::Frame };
+			wingsView->DrawFrame();
+		}
 
 		PAINTSTRUCT paintstruct{};
 		HDC const hdc{ BeginPaint(hWnd, &paintstruct) };
@@ -298,7 +305,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			return -1;
 		}
 
-		SwapBuffers(hdc);
+		{
+			silnith::wings::instrumentation::PhaseTimer const swapTimer{ silnith::wings::instrumentation::Phase::Swap };
+			SwapBuffers(hdc);
+		}
 
 		EndPaint(hWnd, &paintstruct);
 		return 0;
@@ -324,6 +334,8 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 		wglDeleteContext(hglrc);
 
+		silnith::wings::instrumentation::WriteReport();
+
 		PostQuitMessage(0);
 		return 0;
 	}
@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include "WingRendererGL10.h"
@@ -0,0 +1,139 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <array>
+
+#include <cassert>
+#include <cstddef>
+
+#include "WingRendererGL15Batched.h"
+
+#include "AccumulatedDeltas.h"
+#include "Color.h"
+#include "Matrix.h"
+
+namespace silnith::wings::gl
+{
+
+	WingRendererGL15Batched::WingRendererGL15Batched(std::size_t numWings) :
+		numWings{ numWings },
+		newestSlot{ numWings - 1 }
+	{
+		assert(numWings > 0);
+
+		/*
+		 * The buffer is allocated once with no contents.  Each slot is filled
+		 * in when a wing is added to it, and only occupied slots are drawn.
+		 */
+		glGenBuffers(1, &wingsBufferObject);
+		glBindBuffer(GL_ARRAY_BUFFER, wingsBufferObject);
+		glBufferData(GL_ARRAY_BUFFER,
+			static_cast<GLsizeiptr>(sizeof(GLfloat) * vertexSize * verticesPerWing * numWings),
+			nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	WingRendererGL15Batched::~WingRendererGL15Batched(void) noexcept
+	{
+		glDeleteBuffers(1, &wingsBufferObject);
+	}
+
+	void WingRendererGL15Batched::AddWing(Matrix const& wingTransformation,
+		AccumulatedDeltas<GLfloat>::Anchor const& anchor,
+		Color<GLfloat> const& color,
+		Color<GLfloat> const& edgeColor)
+	{
+		newestSlot = (newestSlot + 1 == numWings) ? 0 : newestSlot + 1;
+		if (numOccupied < numWings)
+		{
+			numOccupied++;
+		}
+
+		/*
+		 * The corners of the untransformed wing are (±1, ±1, 0, 1), in the
+		 * same order as WingRendererGL15, so each transformed corner is the
+		 * translation column plus or minus the first two columns.
+		 */
+		std::array<GLfloat, 2 * verticesPerWing> constexpr corners{
+			1, 1,
+			-1, 1,
+			-1, -1,
+			1, -1,
+		};
+		std::array<GLfloat, vertexSize * verticesPerWing> slot{};
+		for (std::size_t vertex{ 0 }; vertex < verticesPerWing; vertex++)
+		{
+			GLfloat* const data{ slot.data() + vertex * vertexSize };
+			GLfloat const x{ corners[2 * vertex + 0] };
+			GLfloat const y{ corners[2 * vertex + 1] };
+			for (std::size_t component{ 0 }; component < 4; component++)
+			{
+				data[positionOffset + component] = wingTransformation[12 + component]
+					+ x * wingTransformation[component]
+					+ y * wingTransformation[4 + component];
+			}
+			data[anchorOffset + 0] = anchor.angle;
+			data[anchorOffset + 1] = anchor.z;
+			data[anchorOffset + 2] = static_cast<GLfloat>(anchor.section);
+			data[colorOffset + 0] = color.getRed();
+			data[colorOffset + 1] = color.getGreen();
+			data[colorOffset + 2] = color.getBlue();
+			data[edgeColorOffset + 0] = edgeColor.getRed();
+			data[edgeColorOffset + 1] = edgeColor.getGreen();
+			data[edgeColorOffset + 2] = edgeColor.getBlue();
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, wingsBufferObject);
+		glBufferSubData(GL_ARRAY_BUFFER,
+			static_cast<GLintptr>(sizeof(GLfloat) * slot.size() * newestSlot),
+			static_cast<GLsizeiptr>(sizeof(GLfloat) * slot.size()),
+			slot.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void WingRendererGL15Batched::DrawFills(GLuint anchorAttribLocation) const
+	{
+		Draw(anchorAttribLocation, colorOffset);
+	}
+
+	void WingRendererGL15Batched::DrawOutlines(GLuint anchorAttribLocation) const
+	{
+		Draw(anchorAttribLocation, edgeColorOffset);
+	}
+
+	std::size_t WingRendererGL15Batched::getNumWings(void) const noexcept
+	{
+		return numOccupied;
+	}
+
+	void WingRendererGL15Batched::Draw(GLuint anchorAttribLocation, std::size_t vertexColorOffset) const
+	{
+		/*
+		 * With an ARRAY_BUFFER bound, the last parameter of each pointer
+		 * function is an offset into the buffer instead of a pointer.
+		 */
+		GLsizei constexpr stride{ static_cast<GLsizei>(sizeof(GLfloat) * vertexSize) };
+		auto const offset{ [](std::size_t floats) -> void const*
+			{
+				return reinterpret_cast<void const*>(sizeof(GLfloat) * floats);
+			} };
+
+		glBindBuffer(GL_ARRAY_BUFFER, wingsBufferObject);
+		glVertexPointer(4, GL_FLOAT, stride, offset(positionOffset));
+		glColorPointer(3, GL_FLOAT, stride, offset(vertexColorOffset));
+		glVertexAttribPointer(anchorAttribLocation, 3, GL_FLOAT, GL_FALSE, stride, offset(anchorOffset));
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+		glEnableVertexAttribArray(anchorAttribLocation);
+
+		glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(verticesPerWing * numOccupied));
+
+		glDisableVertexAttribArray(anchorAttribLocation);
+		glDisableClientState(GL_COLOR_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+}
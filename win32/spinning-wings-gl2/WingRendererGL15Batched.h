@@ -0,0 +1,161 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <cstddef>
+
+#include "AccumulatedDeltas.h"
+#include "Color.h"
+#include "Matrix.h"
+
+namespace silnith::wings::gl
+{
+
+	/// <summary>
+	/// A wing renderer for the OpenGL 1.5 rendering path that keeps every
+	/// wing in one buffer object and draws all of them with a single call.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// <see cref="WingRendererGL15"/> draws one wing per call, and is called
+	/// once per wing per pass from inside that wing's display list.  This
+	/// instead holds the vertices and colors of every wing in a single
+	/// <c>GL_DYNAMIC_DRAW</c> array buffer, one slot per wing.  Adding a wing
+	/// rewrites only its own slot with <c>glBufferSubData</c>, and each pass
+	/// draws every occupied slot with one <c>glDrawArrays</c>.
+	/// </para>
+	/// <para>
+	/// The vertices are stored already multiplied by the wing transformation,
+	/// so the vertex shader only applies the accumulated deltas.  Those come
+	/// from the anchor stored with each vertex and the section offsets uniform,
+	/// exactly as for the per-wing path.  See <see cref="AccumulatedDeltas"/>.
+	/// </para>
+	/// <para>
+	/// This does not implement <see cref="WingRenderer"/>, because that
+	/// interface draws a single untransformed wing.
+	/// </para>
+	/// </remarks>
+	class WingRendererGL15Batched
+	{
+	public:
+		WingRendererGL15Batched(void) = delete;
+
+		/// <summary>
+		/// Allocates the buffer object for the specified number of wings.
+		/// </summary>
+		/// <param name="numWings">The maximum number of wings.</param>
+		explicit WingRendererGL15Batched(std::size_t numWings);
+
+#pragma region Rule of Five
+
+	public:
+		WingRendererGL15Batched(WingRendererGL15Batched const&) = delete;
+		WingRendererGL15Batched& operator=(WingRendererGL15Batched const&) = delete;
+		WingRendererGL15Batched(WingRendererGL15Batched&&) noexcept = delete;
+		WingRendererGL15Batched& operator=(WingRendererGL15Batched&&) noexcept = delete;
+		~WingRendererGL15Batched(void) noexcept;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Adds a new wing as the newest wing.  If every slot is occupied, the
+		/// slot of the oldest wing is reused.
+		/// </summary>
+		/// <param name="wingTransformation">The transformation that places the wing relative to the central axis.</param>
+		/// <param name="anchor">The anchor of the wing into the accumulated deltas.</param>
+		/// <param name="color">The color of the wing.</param>
+		/// <param name="edgeColor">The color of the wing outline.</param>
+		void AddWing(Matrix const& wingTransformation,
+			AccumulatedDeltas<GLfloat>::Anchor const& anchor,
+			Color<GLfloat> const& color,
+			Color<GLfloat> const& edgeColor);
+
+		/// <summary>
+		/// Draws every wing with its fill color.
+		/// </summary>
+		/// <param name="anchorAttribLocation">The location of the <c>vec3</c> anchor attribute in the current program.</param>
+		void DrawFills(GLuint anchorAttribLocation) const;
+
+		/// <summary>
+		/// Draws every wing with its edge color.  The caller is responsible for
+		/// setting the polygon mode.
+		/// </summary>
+		/// <param name="anchorAttribLocation">The location of the <c>vec3</c> anchor attribute in the current program.</param>
+		void DrawOutlines(GLuint anchorAttribLocation) const;
+
+		/// <summary>
+		/// Returns the number of wings currently held.
+		/// </summary>
+		/// <returns>The number of occupied slots.</returns>
+		[[nodiscard]]
+		std::size_t getNumWings(void) const noexcept;
+
+	private:
+		/// <summary>
+		/// Points the vertex, color, and anchor arrays into the buffer object
+		/// and draws every occupied slot.
+		/// </summary>
+		/// <param name="anchorAttribLocation">The location of the anchor attribute.</param>
+		/// <param name="vertexColorOffset">The offset of the color to use within each vertex, in floats.</param>
+		void Draw(GLuint anchorAttribLocation, std::size_t vertexColorOffset) const;
+
+	private:
+		/// <summary>
+		/// The number of vertices in each wing.
+		/// </summary>
+		static std::size_t constexpr verticesPerWing{ 4 };
+
+		/// <summary>
+		/// The offset of the vertex coordinates within each vertex, in floats.
+		/// The coordinates are X, Y, Z, and W.
+		/// </summary>
+		static std::size_t constexpr positionOffset{ 0 };
+
+		/// <summary>
+		/// The offset of the anchor within each vertex, in floats.
+		/// </summary>
+		static std::size_t constexpr anchorOffset{ 4 };
+
+		/// <summary>
+		/// The offset of the fill color within each vertex, in floats.
+		/// </summary>
+		static std::size_t constexpr colorOffset{ 7 };
+
+		/// <summary>
+		/// The offset of the edge color within each vertex, in floats.
+		/// </summary>
+		static std::size_t constexpr edgeColorOffset{ 10 };
+
+		/// <summary>
+		/// The number of floats in each vertex.
+		/// </summary>
+		static std::size_t constexpr vertexSize{ 13 };
+
+		/// <summary>
+		/// The maximum number of wings.
+		/// </summary>
+		std::size_t const numWings{ 1 };
+
+		/// <summary>
+		/// The number of slots currently occupied.  The occupied slots are
+		/// always the first ones.
+		/// </summary>
+		std::size_t numOccupied{ 0 };
+
+		/// <summary>
+		/// The slot of the newest wing.
+		/// </summary>
+		std::size_t newestSlot{ 0 };
+
+		/// <summary>
+		/// The buffer holding the interleaved vertices of every wing.
+		/// This is bound as the <c>GL_ARRAY_BUFFER</c> while drawing.
+		/// </summary>
+		GLuint wingsBufferObject{ 0 };
+	};
+
+}
@@ -1,33 +1,95 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <deque>
+#include <array>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 #include "WingsViewGL2.h"
 
+#include "AccumulatedDeltas.h"
 #include "Color.h"
-#include "CurveGenerator.h"
 #include "FragmentShader.h"
 #include "GLInfo.h"
+#include "Instrumentation.h"
+#include "Matrix.h"
+#include "Philox4x32.h"
 #include "Program.h"
+#include "RingBuffer.h"
+#include "WingCurves.h"
 #include "WingRendererGL10.h"
 #include "WingRendererGL11.h"
 #include "WingRendererGL15.h"
+#include "WingRendererGL15Batched.h"
 #include "VertexShader.h"
 #include "Wing.h"
+#include "WingParameters.h"
 
 using namespace std::literals::string_literals;
 
 namespace silnith::wings::gl2
 {
 
+	std::unique_ptr<silnith::wings::gl::WingRenderer> WingsViewGL2::MakeWingRenderer(silnith::wings::gl::GLInfo const& glInfo)
+	{
+		if (glInfo.isAtLeastVersion(1, 5))
+		{
+			return std::make_unique<silnith::wings::gl::WingRendererGL15>();
+		}
+		else if (glInfo.isAtLeastVersion(1, 1))
+		{
+			return std::make_unique<silnith::wings::gl::WingRendererGL11>();
+		}
+		else
+		{
+			return std::make_unique<silnith::wings::gl::WingRendererGL10>();
+		}
+	}
+
 	WingsViewGL2::WingsViewGL2(silnith::wings::gl::GLInfo const & glInfo) :
-		enablePolygonOffset{ glInfo.isAtLeastVersion(1, 1) }
+		WingsViewGL2{ glInfo, MakeWingRenderer(glInfo), defaultNumWings, Philox4x32::generateRandomSeed() }
+	{}
+
+	WingsViewGL2::WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo,
+		std::unique_ptr<silnith::wings::gl::WingRenderer> wingRenderer,
+		std::size_t numWings, std::uint64_t seed) :
+		WingsViewGL2{ glInfo, std::move(wingRenderer), WingTransform::Precomputed, numWings, seed }
+	{}
+
+	WingsViewGL2::WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo,
+		std::unique_ptr<silnith::wings::gl::WingRenderer> wingRenderer,
+		WingTransform wingTransform,
+		std::size_t numWings, std::uint64_t seed) :
+		WingsViewGL2{ glInfo, std::move(wingRenderer), nullptr, wingTransform, numWings, seed }
+	{}
+
+	WingsViewGL2::WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo,
+		std::unique_ptr<silnith::wings::gl::WingRendererGL15Batched> batchedWingRenderer,
+		std::size_t numWings, std::uint64_t seed) :
+		WingsViewGL2{ glInfo, nullptr, std::move(batchedWingRenderer), WingTransform::Precomputed, numWings, seed }
+	{}
+
+	WingsViewGL2::WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo,
+		std::unique_ptr<silnith::wings::gl::WingRenderer> wingRenderer,
+		std::unique_ptr<silnith::wings::gl::WingRendererGL15Batched> batchedWingRenderer,
+		WingTransform wingTransform,
+		std::size_t numWings, std::uint64_t seed) :
+		numWings{ numWings },
+		curves{ seed },
+		wingTransform{ wingTransform },
+		enablePolygonOffset{ glInfo.isAtLeastVersion(1, 1) },
+		wingRenderer{ std::move(wingRenderer) },
+		batchedWingRenderer{ std::move(batchedWingRenderer) }
 	{
+		assert(static_cast<bool>(this->wingRenderer) != static_cast<bool>(this->batchedWingRenderer));
+
 		/*
 		 * Depth testing is a basic requirement when using a depth buffer.
 		 */
@@ -63,23 +125,6 @@ namespace silnith::wings::gl2
 			0, 0, 13,
 			0, 0, 1);
 
-		/*
-		 * Set up the pieces needed to render one single
-		 * (untransformed, uncolored) wing.
-		 */
-		if (glInfo.isAtLeastVersion(1, 5))
-		{
-			wingRenderer = std::make_unique<silnith::wings::gl::WingRendererGL15>();
-		}
-		else if (glInfo.isAtLeastVersion(1, 1))
-		{
-			wingRenderer = std::make_unique<silnith::wings::gl::WingRendererGL11>();
-		}
-		else
-		{
-			wingRenderer = std::make_unique<silnith::wings::gl::WingRendererGL10>();
-		}
-
 		if (glInfo.isAtLeastVersion(2, 1))
 		{
 			/*
@@ -93,7 +138,11 @@ namespace silnith::wings::gl2
 			{
 				/// <summary>
 				/// The main vertex shader.  This has three input attributes,
-				/// <c>deltaZ</c>, <c>radiusAngle</c>, and <c>rollPitchYaw</c>.
+				/// <c>anchor</c>, <c>radiusAngle</c>, and <c>rollPitchYaw</c>,
+				/// and one uniform, <c>sectionOffsets</c>.  When the wing
+				/// transformation is precomputed, the latter two attributes are
+				/// replaced by the single <c>mat4</c> attribute <c>wingTransformation</c>,
+				/// and when the wings are batched they are dropped entirely.
 				/// It requires linking against the vertex shaders provided by
 				/// <see cref="VertexShader::MakeRotateMatrixShader"/>,
 				/// <see cref="VertexShader::MakeTranslateMatrixShader"/>, and
@@ -108,10 +157,22 @@ namespace silnith::wings::gl2
 				std::shared_ptr<VertexShader const> const mainVertexShader{
 					std::make_shared<VertexShader const>(std::initializer_list<std::string>{
 						Shader::versionDeclaration,
+						this->batchedWingRenderer
+							? "#define PRECOMPUTED_WING_VERTICES\n"s
+							: wingTransform == WingTransform::Precomputed
+							? "#define PRECOMPUTED_WING_TRANSFORMATION\n"s
+							: ""s,
 						R"shaderText(
-attribute vec2 deltaZ;
+attribute vec3 anchor;
+#if defined(PRECOMPUTED_WING_VERTICES)
+#elif defined(PRECOMPUTED_WING_TRANSFORMATION)
+attribute mat4 wingTransformation;
+#else
 attribute vec2 radiusAngle;
 attribute vec3 rollPitchYaw;
+#endif
+
+uniform vec2 sectionOffsets[3];
 
 const vec3 xAxis = vec3(1, 0, 0);
 const vec3 yAxis = vec3(0, 1, 0);
@@ -131,10 +192,30 @@ const vec3 zAxis = vec3(0, 0, 1);
  * It may write to gl_PointSize and gl_ClipVertex.
  */
 void main() {
+    /*
+     * The accumulated deltas of this wing and every newer wing.
+     * See AccumulatedDeltas for why this is a difference.
+     */
+    vec2 accumulatedDeltas = sectionOffsets[int(anchor[2])] - anchor.xy;
+    float deltaAngle = accumulatedDeltas[0];
+    float dZ = accumulatedDeltas[1];
+
+#if defined(PRECOMPUTED_WING_VERTICES) || defined(PRECOMPUTED_WING_TRANSFORMATION)
+    /*
+     * The wing transformation was computed once when the wing was created,
+     * so the only per-vertex work is this rotation about the Z axis and
+     * translation along it.  Both are written out directly rather than
+     * through the general rotate() and translate().
+     */
+    float c = cos(radians(deltaAngle));
+    float s = sin(radians(deltaAngle));
+    mat4 deltaTransformation = mat4(c, s, 0, 0,
+                                    -s, c, 0, 0,
+                                    0, 0, 1, 0,
+                                    0, 0, dZ, 1);
+#else
     float radius = radiusAngle[0];
     float angle = radiusAngle[1];
-    float deltaAngle = deltaZ[0];
-    float dZ = deltaZ[1];
     float roll = rollPitchYaw[0];
     float pitch = rollPitchYaw[1];
     float yaw = rollPitchYaw[2];
@@ -165,6 +246,7 @@ void main() {
                               * rotate(-yaw, zAxis)
                               * rotate(-pitch, yAxis)
                               * rotate(roll, xAxis);
+#endif
 
     /*
      * The OpenGL 1.0 version did not use face culling.
@@ -179,7 +261,15 @@ void main() {
      * gl_ModelViewProjectionMatrix is a built-in uniform.
      * gl_Vertex is a built-in attribute.
      */
+#ifdef PRECOMPUTED_WING_VERTICES
+    /*
+     * The vertices were multiplied by the wing transformation when the
+     * wing was created.
+     */
+    gl_Position = gl_ModelViewProjectionMatrix * deltaTransformation * gl_Vertex;
+#else
     gl_Position = gl_ModelViewProjectionMatrix * deltaTransformation * wingTransformation * gl_Vertex;
+#endif
 }
 )shaderText"s,
 					})
@@ -226,11 +316,27 @@ void main() {
 				glslProgram = std::make_unique<Program>(vertexShaders, fragmentShaders);
 			}
 
-			deltaZAttribLocation = glslProgram->getAttributeLocation("deltaZ"s);
-			radiusAngleAttribLocation = glslProgram->getAttributeLocation("radiusAngle"s);
-			rollPitchYawAttribLocation = glslProgram->getAttributeLocation("rollPitchYaw"s);
+			anchorAttribLocation = glslProgram->getAttributeLocation("anchor"s);
+			/*
+			 * The batched renderer's vertices already include the wing
+			 * transformation, so there is no attribute for it.
+			 */
+			if (!this->batchedWingRenderer)
+			{
+				switch (wingTransform)
+				{
+				case WingTransform::Shader:
+					radiusAngleAttribLocation = glslProgram->getAttributeLocation("radiusAngle"s);
+					rollPitchYawAttribLocation = glslProgram->getAttributeLocation("rollPitchYaw"s);
+					break;
+				case WingTransform::Precomputed:
+					wingTransformationAttribLocation = glslProgram->getAttributeLocation("wingTransformation"s);
+					break;
+				}
+			}
+			sectionOffsetsUniformLocation = glslProgram->getUniformLocation("sectionOffsets"s);
 
-			glslProgram->useProgram();
+			glslProgram->useProgram(stateCache);
 		}
 		else
 		{
@@ -255,16 +361,17 @@ void main() {
 		 * Get the next updated values for all the parameters that define how
 		 * a wing moves.
 		 */
-		GLfloat const radius{ radiusCurve.getNextValue() };
-		GLfloat const angle{ angleCurve.getNextValue() };
-		GLfloat const deltaAngle{ deltaAngleCurve.getNextValue() };
-		GLfloat const deltaZ{ deltaZCurve.getNextValue() };
-		GLfloat const roll{ rollCurve.getNextValue() };
-		GLfloat const pitch{ pitchCurve.getNextValue() };
-		GLfloat const yaw{ yawCurve.getNextValue() };
-		GLfloat const red{ redCurve.getNextValue() };
-		GLfloat const green{ greenCurve.getNextValue() };
-		GLfloat const blue{ blueCurve.getNextValue() };
+		instrumentation::PhaseTimer curveTimer{ instrumentation::Phase::CurveStep };
+		WingParameters<GLfloat> const parameters{ NextWingParameters() };
+		curveTimer.Stop();
+
+		instrumentation::PhaseTimer const transformTimer{ instrumentation::Phase::Transform };
+
+		if (batchedWingRenderer)
+		{
+			AddBatchedWing(parameters);
+			return;
+		}
 
 		/// <summary>
 		/// The display list for the new wing.
@@ -274,19 +381,16 @@ void main() {
 		/// This display list will be compiled to apply the transformations
 		/// that are specific to the wing.  This includes the orientation of
 		/// the wing (roll, pitch, yaw) as well as its radius and angle from
-		/// the central axis.  It does not include the "delta" parameters,
-		/// because those are relative between successive wings and so must
-		/// be applied by the core rendering loop.  The colors are also not
+		/// the central axis.  The "delta" parameters are relative between
+		/// successive wings, so only the wing's anchor into the accumulated
+		/// deltas is included, and the rendering loop supplies the current
+		/// offsets once per frame.  The colors are also not
 		/// included because the display list will be used twice with different
 		/// colors and rendering modes.
 		/// </para>
 		/// </remarks>
 		GLuint displayList{ 0 };
-		if (wings.empty() || wings.size() < numWings)
-		{
-			displayList = glGenLists(1);
-		}
-		else
+		if (wings.full())
 		{
 			/*
 			 * If a wing expires off the end of the list of wings, we can reuse
@@ -294,15 +398,69 @@ void main() {
 			 * data will be overwritten.
 			 */
 			displayList = wings.back().getGLDisplayList();
-			wings.pop_back();
+		}
+		else
+		{
+			displayList = glGenLists(1);
+		}
+
+		AddWing(displayList, parameters);
+	}
+
+	void WingsViewGL2::WarmStart(void)
+	{
+		assert(wings.empty());
+		assert(!batchedWingRenderer || batchedWingRenderer->getNumWings() == 0);
+
+		instrumentation::PhaseTimer const warmStartTimer{ instrumentation::Phase::WarmStart };
+
+		if (batchedWingRenderer)
+		{
+			for (std::size_t i{ 0 }; i < numWings; i++)
+			{
+				AddBatchedWing(NextWingParameters());
+			}
+			return;
 		}
 
+		/*
+		 * The display lists are allocated as one contiguous range.  Each wing
+		 * still owns exactly one of them, so the destructor and the reuse in
+		 * AdvanceAnimation do not need to know how they were allocated.
+		 */
+		GLuint const firstDisplayList{ glGenLists(static_cast<GLsizei>(numWings)) };
+		for (std::size_t i{ 0 }; i < numWings; i++)
+		{
+			AddWing(firstDisplayList + static_cast<GLuint>(i), NextWingParameters());
+		}
+	}
+
+	WingParameters<GLfloat> WingsViewGL2::NextWingParameters(void)
+	{
+		return curves.getNextParameters();
+	}
+
+	void WingsViewGL2::AddBatchedWing(WingParameters<GLfloat> const& parameters)
+	{
+		/*
+		 * Nothing is compiled.  The new wing overwrites one slot of the
+		 * buffer object that holds every wing.
+		 */
+		batchedWingRenderer->AddWing(WingTransformation(parameters.radius, parameters.angle, parameters.roll, parameters.pitch, parameters.yaw),
+			accumulatedDeltas.AddWing(parameters.deltaAngle, parameters.deltaZ),
+			Color<GLfloat>{ parameters.red, parameters.green, parameters.blue },
+			Color<GLfloat>::WHITE);
+	}
+
+	void WingsViewGL2::AddWing(GLuint displayList, WingParameters<GLfloat> const& parameters)
+	{
 		wings.emplace_front(displayList,
-			radius, angle,
-			deltaAngle, deltaZ,
-			roll, pitch, yaw,
-			Color<GLfloat>{ red, green, blue },
+			parameters.radius, parameters.angle,
+			parameters.deltaAngle, parameters.deltaZ,
+			parameters.roll, parameters.pitch, parameters.yaw,
+			Color<GLfloat>{ parameters.red, parameters.green, parameters.blue },
 			Color<GLfloat>::WHITE);
+		AccumulatedDeltas<GLfloat>::Anchor const anchor{ accumulatedDeltas.AddWing(parameters.deltaAngle, parameters.deltaZ) };
 
 		/*
 		 * Create a display list that transforms the wing based on its current
@@ -311,28 +469,53 @@ void main() {
 		 * or pop is necessary.
 		 */
 		glNewList(displayList, GL_COMPILE);
-		glVertexAttrib2f(radiusAngleAttribLocation, radius, angle);
-		glVertexAttrib3f(rollPitchYawAttribLocation, roll, pitch, yaw);
+		glVertexAttrib3f(anchorAttribLocation, anchor.angle, anchor.z, static_cast<GLfloat>(anchor.section));
+		switch (wingTransform)
+		{
+		case WingTransform::Shader:
+			glVertexAttrib2f(radiusAngleAttribLocation, parameters.radius, parameters.angle);
+			glVertexAttrib3f(rollPitchYawAttribLocation, parameters.roll, parameters.pitch, parameters.yaw);
+			break;
+		case WingTransform::Precomputed:
+		{
+			/*
+			 * A matrix attribute occupies one location per column.
+			 */
+			Matrix const wingTransformation{ WingTransformation(parameters.radius, parameters.angle, parameters.roll, parameters.pitch, parameters.yaw) };
+			for (GLuint column{ 0 }; column < 4; column++)
+			{
+				glVertexAttrib4fv(wingTransformationAttribLocation + column, wingTransformation.data() + column * 4);
+			}
+			break;
+		}
+		}
 		wingRenderer->DrawWing();
 		glEndList();
 	}
 
 	void WingsViewGL2::DrawFrame(void) const
 	{
+		/*
+		 * Each wing's display list or buffer slot holds its anchor, so the
+		 * accumulated deltas of every wing are updated by this one uniform.
+		 */
+		std::array<GLfloat, 2 * AccumulatedDeltas<GLfloat>::numSections> const sectionOffsets{ accumulatedDeltas.getSectionOffsets() };
+		glUniform2fv(sectionOffsetsUniformLocation, AccumulatedDeltas<GLfloat>::numSections, sectionOffsets.data());
+
 		/*
 		 * First, draw the solid wings using their solid color.
 		 */
-		GLfloat deltaZ{ 0 };
-		GLfloat deltaAngle{ 0 };
+		instrumentation::PhaseTimer fillTimer{ instrumentation::Phase::FillPass };
+		if (batchedWingRenderer)
+		{
+			batchedWingRenderer->DrawFills(anchorAttribLocation);
+		}
 		for (Wing<GLuint, GLfloat> const& wing : wings) {
-			deltaZ += wing.getDeltaZ();
-			deltaAngle += wing.getDeltaAngle();
-
 			Color<GLfloat> const& color{ wing.getColor() };
 			glColor3f(color.getRed(), color.getGreen(), color.getBlue());
-			glVertexAttrib2f(deltaZAttribLocation, deltaAngle, deltaZ);
 			glCallList(wing.getGLDisplayList());
 		}
+		fillTimer.Stop();
 
 		if (enablePolygonOffset)
 		{
@@ -348,28 +531,33 @@ void main() {
 			 * And corners where lines adjoin will allow overlapping partial fragments to
 			 * blend together rather than displace each other.
 			 */
-			glDepthFunc(GL_LEQUAL);
-			glDepthMask(GL_FALSE);
-			glEnable(GL_BLEND);
-			glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-			deltaZ = 0;
-			deltaAngle = 0;
+			instrumentation::PhaseTimer const outlineTimer{ instrumentation::Phase::OutlinePass };
+			stateCache.DepthFunc(GL_LEQUAL);
+			stateCache.DepthMask(GL_FALSE);
+			stateCache.Enable(GL_BLEND);
+			stateCache.PolygonMode(GL_LINE);
+			if (batchedWingRenderer)
+			{
+				batchedWingRenderer->DrawOutlines(anchorAttribLocation);
+			}
 			for (Wing<GLuint, GLfloat> const& wing : wings) {
-				deltaZ += wing.getDeltaZ();
-				deltaAngle += wing.getDeltaAngle();
-
 				Color<GLfloat> const& edgeColor{ wing.getEdgeColor() };
 				glColor3f(edgeColor.getRed(), edgeColor.getGreen(), edgeColor.getBlue());
-				glVertexAttrib2f(deltaZAttribLocation, deltaAngle, deltaZ);
 				glCallList(wing.getGLDisplayList());
 			}
-			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-			glDisable(GL_BLEND);
-			glDepthMask(GL_TRUE);
-			glDepthFunc(GL_LESS);
+			stateCache.PolygonMode(GL_FILL);
+			stateCache.Disable(GL_BLEND);
+			stateCache.DepthMask(GL_TRUE);
+			stateCache.DepthFunc(GL_LESS);
 		}
 
 		glFlush();
+
+		stateCache.EndFrame();
+
+		firstFrameTimer.FrameDrawn(batchedWingRenderer
+			? batchedWingRenderer->getNumWings() == numWings
+			: wings.full());
 	}
 
 	void WingsViewGL2::Resize(GLsizei width, GLsizei height) const
@@ -429,4 +617,14 @@ void main() {
 		glMatrixMode(GL_MODELVIEW);
 	}
 
+	silnith::wings::gl::GLStateCache const& WingsViewGL2::getStateCache(void) const noexcept
+	{
+		return stateCache;
+	}
+
+	silnith::wings::gl::GLStateCache& WingsViewGL2::getStateCache(void) noexcept
+	{
+		return stateCache;
+	}
+
 }
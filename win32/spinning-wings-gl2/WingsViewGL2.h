@@ -1,17 +1,25 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <deque>
 #include <memory>
 
 #include <cstddef>
+#include <cstdint>
 
-#include "CurveGenerator.h"
+#include "AccumulatedDeltas.h"
 #include "GLInfo.h"
+#include "GLStateCache.h"
+#include "Instrumentation.h"
+#include "RingBuffer.h"
+#include "WingCurves.h"
 #include "WingRenderer.h"
+#include "WingRendererGL15Batched.h"
 #include "Wing.h"
+#include "WingParameters.h"
 
 #include "FragmentShader.h"
 #include "Program.h"
@@ -20,6 +28,26 @@
 namespace silnith::wings::gl2
 {
 
+    /// <summary>
+    /// Where the transformation that places each wing relative to the central
+    /// axis is computed.
+    /// </summary>
+    enum class WingTransform
+    {
+        /// <summary>
+        /// The vertex shader builds the transformation from the radius, angle,
+        /// roll, pitch, and yaw of the wing, for every vertex of every frame.
+        /// </summary>
+        Shader,
+
+        /// <summary>
+        /// The transformation is computed once when the wing is created and
+        /// compiled into its display list as a matrix attribute, so the vertex
+        /// shader only multiplies by it.
+        /// </summary>
+        Precomputed,
+    };
+
     /// <summary>
     /// An object to encapsulate all of the logic and data for initializing,
     /// animating, and rendering the 3D view of the spinning wings.
@@ -45,6 +73,64 @@ namespace silnith::wings::gl2
         /// <param name="glInfo">The queryable OpenGL information.</param>
         explicit WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo);
 
+        /// <summary>
+        /// Configures the OpenGL state machine for rendering the spinning wings
+        /// animation using a specific wing renderer, number of wings, and seed.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This exists so that the wing renderers for older versions of OpenGL
+        /// can be compared against each other on the same implementation.
+        /// Two views created with the same seed produce identical animations.
+        /// </para>
+        /// </remarks>
+        /// <param name="glInfo">The queryable OpenGL information.</param>
+        /// <param name="wingRenderer">The handler for drawing a single wing.</param>
+        /// <param name="numWings">The number of wings to animate.</param>
+        /// <param name="seed">The seed for the curve generators.</param>
+        explicit WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo,
+            std::unique_ptr<silnith::wings::gl::WingRenderer> wingRenderer,
+            std::size_t numWings, std::uint64_t seed);
+
+        /// <summary>
+        /// Configures the OpenGL state machine for rendering the spinning wings
+        /// animation using a specific wing renderer, wing transformation,
+        /// number of wings, and seed.
+        /// </summary>
+        /// <param name="glInfo">The queryable OpenGL information.</param>
+        /// <param name="wingRenderer">The handler for drawing a single wing.</param>
+        /// <param name="wingTransform">Where the wing transformation is computed.</param>
+        /// <param name="numWings">The number of wings to animate.</param>
+        /// <param name="seed">The seed for the curve generators.</param>
+        explicit WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo,
+            std::unique_ptr<silnith::wings::gl::WingRenderer> wingRenderer,
+            WingTransform wingTransform,
+            std::size_t numWings, std::uint64_t seed);
+
+        /// <summary>
+        /// Configures the OpenGL state machine for rendering the spinning wings
+        /// animation with every wing held in one buffer object, so that each
+        /// pass is a single draw call instead of one display list per wing.
+        /// </summary>
+        /// <param name="glInfo">The queryable OpenGL information.</param>
+        /// <param name="batchedWingRenderer">The handler for drawing every wing, with room for <paramref name="numWings"/> wings.</param>
+        /// <param name="numWings">The number of wings to animate.</param>
+        /// <param name="seed">The seed for the curve generators.</param>
+        explicit WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo,
+            std::unique_ptr<silnith::wings::gl::WingRendererGL15Batched> batchedWingRenderer,
+            std::size_t numWings, std::uint64_t seed);
+
+    private:
+        /// <summary>
+        /// The constructor that all of the others delegate to.  Exactly one of
+        /// the two wing renderers is provided.
+        /// </summary>
+        explicit WingsViewGL2(silnith::wings::gl::GLInfo const& glInfo,
+            std::unique_ptr<silnith::wings::gl::WingRenderer> wingRenderer,
+            std::unique_ptr<silnith::wings::gl::WingRendererGL15Batched> batchedWingRenderer,
+            WingTransform wingTransform,
+            std::size_t numWings, std::uint64_t seed);
+
 #pragma region Rule of Five
 
     public:
@@ -68,6 +154,20 @@ namespace silnith::wings::gl2
         /// </remarks>
         void AdvanceAnimation(void);
 
+        /// <summary>
+        /// Fills the entire wing history at once, so that the first frame
+        /// drawn is already a complete spiral.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This is equivalent to calling <see cref="AdvanceAnimation"/> once
+        /// per wing, except that the display lists for all of the wings are
+        /// allocated with a single call.  It must be called before the
+        /// animation is advanced for the first time.
+        /// </para>
+        /// </remarks>
+        void WarmStart(void);
+
         /// <summary>
         /// Renders the current spinning wings animation frame into the current
         /// rendering context.
@@ -110,127 +210,145 @@ namespace silnith::wings::gl2
         /// <param name="height">the new viewport height</param>
         void Resize(GLint x, GLint y, GLsizei width, GLsizei height) const;
 
-    private:
         /// <summary>
-        /// The number of wings to animate.
+        /// Returns the shadow of the OpenGL state that drawing changes, which
+        /// counts the state changes that were issued and elided.
         /// </summary>
-        std::size_t const numWings{ 40 };
+        /// <returns>The state cache.</returns>
+        [[nodiscard]]
+        silnith::wings::gl::GLStateCache const& getStateCache(void) const noexcept;
 
         /// <summary>
-        /// Whether the GL supports the polygon offset feature.
+        /// Returns the shadow of the OpenGL state that drawing changes, so
+        /// that code changing the same state can invalidate it.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// This feature prevents Z-fighting between the polygon surface and
-        /// the wire outline of each wing.  If it is supported, then the wire
-        /// outlines will be rendered.  The outlines will also have smoothing
-        /// enabled, which requires fragment blending.
-        /// </para>
-        /// <para>
-        /// Since this project is a demonstration for OpenGL 2.0, this will
-        /// always be <see langword="true"/>.
-        /// </para>
-        /// </remarks>
-        bool const enablePolygonOffset{ false };
+        /// <returns>The state cache.</returns>
+        [[nodiscard]]
+        silnith::wings::gl::GLStateCache& getStateCache(void) noexcept;
 
+    public:
         /// <summary>
-        /// A handler for drawing the actual wing.
+        /// The number of wings animated when none is specified.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// The actual implementation will be chosen at runtime during
-        /// construction based on the version of OpenGL supported.
-        /// </para>
-        /// <para>
-        /// (Of course, since this is the OpenGL 2.x demonstration, the
-        /// renderer chosen will always be the OpenGL 1.5 implementation.)
-        /// </para>
-        /// </remarks>
-        std::unique_ptr<silnith::wings::gl::WingRenderer> wingRenderer{ nullptr };
+        static std::size_t constexpr defaultNumWings{ 40 };
 
         /// <summary>
-        /// The sequence of transformed wings.
+        /// Returns the wing renderer for the newest version of OpenGL supported.
         /// </summary>
-        std::deque<Wing<GLuint, GLfloat> > wings{};
+        /// <param name="glInfo">The queryable OpenGL information.</param>
+        /// <returns>A new wing renderer.</returns>
+        [[nodiscard]]
+        static std::unique_ptr<silnith::wings::gl::WingRenderer> MakeWingRenderer(silnith::wings::gl::GLInfo const& glInfo);
 
-#pragma region The Random Curve Generators
+    private:
+        /// <summary>
+        /// Steps every curve once.
+        /// </summary>
+        /// <returns>The parameters of the next wing.</returns>
+        [[nodiscard]]
+        WingParameters<GLfloat> NextWingParameters(void);
 
         /// <summary>
-        /// The curve generator for the distance of the wing from the central axis.
+        /// Adds a new wing to the batched wing renderer.
         /// </summary>
-        CurveGenerator<GLfloat> radiusCurve{ 10.0f, -15.0f, 15.0f, false, 0.1f, 0.01f, 150 };
+        /// <param name="parameters">The parameters of the new wing.</param>
+        void AddBatchedWing(WingParameters<GLfloat> const& parameters);
 
         /// <summary>
-        /// The curve generator for the angle that the wing is rotated around the central axis.
+        /// Adds a new wing to the front of the history and compiles its
+        /// transformation into a display list.
         /// </summary>
-        CurveGenerator<GLfloat> angleCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120) };
+        /// <param name="displayList">The display list to compile.  It must not be used by any other wing.</param>
+        /// <param name="parameters">The parameters of the new wing.</param>
+        void AddWing(GLuint displayList, WingParameters<GLfloat> const& parameters);
 
+    private:
         /// <summary>
-        /// The curve generator for the additional angle added to each successive "shadow" of the wing.
+        /// The time from construction to the first complete frame.  This is
+        /// declared first so that it includes the construction of every other member.
         /// </summary>
-        CurveGenerator<GLfloat> deltaAngleCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(15.0f, 0.2f, 0.02f, 80) };
+        silnith::wings::instrumentation::FirstFrameTimer const firstFrameTimer{};
 
         /// <summary>
-        /// The curve generator for the distance "up" the central axis that each wing shadow is moved.
+        /// The number of wings to animate.
         /// </summary>
-        CurveGenerator<GLfloat> deltaZCurve{ 0.5f, 0.4f, 0.7f, false, 0.01f, 0.001f, 200 };
+        std::size_t const numWings{ defaultNumWings };
 
         /// <summary>
-        /// The curve generator for the roll of the wing.
+        /// The curve generators for all of the parameters that define how a wing moves.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
-        /// </para>
-        /// </remarks>
-        CurveGenerator<GLfloat> rollCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 1.0f, 0.25f, 80) };
+        WingCurves curves;
 
         /// <summary>
-        /// The curve generator for the pitch of the wing.
+        /// The shadow of the OpenGL state that <see cref="DrawFrame"/> changes.
+        /// </summary>
+        mutable silnith::wings::gl::GLStateCache stateCache{};
+
+        /// <summary>
+        /// Where the wing transformation is computed.
+        /// </summary>
+        WingTransform const wingTransform{ WingTransform::Precomputed };
+
+        /// <summary>
+        /// Whether the GL supports the polygon offset feature.
         /// </summary>
         /// <remarks>
         /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
+        /// This feature prevents Z-fighting between the polygon surface and
+        /// the wire outline of each wing.  If it is supported, then the wire
+        /// outlines will be rendered.  The outlines will also have smoothing
+        /// enabled, which requires fragment blending.
+        /// </para>
+        /// <para>
+        /// Since this project is a demonstration for OpenGL 2.0, this will
+        /// always be <see langword="true"/>.
         /// </para>
         /// </remarks>
-        CurveGenerator<GLfloat> pitchCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 2.0f, 0.25f, 40) };
+        bool const enablePolygonOffset{ false };
 
         /// <summary>
-        /// The curve generator for the yaw of the wing.
+        /// A handler for drawing the actual wing.
         /// </summary>
         /// <remarks>
         /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
+        /// Unless one is provided, the actual implementation will be chosen at
+        /// runtime during construction based on the version of OpenGL supported.
+        /// </para>
+        /// <para>
+        /// (Of course, since this is the OpenGL 2.x demonstration, the
+        /// renderer chosen will always be the OpenGL 1.5 implementation.)
         /// </para>
         /// </remarks>
-        CurveGenerator<GLfloat> yawCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 1.5f, 0.25f, 50) };
+        std::unique_ptr<silnith::wings::gl::WingRenderer> wingRenderer{ nullptr };
 
         /// <summary>
-        /// The curve generator for the red component of the wing color.
+        /// A handler for drawing every wing at once.  If this is provided,
+        /// then <see cref="wingRenderer"/> is not, no display lists are
+        /// compiled, and the vertex shader receives vertices that already
+        /// include the wing transformation.
         /// </summary>
-        CurveGenerator<GLfloat> redCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 95) };
+        std::unique_ptr<silnith::wings::gl::WingRendererGL15Batched> batchedWingRenderer{ nullptr };
 
         /// <summary>
-        /// The curve generator for the green component of the wing color.
+        /// The sequence of transformed wings.
         /// </summary>
-        CurveGenerator<GLfloat> greenCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 40) };
+        RingBuffer<Wing<GLuint, GLfloat> > wings{ numWings };
 
         /// <summary>
-        /// The curve generator for the blue component of the wing color.
+        /// The delta angle and delta Z accumulated by the wings.
         /// </summary>
-        CurveGenerator<GLfloat> blueCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 70) };
-
-#pragma endregion
+        AccumulatedDeltas<GLfloat> accumulatedDeltas{ numWings };
 
         /// <summary>
         /// The GLSL program for rendering.
         /// </summary>
         /// <remarks>
         /// <para>
-        /// This has three attributes that should be populated using <c>glGetAttribLocation</c>:
+        /// This has three attributes that should be populated using <c>glGetAttribLocation</c>,
+        /// and one uniform populated using <c>glGetUniformLocation</c>.  For
+        /// <see cref="WingTransform::Precomputed"/>, <c>radiusAngle</c> and
+        /// <c>rollPitchYaw</c> are replaced by the <c>mat4</c> attribute
+        /// <c>wingTransformation</c>:
         /// </para>
         /// <list>
         /// <listheader>
@@ -238,8 +356,8 @@ namespace silnith::wings::gl2
         /// <description>Data Type</description>
         /// </listheader>
         /// <item>
-        /// <term>deltaZ</term>
-        /// <description>vec2</description>
+        /// <term>anchor</term>
+        /// <description>vec3</description>
         /// </item>
         /// <item>
         /// <term>radiusAngle</term>
@@ -249,24 +367,30 @@ namespace silnith::wings::gl2
         /// <term>rollPitchYaw</term>
         /// <description>vec3</description>
         /// </item>
+        /// <item>
+        /// <term>sectionOffsets</term>
+        /// <description>vec2[3]</description>
+        /// </item>
         /// </list>
         /// </remarks>
-        /// <seealso cref="deltaZAttribLocation"/>
+        /// <seealso cref="anchorAttribLocation"/>
         /// <seealso cref="radiusAngleAttribLocation"/>
         /// <seealso cref="rollPitchYawAttribLocation"/>
+        /// <seealso cref="sectionOffsetsUniformLocation"/>
         std::unique_ptr<Program> glslProgram{ nullptr };
 
         /// <summary>
-        /// The attribute location for the <c>deltaZ</c> attribute.
-        /// This is of type <c>vec2</c>.
+        /// The attribute location for the <c>anchor</c> attribute.
+        /// This is of type <c>vec3</c>.
         /// </summary>
         /// <example>
         /// <code>
-        /// glVertexAttrib2f(deltaZAttribLocation, deltaAngle, deltaZ);
+        /// glVertexAttrib3f(anchorAttribLocation, anchor.angle, anchor.z, anchor.section);
         /// </code>
         /// </example>
         /// <seealso cref="glslProgram"/>
-        GLuint deltaZAttribLocation{ 0 };
+        /// <seealso cref="AccumulatedDeltas"/>
+        GLuint anchorAttribLocation{ 0 };
 
         /// <summary>
         /// The attribute location for the <c>radiusAngle</c> attribute.
@@ -291,6 +415,32 @@ namespace silnith::wings::gl2
         /// </example>
         /// <seealso cref="glslProgram"/>
         GLuint rollPitchYawAttribLocation{ 0 };
+
+        /// <summary>
+        /// The attribute location for the <c>wingTransformation</c> attribute.
+        /// This is of type <c>mat4</c>, and so occupies four consecutive
+        /// locations, one for each column.
+        /// </summary>
+        /// <example>
+        /// <code>
+        /// glVertexAttrib4fv(wingTransformationAttribLocation + column, matrix.data() + column * 4);
+        /// </code>
+        /// </example>
+        /// <seealso cref="glslProgram"/>
+        GLuint wingTransformationAttribLocation{ 0 };
+
+        /// <summary>
+        /// The uniform location for the <c>sectionOffsets</c> uniform.
+        /// This is of type <c>vec2[3]</c>.
+        /// </summary>
+        /// <example>
+        /// <code>
+        /// glUniform2fv(sectionOffsetsUniformLocation, 3, accumulatedDeltas.getSectionOffsets().data());
+        /// </code>
+        /// </example>
+        /// <seealso cref="glslProgram"/>
+        /// <seealso cref="AccumulatedDeltas"/>
+        GLint sectionOffsetsUniformLocation{ -1 };
     };
 
 }
@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <initializer_list>
@@ -296,9 +298,12 @@ namespace silnith::wings::gl3
         return static_cast<GLint>(uniformLocation);
     }
 
-    void Program::useProgram(void) const
+    void Program::useProgram(silnith::wings::gl::GLStateCache& stateCache) const
     {
-        glUseProgram(name);
+        if (stateCache.ChangeProgram(name))
+        {
+            glUseProgram(name);
+        }
     }
 
 }
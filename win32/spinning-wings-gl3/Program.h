@@ -1,6 +1,8 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <initializer_list>
@@ -8,6 +10,7 @@
 #include <string>
 
 #include "FragmentShader.h"
+#include "GLStateCache.h"
 #include "VertexShader.h"
 
 namespace silnith::wings::gl3
@@ -101,10 +104,12 @@ namespace silnith::wings::gl3
         GLint getUniformLocation(std::string const& uniformName) const;
 
         /// <summary>
-        /// Installs the GLSL program as part of the current rendering state.
+        /// Installs the GLSL program as part of the current rendering state,
+        /// unless the state cache shows that it already is.
         /// </summary>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
         /// <exception cref="std::runtime_error">If the program could not be installed.</exception>
-        void useProgram(void) const;
+        void useProgram(silnith::wings::gl::GLStateCache& stateCache) const;
 
     private:
         /// <summary>
@@ -15,6 +15,7 @@
 #include <memory>
 #include <stdexcept>
 
+#include "Instrumentation.h"
 #include "WingsPixelFormat.h"
 #include "WingsViewGL3.h"
 
@@ -79,7 +80,10 @@ void CALLBACK AdvanceAnimation(HWND hWnd, UINT uMsg, UINT_PTR idEvent, DWORD dwT
 
 	assert(hglrc == wglGetCurrentContext());
 
-	wingsView->AdvanceAnimation();
+	{
+		silnith::wings::instrumentation::PhaseTimer const tickTimer{ silnith::wings::instrumentation::Phase::Tick };
+		wingsView->AdvanceAnimation();
+	}
 
 	HRGN constexpr hRegion{ nullptr };
 	BOOL constexpr eraseBackground{ FALSE };
@@ -310,7 +314,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		wingsView->DrawFrame();
+		{
+			silnith::wings::instrumentation::PhaseTimer const frameTimer{ silnith::wings::instrumentation::Phase::Frame };
+			wingsView->DrawFrame();
+		}
 
 		PAINTSTRUCT paintstruct{};
 		HDC const hdc{ BeginPaint(hWnd, &paintstruct) };
@@ -318,7 +325,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			return -1;
 		}
 
-		SwapBuffers(hdc);
+		{
+			silnith::wings::instrumentation::PhaseTimer const swapTimer{ silnith::wings::instrumentation::Phase::Swap };
+			SwapBuffers(hdc);
+		}
 
 		EndPaint(hWnd, &paintstruct);
 		return 0;
@@ -344,6 +354,8 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 		wglDeleteContext(hglrc);
 
+		silnith::wings::instrumentation::WriteReport();
+
 		PostQuitMessage(0);
 		return 0;
 	}
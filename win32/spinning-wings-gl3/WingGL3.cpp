@@ -1,46 +1,34 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <memory>
-
 #include "WingGL3.h"
 
-#include "ArrayBuffer.h"
+#include "AccumulatedDeltas.h"
 
 namespace silnith::wings::gl3
 {
 
-	Wing::Wing(GLfloat deltaAngle, GLfloat deltaZ,
-		std::shared_ptr<ArrayBuffer const> const& vertexBuffer,
-		std::shared_ptr<ArrayBuffer const> const& colorBuffer,
-		std::shared_ptr<ArrayBuffer const> const& edgeColorBuffer) noexcept
-		: deltaAngle{ deltaAngle }, deltaZ{ deltaZ },
-		vertexBuffer{ vertexBuffer }, colorBuffer{ colorBuffer }, edgeColorBuffer{ edgeColorBuffer }
+	Wing::Wing(AccumulatedDeltas<GLfloat>::Anchor const& anchor,
+		GLint firstVertex) noexcept
+		: anchor{ anchor },
+		firstVertex{ firstVertex }
 	{}
 
-	GLfloat Wing::getDeltaAngle(void) const noexcept
-	{
-		return deltaAngle;
-	}
-
-	GLfloat Wing::getDeltaZ(void) const noexcept
-	{
-		return deltaZ;
-	}
-
-	std::shared_ptr<ArrayBuffer const> Wing::getVertexBuffer(void) const noexcept
+	AccumulatedDeltas<GLfloat>::Anchor const& Wing::getAnchor(void) const noexcept
 	{
-		return vertexBuffer;
+		return anchor;
 	}
 
-	std::shared_ptr<ArrayBuffer const> Wing::getColorBuffer(void) const noexcept
+	void Wing::setAnchor(AccumulatedDeltas<GLfloat>::Anchor const& anchor) noexcept
 	{
-		return colorBuffer;
+		this->anchor = anchor;
 	}
 
-	std::shared_ptr<ArrayBuffer const> Wing::getEdgeColorBuffer(void) const noexcept
+	GLint Wing::getFirstVertex(void) const noexcept
 	{
-		return edgeColorBuffer;
+		return firstVertex;
 	}
 
 }
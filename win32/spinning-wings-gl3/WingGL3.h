@@ -1,12 +1,12 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <memory>
-
+#include "AccumulatedDeltas.h"
 #include "Color.h"
-#include "ArrayBuffer.h"
 
 namespace silnith::wings::gl3
 {
@@ -35,22 +35,17 @@ namespace silnith::wings::gl3
 	{
 	public:
 		/// <summary>
-		/// Default constructor is required by the STL containers.
+		/// Default constructor is required by <see cref="RingBuffer"/>.
 		/// </summary>
 		explicit Wing(void) = default;
 
 		/// <summary>
 		/// Creates a new wing with the provided parameters.
 		/// </summary>
-		/// <param name="deltaAngle">The additional angle around the central axis as the wing recedes into history.</param>
-		/// <param name="deltaZ">The additional height along the central axis as the wing recedes into history.</param>
-		/// <param name="vertexBuffer">The vertex buffer to reuse for this wing.</param>
-		/// <param name="colorBuffer">The color buffer to reuse.</param>
-		/// <param name="edgeColorBuffer">The edge color buffer to reuse.</param>
-		explicit Wing(GLfloat deltaAngle, GLfloat deltaZ,
-			std::shared_ptr<ArrayBuffer const> const& vertexBuffer,
-			std::shared_ptr<ArrayBuffer const> const& colorBuffer,
-			std::shared_ptr<ArrayBuffer const> const& edgeColorBuffer) noexcept;
+		/// <param name="anchor">The wing's anchor into the accumulated delta angle and delta Z.</param>
+		/// <param name="firstVertex">The index of the wing's first vertex within the buffer.</param>
+		explicit Wing(AccumulatedDeltas<GLfloat>::Anchor const& anchor,
+			GLint firstVertex) noexcept;
 
 #pragma region Rule of Five
 
@@ -65,67 +60,33 @@ namespace silnith::wings::gl3
 
 	public:
 		/// <summary>
-		/// Returns the additional angle around the central axis that each subsequent wing should be rendered.
-		/// </summary>
-		/// <returns>The additional angle that the wing gains as it recedes into history.</returns>
-		[[nodiscard]]
-		GLfloat getDeltaAngle(void) const noexcept;
-
-		/// <summary>
-		/// Returns the additional distance up the central axis that each subsequent wing should be rendered.
+		/// Returns the wing's anchor into the accumulated delta angle and
+		/// delta Z of all the wings.
 		/// </summary>
-		/// <returns>The additional height that the wing gains as it recedes into history.</returns>
+		/// <returns>The anchor.</returns>
+		/// <seealso cref="AccumulatedDeltas::getAccumulatedDeltas"/>
 		[[nodiscard]]
-		GLfloat getDeltaZ(void) const noexcept;
+		AccumulatedDeltas<GLfloat>::Anchor const& getAnchor(void) const noexcept;
 
 		/// <summary>
-		/// Returns the vertex buffer.  This is only used to hand off ownership
-		/// to a new wing before this one is destroyed.
+		/// Replaces the anchor, so that the wing and its slot in the vertex
+		/// buffer can be reused for a newly-created wing.
 		/// </summary>
-		/// <remarks>
-		/// <para>
-		/// This should be removed once I become comfortable with how to use
-		/// unique pointers to transfer ownership out of an object.
-		/// </para>
-		/// </remarks>
-		/// <returns>A shared pointer to the buffer.</returns>
-		[[nodiscard]]
-		std::shared_ptr<ArrayBuffer const> getVertexBuffer(void) const noexcept;
-
-		/// <summary>
-		/// Returns the color buffer.  This is only used to hand off ownership
-		/// to a new wing before this one is destroyed.
-		/// </summary>
-		/// <remarks>
-		/// <para>
-		/// This should be removed once I become comfortable with how to use
-		/// unique pointers to transfer ownership out of an object.
-		/// </para>
-		/// </remarks>
-		/// <returns>A shared pointer to the buffer.</returns>
-		[[nodiscard]]
-		std::shared_ptr<ArrayBuffer const> getColorBuffer(void) const noexcept;
+		/// <param name="anchor">The anchor of the newly-created wing.</param>
+		void setAnchor(AccumulatedDeltas<GLfloat>::Anchor const& anchor) noexcept;
 
 		/// <summary>
-		/// Returns the edge color buffer.  This is only used to hand off ownership
-		/// to a new wing before this one is destroyed.
+		/// Returns the index of the wing's first vertex within the vertex
+		/// buffer.  The buffer is shared by all of the wings, each in its own
+		/// slot.  A reused wing keeps its slot.
 		/// </summary>
-		/// <remarks>
-		/// <para>
-		/// This should be removed once I become comfortable with how to use
-		/// unique pointers to transfer ownership out of an object.
-		/// </para>
-		/// </remarks>
-		/// <returns>A shared pointer to the buffer.</returns>
+		/// <returns>The base vertex for drawing the wing.</returns>
 		[[nodiscard]]
-		std::shared_ptr<ArrayBuffer const> getEdgeColorBuffer(void) const noexcept;
+		GLint getFirstVertex(void) const noexcept;
 
 	private:
-		GLfloat const deltaAngle{ 15 };
-		GLfloat const deltaZ{ 0.5 };
-		std::shared_ptr<ArrayBuffer const> vertexBuffer{ nullptr };
-		std::shared_ptr<ArrayBuffer const> colorBuffer{ nullptr };
-		std::shared_ptr<ArrayBuffer const> edgeColorBuffer{ nullptr };
+		AccumulatedDeltas<GLfloat>::Anchor anchor{};
+		GLint firstVertex{ 0 };
 	};
 
 }
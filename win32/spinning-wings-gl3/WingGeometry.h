@@ -1,10 +1,14 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <array>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "ArrayBuffer.h"
 #include "ElementArrayBuffer.h"
@@ -33,16 +37,6 @@ namespace silnith::wings::gl3
 #pragma endregion
 
     public:
-        /// <summary>
-        /// Allocates a buffer object to serve as the recipient of a transform
-        /// feedback program.  The buffer will be of sufficient size and
-        /// configured with the appropriate format to receive generic vertex
-        /// attributes with the specified number of components.
-        /// </summary>
-        /// <param name="numComponentsPerVertex">The number of components per vertex that will be received.</param>
-        /// <returns>A pre-allocated empty buffer for receiving transformed vertex attributes.</returns>
-        std::shared_ptr<ArrayBuffer const> CreateBuffer(GLint numComponentsPerVertex) const;
-
         /// <summary>
         /// Returns the number of vertices in the wing.
         /// This is the number of (x, y, z, w) coordinate tuples, and is
@@ -80,7 +74,23 @@ namespace silnith::wings::gl3
         void RenderAsPoints(void) const;
 
         /// <summary>
-        /// Draws the wing as solid polygons.
+        /// Draws multiple copies of the wing as clouds of unconnected points
+        /// in a single call.  The points of each copy follow those of the
+        /// previous copy.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This has the same expectations as <see cref="RenderAsPoints"/>.
+        /// The vertex shader must use <c>gl_InstanceID</c> or instanced
+        /// attributes to tell the copies apart.
+        /// </para>
+        /// </remarks>
+        /// <param name="instanceCount">The number of copies of the wing to draw.</param>
+        void RenderAsPointsInstanced(GLsizei instanceCount) const;
+
+        /// <summary>
+        /// Draws several copies of the wing as solid polygons in a single call,
+        /// each from its own base vertex.
         /// This is used for the final rendering to the screen.
         /// </summary>
         /// <remarks>
@@ -94,11 +104,13 @@ namespace silnith::wings::gl3
         /// <see cref="UseElementArrayBuffer"/>.
         /// </para>
         /// </remarks>
+        /// <param name="baseVertices">The index of the first vertex of each wing within the vertex buffers.</param>
         /// <seealso cref="UseElementArrayBuffer"/>
-        void RenderAsPolygons(void) const;
+        void RenderAsPolygons(std::span<GLint const> baseVertices) const;
 
         /// <summary>
-        /// Draws the wing as an outline.
+        /// Draws several copies of the wing as outlines in a single call,
+        /// each from its own base vertex.
         /// This is used for the final rendering to the screen.
         /// </summary>
         /// <remarks>
@@ -112,8 +124,33 @@ namespace silnith::wings::gl3
         /// <see cref="UseElementArrayBuffer"/>.
         /// </para>
         /// </remarks>
+        /// <param name="baseVertices">The index of the first vertex of each wing within the vertex buffers.</param>
         /// <seealso cref="UseElementArrayBuffer"/>
-        void RenderAsOutline(void) const;
+        void RenderAsOutline(std::span<GLint const> baseVertices) const;
+
+        /// <summary>
+        /// Draws multiple copies of the wing as solid polygons in a single call.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This has the same expectations as <see cref="RenderAsPolygons"/>.
+        /// The vertex shader must use <c>gl_InstanceID</c> to tell the copies apart.
+        /// </para>
+        /// </remarks>
+        /// <param name="instanceCount">The number of copies of the wing to draw.</param>
+        void RenderAsPolygonsInstanced(GLsizei instanceCount) const;
+
+        /// <summary>
+        /// Draws multiple copies of the wing as outlines in a single call.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This has the same expectations as <see cref="RenderAsOutline"/>.
+        /// The vertex shader must use <c>gl_InstanceID</c> to tell the copies apart.
+        /// </para>
+        /// </remarks>
+        /// <param name="instanceCount">The number of copies of the wing to draw.</param>
+        void RenderAsOutlineInstanced(GLsizei instanceCount) const;
 
     private:
         /// <summary>
@@ -125,6 +162,33 @@ namespace silnith::wings::gl3
         /// The indices into <see cref="vertexArrayBuffer"/> that are assembled into primitives.
         /// </summary>
         ElementArrayBuffer const elementArrayBuffer;
+
+        /// <summary>
+        /// The index count of each draw in <see cref="RenderAsPolygons"/> and
+        /// <see cref="RenderAsOutline"/>.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Every wing uses the same indices, so this and <see cref="indexOffsets"/>
+        /// only ever grow to the largest number of wings drawn.  They are kept
+        /// so that drawing does not allocate.
+        /// </para>
+        /// </remarks>
+        mutable std::vector<GLsizei> indexCounts{};
+
+        /// <summary>
+        /// The offset of the indices of each draw in <see cref="RenderAsPolygons"/>
+        /// and <see cref="RenderAsOutline"/>.
+        /// </summary>
+        mutable std::vector<void const*> indexOffsets{};
+
+    private:
+        /// <summary>
+        /// Draws one copy of the wing from each base vertex.
+        /// </summary>
+        /// <param name="mode">The primitive type.</param>
+        /// <param name="baseVertices">The index of the first vertex of each wing.</param>
+        void MultiDrawFromBaseVertices(GLenum mode, std::span<GLint const> baseVertices) const;
     };
 
 }
@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <glm/glm.hpp>
@@ -6,24 +8,27 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <array>
-#include <deque>
 #include <initializer_list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <cassert>
 
 #include "WingRenderProgram.h"
 
+#include "AccumulatedDeltas.h"
+#include "Instrumentation.h"
 #include "Program.h"
 #include "VertexShader.h"
 #include "FragmentShader.h"
 #include "Shader.h"
 
-#include "ArrayBuffer.h"
 #include "ModelViewProjectionUniformBuffer.h"
+#include "RingBuffer.h"
 
 #include "WingGeometry.h"
+#include "WingVertexBuffer.h"
 
 using namespace std::literals::string_literals;
 
@@ -39,12 +44,16 @@ namespace silnith::wings::gl3
 					Shader::versionDeclaration,
 					ModelViewProjectionUniformBuffer::uniformBlockDeclaration,
 					R"shaderText(
-uniform vec2 deltaZ = vec2(15, 0.5);
+uniform vec2 sectionOffsets[3];
+
+uniform bool outline = false;
+uniform vec3 edgeColor = vec3(1, 1, 1);
 
 in vec4 vertex;
 in vec4 color;
+in vec3 anchor;
 
-smooth out vec4 varyingColor;
+flat out vec4 varyingColor;
 
 const vec3 xAxis = vec3(1, 0, 0);
 const vec3 yAxis = vec3(0, 1, 0);
@@ -54,12 +63,21 @@ const vec3 zAxis = vec3(0, 0, 1);
 					Shader::translateMatrixFunctionDeclaration,
 					R"shaderText(
 void main() {
-    float deltaAngle = deltaZ[0];
-    float dZ = deltaZ[1];
+    /*
+     * The accumulated deltas of this wing and every newer wing.
+     * See AccumulatedDeltas for why this is a difference.
+     */
+    vec2 accumulatedDeltas = sectionOffsets[int(anchor[2])] - anchor.xy;
+    float deltaAngle = accumulatedDeltas[0];
+    float dZ = accumulatedDeltas[1];
 
     mat4 modelViewProjection = projection * view * model;
 
-    varyingColor = color;
+    if (outline) {
+        varyingColor = vec4(edgeColor, 1);
+    } else {
+        varyingColor = color;
+    }
     gl_Position = modelViewProjection
                   * translate(vec3(0, 0, dZ))
                   * rotate(deltaAngle, zAxis)
@@ -74,7 +92,7 @@ void main() {
 				std::make_shared<FragmentShader const>(std::initializer_list<std::string>{
 					Shader::versionDeclaration,
 					R"shaderText(
-smooth in vec4 varyingColor;
+flat in vec4 varyingColor;
 
 out vec4 fragmentColor;
 
@@ -87,14 +105,18 @@ void main() {
 			"fragmentColor"s
 		},
 		wingGeometry{ wingGeometry },
-		deltaZUniformLocation{ getUniformLocation("deltaZ"s) },
+		sectionOffsetsUniformLocation{ getUniformLocation("sectionOffsets"s) },
+		outlineUniformLocation{ getUniformLocation("outline"s) },
 		vertexAttributeLocation{ getAttributeLocation("vertex"s) },
-		colorAttributeLocation{ getAttributeLocation("color"s) }
+		colorAttributeLocation{ getAttributeLocation("color"s) },
+		anchorAttributeLocation{ getAttributeLocation("anchor"s) },
+		baseVertices{}
 	{
 		glGenVertexArrays(1, &vertexArray);
 		glBindVertexArray(vertexArray);
 		glEnableVertexAttribArray(vertexAttributeLocation);
 		glEnableVertexAttribArray(colorAttributeLocation);
+		glEnableVertexAttribArray(anchorAttributeLocation);
 		wingGeometry->UseElementArrayBuffer();
 		glBindVertexArray(0);
 
@@ -143,30 +165,58 @@ void main() {
 		glDeleteVertexArrays(1, &vertexArray);
 	}
 
-	void WingRenderProgram::RenderWings(std::deque<Wing> const& wings) const
+	void WingRenderProgram::RenderWings(RingBuffer<Wing> const& wings,
+		WingVertexBuffer const& vertexBuffer,
+		AccumulatedDeltas<GLfloat> const& accumulatedDeltas,
+		silnith::wings::gl::GLStateCache& stateCache) const
 	{
-		useProgram();
-
-		glBindVertexArray(vertexArray);
+		useProgram(stateCache);
 
 		/*
-		 * First, draw the solid wings using their solid color.
+		 * This moves every wing to its place for this frame.  Each wing then
+		 * only needs its own anchor, which never changes and so was captured
+		 * along with its vertices.
 		 */
-		GLfloat deltaZ{ 0 };
-		GLfloat deltaAngle{ 0 };
-		for (Wing const& wing : wings) {
-			deltaZ += wing.getDeltaZ();
-			deltaAngle += wing.getDeltaAngle();
-
-			glUniform2f(deltaZUniformLocation, deltaAngle, deltaZ);
+		std::array<GLfloat, 2 * AccumulatedDeltas<GLfloat>::numSections> const sectionOffsets{ accumulatedDeltas.getSectionOffsets() };
+		glUniform2fv(sectionOffsetsUniformLocation, AccumulatedDeltas<GLfloat>::numSections, sectionOffsets.data());
 
-			wing.getVertexBuffer()->UseForVertexAttribute(vertexAttributeLocation);
+		if (stateCache.ChangeVertexArray(vertexArray))
+		{
+			glBindVertexArray(vertexArray);
+		}
 
-			wing.getColorBuffer()->UseForVertexAttribute(colorAttributeLocation);
+		/*
+		 * Every wing is a slot of the same buffer, so the attribute pointers
+		 * are set once and each wing is drawn from its base vertex.  The
+		 * pointers are kept by the vertex array object, so they only need to
+		 * be set again if the buffer or its layout changes.  Nothing else
+		 * differs between the wings, so each pass is a single draw.
+		 */
+		if (stateCache.ChangeVertexAttribute(vertexArray, vertexAttributeLocation, vertexBuffer.GetPositionsPointer()))
+		{
+			vertexBuffer.UsePositionsForVertexAttribute(vertexAttributeLocation);
+		}
+		if (stateCache.ChangeVertexAttribute(vertexArray, colorAttributeLocation, vertexBuffer.GetColorsPointer()))
+		{
+			vertexBuffer.UseColorsForVertexAttribute(colorAttributeLocation);
+		}
+		if (stateCache.ChangeVertexAttribute(vertexArray, anchorAttributeLocation, vertexBuffer.GetAnchorsPointer()))
+		{
+			vertexBuffer.UseAnchorsForVertexAttribute(anchorAttributeLocation);
+		}
 
-			wingGeometry->RenderAsPolygons();
+		baseVertices.clear();
+		for (Wing const& wing : wings) {
+			baseVertices.push_back(wing.getFirstVertex());
 		}
 
+		/*
+		 * First, draw the solid wings using their solid color.
+		 */
+		instrumentation::PhaseTimer fillTimer{ instrumentation::Phase::FillPass };
+		wingGeometry->RenderAsPolygons(baseVertices);
+		fillTimer.Stop();
+
 		/*
 		 * Second, draw the wing outlines using the outline color.
 		 * The outlines have smoothing (antialiasing) enabled, which
@@ -179,30 +229,17 @@ void main() {
 		 * And corners where lines adjoin will allow overlapping partial fragments to
 		 * blend together rather than displace each other.
 		 */
-		deltaZ = 0;
-		deltaAngle = 0;
-		glDepthFunc(GL_LEQUAL);
-		glDepthMask(GL_FALSE);
-		glEnable(GL_BLEND);
-		for (Wing const& wing : wings) {
-			deltaZ += wing.getDeltaZ();
-			deltaAngle += wing.getDeltaAngle();
-
-			glUniform2f(deltaZUniformLocation, deltaAngle, deltaZ);
-
-			wing.getVertexBuffer()->UseForVertexAttribute(vertexAttributeLocation);
-
-			wing.getEdgeColorBuffer()->UseForVertexAttribute(colorAttributeLocation);
-
-			wingGeometry->RenderAsOutline();
-		}
-		glDisable(GL_BLEND);
-		glDepthMask(GL_TRUE);
-		glDepthFunc(GL_LESS);
-
-		glBindVertexArray(0);
-
-		glUseProgram(0);
+		instrumentation::PhaseTimer outlineTimer{ instrumentation::Phase::OutlinePass };
+		stateCache.DepthFunc(GL_LEQUAL);
+		stateCache.DepthMask(GL_FALSE);
+		stateCache.Enable(GL_BLEND);
+		glUniform1i(outlineUniformLocation, GL_TRUE);
+		wingGeometry->RenderAsOutline(baseVertices);
+		glUniform1i(outlineUniformLocation, GL_FALSE);
+		stateCache.Disable(GL_BLEND);
+		stateCache.DepthMask(GL_TRUE);
+		stateCache.DepthFunc(GL_LESS);
+		outlineTimer.Stop();
 	}
 
 	void WingRenderProgram::Resize(GLfloat const width, GLfloat const height) const
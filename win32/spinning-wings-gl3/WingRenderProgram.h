@@ -1,16 +1,22 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <deque>
 #include <memory>
+#include <vector>
 
+#include "AccumulatedDeltas.h"
+#include "GLStateCache.h"
 #include "Program.h"
+#include "RingBuffer.h"
 
 #include "ModelViewProjectionUniformBuffer.h"
 
 #include "WingGL3.h"
+#include "WingVertexBuffer.h"
 
 #include "WingGeometry.h"
 
@@ -74,7 +80,13 @@ namespace silnith::wings::gl3
         /// Renders the provided collection of wings.
         /// </summary>
         /// <param name="wings">The wings to render.</param>
-        void RenderWings(std::deque<Wing> const& wings) const;
+        /// <param name="vertexBuffer">The buffer holding the transformed vertices of every wing.</param>
+        /// <param name="accumulatedDeltas">The delta angle and delta Z accumulated by the wings.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void RenderWings(RingBuffer<Wing> const& wings,
+            WingVertexBuffer const& vertexBuffer,
+            AccumulatedDeltas<GLfloat> const& accumulatedDeltas,
+            silnith::wings::gl::GLStateCache& stateCache) const;
 
         /// <summary>
         /// Sets up the orthographic projection that transforms modelview coordinates
@@ -100,7 +112,7 @@ namespace silnith::wings::gl3
         /// before all of the required parameters are known.
         /// </para>
         /// </remarks>
-        std::shared_ptr<ModelViewProjectionUniformBuffer const> modelViewProjectionUniformBuffer{ nullptr };
+        std::shared_ptr<ModelViewProjectionUniformBuffer> modelViewProjectionUniformBuffer{ nullptr };
 
         /// <summary>
         /// The vertex array object that stores all the rendering state for
@@ -109,14 +121,20 @@ namespace silnith::wings::gl3
 		/// things that need to be set are the specific buffers bound for each
         /// vertex attribute location, since those are different for every wing.
         /// </summary>
-        /// <seealso cref="ArrayBuffer::UseForVertexAttribute"/>
+        /// <seealso cref="WingVertexBuffer::UsePositionsForVertexAttribute"/>
         GLuint vertexArray{ 0 };
 
         /// <summary>
-        /// The location of the uniform variable <c>deltaZ</c>.
+        /// The location of the uniform variable <c>sectionOffsets</c>.
         /// </summary>
-        /// <seealso cref="glUniform2f"/>
-        GLint deltaZUniformLocation{ 0 };
+        /// <seealso cref="glUniform2fv"/>
+        /// <seealso cref="AccumulatedDeltas::getSectionOffsets"/>
+        GLint sectionOffsetsUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the uniform variable <c>outline</c>.
+        /// </summary>
+        GLint outlineUniformLocation{ 0 };
 
         /// <summary>
         /// The location of the vertex attribute <c>vertex</c>.
@@ -127,6 +145,19 @@ namespace silnith::wings::gl3
         /// The location of the vertex attribute <c>color</c>.
         /// </summary>
         GLuint colorAttributeLocation{ 0 };
+
+        /// <summary>
+        /// The location of the vertex attribute <c>anchor</c>.
+        /// </summary>
+        /// <seealso cref="Wing::getAnchor"/>
+        GLuint anchorAttributeLocation{ 0 };
+
+        /// <summary>
+        /// The base vertex of every wing, in drawing order.  This is rebuilt
+        /// for each frame, but keeps its storage so that drawing does not
+        /// allocate.
+        /// </summary>
+        mutable std::vector<GLint> baseVertices{};
     };
 
 }
@@ -0,0 +1,236 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <array>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "WingStreamBuffer.h"
+
+#include "AccumulatedDeltas.h"
+#include "Buffer.h"
+
+namespace silnith::wings::gl3
+{
+
+	/// <summary>
+	/// The number of nanoseconds to wait on a fence before checking again.
+	/// </summary>
+	static GLuint64 constexpr fenceTimeout{ 1'000'000 };
+
+	WingStreamBuffer::WingStreamBuffer(GLsizei numWings)
+		: Buffer{},
+		sectionSize{ numWings },
+		capacity{ numSections * numWings },
+		persistent{ GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage },
+		mappedRecords{ nullptr },
+		texture{ 0 },
+		numWings{ 0 },
+		firstSlot{ 0 },
+		fences{},
+		accumulatedDeltas{ static_cast<std::size_t>(numWings) }
+	{
+		assert(numWings > 0);
+
+		GLsizeiptr const dataSize{ static_cast<GLsizeiptr>(sizeof(GLfloat)) * numComponentsPerWing * capacity };
+
+		glBindBuffer(GL_TEXTURE_BUFFER, GetName());
+		if (persistent)
+		{
+			/*
+			 * A coherent mapping means writes become visible to the GPU
+			 * without any explicit flush or barrier.  The fences take care
+			 * of the other direction.
+			 */
+			GLbitfield constexpr flags{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+			glBufferStorage(GL_TEXTURE_BUFFER, dataSize, nullptr, flags);
+			mappedRecords = static_cast<GLfloat*>(glMapBufferRange(GL_TEXTURE_BUFFER, 0, dataSize, flags));
+			assert(mappedRecords != nullptr);
+		}
+		else
+		{
+			glBufferData(GL_TEXTURE_BUFFER, dataSize, nullptr, GL_STREAM_DRAW);
+		}
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_BUFFER, texture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, GetName());
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+	}
+
+	WingStreamBuffer::~WingStreamBuffer(void) noexcept
+	{
+		for (GLsync const fence : fences)
+		{
+			/*
+			 * The delete function silently ignores zero.
+			 */
+			glDeleteSync(fence);
+		}
+
+		glDeleteTextures(1, &texture);
+
+		if (persistent)
+		{
+			glBindBuffer(GL_TEXTURE_BUFFER, GetName());
+			glUnmapBuffer(GL_TEXTURE_BUFFER);
+			glBindBuffer(GL_TEXTURE_BUFFER, 0);
+		}
+	}
+
+	void WingStreamBuffer::AddWing(GLfloat radius, GLfloat angle,
+		GLfloat deltaAngle, GLfloat deltaZ,
+		GLfloat roll, GLfloat pitch, GLfloat yaw,
+		GLfloat red, GLfloat green, GLfloat blue)
+	{
+		/*
+		 * The ring is filled backwards, so that the older wings follow the
+		 * newest one in ascending slot order.
+		 */
+		firstSlot = (firstSlot == 0 ? capacity : firstSlot) - 1;
+		if (numWings < sectionSize)
+		{
+			numWings++;
+		}
+
+		GLsizei const section{ firstSlot / sectionSize };
+		if (firstSlot % sectionSize == sectionSize - 1)
+		{
+			/*
+			 * This is the first write into the section since the last time
+			 * around the ring.
+			 */
+			WaitForSection(section);
+		}
+
+		/*
+		 * The accumulated deltas start a new section at the same wing as the
+		 * ring does, but the ring is filled backwards, so it visits the
+		 * sections in the opposite order.
+		 */
+		AccumulatedDeltas<GLfloat>::Anchor const anchor{ accumulatedDeltas.AddWing(deltaAngle, deltaZ) };
+		assert(anchor.section == static_cast<std::size_t>(numSections - 1 - section));
+
+		WriteRecord(firstSlot, {
+			radius, angle,
+			roll, pitch, yaw,
+			red, green, blue,
+			anchor.angle, anchor.z,
+			});
+	}
+
+	void WingStreamBuffer::FenceReads(void)
+	{
+		if (numWings == 0)
+		{
+			return;
+		}
+
+		GLsizei const firstSection{ firstSlot / sectionSize };
+		GLsizei const lastSection{ ((firstSlot + numWings - 1) % capacity) / sectionSize };
+		for (GLsizei const section : { firstSection, lastSection })
+		{
+			glDeleteSync(fences[section]);
+			fences[section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			if (firstSection == lastSection)
+			{
+				break;
+			}
+		}
+	}
+
+	void WingStreamBuffer::UseAsTexture(void) const
+	{
+		glBindTexture(GL_TEXTURE_BUFFER, texture);
+	}
+
+	bool WingStreamBuffer::isPersistent(void) const noexcept
+	{
+		return persistent;
+	}
+
+	GLsizei WingStreamBuffer::getNumWings(void) const noexcept
+	{
+		return numWings;
+	}
+
+	GLsizei WingStreamBuffer::getFirstSlot(void) const noexcept
+	{
+		return firstSlot;
+	}
+
+	GLsizei WingStreamBuffer::getCapacity(void) const noexcept
+	{
+		return capacity;
+	}
+
+	GLsizei WingStreamBuffer::getSectionSize(void) const noexcept
+	{
+		return sectionSize;
+	}
+
+	std::array<GLfloat, 2 * WingStreamBuffer::numSections> WingStreamBuffer::getSectionOffsets(void) const noexcept
+	{
+		std::array<GLfloat, 2 * numSections> const deltasOffsets{ accumulatedDeltas.getSectionOffsets() };
+		std::array<GLfloat, 2 * numSections> offsets{};
+		for (GLsizei section{ 0 }; section < numSections; section++)
+		{
+			GLsizei const deltasSection{ numSections - 1 - section };
+			offsets[2 * section + 0] = deltasOffsets[2 * deltasSection + 0];
+			offsets[2 * section + 1] = deltasOffsets[2 * deltasSection + 1];
+		}
+		return offsets;
+	}
+
+	void WingStreamBuffer::WaitForSection(GLsizei section)
+	{
+		GLsync const fence{ fences[section] };
+		if (fence == nullptr)
+		{
+			return;
+		}
+
+		GLenum result{ glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout) };
+		while (result == GL_TIMEOUT_EXPIRED)
+		{
+			result = glClientWaitSync(fence, 0, fenceTimeout);
+		}
+		assert(result != GL_WAIT_FAILED);
+
+		glDeleteSync(fence);
+		fences[section] = nullptr;
+	}
+
+	void WingStreamBuffer::WriteRecord(GLsizei slot, std::array<GLfloat, numComponentsPerWing> const& record)
+	{
+		if (persistent)
+		{
+			std::copy(record.begin(), record.end(), mappedRecords + static_cast<std::ptrdiff_t>(slot) * numComponentsPerWing);
+		}
+		else
+		{
+			/*
+			 * Without the unsynchronized bit, the driver would wait for every
+			 * frame in flight.  The fences already guarantee that no frame in
+			 * flight reads this record.
+			 */
+			GLintptr const offset{ static_cast<GLintptr>(sizeof(GLfloat)) * numComponentsPerWing * slot };
+			GLsizeiptr constexpr size{ static_cast<GLsizeiptr>(sizeof(GLfloat)) * numComponentsPerWing };
+			GLbitfield constexpr flags{ GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT };
+
+			glBindBuffer(GL_TEXTURE_BUFFER, GetName());
+			GLfloat* const mappedRecord{ static_cast<GLfloat*>(glMapBufferRange(GL_TEXTURE_BUFFER, offset, size, flags)) };
+			assert(mappedRecord != nullptr);
+			std::copy(record.begin(), record.end(), mappedRecord);
+			glUnmapBuffer(GL_TEXTURE_BUFFER);
+			glBindBuffer(GL_TEXTURE_BUFFER, 0);
+		}
+	}
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <memory>
+
+#include "GLStateCache.h"
+#include "Program.h"
+
+#include "ModelViewProjectionUniformBuffer.h"
+
+#include "WingGeometry.h"
+#include "WingStreamBuffer.h"
+
+namespace silnith::wings::gl3
+{
+
+    /// <summary>
+    /// The GLSL program that renders all the wings directly from a
+    /// <see cref="WingStreamBuffer"/>.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Unlike <see cref="WingRenderProgram"/>, this does not depend on wings
+    /// that were previously transformed using <see cref="WingTransformProgram"/>.
+    /// The vertex shader fetches the parameters for each wing from the buffer
+    /// texture and applies the full transformation itself, so each rendering
+    /// pass is a single instanced draw call.
+    /// </para>
+    /// </remarks>
+    class WingStreamRenderProgram : public Program
+    {
+#pragma region Static Members
+
+    private:
+        /// <summary>
+        /// The uniform buffer binding index for the ModelViewProjection matrices.
+        /// </summary>
+        /// <seealso cref="WingRenderProgram::modelViewProjectionBindingIndex"/>
+        static GLuint constexpr modelViewProjectionBindingIndex{ 0 };
+
+        /// <summary>
+        /// The texture unit that the wing parameters are bound to.
+        /// </summary>
+        static GLint constexpr wingParametersTextureUnit{ 0 };
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  The render program requires the
+        /// wing geometry and utility shaders that are shared between multiple
+        /// programs.
+        /// </summary>
+        WingStreamRenderProgram(void) = delete;
+
+        explicit WingStreamRenderProgram(std::shared_ptr<WingGeometry const> const& wingGeometry,
+            std::shared_ptr<VertexShader const> const& rotateMatrixShader,
+            std::shared_ptr<VertexShader const> const& translateMatrixShader);
+
+#pragma region Rule of Five
+
+    public:
+        WingStreamRenderProgram(WingStreamRenderProgram const&) = delete;
+        WingStreamRenderProgram& operator=(WingStreamRenderProgram const&) = delete;
+        WingStreamRenderProgram(WingStreamRenderProgram&&) noexcept = delete;
+        WingStreamRenderProgram& operator=(WingStreamRenderProgram&&) noexcept = delete;
+        virtual ~WingStreamRenderProgram(void) noexcept override;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Renders all of the wings in the provided stream, then fences the
+        /// sections of the stream that were read.
+        /// </summary>
+        /// <param name="wingStreamBuffer">The wings to render.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void RenderWings(WingStreamBuffer& wingStreamBuffer,
+            silnith::wings::gl::GLStateCache& stateCache) const;
+
+        /// <summary>
+        /// Sets up the orthographic projection that transforms modelview coordinates
+        /// into normalized device coordinates.
+        /// This takes into account the aspect ratio of the viewport.
+        /// </summary>
+        /// <param name="width">The viewport width.</param>
+        /// <param name="height">The viewport height.</param>
+        void Resize(GLfloat const width, GLfloat const height) const;
+
+    private:
+        /// <summary>
+        /// A pointer to the wing geometry object.
+        /// </summary>
+        std::shared_ptr<WingGeometry const> wingGeometry{ nullptr };
+
+        /// <summary>
+        /// The uniform buffer for the ModelViewProjection matrices.
+        /// </summary>
+        std::shared_ptr<ModelViewProjectionUniformBuffer> modelViewProjectionUniformBuffer{ nullptr };
+
+        /// <summary>
+        /// The vertex array object.  This only holds the untransformed wing
+        /// vertices and the element array buffer, since everything else is
+        /// fetched from the wing parameters.
+        /// </summary>
+        GLuint vertexArray{ 0 };
+
+        /// <summary>
+        /// The location of the uniform variable <c>firstSlot</c>.
+        /// </summary>
+        GLint firstSlotUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the uniform variable <c>capacity</c>.
+        /// </summary>
+        GLint capacityUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the uniform variable <c>sectionSize</c>.
+        /// </summary>
+        GLint sectionSizeUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the uniform array <c>sectionOffsets</c>.
+        /// </summary>
+        /// <seealso cref="glUniform2fv"/>
+        GLint sectionOffsetsUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the uniform variable <c>outline</c>.
+        /// </summary>
+        GLint outlineUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the vertex attribute <c>vertex</c>.
+        /// </summary>
+        GLuint vertexAttributeLocation{ 0 };
+    };
+
+}
@@ -1,19 +1,27 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <array>
 #include <initializer_list>
 #include <map>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include <cassert>
+#include <cstddef>
 
 #include "WingTransformProgram.h"
 
+#include "AccumulatedDeltas.h"
 #include "VertexShader.h"
+#include "WingParameters.h"
 
-#include "ArrayBuffer.h"
+#include "Buffer.h"
+#include "WingVertexBuffer.h"
 
 using namespace std::literals::string_literals;
 
@@ -21,35 +29,21 @@ namespace silnith::wings::gl3
 {
 
     /// <summary>
-    /// The number of vertex coordinates captured from the transform
-    /// feedback program.
+    /// The number of floats in the parameter record for each wing.
     /// </summary>
     /// <remarks>
     /// <para>
-    /// The vertex shader sets the built-in variable <c>gl_Position</c>,
-    /// which is of type <c>vec4</c>.
+    /// The record is radius, angle, roll, pitch, yaw, red, green, blue, then
+    /// the anchor angle, Z, and section.  This must match the
+    /// <c>wingParameter</c> function in the vertex shader.
     /// </para>
     /// </remarks>
-    static GLint constexpr numCapturedCoordinatesPerVertex{ 4 };
+    static std::size_t constexpr numParametersPerWing{ 11 };
 
-    /// <summary>
-    /// The number of color components captured from the transform
-    /// feedback program.
-    /// </summary>
-    /// <remarks>
-    /// <para>
-    /// The vertex shader sets the varying variables <c>varyingWingColor</c>
-    /// and <c>varyingEdgeColor</c>, which are both of type <c>vec3</c>.
-    /// </para>
-    /// </remarks>
-    static GLint constexpr numCapturedColorComponentsPerVertex{ 3 };
-
-    GLuint constexpr glPositionBindingPoint{ 0 };
-    GLuint constexpr varyingWingColorBindingPoint{ 1 };
-    GLuint constexpr varyingEdgeColorBindingPoint{ 2 };
-    constexpr char const* capturedVaryingZero{ "gl_Position" };
-    constexpr char const* capturedVaryingOne{ "varyingWingColor" };
-    constexpr char const* capturedVaryingTwo{ "varyingEdgeColor" };
+    GLuint constexpr packedVertexBindingPoint{ 0 };
+    constexpr char const* capturedVaryingZero{ "packedVertex" };
+    GLuint constexpr anchorBindingPoint{ 1 };
+    constexpr char const* capturedVaryingOne{ "wingAnchor" };
     // TODO: Find a way to static_assert these match the initializer list passed to the superclass constructor.
 
     WingTransformProgram::WingTransformProgram(std::shared_ptr<WingGeometry const> const& wingGeometry,
@@ -60,10 +54,11 @@ namespace silnith::wings::gl3
                 std::make_shared<VertexShader const>(std::initializer_list<std::string>{
                     Shader::versionDeclaration,
                     R"shaderText(
-uniform vec2 radiusAngle;
-uniform vec3 rollPitchYaw;
-uniform vec3 color;
-uniform vec3 edgeColor = vec3(1, 1, 1);
+/*
+ * The parameters of every wing in the batch, eleven floats per wing.
+ * Each instance of the draw call is one wing.
+ */
+uniform samplerBuffer wingParameters;
 
 /*
  * Vertex attributes are always extended to type vec4 by the GL when read.
@@ -73,8 +68,8 @@ uniform vec3 edgeColor = vec3(1, 1, 1);
  */
 in vec4 vertex;
 
-smooth out vec3 varyingWingColor;
-smooth out vec3 varyingEdgeColor;
+flat out uvec3 packedVertex;
+flat out vec3 wingAnchor;
 
 const vec3 xAxis = vec3(1, 0, 0);
 const vec3 yAxis = vec3(0, 1, 0);
@@ -82,23 +77,29 @@ const vec3 zAxis = vec3(0, 0, 1);
 )shaderText",
                     Shader::rotateMatrixFunctionDeclaration,
                     Shader::translateMatrixFunctionDeclaration,
+                    WingVertexBuffer::packFunctionDeclaration,
                     R"shaderText(
+float wingParameter(int index) {
+    return texelFetch(wingParameters, gl_InstanceID * 11 + index).r;
+}
+
 void main() {
-    float radius = radiusAngle[0];
-    float angle = radiusAngle[1];
-    float roll = rollPitchYaw[0];
-    float pitch = rollPitchYaw[1];
-    float yaw = rollPitchYaw[2];
+    float radius = wingParameter(0);
+    float angle = wingParameter(1);
+    float roll = wingParameter(2);
+    float pitch = wingParameter(3);
+    float yaw = wingParameter(4);
 
-    varyingWingColor = color;
-    varyingEdgeColor = edgeColor;
+    vec3 color = vec3(wingParameter(5), wingParameter(6), wingParameter(7));
 
     mat4 wingTransformation = rotate(angle, zAxis)
                               * translate(vec3(radius, 0, 0))
                               * rotate(-yaw, zAxis)
                               * rotate(-pitch, yAxis)
                               * rotate(roll, xAxis);
-    gl_Position = wingTransformation * vertex;
+    vec4 position = wingTransformation * vertex;
+    packedVertex = packWingVertex(position.xyz, color);
+    wingAnchor = vec3(wingParameter(8), wingParameter(9), wingParameter(10));
 }
 )shaderText",
                 }),
@@ -108,15 +109,25 @@ void main() {
             std::initializer_list<std::string>{
                 capturedVaryingZero,
                 capturedVaryingOne,
-                capturedVaryingTwo,
             }
         },
         wingGeometry{ wingGeometry },
-        radiusAngleUniformLocation{ getUniformLocation("radiusAngle"s) },
-        rollPitchYawUniformLocation{ getUniformLocation("rollPitchYaw"s) },
-        colorUniformLocation{ getUniformLocation("color"s) },
-        edgeColorUniformLocation{ getUniformLocation("edgeColor"s) }
+        parameterBuffer{},
+        parameterTexture{ 0 }
     {
+        /*
+         * A buffer name does not become a buffer object until it is first
+         * bound, and only a buffer object can be attached to a texture.
+         * The texture refers to the buffer object rather than its storage,
+         * so it stays valid when the buffer is reallocated for each batch.
+         */
+        glBindBuffer(GL_TEXTURE_BUFFER, parameterBuffer.GetName());
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        glGenTextures(1, &parameterTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, parameterTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, parameterBuffer.GetName());
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+
         GLuint const vertexAttributeLocation{ getAttributeLocation("vertex"s) };
         glGenVertexArrays(1, &vertexArray);
         glBindVertexArray(vertexArray);
@@ -127,56 +138,78 @@ void main() {
 
     WingTransformProgram::~WingTransformProgram(void) noexcept
     {
+        glDeleteTextures(1, &parameterTexture);
         glDeleteVertexArrays(1, &vertexArray);
     }
 
-    std::shared_ptr<ArrayBuffer const> WingTransformProgram::CreateVertexBuffer() const
+    std::shared_ptr<WingVertexBuffer const> WingTransformProgram::CreateVertexBuffer(GLsizei numWings) const
     {
-        return wingGeometry->CreateBuffer(numCapturedCoordinatesPerVertex);
+        return std::make_shared<WingVertexBuffer const>(wingGeometry->getNumVertices() * numWings);
     }
 
-    std::shared_ptr<ArrayBuffer const> WingTransformProgram::CreateColorBuffer() const
+    void WingTransformProgram::TransformWings(std::span<WingParameters<GLfloat> const> wings,
+        std::span<AccumulatedDeltas<GLfloat>::Anchor const> anchors,
+        GLsizei firstWing,
+        WingVertexBuffer const& vertexBuffer,
+        silnith::wings::gl::GLStateCache& stateCache) const
     {
-        return wingGeometry->CreateBuffer(numCapturedColorComponentsPerVertex);
-    }
-
-    void WingTransformProgram::TransformWing(GLfloat radius, GLfloat angle,
-        GLfloat roll, GLfloat pitch, GLfloat yaw,
-        GLfloat red, GLfloat green, GLfloat blue,
-        ArrayBuffer const& vertexBuffer,
-        ArrayBuffer const& colorBuffer,
-        ArrayBuffer const& edgeColorBuffer) const
-    {
-        useProgram();
-
-        glUniform2f(radiusAngleUniformLocation, radius, angle);
-        glUniform3f(rollPitchYawUniformLocation, roll, pitch, yaw);
-        glUniform3f(colorUniformLocation, red, green, blue);
-        glUniform3f(edgeColorUniformLocation, 1, 1, 1);
-
-        glBindVertexArray(vertexArray);
-
-        // Assert that the buffers are expecting the correct data layout.
-        assert(vertexBuffer.getNumComponentsPerVertex() == 4);
-        assert(colorBuffer.getNumComponentsPerVertex() == 3);
-        assert(edgeColorBuffer.getNumComponentsPerVertex() == 3);
-        // Assert that the buffers are sized appropriately.
-        assert(vertexBuffer.getNumVertices() == wingGeometry->getNumVertices());
-        assert(colorBuffer.getNumVertices() == wingGeometry->getNumVertices());
-        assert(edgeColorBuffer.getNumVertices() == wingGeometry->getNumVertices());
-        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, glPositionBindingPoint, vertexBuffer.GetName());
-        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, varyingWingColorBindingPoint, colorBuffer.GetName());
-        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, varyingEdgeColorBindingPoint, edgeColorBuffer.GetName());
+        if (wings.empty())
+        {
+            return;
+        }
+
+        assert(anchors.size() == wings.size());
+
+        GLsizei const numWings{ static_cast<GLsizei>(wings.size()) };
+        GLsizei const numVertices{ wingGeometry->getNumVertices() };
+
+        // Assert that the batch fits in the buffer without wrapping.
+        assert(firstWing >= 0);
+        assert((firstWing + numWings) * numVertices <= vertexBuffer.getNumVertices());
+
+        std::vector<GLfloat> parameters{};
+        parameters.reserve(numParametersPerWing * wings.size());
+        for (std::size_t index{ 0 }; index < wings.size(); index++)
+        {
+            WingParameters<GLfloat> const& wing{ wings[index] };
+            AccumulatedDeltas<GLfloat>::Anchor const& anchor{ anchors[index] };
+            parameters.insert(parameters.end(), {
+                wing.radius, wing.angle,
+                wing.roll, wing.pitch, wing.yaw,
+                wing.red, wing.green, wing.blue,
+                anchor.angle, anchor.z, static_cast<GLfloat>(anchor.section),
+                });
+        }
+
+        /*
+         * Reallocating the whole buffer lets the driver hand out fresh storage
+         * instead of waiting for the previous batch to finish reading it.
+         */
+        glBindBuffer(GL_TEXTURE_BUFFER, parameterBuffer.GetName());
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(sizeof(GLfloat) * parameters.size()), parameters.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+        useProgram(stateCache);
+
+        if (stateCache.ChangeVertexArray(vertexArray))
+        {
+            glBindVertexArray(vertexArray);
+        }
+        glBindTexture(GL_TEXTURE_BUFFER, parameterTexture);
+
+        /*
+         * The binding covers exactly the slots of this batch, so the first
+         * captured vertex lands in the slot of the first wing.
+         */
+        vertexBuffer.UseForCapture(packedVertexBindingPoint, anchorBindingPoint, firstWing * numVertices, numWings * numVertices);
 
         glEnable(GL_RASTERIZER_DISCARD);
         glBeginTransformFeedback(GL_POINTS);
-        wingGeometry->RenderAsPoints();
+        wingGeometry->RenderAsPointsInstanced(numWings);
         glEndTransformFeedback();
         glDisable(GL_RASTERIZER_DISCARD);
 
-        glBindVertexArray(0);
-
-        glUseProgram(0);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
     }
 
 }
@@ -1,15 +1,22 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <memory>
+#include <span>
 
+#include "AccumulatedDeltas.h"
+#include "GLStateCache.h"
 #include "Program.h"
+#include "WingParameters.h"
 
 #include "WingGeometry.h"
 
-#include "ArrayBuffer.h"
+#include "Buffer.h"
+#include "WingVertexBuffer.h"
 
 namespace silnith::wings::gl3
 {
@@ -18,6 +25,20 @@ namespace silnith::wings::gl3
     /// The GLSL program that transforms each wing and captures the results
     /// using transform feedback.
     /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Any number of wings are transformed with a single instanced draw, one
+    /// instance per wing.  OpenGL 3.2 has no instanced vertex attributes, so
+    /// the parameters of every wing are uploaded into a buffer texture that
+    /// the vertex shader indexes with <c>gl_InstanceID</c>, the same way as
+    /// <see cref="WingStreamRenderProgram"/>.
+    /// </para>
+    /// <para>
+    /// The transformed vertices are captured in the packed layout of
+    /// <see cref="WingVertexBuffer"/>.  Only the wing color is captured, since
+    /// the edge color is a uniform of the render program.
+    /// </para>
+    /// </remarks>
     class WingTransformProgram : public Program
     {
     public:
@@ -47,42 +68,38 @@ namespace silnith::wings::gl3
         /// <summary>
         /// Allocates a buffer object to serve as the recipient of the
         /// transform feedback program.  The buffer will be of sufficient size
-        /// and configured with the appropriate format to receive vertex coordinates.
+        /// to receive the packed vertices for the specified number of wings.
         /// </summary>
-        /// <returns>A pre-allocated empty buffer for receiving transformed vertex coordinates.</returns>
-        std::shared_ptr<ArrayBuffer const> CreateVertexBuffer() const;
+        /// <param name="numWings">The number of wings the buffer can hold.</param>
+        /// <returns>A pre-allocated empty buffer for receiving transformed vertices.</returns>
+        std::shared_ptr<WingVertexBuffer const> CreateVertexBuffer(GLsizei numWings) const;
 
         /// <summary>
-        /// Allocates a buffer object to serve as the recipient of the
-        /// transform feedback program.  The buffer will be of sufficient size
-        /// and configured with the appropriate format to receive color values.
-        /// </summary>
-        /// <returns>A pre-allocated empty buffer for receiving transformed color values.</returns>
-        std::shared_ptr<ArrayBuffer const> CreateColorBuffer() const;
-
-        /// <summary>
-        /// Generates the transformed vertex data for a new wing.
-        /// This applies the rotations and translations to put the wing in the
+        /// Generates the transformed vertex data for several new wings.
+        /// This applies the rotations and translations to put each wing in the
         /// correct place, and places the vertex coordinates and colors for the
-        /// wing into the buffers provided.
+        /// wings into consecutive slots of the buffer provided.
         /// </summary>
-        /// <param name="radius">The radius of the wing around the central axis.</param>
-        /// <param name="angle">The angle of the wing around the central axis.</param>
-        /// <param name="roll">The roll of the wing.</param>
-        /// <param name="pitch">The pitch of the wing.</param>
-        /// <param name="yaw">The yaw of the wing.</param>
-        /// <param name="red">The red component of the wing color.</param>
-        /// <param name="green">The green component of the wing color.</param>
-        /// <param name="blue">The blue component of the wing color.</param>
-        /// <param name="vertexBuffer">The buffer that will be populated with the wing geometry.</param>
-        /// <param name="colorBuffer">The buffer that will be populated with the wing surface color.</param>
-        /// <param name="edgeColorBuffer">The buffer that will be populated with the wing edge color.</param>
-        void TransformWing(GLfloat radius, GLfloat angle,
-            GLfloat roll, GLfloat pitch, GLfloat yaw,
-            GLfloat red, GLfloat green, GLfloat blue,
-            ArrayBuffer const& vertexBuffer,
-            ArrayBuffer const& colorBuffer,
-            ArrayBuffer const& edgeColorBuffer) const;
+        /// <remarks>
+        /// <para>
+        /// The wings are captured in a single transform feedback pass, so
+        /// they must fit in the buffer without wrapping.  A caller that uses
+        /// the buffer as a ring must split a batch where it wraps.
+        /// </para>
+        /// <para>
+        /// The delta angle and delta Z of each wing are not used here.
+        /// </para>
+        /// </remarks>
+        /// <param name="wings">The parameters of each wing.</param>
+        /// <param name="anchors">The anchor of each wing, which is captured along with its vertices.</param>
+        /// <param name="firstWing">The slot in the buffer for the first wing.</param>
+        /// <param name="vertexBuffer">The buffer that will be populated with the wing geometry and surface color.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void TransformWings(std::span<WingParameters<GLfloat> const> wings,
+            std::span<AccumulatedDeltas<GLfloat>::Anchor const> anchors,
+            GLsizei firstWing,
+            WingVertexBuffer const& vertexBuffer,
+            silnith::wings::gl::GLStateCache& stateCache) const;
 
     private:
         /// <summary>
@@ -97,28 +114,16 @@ namespace silnith::wings::gl3
         GLuint vertexArray{ 0 };
 
         /// <summary>
-        /// The location of the uniform variable <c>radiusAngle</c>.
-        /// </summary>
-        /// <seealso cref="glUniform2f"/>
-        GLint radiusAngleUniformLocation{ 0 };
-
-        /// <summary>
-        /// The location of the uniform variable <c>rollPitchYaw</c>.
-        /// </summary>
-        /// <seealso cref="glUniform3f"/>
-        GLint rollPitchYawUniformLocation{ 0 };
-
-        /// <summary>
-        /// The location of the uniform variable <c>color</c>.
+        /// The buffer holding the parameters of the wings being transformed.
+        /// It is reallocated for every batch.
         /// </summary>
-        /// <seealso cref="glUniform3f"/>
-        GLint colorUniformLocation{ 0 };
+        Buffer const parameterBuffer{};
 
         /// <summary>
-        /// The location of the uniform variable <c>edgeColor</c>.
+        /// The buffer texture that exposes <see cref="parameterBuffer"/> to
+        /// the vertex shader.
         /// </summary>
-        /// <seealso cref="glUniform3f"/>
-        GLint edgeColorUniformLocation{ 0 };
+        GLuint parameterTexture{ 0 };
     };
 
 }
@@ -0,0 +1,156 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <string>
+
+#include <cassert>
+
+#include "WingVertexBuffer.h"
+
+namespace silnith::wings::gl3
+{
+
+    std::string const WingVertexBuffer::packFunctionDeclaration{
+        R"shaderText(
+/*
+ * Rounds to the nearest half float.  GLSL 1.50 cannot reinterpret the bits
+ * of a float, so the exponent and mantissa are found arithmetically.  The
+ * mantissa is only scaled by a power of two, which loses nothing.  Wing
+ * coordinates are well inside the range of a half float, so anything too
+ * small for a normal half is flushed to zero and overflow is not considered.
+ * A carry out of the mantissa correctly bumps the exponent.
+ */
+uint packHalf(float value) {
+    uint sign = value < 0.0 ? 0x8000u : 0u;
+    float magnitude = abs(value);
+    if (magnitude < exp2(-14.0)) {
+        return sign;
+    }
+    float exponent = floor(log2(magnitude));
+    float mantissa = magnitude * exp2(-exponent);
+    /*
+     * The logarithm may be off by one near a power of two.
+     */
+    if (mantissa < 1.0) {
+        exponent -= 1.0;
+        mantissa *= 2.0;
+    } else if (mantissa >= 2.0) {
+        exponent += 1.0;
+        mantissa *= 0.5;
+    }
+    return sign | ((uint(exponent + 15.0) << 10) + uint(round((mantissa - 1.0) * 1024.0)));
+}
+
+uint packColor(vec4 value) {
+    uvec4 bytes = uvec4(round(clamp(value, 0.0, 1.0) * 255.0));
+    return bytes.r | (bytes.g << 8) | (bytes.b << 16) | (bytes.a << 24);
+}
+
+/*
+ * The fourth half of the position is always 1.0, so that the attribute
+ * reads back as a homogeneous coordinate.
+ */
+uvec3 packWingVertex(vec3 position, vec3 color) {
+    return uvec3(packHalf(position.x) | (packHalf(position.y) << 16),
+                 packHalf(position.z) | (0x3c00u << 16),
+                 packColor(vec4(color, 1)));
+}
+)shaderText"
+    };
+
+    /// <summary>
+    /// The byte offset of the color within each vertex.
+    /// </summary>
+    static GLsizeiptr constexpr colorOffset{ 4 * 2 };
+
+    WingVertexBuffer::WingVertexBuffer(GLsizei numVertices)
+        : Buffer{},
+        numVertices{ numVertices },
+        anchorsOffset{ static_cast<GLintptr>(vertexSize) * numVertices }
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, GetName());
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexSize + anchorSize) * numVertices, nullptr, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void WingVertexBuffer::UseForCapture(GLuint vertexIndex, GLuint anchorIndex, GLsizei firstVertex, GLsizei numVertices) const
+    {
+        assert(firstVertex >= 0);
+        assert(firstVertex + numVertices <= this->numVertices);
+
+        glBindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, vertexIndex, GetName(),
+            static_cast<GLintptr>(vertexSize) * firstVertex,
+            static_cast<GLsizeiptr>(vertexSize) * numVertices);
+        glBindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, anchorIndex, GetName(),
+            anchorsOffset + static_cast<GLintptr>(anchorSize) * firstVertex,
+            static_cast<GLsizeiptr>(anchorSize) * numVertices);
+    }
+
+    void WingVertexBuffer::UsePositionsForVertexAttribute(GLuint attributeLocation) const
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, GetName());
+        glVertexAttribPointer(attributeLocation, 4, GL_HALF_FLOAT, GL_FALSE, vertexSize, nullptr);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void WingVertexBuffer::UseColorsForVertexAttribute(GLuint attributeLocation) const
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, GetName());
+        glVertexAttribPointer(attributeLocation, 4, GL_UNSIGNED_BYTE, GL_TRUE, vertexSize, reinterpret_cast<void const*>(colorOffset));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void WingVertexBuffer::UseAnchorsForVertexAttribute(GLuint attributeLocation) const
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, GetName());
+        glVertexAttribPointer(attributeLocation, 3, GL_FLOAT, GL_FALSE, anchorSize, reinterpret_cast<void const*>(anchorsOffset));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    silnith::wings::gl::GLStateCache::VertexAttributePointer WingVertexBuffer::GetPositionsPointer(void) const
+    {
+        return silnith::wings::gl::GLStateCache::VertexAttributePointer{
+            .buffer = GetName(),
+            .size = 4,
+            .type = GL_HALF_FLOAT,
+            .normalized = GL_FALSE,
+            .stride = vertexSize,
+            .offset = 0,
+            .divisor = 0,
+        };
+    }
+
+    silnith::wings::gl::GLStateCache::VertexAttributePointer WingVertexBuffer::GetColorsPointer(void) const
+    {
+        return silnith::wings::gl::GLStateCache::VertexAttributePointer{
+            .buffer = GetName(),
+            .size = 4,
+            .type = GL_UNSIGNED_BYTE,
+            .normalized = GL_TRUE,
+            .stride = vertexSize,
+            .offset = colorOffset,
+            .divisor = 0,
+        };
+    }
+
+    silnith::wings::gl::GLStateCache::VertexAttributePointer WingVertexBuffer::GetAnchorsPointer(void) const
+    {
+        return silnith::wings::gl::GLStateCache::VertexAttributePointer{
+            .buffer = GetName(),
+            .size = 3,
+            .type = GL_FLOAT,
+            .normalized = GL_FALSE,
+            .stride = anchorSize,
+            .offset = anchorsOffset,
+            .divisor = 0,
+        };
+    }
+
+    GLsizei WingVertexBuffer::getNumVertices(void) const
+    {
+        return numVertices;
+    }
+
+}
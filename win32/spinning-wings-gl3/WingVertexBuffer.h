@@ -0,0 +1,164 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <string>
+
+#include "Buffer.h"
+#include "GLStateCache.h"
+
+namespace silnith::wings::gl3
+{
+
+    /// <summary>
+    /// A buffer of transformed wing vertices in a packed, interleaved layout.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each vertex is <see cref="vertexSize"/> bytes: the position as four
+    /// half floats, then the wing color as four normalized unsigned bytes.
+    /// This replaces a <c>vec4</c> position buffer and two <c>vec3</c> color
+    /// buffers, which took 40 bytes per vertex.  The edge color is the same
+    /// for every wing, so it is not stored at all.
+    /// </para>
+    /// <para>
+    /// Transform feedback can only write 32-bit components, so the vertex
+    /// shader packs each vertex into a <c>uvec3</c> using the function in
+    /// <see cref="packFunctionDeclaration"/>, and the render program reads the
+    /// same bytes back through <c>GL_HALF_FLOAT</c> and normalized
+    /// <c>GL_UNSIGNED_BYTE</c> vertex attributes.
+    /// </para>
+    /// <para>
+    /// Every vertex also carries the anchor of its wing, as three floats
+    /// of <see cref="anchorSize"/> bytes.  The anchor never changes once
+    /// the wing is written, so keeping it with the slot lets every wing be
+    /// drawn by a single call.  Transform feedback writes each captured
+    /// varying to its own range, so the anchors follow all of the packed
+    /// vertices rather than being interleaved with them.
+    /// </para>
+    /// </remarks>
+    class WingVertexBuffer : public Buffer
+    {
+    public:
+        /// <summary>
+        /// The number of bytes for each vertex.
+        /// </summary>
+        static GLsizei constexpr vertexSize{ 12 };
+
+        /// <summary>
+        /// The number of bytes for the anchor of each vertex.
+        /// </summary>
+        static GLsizei constexpr anchorSize{ 12 };
+
+        /// <summary>
+        /// The GLSL declaration of the function
+        /// <c>uvec3 packWingVertex(vec3 position, vec3 color)</c>, which
+        /// returns one vertex in the layout of this buffer.
+        /// </summary>
+        static std::string const packFunctionDeclaration;
+
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  The buffer needs to know how many
+        /// vertices it holds.
+        /// </summary>
+        WingVertexBuffer(void) = delete;
+
+        /// <summary>
+        /// Allocates storage for the specified number of vertices.  The
+        /// contents are undefined until written by transform feedback.
+        /// </summary>
+        /// <param name="numVertices">The number of vertices for the buffer to hold.</param>
+        explicit WingVertexBuffer(GLsizei numVertices);
+
+#pragma region Rule of Five
+
+    public:
+        WingVertexBuffer(WingVertexBuffer const&) = delete;
+        WingVertexBuffer& operator=(WingVertexBuffer const&) = delete;
+        WingVertexBuffer(WingVertexBuffer&&) noexcept = delete;
+        WingVertexBuffer& operator=(WingVertexBuffer&&) noexcept = delete;
+        virtual ~WingVertexBuffer(void) noexcept override = default;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Binds a range of vertices of this buffer, and their anchors, to two
+        /// transform feedback binding indices of the currently bound transform
+        /// feedback object.
+        /// </summary>
+        /// <param name="vertexIndex">The transform feedback binding index for the packed vertices.</param>
+        /// <param name="anchorIndex">The transform feedback binding index for the anchors.</param>
+        /// <param name="firstVertex">The index of the first vertex to write.</param>
+        /// <param name="numVertices">The number of vertices to write.</param>
+        void UseForCapture(GLuint vertexIndex, GLuint anchorIndex, GLsizei firstVertex, GLsizei numVertices) const;
+
+        /// <summary>
+        /// Makes the vertex positions the active data for the specified
+        /// vertex attribute location.
+        /// </summary>
+        /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
+        void UsePositionsForVertexAttribute(GLuint attributeLocation) const;
+
+        /// <summary>
+        /// Makes the vertex colors the active data for the specified vertex
+        /// attribute location.
+        /// </summary>
+        /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
+        void UseColorsForVertexAttribute(GLuint attributeLocation) const;
+
+        /// <summary>
+        /// Makes the wing anchors the active data for the specified vertex
+        /// attribute location.
+        /// </summary>
+        /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
+        void UseAnchorsForVertexAttribute(GLuint attributeLocation) const;
+
+        /// <summary>
+        /// Returns the attribute pointer that <see cref="UsePositionsForVertexAttribute"/>
+        /// sets, for comparison against the state cache.
+        /// </summary>
+        /// <returns>The buffer and layout of the vertex positions.</returns>
+        [[nodiscard]]
+        silnith::wings::gl::GLStateCache::VertexAttributePointer GetPositionsPointer(void) const;
+
+        /// <summary>
+        /// Returns the attribute pointer that <see cref="UseColorsForVertexAttribute"/>
+        /// sets, for comparison against the state cache.
+        /// </summary>
+        /// <returns>The buffer and layout of the vertex colors.</returns>
+        [[nodiscard]]
+        silnith::wings::gl::GLStateCache::VertexAttributePointer GetColorsPointer(void) const;
+
+        /// <summary>
+        /// Returns the attribute pointer that <see cref="UseAnchorsForVertexAttribute"/>
+        /// sets, for comparison against the state cache.
+        /// </summary>
+        /// <returns>The buffer and layout of the wing anchors.</returns>
+        [[nodiscard]]
+        silnith::wings::gl::GLStateCache::VertexAttributePointer GetAnchorsPointer(void) const;
+
+        /// <summary>
+        /// Returns the number of vertices that this buffer can hold.
+        /// </summary>
+        /// <returns>The number of vertices that this buffer can hold.</returns>
+        [[nodiscard]]
+        GLsizei getNumVertices(void) const;
+
+    private:
+        /// <summary>
+        /// The number of vertices that this buffer can hold.
+        /// </summary>
+        GLsizei const numVertices{ 0 };
+
+        /// <summary>
+        /// The byte offset of the first anchor, just past the packed vertices.
+        /// </summary>
+        GLintptr const anchorsOffset{ 0 };
+    };
+
+}
@@ -1,16 +1,30 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <deque>
 #include <memory>
+#include <span>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 #include "WingsViewGL3.h"
 
-#include "CurveGenerator.h"
+#include "AccumulatedDeltas.h"
+#include "Instrumentation.h"
+#include "Philox4x32.h"
+#include "RingBuffer.h"
+#include "WingCurves.h"
 #include "WingGL3.h"
+#include "WingParameters.h"
 
 #include "WingTransformProgram.h"
 #include "WingRenderProgram.h"
+#include "WingStreamBuffer.h"
+#include "WingStreamRenderProgram.h"
 
 using namespace std::literals::string_literals;
 
@@ -18,6 +32,15 @@ namespace silnith::wings::gl3
 {
 
 	WingsViewGL3::WingsViewGL3(void)
+		: WingsViewGL3{ WingPipeline::TransformFeedback }
+	{}
+
+	WingsViewGL3::WingsViewGL3(WingPipeline pipeline)
+		: WingsViewGL3{ pipeline, defaultNumWings, Philox4x32::generateRandomSeed() }
+	{}
+
+	WingsViewGL3::WingsViewGL3(WingPipeline pipeline, std::size_t numWings, std::uint64_t seed)
+		: pipeline{ pipeline }, numWings{ numWings }, curves{ seed }
 	{
 		GLint glMajorVersion{ 1 };
 		GLint glMinorVersion{ 0 };
@@ -61,8 +84,18 @@ namespace silnith::wings::gl3
 			VertexShader::MakeScaleMatrixShader()
 		};
 		wingGeometry = std::make_shared<WingGeometry const>();
-		wingTransformProgram = std::make_unique<WingTransformProgram const>(wingGeometry, rotateMatrixShader, translateMatrixShader);
-		wingRenderProgram = std::make_unique<WingRenderProgram const>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+		switch (pipeline)
+		{
+		case WingPipeline::TransformFeedback:
+			wingTransformProgram = std::make_unique<WingTransformProgram const>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+			vertexBuffer = wingTransformProgram->CreateVertexBuffer(static_cast<GLsizei>(numWings));
+			wingRenderProgram = std::make_unique<WingRenderProgram const>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+			break;
+		case WingPipeline::MappedStream:
+			wingStreamBuffer = std::make_unique<WingStreamBuffer>(static_cast<GLsizei>(numWings));
+			wingStreamRenderProgram = std::make_unique<WingStreamRenderProgram const>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+			break;
+		}
 	}
 
 	void WingsViewGL3::AdvanceAnimation(void)
@@ -71,61 +104,130 @@ namespace silnith::wings::gl3
 		 * Get the next updated values for all the parameters that define how
 		 * a wing moves.
 		 */
-		GLfloat const radius{ radiusCurve.getNextValue() };
-		GLfloat const angle{ angleCurve.getNextValue() };
-		GLfloat const deltaAngle{ deltaAngleCurve.getNextValue() };
-		GLfloat const deltaZ{ deltaZCurve.getNextValue() };
-		GLfloat const roll{ rollCurve.getNextValue() };
-		GLfloat const pitch{ pitchCurve.getNextValue() };
-		GLfloat const yaw{ yawCurve.getNextValue() };
-		GLfloat const red{ redCurve.getNextValue() };
-		GLfloat const green{ greenCurve.getNextValue() };
-		GLfloat const blue{ blueCurve.getNextValue() };
-
-		std::shared_ptr<ArrayBuffer const> vertexBuffer{ nullptr };
-		std::shared_ptr<ArrayBuffer const> colorBuffer{ nullptr };
-		std::shared_ptr<ArrayBuffer const> edgeColorBuffer{ nullptr };
-		if (wings.empty() || wings.size() < numWings)
-		{
-			vertexBuffer = wingTransformProgram->CreateVertexBuffer();
-			colorBuffer = wingTransformProgram->CreateColorBuffer();
-			edgeColorBuffer = wingTransformProgram->CreateColorBuffer();
-		}
-		else
+		instrumentation::PhaseTimer curveTimer{ instrumentation::Phase::CurveStep };
+		WingParameters<GLfloat> const parameters{ NextWingParameters() };
+		curveTimer.Stop();
+
+		instrumentation::PhaseTimer const transformTimer{ instrumentation::Phase::Transform };
+
+		if (pipeline == WingPipeline::MappedStream)
 		{
-			/*
-			 * If a wing expires off the end of the list of wings, we can reuse
-			 * the various buffers for the newly-created wing.  The old data
-			 * will be overwritten.
-			 */
-			vertexBuffer = wings.back().getVertexBuffer();
-			colorBuffer = wings.back().getColorBuffer();
-			edgeColorBuffer = wings.back().getEdgeColorBuffer();
-			wings.pop_back();
+			AddStreamWing(parameters);
+			return;
 		}
 
-		wings.emplace_front(deltaAngle, deltaZ, vertexBuffer, colorBuffer, edgeColorBuffer);
+		Wing const& wing{ AddWing(parameters) };
 
 		/*
 		 * Run a vertex shader to transform the wing based on its current
 		 * animation state, and capture the transformed geometry using transform
 		 * feedback.
 		 */
-		wingTransformProgram->TransformWing(radius, angle,
-			roll, pitch, yaw,
-			red, green, blue,
-			*vertexBuffer,
-			*colorBuffer,
-			*edgeColorBuffer);
+		wingTransformProgram->TransformWings(std::span<WingParameters<GLfloat> const>{ &parameters, 1 },
+			std::span<AccumulatedDeltas<GLfloat>::Anchor const>{ &wing.getAnchor(), 1 },
+			wing.getFirstVertex() / wingGeometry->getNumVertices(),
+			*vertexBuffer, stateCache);
+
+		glFlush();
+	}
+
+	void WingsViewGL3::WarmStart(void)
+	{
+		assert(wings.empty());
+		assert(!wingStreamBuffer || wingStreamBuffer->getNumWings() == 0);
+
+		instrumentation::PhaseTimer const warmStartTimer{ instrumentation::Phase::WarmStart };
+
+		std::vector<WingParameters<GLfloat> > history(numWings);
+		for (WingParameters<GLfloat>& parameters : history)
+		{
+			parameters = NextWingParameters();
+		}
+
+		if (pipeline == WingPipeline::MappedStream)
+		{
+			for (WingParameters<GLfloat> const& parameters : history)
+			{
+				AddStreamWing(parameters);
+			}
+			return;
+		}
+
+		/*
+		 * The history starts empty, so the wings take the slots in order and
+		 * the whole history can be captured by one transform feedback pass.
+		 */
+		std::vector<AccumulatedDeltas<GLfloat>::Anchor> anchors{};
+		anchors.reserve(history.size());
+		for (WingParameters<GLfloat> const& parameters : history)
+		{
+			anchors.push_back(AddWing(parameters).getAnchor());
+		}
+		wingTransformProgram->TransformWings(history, anchors, 0, *vertexBuffer, stateCache);
 
 		glFlush();
 	}
 
+	WingParameters<GLfloat> WingsViewGL3::NextWingParameters(void)
+	{
+		return curves.getNextParameters();
+	}
+
+	Wing const& WingsViewGL3::AddWing(WingParameters<GLfloat> const& parameters)
+	{
+		AccumulatedDeltas<GLfloat>::Anchor const anchor{ accumulatedDeltas.AddWing(parameters.deltaAngle, parameters.deltaZ) };
+		if (wings.full())
+		{
+			/*
+			 * If a wing expires off the end of the list of wings, we can reuse
+			 * the wing and its slot in the buffers for the newly-created wing.
+			 * The old data will be overwritten.
+			 */
+			wings.recycle_front().setAnchor(anchor);
+		}
+		else
+		{
+			/*
+			 * Until the list is full, the wings take the slots in order.
+			 */
+			GLint const firstVertex{ static_cast<GLint>(wings.size()) * wingGeometry->getNumVertices() };
+			wings.emplace_front(anchor, firstVertex);
+		}
+		return wings.front();
+	}
+
+	void WingsViewGL3::AddStreamWing(WingParameters<GLfloat> const& parameters)
+	{
+		/*
+		 * The render program does all of the transformation, so the
+		 * parameters are all that need to be recorded.
+		 */
+		wingStreamBuffer->AddWing(parameters.radius, parameters.angle,
+			parameters.deltaAngle, parameters.deltaZ,
+			parameters.roll, parameters.pitch, parameters.yaw,
+			parameters.red, parameters.green, parameters.blue);
+	}
+
 	void WingsViewGL3::DrawFrame(void) const
 	{
-		wingRenderProgram->RenderWings(wings);
+		bool complete{ false };
+		switch (pipeline)
+		{
+		case WingPipeline::TransformFeedback:
+			wingRenderProgram->RenderWings(wings, *vertexBuffer, accumulatedDeltas, stateCache);
+			complete = wings.full();
+			break;
+		case WingPipeline::MappedStream:
+			wingStreamRenderProgram->RenderWings(*wingStreamBuffer, stateCache);
+			complete = static_cast<std::size_t>(wingStreamBuffer->getNumWings()) == numWings;
+			break;
+		}
 
 		glFlush();
+
+		stateCache.EndFrame();
+
+		firstFrameTimer.FrameDrawn(complete);
 	}
 
 	void WingsViewGL3::Resize(GLsizei width, GLsizei height) const
@@ -143,7 +245,25 @@ namespace silnith::wings::gl3
 		 */
 		glViewport(x, y, width, height);
 
-		wingRenderProgram->Resize(static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+		switch (pipeline)
+		{
+		case WingPipeline::TransformFeedback:
+			wingRenderProgram->Resize(static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+			break;
+		case WingPipeline::MappedStream:
+			wingStreamRenderProgram->Resize(static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+			break;
+		}
+	}
+
+	silnith::wings::gl::GLStateCache const& WingsViewGL3::getStateCache(void) const noexcept
+	{
+		return stateCache;
+	}
+
+	silnith::wings::gl::GLStateCache& WingsViewGL3::getStateCache(void) noexcept
+	{
+		return stateCache;
 	}
 
 }
@@ -1,20 +1,51 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <deque>
 #include <memory>
 
-#include "CurveGenerator.h"
+#include <cstddef>
+#include <cstdint>
+
+#include "AccumulatedDeltas.h"
+#include "GLStateCache.h"
+#include "Instrumentation.h"
+#include "RingBuffer.h"
+#include "WingCurves.h"
 #include "WingGL3.h"
 #include "WingGeometry.h"
+#include "WingParameters.h"
 #include "WingRenderProgram.h"
+#include "WingStreamBuffer.h"
+#include "WingStreamRenderProgram.h"
 #include "WingTransformProgram.h"
+#include "WingVertexBuffer.h"
 
 namespace silnith::wings::gl3
 {
 
+    /// <summary>
+    /// The ways the per-wing transformation can reach the GPU.
+    /// </summary>
+    enum class WingPipeline
+    {
+        /// <summary>
+        /// Each new wing is transformed once using transform feedback, and
+        /// every frame draws each wing from its captured buffers.
+        /// </summary>
+        TransformFeedback,
+
+        /// <summary>
+        /// Each new wing only writes its parameters into a mapped
+        /// <see cref="WingStreamBuffer"/>, and the render program transforms
+        /// every wing every frame using instanced draw calls.
+        /// </summary>
+        MappedStream,
+    };
+
     /// <summary>
     /// An object to encapsulate all of the logic and data for initializing,
     /// animating, and rendering the 3D view of the spinning wings.
@@ -37,6 +68,27 @@ namespace silnith::wings::gl3
         /// </summary>
         explicit WingsViewGL3(void);
 
+        /// <summary>
+        /// Configures the OpenGL state machine for rendering the spinning wings
+        /// animation using the specified pipeline.
+        /// </summary>
+        /// <param name="pipeline">How the wing transformations reach the GPU.</param>
+        explicit WingsViewGL3(WingPipeline pipeline);
+
+        /// <summary>
+        /// Configures the OpenGL state machine for rendering the spinning wings
+        /// animation using the specified pipeline, number of wings, and seed.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Two views created with the same seed produce identical animations.
+        /// </para>
+        /// </remarks>
+        /// <param name="pipeline">How the wing transformations reach the GPU.</param>
+        /// <param name="numWings">The number of wings to animate.</param>
+        /// <param name="seed">The seed for the curve generators.</param>
+        explicit WingsViewGL3(WingPipeline pipeline, std::size_t numWings, std::uint64_t seed);
+
 #pragma region Rule of Five
 
     public:
@@ -60,6 +112,21 @@ namespace silnith::wings::gl3
         /// </remarks>
         void AdvanceAnimation(void);
 
+        /// <summary>
+        /// Fills the entire wing history at once, so that the first frame
+        /// drawn is already a complete spiral.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This is equivalent to calling <see cref="AdvanceAnimation"/> once
+        /// per wing, except that with the
+        /// <see cref="WingPipeline::TransformFeedback"/> pipeline every wing
+        /// is transformed by a single transform feedback pass.  It must be
+        /// called before the animation is advanced for the first time.
+        /// </para>
+        /// </remarks>
+        void WarmStart(void);
+
         /// <summary>
         /// Renders the current spinning wings animation frame into the current
         /// rendering context.
@@ -90,84 +157,88 @@ namespace silnith::wings::gl3
         /// <param name="height">the new viewport height</param>
         void Resize(GLint x, GLint y, GLsizei width, GLsizei height) const;
 
-    private:
         /// <summary>
-        /// The number of wings to animate.
+        /// Returns the shadow of the OpenGL state that drawing changes, which
+        /// counts the state changes that were issued and elided.
         /// </summary>
-        std::size_t const numWings{ 40 };
+        /// <returns>The state cache.</returns>
+        [[nodiscard]]
+        silnith::wings::gl::GLStateCache const& getStateCache(void) const noexcept;
 
         /// <summary>
-        /// The sequence of transformed wings.
+        /// Returns the shadow of the OpenGL state that drawing changes, so
+        /// that code changing the same state can invalidate it.
         /// </summary>
-        std::deque<Wing> wings{};
+        /// <returns>The state cache.</returns>
+        [[nodiscard]]
+        silnith::wings::gl::GLStateCache& getStateCache(void) noexcept;
 
+    public:
         /// <summary>
-        /// The curve generator for the distance of the wing from the central axis.
+        /// The number of wings animated when none is specified.
         /// </summary>
-        CurveGenerator<GLfloat> radiusCurve{ 10.0f, -15.0f, 15.0f, false, 0.1f, 0.01f, 150 };
+        static std::size_t constexpr defaultNumWings{ 40 };
 
+    private:
         /// <summary>
-        /// The curve generator for the angle that the wing is rotated around the central axis.
+        /// Steps every curve once.
         /// </summary>
-        CurveGenerator<GLfloat> angleCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120) };
+        /// <returns>The parameters of the next wing.</returns>
+        [[nodiscard]]
+        WingParameters<GLfloat> NextWingParameters(void);
 
         /// <summary>
-        /// The curve generator for the additional angle added to each successive "shadow" of the wing.
+        /// Adds a new wing to the front of <see cref="wings"/> without
+        /// transforming it.  Until the history is full, each wing takes the
+        /// next slot in the buffers, after that it reuses the slot of the
+        /// oldest wing.
         /// </summary>
-        CurveGenerator<GLfloat> deltaAngleCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(15.0f, 0.2f, 0.02f, 80) };
+        /// <param name="parameters">The parameters of the new wing.</param>
+        /// <returns>The new wing.</returns>
+        Wing const& AddWing(WingParameters<GLfloat> const& parameters);
 
         /// <summary>
-        /// The curve generator for the distance "up" the central axis that each wing shadow is moved.
+        /// Records a new wing in <see cref="wingStreamBuffer"/>.
         /// </summary>
-        CurveGenerator<GLfloat> deltaZCurve{ 0.5f, 0.4f, 0.7f, false, 0.01f, 0.001f, 200 };
+        /// <param name="parameters">The parameters of the new wing.</param>
+        void AddStreamWing(WingParameters<GLfloat> const& parameters);
 
+    private:
         /// <summary>
-        /// The curve generator for the roll of the wing.
+        /// The time from construction to the first complete frame.  This is
+        /// declared first so that it includes the construction of every other member.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
-        /// </para>
-        /// </remarks>
-        CurveGenerator<GLfloat> rollCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 1.0f, 0.25f, 80) };
+        instrumentation::FirstFrameTimer const firstFrameTimer{};
 
         /// <summary>
-        /// The curve generator for the pitch of the wing.
+        /// How the wing transformations reach the GPU.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
-        /// </para>
-        /// </remarks>
-        CurveGenerator<GLfloat> pitchCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 2.0f, 0.25f, 40) };
+        WingPipeline const pipeline{ WingPipeline::TransformFeedback };
 
         /// <summary>
-        /// The curve generator for the yaw of the wing.
+        /// The number of wings to animate.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
-        /// </para>
-        /// </remarks>
-        CurveGenerator<GLfloat> yawCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 1.5f, 0.25f, 50) };
+        std::size_t const numWings{ defaultNumWings };
+
+        /// <summary>
+        /// The curve generators for all of the parameters that define how a wing moves.
+        /// </summary>
+        WingCurves curves;
 
         /// <summary>
-        /// The curve generator for the red component of the wing color.
+        /// The shadow of the OpenGL state that transforming and drawing the wings changes.
         /// </summary>
-        CurveGenerator<GLfloat> redCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 95) };
+        mutable silnith::wings::gl::GLStateCache stateCache{};
 
         /// <summary>
-        /// The curve generator for the green component of the wing color.
+        /// The sequence of transformed wings.
         /// </summary>
-        CurveGenerator<GLfloat> greenCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 40) };
+        RingBuffer<Wing> wings{ numWings };
 
         /// <summary>
-        /// The curve generator for the blue component of the wing color.
+        /// The delta angle and delta Z accumulated by <see cref="wings"/>.
         /// </summary>
-        CurveGenerator<GLfloat> blueCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 70) };
+        AccumulatedDeltas<GLfloat> accumulatedDeltas{ numWings };
 
         /// <summary>
         /// The various buffers that hold the wing geometry.
@@ -180,10 +251,27 @@ namespace silnith::wings::gl3
         /// </summary>
         std::unique_ptr<WingTransformProgram const> wingTransformProgram{ nullptr };
 
+        /// <summary>
+        /// The transformed vertex coordinates and surface colors of every wing
+        /// in <see cref="wings"/>, one slot per wing.
+        /// </summary>
+        std::shared_ptr<WingVertexBuffer const> vertexBuffer{ nullptr };
+
         /// <summary>
         /// The GLSL program for rendering the wings.
         /// </summary>
         std::unique_ptr<WingRenderProgram const> wingRenderProgram{ nullptr };
+
+        /// <summary>
+        /// The mapped ring of wing parameters, used instead of <see cref="wings"/>
+        /// by the <see cref="WingPipeline::MappedStream"/> pipeline.
+        /// </summary>
+        std::unique_ptr<WingStreamBuffer> wingStreamBuffer{ nullptr };
+
+        /// <summary>
+        /// The GLSL program for rendering the wings from <see cref="wingStreamBuffer"/>.
+        /// </summary>
+        std::unique_ptr<WingStreamRenderProgram const> wingStreamRenderProgram{ nullptr };
     };
 
 }
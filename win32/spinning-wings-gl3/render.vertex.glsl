@@ -1,12 +1,13 @@
 #version 150
 
-uniform ModelViewProjection {
+layout(std140) uniform ModelViewProjection {
     mat4 model;
     mat4 view;
     mat4 projection;
 };
 
-uniform vec2 deltaZ = vec2(15, 0.5);
+uniform vec3 anchor = vec3(0, 0, 0);
+uniform vec2 sectionOffsets[3];
 
 in vec4 vertex;
 in vec4 color;
@@ -41,8 +42,9 @@ const vec3 yAxis = vec3(0, 1, 0);
 const vec3 zAxis = vec3(0, 0, 1);
 
 void main() {
-    float deltaAngle = deltaZ[0];
-    float deltaZ = deltaZ[1];
+    vec2 accumulatedDeltas = sectionOffsets[int(anchor[2])] - anchor.xy;
+    float deltaAngle = accumulatedDeltas[0];
+    float deltaZ = accumulatedDeltas[1];
 
     mat4 modelViewProjection = projection * view * model;
 
@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <span>
@@ -24,9 +26,7 @@ namespace silnith::wings::gl4
         assert(data.size() == static_cast<std::size_t>(numComponentsPerVertex) * static_cast<std::size_t>(numVertices));
         GLsizeiptr const dataSize{ static_cast<GLsizeiptr>(data.size_bytes()) };
 
-        glBindBuffer(GL_ARRAY_BUFFER, GetName());
-        glBufferData(GL_ARRAY_BUFFER, dataSize, data.data(), usageHint);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        AllocateStorage(dataSize, data.data(), usageHint);
     }
 
     ArrayBuffer::ArrayBuffer(GLint numComponentsPerVertex, GLsizei numVertices, GLenum usageHint)
@@ -40,22 +40,34 @@ namespace silnith::wings::gl4
     {
         GLsizeiptr const dataSize{ static_cast<GLsizeiptr>(sizeof(GLfloat) * numComponentsPerVertex * numVertices) };
 
-        glBindBuffer(GL_ARRAY_BUFFER, GetName());
-        glBufferData(GL_ARRAY_BUFFER, dataSize, nullptr, usageHint);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        AllocateStorage(dataSize, nullptr, usageHint);
     }
 
-    void ArrayBuffer::UseForVertexAttribute(GLuint attributeLocation) const
+    void ArrayBuffer::UseForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation) const
     {
-        /*
-         * The currently-bound array buffer is captured as part of the state
-         * associated with a vertex attribute pointer.  Therefore, after the
-         * call to glVertexAttribPointer, the buffer can be unbound without
-         * affecting the stored state of the vertex attribute pointer.
-         */
-        glBindBuffer(GL_ARRAY_BUFFER, GetName());
-        glVertexAttribPointer(attributeLocation, numComponentsPerVertex, dataType, normalized, stride, offset);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GLsizei const packedStride{ stride != 0 ? stride : static_cast<GLsizei>(sizeof(GLfloat) * numComponentsPerVertex) };
+        vertexArray.UseBufferForAttribute(attributeLocation, GetName(),
+            numComponentsPerVertex, dataType, normalized,
+            packedStride, reinterpret_cast<GLintptr>(offset), 0);
+    }
+
+    void ArrayBuffer::UseForInstanceAttribute(VertexArray const& vertexArray, GLuint attributeLocation) const
+    {
+        GLsizei const packedStride{ stride != 0 ? stride : static_cast<GLsizei>(sizeof(GLfloat) * numComponentsPerVertex) };
+        vertexArray.UseBufferForAttribute(attributeLocation, GetName(),
+            numComponentsPerVertex, dataType, normalized,
+            packedStride, reinterpret_cast<GLintptr>(offset), 1);
+    }
+
+    void ArrayBuffer::ReplaceVertices(GLsizei firstVertex, std::span<GLfloat const> data) const
+    {
+        std::size_t const componentsPerVertex{ static_cast<std::size_t>(numComponentsPerVertex) };
+        assert(data.size() % componentsPerVertex == 0);
+        assert(static_cast<std::size_t>(firstVertex) + data.size() / componentsPerVertex <= static_cast<std::size_t>(numVertices));
+        GLintptr const dataOffset{ static_cast<GLintptr>(sizeof(GLfloat) * componentsPerVertex * static_cast<std::size_t>(firstVertex)) };
+        GLsizeiptr const dataSize{ static_cast<GLsizeiptr>(data.size_bytes()) };
+
+        ReplaceData(dataOffset, dataSize, data.data());
     }
 
     GLint ArrayBuffer::getNumComponentsPerVertex(void) const
@@ -1,12 +1,15 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <array>
 #include <span>
 
 #include "Buffer.h"
+#include "VertexArray.h"
 
 namespace silnith::wings::gl4
 {
@@ -68,10 +71,39 @@ namespace silnith::wings::gl4
     public:
         /// <summary>
         /// Makes this buffer the active buffer for the specified vertex
-        /// attribute location.
+        /// attribute location of a vertex array.
         /// </summary>
+        /// <param name="vertexArray">The vertex array to modify.</param>
         /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
-        void UseForVertexAttribute(GLuint attributeLocation) const;
+        void UseForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation) const;
+
+        /// <summary>
+        /// Makes this buffer the active buffer for the specified vertex
+        /// attribute location, advancing once per instance rather than once
+        /// per vertex.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Each "vertex" in the buffer then holds the attribute values for
+        /// one instance of an instanced draw call.
+        /// </para>
+        /// </remarks>
+        /// <param name="vertexArray">The vertex array to modify.</param>
+        /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
+        void UseForInstanceAttribute(VertexArray const& vertexArray, GLuint attributeLocation) const;
+
+        /// <summary>
+        /// Overwrites the components of consecutive vertices in the buffer,
+        /// starting with the specified vertex.
+        /// </summary>
+        /// <param name="firstVertex">The index of the first vertex to overwrite.</param>
+        /// <remarks>
+        /// <para>
+        /// The buffer must not have been created with a static usage hint.
+        /// </para>
+        /// </remarks>
+        /// <param name="data">The new components, which must be a whole number of vertices.</param>
+        void ReplaceVertices(GLsizei firstVertex, std::span<GLfloat const> data) const;
 
         /// <summary>
         /// Returns the number of components per vertex that this buffer is
@@ -1,14 +1,30 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include "Buffer.h"
 
+#include "DirectStateAccess.h"
+
 namespace silnith::wings::gl4
 {
 
     Buffer::Buffer(void)
     {
-        glGenBuffers(1, &name);
+        if (HasDirectStateAccess())
+        {
+            /*
+             * Unlike a generated name, a created buffer object exists
+             * immediately, so it can be edited by name without ever being
+             * bound.
+             */
+            glCreateBuffers(1, &name);
+        }
+        else
+        {
+            glGenBuffers(1, &name);
+        }
     }
 
     Buffer::~Buffer(void) noexcept
@@ -24,4 +40,49 @@ namespace silnith::wings::gl4
         return name;
     }
 
+    void Buffer::AllocateStorage(GLsizeiptr size, void const* data, GLenum usageHint) const
+    {
+        if (HasDirectStateAccess())
+        {
+            bool const isStatic{ usageHint == GL_STATIC_DRAW || usageHint == GL_STATIC_READ || usageHint == GL_STATIC_COPY };
+            glNamedBufferStorage(name, size, data, isStatic ? 0 : GL_DYNAMIC_STORAGE_BIT);
+        }
+        else
+        {
+            Reallocate(size, data, usageHint);
+        }
+    }
+
+    void Buffer::Reallocate(GLsizeiptr size, void const* data, GLenum usageHint) const
+    {
+        if (HasDirectStateAccess())
+        {
+            glNamedBufferData(name, size, data, usageHint);
+        }
+        else
+        {
+            /*
+             * The copy target is not part of any vertex array or indexed
+             * binding, so binding it here cannot disturb other state.
+             */
+            glBindBuffer(GL_COPY_WRITE_BUFFER, name);
+            glBufferData(GL_COPY_WRITE_BUFFER, size, data, usageHint);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+    }
+
+    void Buffer::ReplaceData(GLintptr offset, GLsizeiptr size, void const* data) const
+    {
+        if (HasDirectStateAccess())
+        {
+            glNamedBufferSubData(name, offset, size, data);
+        }
+        else
+        {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, name);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+    }
+
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 namespace silnith::wings::gl4
@@ -25,7 +27,8 @@ namespace silnith::wings::gl4
     public:
         /// <summary>
         /// Constructs a new buffer object.  The buffer has no attached storage
-        /// until some is allocated using <see cref="glBufferData"/>.
+        /// until some is allocated using <see cref="AllocateStorage"/> or
+        /// <see cref="Reallocate"/>.
         /// </summary>
         explicit Buffer(void);
 
@@ -48,6 +51,41 @@ namespace silnith::wings::gl4
         [[nodiscard]]
         GLuint GetName(void) const;
 
+        /// <summary>
+        /// Allocates storage for the buffer, once, and optionally initializes
+        /// it.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// With <see cref="HasDirectStateAccess"/> the storage is immutable.
+        /// Static usage hints get storage that the CPU can never write again,
+        /// which lets the driver place it wherever the GPU reads it fastest.
+        /// Any other hint allows <see cref="ReplaceData"/>.
+        /// </para>
+        /// </remarks>
+        /// <param name="size">The size of the storage in bytes.</param>
+        /// <param name="data">The initial contents, or <c>nullptr</c> to leave them undefined.</param>
+        /// <param name="usageHint">A hint to the GL about how the data will be used.</param>
+        void AllocateStorage(GLsizeiptr size, void const* data, GLenum usageHint) const;
+
+        /// <summary>
+        /// Replaces the storage of the buffer with new storage, orphaning the
+        /// old.  This must never be used on a buffer whose storage came from
+        /// <see cref="AllocateStorage"/>, since that may be immutable.
+        /// </summary>
+        /// <param name="size">The size of the new storage in bytes.</param>
+        /// <param name="data">The new contents, or <c>nullptr</c> to leave them undefined.</param>
+        /// <param name="usageHint">A hint to the GL about how the data will be used.</param>
+        void Reallocate(GLsizeiptr size, void const* data, GLenum usageHint) const;
+
+        /// <summary>
+        /// Overwrites part of the buffer contents.
+        /// </summary>
+        /// <param name="offset">The byte offset of the first byte to overwrite.</param>
+        /// <param name="size">The number of bytes to overwrite.</param>
+        /// <param name="data">The new contents.</param>
+        void ReplaceData(GLintptr offset, GLsizeiptr size, void const* data) const;
+
     private:
         /// <summary>
         /// The OpenGL name for the buffer object.
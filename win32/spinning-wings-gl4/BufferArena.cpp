@@ -0,0 +1,65 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+
+#include "BufferArena.h"
+
+namespace silnith::wings::gl4
+{
+
+    GLsizeiptr BufferArena::GetAlignment(void)
+    {
+        GLint alignment{ static_cast<GLint>(sizeof(GLfloat)) };
+
+        GLint uniformBufferAlignment{ 0 };
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformBufferAlignment);
+        alignment = std::max(alignment, uniformBufferAlignment);
+
+        /*
+         * Shader storage buffers are only queried where they exist, since
+         * asking an OpenGL 4.1 implementation is an error.
+         */
+        if (GLEW_VERSION_4_3)
+        {
+            GLint shaderStorageBufferAlignment{ 0 };
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &shaderStorageBufferAlignment);
+            alignment = std::max(alignment, shaderStorageBufferAlignment);
+        }
+
+        return static_cast<GLsizeiptr>(alignment);
+    }
+
+    BufferArena::BufferArena(std::initializer_list<GLsizeiptr> sliceSizes, GLenum usageHint)
+        : Buffer{},
+        slices{}
+    {
+        GLsizeiptr const alignment{ GetAlignment() };
+        GLsizeiptr size{ 0 };
+
+        slices.reserve(sliceSizes.size());
+        for (GLsizeiptr const sliceSize : sliceSizes)
+        {
+            assert(sliceSize > 0);
+            GLintptr const offset{ (size + alignment - 1) / alignment * alignment };
+            slices.emplace_back(BufferSlice{ GetName(), offset, sliceSize });
+            size = offset + sliceSize;
+        }
+
+        AllocateStorage(size, nullptr, usageHint);
+    }
+
+    BufferSlice const& BufferArena::getSlice(std::size_t index) const
+    {
+        assert(index < slices.size());
+        return slices[index];
+    }
+
+}
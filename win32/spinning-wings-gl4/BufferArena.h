@@ -0,0 +1,111 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <initializer_list>
+#include <vector>
+
+#include <cstddef>
+
+#include "Buffer.h"
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// A range of bytes within a buffer object.
+    /// </summary>
+    /// <seealso cref="BufferArena"/>
+    struct BufferSlice
+    {
+        /// <summary>
+        /// The OpenGL name of the buffer object that holds the slice.
+        /// </summary>
+        GLuint buffer{ 0 };
+
+        /// <summary>
+        /// The byte offset of the slice within the buffer.
+        /// </summary>
+        GLintptr offset{ 0 };
+
+        /// <summary>
+        /// The number of bytes in the slice.
+        /// </summary>
+        GLsizeiptr size{ 0 };
+    };
+
+    /// <summary>
+    /// A single buffer object divided into several slices, so that data that
+    /// would otherwise need a buffer object of its own can share one.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The slices are laid out once, when the arena is created, and never
+    /// move.  Every slice starts on a multiple of <see cref="GetAlignment"/>,
+    /// so any slice can be bound with <c>glBindBufferRange</c> to any indexed
+    /// target, or used as the offset of a vertex attribute pointer.
+    /// </para>
+    /// <para>
+    /// Keeping related data in one buffer object means one name, one
+    /// allocation, and one <c>GL_ARRAY_BUFFER</c> binding to set up all of
+    /// the vertex attributes that read it.
+    /// </para>
+    /// </remarks>
+    class BufferArena : public Buffer
+    {
+    public:
+        /// <summary>
+        /// Returns the alignment of every slice.  This is the largest of the
+        /// offset alignments the implementation requires for uniform buffer
+        /// and shader storage buffer ranges, and no less than the size of a
+        /// <c>GLfloat</c>.
+        /// </summary>
+        /// <returns>The alignment of each slice, in bytes.</returns>
+        [[nodiscard]]
+        static GLsizeiptr GetAlignment(void);
+
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  An arena needs its slices.
+        /// </summary>
+        BufferArena(void) = delete;
+
+        /// <summary>
+        /// Allocates a buffer object large enough for the specified slices,
+        /// in order.  The contents are undefined.
+        /// </summary>
+        /// <param name="sliceSizes">The size in bytes of each slice.</param>
+        /// <param name="usageHint">A hint to the GL about how the data will be used.</param>
+        explicit BufferArena(std::initializer_list<GLsizeiptr> sliceSizes, GLenum usageHint);
+
+#pragma region Rule of Five
+
+    public:
+        BufferArena(BufferArena const&) = delete;
+        BufferArena& operator=(BufferArena const&) = delete;
+        BufferArena(BufferArena&&) noexcept = delete;
+        BufferArena& operator=(BufferArena&&) noexcept = delete;
+        virtual ~BufferArena(void) noexcept override = default;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Returns one of the slices.
+        /// </summary>
+        /// <param name="index">The position of the slice in the list given to the constructor.</param>
+        /// <returns>The slice.</returns>
+        [[nodiscard]]
+        BufferSlice const& getSlice(std::size_t index) const;
+
+    private:
+        /// <summary>
+        /// The slices, in the order they were requested.
+        /// </summary>
+        std::vector<BufferSlice> slices{};
+    };
+
+}
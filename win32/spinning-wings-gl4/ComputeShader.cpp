@@ -0,0 +1,18 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <initializer_list>
+#include <string>
+
+#include "ComputeShader.h"
+
+namespace silnith::wings::gl4
+{
+
+    ComputeShader::ComputeShader(std::initializer_list<std::string> sources)
+        : Shader{ GL_COMPUTE_SHADER, sources }
+    {}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <initializer_list>
+#include <string>
+
+#include "Shader.h"
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// Manages a single GLSL compute shader.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This is designed for OpenGL 4.3 or greater.  The source should begin
+    /// with <see cref="Shader::computeVersionDeclaration"/> rather than
+    /// <see cref="Shader::versionDeclaration"/>.
+    /// </para>
+    /// </remarks>
+    class ComputeShader : public Shader
+    {
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  A shader is not valid without source code.
+        /// </summary>
+        ComputeShader(void) = delete;
+
+        /// <summary>
+        /// Creates and compiles a compute shader from the given GLSL sources.
+        /// The source strings are concatenated.
+        /// </summary>
+        /// <param name="sources">The source strings to concatenate.</param>
+        /// <exception cref="std::runtime_error">If an error occurs creating the shader object in the OpenGL state machine.</exception>
+        explicit ComputeShader(std::initializer_list<std::string> sources);
+
+#pragma region Rule of Five
+
+    public:
+        ComputeShader(ComputeShader const&) = delete;
+        ComputeShader& operator=(ComputeShader const&) = delete;
+        ComputeShader(ComputeShader&&) noexcept = delete;
+        ComputeShader& operator=(ComputeShader&&) noexcept = delete;
+        virtual ~ComputeShader(void) noexcept override = default;
+
+#pragma endregion
+
+    };
+
+}
@@ -0,0 +1,21 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include "DirectStateAccess.h"
+
+namespace silnith::wings::gl4
+{
+
+    bool HasDirectStateAccess(void) noexcept
+    {
+        /*
+         * The extension on its own only provides glNamedBufferStorage if
+         * immutable buffer storage is also available.
+         */
+        return GLEW_VERSION_4_5
+            || (GLEW_ARB_direct_state_access && (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage));
+    }
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// Returns whether the OpenGL implementation supports direct state access
+    /// and immutable buffer storage.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Both are core in OpenGL 4.5.  When they are available, the buffer,
+    /// vertex array, and transform feedback wrappers create their objects
+    /// with <c>glCreate*</c> and edit them by name, so nothing needs to be
+    /// bound just to be modified.  Otherwise they fall back to binding the
+    /// object, editing it, and unbinding it.
+    /// </para>
+    /// <para>
+    /// This must not be called before GLEW has been initialized, and the
+    /// answer never changes afterwards.  An object created under one answer
+    /// must never be used under the other.
+    /// </para>
+    /// </remarks>
+    /// <returns>Whether direct state access is used.</returns>
+    [[nodiscard]]
+    bool HasDirectStateAccess(void) noexcept;
+
+}
@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <span>
@@ -18,14 +20,12 @@ namespace silnith::wings::gl4
     {
         GLsizeiptr const dataSize{ static_cast<GLsizeiptr>(indexData.size_bytes()) };
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GetName());
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, dataSize, indexData.data(), usageHint);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        AllocateStorage(dataSize, indexData.data(), usageHint);
     }
 
-    void ElementArrayBuffer::UseAsElementArray() const
+    void ElementArrayBuffer::UseAsElementArray(VertexArray const& vertexArray) const
     {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, GetName());
+        vertexArray.UseElementArrayBuffer(GetName());
     }
 
     GLsizei ElementArrayBuffer::getNumIndices(void) const
@@ -1,11 +1,14 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <span>
 
 #include "Buffer.h"
+#include "VertexArray.h"
 
 namespace silnith::wings::gl4
 {
@@ -50,17 +53,19 @@ namespace silnith::wings::gl4
 
     public:
         /// <summary>
-        /// Makes this buffer the active buffer for <c>GL_ELEMENT_ARRAY_BUFFER</c>.
+        /// Makes this buffer the element array buffer of a vertex array.
         /// </summary>
         /// <example>
         /// <code>
-        /// ...;  // Bind the vertex attribute buffers.
+        /// ...;  // Set up the vertex attributes of vertexArray.
         /// ElementArrayBuffer elementArrayBuffer{ ... };
-        /// elementArrayBuffer.UseAsElementArray();
+        /// elementArrayBuffer.UseAsElementArray(vertexArray);
+        /// vertexArray.Bind(stateCache);
         /// glDrawElements(GL_TRIANGLE_FAN, elementArrayBuffer.getNumIndices(), elementArrayBuffer.getDataType(), elementArrayBuffer.getOffset());
         /// </code>
         /// </example>
-        void UseAsElementArray() const;
+        /// <param name="vertexArray">The vertex array to modify.</param>
+        void UseAsElementArray(VertexArray const& vertexArray) const;
 
         /// <summary>
         /// Returns the number of indices in the element array.
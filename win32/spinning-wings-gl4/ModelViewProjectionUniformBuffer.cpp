@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <array>
@@ -7,7 +9,9 @@
 #include <string>
 
 #include <cassert>
+#include <cstddef>
 
+#include "BufferArena.h"
 #include "ModelViewProjectionUniformBuffer.h"
 
 namespace silnith::wings::gl4
@@ -15,7 +19,7 @@ namespace silnith::wings::gl4
 
 	std::string const ModelViewProjectionUniformBuffer::uniformBlockDeclaration{
 		R"shaderText(
-uniform ModelViewProjection {
+layout(std140) uniform ModelViewProjection {
     mat4 model;
     mat4 view;
     mat4 projection;
@@ -23,52 +27,10 @@ uniform ModelViewProjection {
 )shaderText"
 	};
 
-	static GLsizei constexpr numUniforms{ 3 };
 	static constexpr GLchar const* uniformBlockName{ "ModelViewProjection" };
-	static std::array<GLchar const*, numUniforms> constexpr uniformVariableNames{ "model", "view", "projection" };
 
-	std::shared_ptr<ModelViewProjectionUniformBuffer const> ModelViewProjectionUniformBuffer::MakeBuffer(GLuint programName, GLuint bindingPoint)
+	std::shared_ptr<ModelViewProjectionUniformBuffer> ModelViewProjectionUniformBuffer::MakeBuffer(GLuint programName, GLuint bindingPoint)
 	{
-		/*
-		 * Find the locations (indices) of the components of the uniform block.
-		 */
-		std::array<GLuint, numUniforms> uniformIndices{ 0, 0, 0 };
-		glGetUniformIndices(programName, numUniforms, uniformVariableNames.data(), uniformIndices.data());
-
-		/*
-		 * For each index in the uniform block, find the data offset for that index.
-		 * This, finally, is the data offset we need to write to in order to set the
-		 * data for that component.
-		 */
-		std::array<GLint, numUniforms> uniformOffsets{ 0, 0, 0, };
-		glGetActiveUniformsiv(programName, numUniforms, uniformIndices.data(), GL_UNIFORM_OFFSET, uniformOffsets.data());
-		static_assert(uniformVariableNames[0] == "model");
-		GLintptr const modelOffset{ uniformOffsets[0] };
-		static_assert(uniformVariableNames[1] == "view");
-		GLintptr const viewOffset{ uniformOffsets[1] };
-		static_assert(uniformVariableNames[2] == "projection");
-		GLintptr const projectionOffset{ uniformOffsets[2] };
-
-#if !defined(NDEBUG)
-		/*
-		 * Confirm that the uniform variables are of the correct type.
-		 */
-		std::array<GLint, numUniforms> uniformTypes{ 0, 0, 0, };
-		glGetActiveUniformsiv(programName, numUniforms, uniformIndices.data(), GL_UNIFORM_TYPE, uniformTypes.data());
-		assert(uniformTypes[0] == GL_FLOAT_MAT4);
-		assert(uniformTypes[1] == GL_FLOAT_MAT4);
-		assert(uniformTypes[2] == GL_FLOAT_MAT4);
-
-		/*
-		 * The ModelViewProjectionUniformBuffer class will write the matrices as column-major.
-		 */
-		std::array<GLint, numUniforms> isRowMajor{ 0, 0, 0, };
-		glGetActiveUniformsiv(programName, numUniforms, uniformIndices.data(), GL_UNIFORM_IS_ROW_MAJOR, isRowMajor.data());
-		assert(isRowMajor[0] == 0);
-		assert(isRowMajor[1] == 0);
-		assert(isRowMajor[2] == 0);
-#endif
-
 		/*
 		 * Get the location (index) of the uniform block.
 		 */
@@ -78,40 +40,43 @@ uniform ModelViewProjection {
 			throw std::runtime_error{ std::string{ uniformBlockName } + " is not an active uniform block for the program object." };
 		}
 
+#if !defined(NDEBUG)
 		/*
-		 * Map the local index for the named uniform block to the
-		 * global binding point that the buffer is bound to.
+		 * The std140 layout makes the block exactly as large as the C++ struct.
 		 */
-		glUniformBlockBinding(programName, blockIndex, bindingPoint);
+		GLint modelViewProjectionUniformDataSize{ 0 };
+		glGetActiveUniformBlockiv(programName, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &modelViewProjectionUniformDataSize);
+		assert(modelViewProjectionUniformDataSize == sizeof(ModelViewProjectionBlock));
+#endif
 
 		/*
-		 * Find the data size required for the uniform block.
+		 * Map the local index for the named uniform block to the
+		 * global binding point that the buffer is bound to.
 		 */
-		GLint modelViewProjectionUniformDataSize{ 0 };
-		glGetActiveUniformBlockiv(programName, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &modelViewProjectionUniformDataSize);
+		glUniformBlockBinding(programName, blockIndex, bindingPoint);
 
 		/*
 		 * Allocate a buffer that can be bound for the uniform block.  Whatever
 		 * is written to this buffer will be available in the GLSL program as
 		 * the named uniform variables.
 		 */
-		return std::make_shared<ModelViewProjectionUniformBuffer const>(
-			bindingPoint,
-			modelViewProjectionUniformDataSize,
-			modelOffset, viewOffset, projectionOffset);
+		return std::make_shared<ModelViewProjectionUniformBuffer>(bindingPoint);
+	}
+
+	GLintptr ModelViewProjectionUniformBuffer::GetCopyStride(void)
+	{
+		GLintptr const alignment{ BufferArena::GetAlignment() };
+		GLintptr constexpr blockSize{ sizeof(ModelViewProjectionBlock) };
+
+		return (blockSize + alignment - 1) / alignment * alignment;
 	}
 
-	ModelViewProjectionUniformBuffer::ModelViewProjectionUniformBuffer(
-		GLuint bindingPoint,
-		GLsizei dataSize,
-		GLintptr modelOffset,
-		GLintptr viewOffset,
-		GLintptr projectionOffset)
+	ModelViewProjectionUniformBuffer::ModelViewProjectionUniformBuffer(GLuint bindingPoint)
 		: Buffer{},
 		bindingPoint{ bindingPoint },
-		modelOffset{ modelOffset },
-		viewOffset{ viewOffset },
-		projectionOffset{ projectionOffset }
+		copyStride{ GetCopyStride() },
+		block{},
+		currentCopy{ numCopies - 1 }
 	{
 		/*
 		 * The C++ syntax makes this look like it is row-major, but OpenGL will read it as column-major.
@@ -123,38 +88,26 @@ uniform ModelViewProjection {
 			0, 0, 1, 0,
 			0, 0, 0, 1,
 		};
-		GLsizeiptr constexpr identityDataSize{ sizeof(GLfloat) * identity.size() };
 
 		/*
-		 * This serves double-duty.  It binds this buffer as the currently
-		 * active uniform buffer, so subsequent buffer data will go into this
-		 * buffer.  It also binds this buffer to the specified uniform buffer
-		 * binding point, so program objects can map their local uniform
-		 * indices to the shared binding point.
-		 */
-		glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, GetName());
-		/*
-		 * First we need to allocate storage space for the uniform buffer.
-		 */
-		glBufferData(GL_UNIFORM_BUFFER, dataSize, nullptr, GL_STATIC_DRAW);
-		/*
-		 * Then we initialize the components of the uniform block.
-		 * Each component is initialized separately.
+		 * First we need to allocate storage space for every copy of the
+		 * uniform block.  The matrices are replaced whenever the window is
+		 * resized, so the storage must stay writable.
 		 */
-		glBufferSubData(GL_UNIFORM_BUFFER, modelOffset, identityDataSize, identity.data());
-		glBufferSubData(GL_UNIFORM_BUFFER, viewOffset, identityDataSize, identity.data());
+		AllocateStorage(copyStride * static_cast<GLsizeiptr>(numCopies), nullptr, GL_DYNAMIC_DRAW);
 		/*
 		 * The projection matrix is initialized here to the identity matrix.
 		 * It will be replaced with the real projection matrix later when the window is resized.
 		 */
-		glBufferSubData(GL_UNIFORM_BUFFER, projectionOffset, identityDataSize, identity.data());
+		block.model = identity;
+		block.view = identity;
+		block.projection = identity;
 		/*
-		 * Note that this only clears the binding of the generic uniform buffer
-		 * which is used for providing data.  It does not disturb the global
-		 * uniform buffer binding point, so programs that map their local
-		 * uniform block index to the global binding point will still work.
+		 * This also binds the first copy to the specified uniform buffer
+		 * binding point, so program objects can map their local uniform
+		 * indices to the shared binding point.
 		 */
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		WriteBlock();
 	}
 
 	ModelViewProjectionUniformBuffer::~ModelViewProjectionUniformBuffer(void) noexcept
@@ -189,28 +142,37 @@ uniform ModelViewProjection {
 		glUniformBlockBinding(programName, blockIndex, bindingPoint);
 	}
 
-	void ModelViewProjectionUniformBuffer::SetModelMatrix(std::array<GLfloat, 4 * 4> const& modelMatrix) const
+	void ModelViewProjectionUniformBuffer::SetModelMatrix(std::array<GLfloat, 4 * 4> const& modelMatrix)
 	{
-		SetMatrix(modelOffset, modelMatrix);
+		block.model = modelMatrix;
+		WriteBlock();
 	}
 
-	void ModelViewProjectionUniformBuffer::SetViewMatrix(std::array<GLfloat, 4 * 4> const& viewMatrix) const
+	void ModelViewProjectionUniformBuffer::SetViewMatrix(std::array<GLfloat, 4 * 4> const& viewMatrix)
 	{
-		SetMatrix(viewOffset, viewMatrix);
+		block.view = viewMatrix;
+		WriteBlock();
 	}
 
-	void ModelViewProjectionUniformBuffer::SetProjectionMatrix(std::array<GLfloat, 4 * 4> const& projectionMatrix) const
+	void ModelViewProjectionUniformBuffer::SetProjectionMatrix(std::array<GLfloat, 4 * 4> const& projectionMatrix)
 	{
-		SetMatrix(projectionOffset, projectionMatrix);
+		block.projection = projectionMatrix;
+		WriteBlock();
 	}
 
-	void ModelViewProjectionUniformBuffer::SetMatrix(GLintptr offset, std::array<GLfloat, 4 * 4> const& matrix) const
+	void ModelViewProjectionUniformBuffer::WriteBlock(void)
 	{
-		GLsizeiptr const dataSize{ static_cast<GLsizeiptr>(sizeof(GLfloat) * matrix.size()) };
+		/*
+		 * The copy after the one the GPU was last told to read has not been
+		 * bound since numCopies updates ago, so writing it does not have to
+		 * wait for any draw that is still in flight.
+		 */
+		currentCopy = (currentCopy + 1) % numCopies;
+		GLintptr const offset{ copyStride * static_cast<GLintptr>(currentCopy) };
+		GLsizeiptr constexpr blockSize{ sizeof(ModelViewProjectionBlock) };
 
-		glBindBuffer(GL_UNIFORM_BUFFER, GetName());
-		glBufferSubData(GL_UNIFORM_BUFFER, offset, dataSize, matrix.data());
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		ReplaceData(offset, blockSize, &block);
+		glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, GetName(), offset, blockSize);
 	}
 
 }
@@ -1,17 +1,56 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <array>
 #include <memory>
 #include <string>
 
+#include <cstddef>
+
 #include "Buffer.h"
 
 namespace silnith::wings::gl4
 {
 
+    /// <summary>
+    /// The contents of the <c>ModelViewProjection</c> uniform block, exactly
+    /// as the <c>std140</c> layout rules place them in a buffer.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Under <c>std140</c> a <c>mat4</c> is stored as four <c>vec4</c>
+    /// columns, each aligned to sixteen bytes, so the three matrices are
+    /// packed back to back with no padding.  The assertions below hold the
+    /// C++ layout to that.
+    /// </para>
+    /// </remarks>
+    struct ModelViewProjectionBlock
+    {
+        /// <summary>
+        /// The model matrix, in column-major order.
+        /// </summary>
+        std::array<GLfloat, 4 * 4> model{};
+
+        /// <summary>
+        /// The view matrix, in column-major order.
+        /// </summary>
+        std::array<GLfloat, 4 * 4> view{};
+
+        /// <summary>
+        /// The projection matrix, in column-major order.
+        /// </summary>
+        std::array<GLfloat, 4 * 4> projection{};
+    };
+
+    static_assert(offsetof(ModelViewProjectionBlock, model) == 0);
+    static_assert(offsetof(ModelViewProjectionBlock, view) == 64);
+    static_assert(offsetof(ModelViewProjectionBlock, projection) == 128);
+    static_assert(sizeof(ModelViewProjectionBlock) == 192);
+
     /// <summary>
     /// A class to reimplement the ModelView and Projection matrices that were
     /// removed from the OpenGL 3.2 Core profile.  The GLSL programs now take
@@ -20,7 +59,7 @@ namespace silnith::wings::gl4
     /// <example>
     /// The GLSL declaration for this is:
     /// <code>
-    /// uniform ModelViewProjection{
+    /// layout(std140) uniform ModelViewProjection{
     ///     mat4 model;
     ///     mat4 view;
     ///     mat4 projection;
@@ -32,6 +71,13 @@ namespace silnith::wings::gl4
     /// This implementation writes matrices to the buffer as column-major,
     /// which is historically what OpenGL expects.
     /// </para>
+    /// <para>
+    /// The buffer holds a small ring of copies of the uniform block.  Every
+    /// change writes the whole block into the next copy and binds that copy
+    /// to the binding point with <c>glBindBufferRange</c>, so an update never
+    /// has to wait for the GPU to finish reading a copy that an earlier frame
+    /// is still using.
+    /// </para>
     /// </remarks>
     class ModelViewProjectionUniformBuffer : public Buffer
     {
@@ -45,17 +91,17 @@ namespace silnith::wings::gl4
         /// <remarks>
         /// <para>
         /// Every shader that wants to use this uniform buffer should include
-        /// this declaration.  The default memory layout is <c>shared</c>,
-        /// which means every program that includes this can map to the same
-        /// uniform buffer binding point and read the uniform variables from
-        /// the same buffer.
+        /// this declaration.  The memory layout is <c>std140</c>, which fixes
+        /// the offsets of the matrices to those of <see cref="ModelViewProjectionBlock"/>
+        /// for every program and every implementation, so the buffer never
+        /// needs to ask a program where they are.
         /// </para>
         /// </remarks>
         static std::string const uniformBlockDeclaration;
 
         /// <summary>
-        /// Create and initialize a new uniform buffer by querying the memory
-        /// layout of the provide program object.  The program must include
+        /// Create and initialize a new uniform buffer for the provided program
+        /// object.  The program must include
         /// <see cref="uniformBlockDeclaration"/> in its shader source code,
         /// and must reference it so that the uniform is considered active.
         /// </summary>
@@ -69,14 +115,14 @@ namespace silnith::wings::gl4
         /// <param name="programName">The OpenGL name for the program object.</param>
         /// <returns>A newly-allocated uniform buffer.</returns>
         /// <exception cref="std::runtime_error">If there was any problem creating the buffer.</exception>
-        static std::shared_ptr<ModelViewProjectionUniformBuffer const> MakeBuffer(GLuint programName, GLuint bindingPoint);
+        static std::shared_ptr<ModelViewProjectionUniformBuffer> MakeBuffer(GLuint programName, GLuint bindingPoint);
 
 #pragma endregion
 
     public:
         /// <summary>
         /// Default constructor is deleted.  A uniform buffer is not valid
-        /// without knowing the offsets of its contents.
+        /// without a binding point.
         /// </summary>
         ModelViewProjectionUniformBuffer(void) = delete;
 
@@ -86,16 +132,7 @@ namespace silnith::wings::gl4
         /// <see cref="WingRenderProgram"/>.
         /// </summary>
         /// <param name="bindingPoint">The index of the global binding point that this buffer will use.</param>
-        /// <param name="dataSize">The buffer size needed for the entire uniform block.</param>
-        /// <param name="modelOffset">The offset within the buffer of the <c>model</c> matrix.</param>
-        /// <param name="viewOffset">The offset within the buffer of the <c>view</c> matrix.</param>
-        /// <param name="projectionOffset">The offset within the buffer of the <c>projection</c> matrix.</param>
-        explicit ModelViewProjectionUniformBuffer(
-            GLuint bindingPoint,
-            GLsizei dataSize,
-            GLintptr modelOffset,
-            GLintptr viewOffset,
-            GLintptr projectionOffset);
+        explicit ModelViewProjectionUniformBuffer(GLuint bindingPoint);
 
 #pragma region Rule of Five
 
@@ -130,37 +167,44 @@ namespace silnith::wings::gl4
         /// The matrix must be stored in column-major order.
         /// </summary>
         /// <param name="modelMatrix">The new value for the model matrix.</param>
-        void SetModelMatrix(std::array<GLfloat, 4 * 4> const& modelMatrix) const;
+        void SetModelMatrix(std::array<GLfloat, 4 * 4> const& modelMatrix);
 
         /// <summary>
         /// Replaces the current view matrix in the buffer with the new value.
         /// The matrix must be stored in column-major order.
         /// </summary>
         /// <param name="modelMatrix">The new value for the view matrix.</param>
-        void SetViewMatrix(std::array<GLfloat, 4 * 4> const& viewMatrix) const;
+        void SetViewMatrix(std::array<GLfloat, 4 * 4> const& viewMatrix);
 
         /// <summary>
         /// Replaces the current projection matrix in the buffer with the new value.
         /// The matrix must be stored in column-major order.
         /// </summary>
         /// <param name="modelMatrix">The new value for the projection matrix.</param>
-        void SetProjectionMatrix(std::array<GLfloat, 4 * 4> const& projectionMatrix) const;
+        void SetProjectionMatrix(std::array<GLfloat, 4 * 4> const& projectionMatrix);
 
     private:
         /// <summary>
-        /// Writes the provided matrix into the buffer at the given offset.
+        /// Returns the size of the uniform block rounded up to the uniform
+        /// buffer offset alignment, so that every copy in the ring can be
+        /// bound on its own.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// This is a convenience function for the public methods above,
-        /// because the code to write is the same for all of them.
-        /// </para>
-        /// </remarks>
-        /// <param name="offset">The offset inside the buffer where the matrix will be written.</param>
-        /// <param name="matrix">The matrix to write.</param>
-        void SetMatrix(GLintptr offset, std::array<GLfloat, 4 * 4> const& matrix) const;
+        /// <returns>The distance in bytes between consecutive copies.</returns>
+        [[nodiscard]]
+        static GLintptr GetCopyStride(void);
+
+        /// <summary>
+        /// Writes the whole uniform block into the next copy in the ring and
+        /// binds that copy to the binding point.
+        /// </summary>
+        void WriteBlock(void);
 
     private:
+        /// <summary>
+        /// The number of copies of the uniform block kept in the buffer.
+        /// </summary>
+        static std::size_t constexpr numCopies{ 3 };
+
         /// <summary>
         /// The binding point that this buffer will be bound to.
         /// </summary>
@@ -179,19 +223,20 @@ namespace silnith::wings::gl4
         GLuint const bindingPoint{ 0 };
 
         /// <summary>
-        /// The offset into the uniform buffer where the model matrix is.
+        /// The distance in bytes between consecutive copies of the uniform
+        /// block, rounded up to the uniform buffer offset alignment.
         /// </summary>
-        GLintptr const modelOffset{ 0 };
+        GLintptr const copyStride{ 0 };
 
         /// <summary>
-        /// The offset into the uniform buffer where the view matrix is.
+        /// The current contents of the uniform block.
         /// </summary>
-        GLintptr const viewOffset{ 0 };
+        ModelViewProjectionBlock block{};
 
         /// <summary>
-        /// The offset into the uniform buffer where the projection matrix is.
+        /// The copy of the uniform block currently bound to the binding point.
         /// </summary>
-        GLintptr const projectionOffset{ 0 };
+        std::size_t currentCopy{ 0 };
     };
 
 }
@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <initializer_list>
@@ -12,6 +14,7 @@
 
 #include "Program.h"
 
+#include "ComputeShader.h"
 #include "FragmentShader.h"
 #include "VertexShader.h"
 
@@ -227,6 +230,59 @@ namespace silnith::wings::gl4
         }
     }
 
+    Program::Program(std::initializer_list<std::shared_ptr<ComputeShader const> > computeShaders)
+        : name{ glCreateProgram() }, linkLog{}
+    {
+        if (name == 0)
+        {
+            throw std::runtime_error{ "Failed to create GLSL program object."s };
+        }
+
+        /*
+         * A compute program has no other stages, and nothing to bind before
+         * linking.  Its inputs and outputs are all buffers and uniforms.
+         */
+        for (std::shared_ptr<ComputeShader const> const& computeShader : computeShaders)
+        {
+            glAttachShader(name, computeShader->GetName());
+        }
+
+        glLinkProgram(name);
+
+        for (std::shared_ptr<ComputeShader const> const& computeShader : computeShaders)
+        {
+            glDetachShader(name, computeShader->GetName());
+        }
+
+        GLint logSize{ 0 };
+        glGetProgramiv(name, GL_INFO_LOG_LENGTH, &logSize);
+        if (logSize > 0) {
+            std::unique_ptr<GLchar[]> log{ std::make_unique<GLchar[]>(static_cast<std::size_t>(logSize)) };
+            glGetProgramInfoLog(name, static_cast<GLsizei>(logSize), nullptr, log.get());
+            linkLog = std::string{ log.get() };
+        }
+
+        GLint linkSuccess{ 0 };
+        glGetProgramiv(name, GL_LINK_STATUS, &linkSuccess);
+        switch (linkSuccess)
+        {
+        case GL_TRUE:
+            break;
+        case GL_FALSE:
+        {
+            glDeleteProgram(name);
+            throw std::runtime_error{ linkLog };
+        }
+        default:
+        {
+            glDeleteProgram(name);
+            std::ostringstream errorMessage{ "Unknown link status: "s };
+            errorMessage << linkSuccess;
+            throw std::runtime_error{ errorMessage.str() };
+        }
+        }
+    }
+
     Program::~Program(void) noexcept
     {
         /*
@@ -310,9 +366,12 @@ namespace silnith::wings::gl4
         return static_cast<GLint>(uniformLocation);
     }
 
-    void Program::useProgram(void) const
+    void Program::useProgram(silnith::wings::gl::GLStateCache& stateCache) const
     {
-        glUseProgram(name);
+        if (stateCache.ChangeProgram(name))
+        {
+            glUseProgram(name);
+        }
     }
 
 }
@@ -1,13 +1,17 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <initializer_list>
 #include <memory>
 #include <string>
 
+#include "ComputeShader.h"
 #include "FragmentShader.h"
+#include "GLStateCache.h"
 #include "VertexShader.h"
 
 namespace silnith::wings::gl4
@@ -56,6 +60,13 @@ namespace silnith::wings::gl4
             std::initializer_list<std::shared_ptr<FragmentShader const> > fragmentShaders,
             std::string const& fragmentData);
 
+        /// <summary>
+        /// Creates a GLSL program for general computation.
+        /// </summary>
+        /// <param name="computeShaders">The compute shaders to assemble.  Only one may define the <c>main</c> function.</param>
+        /// <exception cref="std::runtime_error">If the program fails to link.</exception>
+        explicit Program(std::initializer_list<std::shared_ptr<ComputeShader const> > computeShaders);
+
 #pragma region Rule of Five
 
     public:
@@ -101,10 +112,12 @@ namespace silnith::wings::gl4
         GLint getUniformLocation(std::string const& uniformName) const;
 
         /// <summary>
-        /// Installs the GLSL program as part of the current rendering state.
+        /// Installs the GLSL program as part of the current rendering state,
+        /// unless the state cache shows that it already is.
         /// </summary>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
         /// <exception cref="std::runtime_error">If the program could not be installed.</exception>
-        void useProgram(void) const;
+        void useProgram(silnith::wings::gl::GLStateCache& stateCache) const;
 
     private:
         /// <summary>
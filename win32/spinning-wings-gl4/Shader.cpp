@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <memory>
@@ -23,6 +25,12 @@ namespace silnith::wings::gl4
 )shaderText"
     };
 
+    std::string const Shader::computeVersionDeclaration{
+        R"shaderText(#version 430 core
+// Shader version 4.30 corresponds to OpenGL 4.3
+)shaderText"
+    };
+
     std::string const Shader::scaleMatrixFunctionDeclaration{
         R"shaderText(
 mat4 scale(const in vec3 factor);
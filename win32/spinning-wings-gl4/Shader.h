@@ -1,6 +1,8 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <initializer_list>
@@ -10,8 +12,8 @@ namespace silnith::wings::gl4
 {
 
     /// <summary>
-    /// Manages a single GLSL shader.  Use <c>FragmentShader</c>
-    /// or <c>VertexShader</c> instead.
+    /// Manages a single GLSL shader.  Use <c>ComputeShader</c>,
+    /// <c>FragmentShader</c>, or <c>VertexShader</c> instead.
     /// </summary>
     /// <remarks>
     /// <para>
@@ -42,6 +44,13 @@ namespace silnith::wings::gl4
         /// </remarks>
         static std::string const versionDeclaration;
 
+        /// <summary>
+        /// The GLSL 4.30 version declaration corresponding to OpenGL 4.3.
+        /// This is the first version with compute shaders and shader storage
+        /// blocks, so it is only used by <see cref="ComputeShader"/>.
+        /// </summary>
+        static std::string const computeVersionDeclaration;
+
         /// <summary>
         /// The GLSL function declaration for <c>scale</c>, which returns a
         /// transformation matrix that scales.
@@ -15,6 +15,7 @@
 #include <memory>
 #include <stdexcept>
 
+#include "Instrumentation.h"
 #include "WingsPixelFormat.h"
 #include "WingsViewGL4.h"
 
@@ -79,7 +80,10 @@ void CALLBACK AdvanceAnimation(HWND hWnd, UINT uMsg, UINT_PTR idEvent, DWORD dwT
 
 	assert(hglrc == wglGetCurrentContext());
 
-	silnith::wings::gl4::AdvanceAnimation();
+	{
+		silnith::wings::instrumentation::PhaseTimer const tickTimer{ silnith::wings::instrumentation::Phase::Tick };
+		silnith::wings::gl4::AdvanceAnimation();
+	}
 
 	HRGN constexpr hRegion{ nullptr };
 	BOOL constexpr eraseBackground{ FALSE };
@@ -311,7 +315,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-		silnith::wings::gl4::DrawFrame();
+		{
+			silnith::wings::instrumentation::PhaseTimer const frameTimer{ silnith::wings::instrumentation::Phase::Frame };
+			silnith::wings::gl4::DrawFrame();
+		}
 
 		PAINTSTRUCT paintstruct{};
 		HDC const hdc{ BeginPaint(hWnd, &paintstruct) };
@@ -319,7 +326,10 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 			return -1;
 		}
 
-		SwapBuffers(hdc);
+		{
+			silnith::wings::instrumentation::PhaseTimer const swapTimer{ silnith::wings::instrumentation::Phase::Swap };
+			SwapBuffers(hdc);
+		}
 
 		EndPaint(hWnd, &paintstruct);
 		return 0;
@@ -342,6 +352,8 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 
 		wglDeleteContext(hglrc);
 
+		silnith::wings::instrumentation::WriteReport();
+
 		PostQuitMessage(0);
 		return 0;
 	}
@@ -1,15 +1,26 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include "TransformFeedback.h"
 
+#include "DirectStateAccess.h"
+
 namespace silnith::wings::gl4
 {
     
     TransformFeedback::TransformFeedback(void)
         : name{ 0 }
     {
-        glGenTransformFeedbacks(1, &name);
+        if (HasDirectStateAccess())
+        {
+            glCreateTransformFeedbacks(1, &name);
+        }
+        else
+        {
+            glGenTransformFeedbacks(1, &name);
+        }
     }
 
     TransformFeedback::~TransformFeedback(void)
@@ -0,0 +1,108 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <cassert>
+
+#include "VertexArray.h"
+
+#include "DirectStateAccess.h"
+
+namespace silnith::wings::gl4
+{
+
+    VertexArray::VertexArray(void)
+    {
+        if (HasDirectStateAccess())
+        {
+            glCreateVertexArrays(1, &name);
+        }
+        else
+        {
+            glGenVertexArrays(1, &name);
+        }
+    }
+
+    VertexArray::~VertexArray(void) noexcept
+    {
+        glDeleteVertexArrays(1, &name);
+    }
+
+    GLuint VertexArray::GetName(void) const
+    {
+        return name;
+    }
+
+    void VertexArray::Bind(silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        if (stateCache.ChangeVertexArray(name))
+        {
+            glBindVertexArray(name);
+        }
+    }
+
+    void VertexArray::EnableAttribute(GLuint attributeLocation) const
+    {
+        if (HasDirectStateAccess())
+        {
+            glEnableVertexArrayAttrib(name, attributeLocation);
+        }
+        else
+        {
+            glBindVertexArray(name);
+            glEnableVertexAttribArray(attributeLocation);
+        }
+    }
+
+    void VertexArray::UseBufferForAttribute(GLuint attributeLocation, GLuint buffer,
+        GLint numComponents, GLenum dataType, GLboolean normalized,
+        GLsizei stride, GLintptr offset, GLuint divisor) const
+    {
+        /*
+         * A stride of zero means "tightly packed" to glVertexAttribPointer,
+         * but literally zero to glVertexArrayVertexBuffer.
+         */
+        assert(stride > 0);
+
+        if (HasDirectStateAccess())
+        {
+            glVertexArrayVertexBuffer(name, attributeLocation, buffer, offset, stride);
+            glVertexArrayAttribFormat(name, attributeLocation, numComponents, dataType, normalized, 0);
+            glVertexArrayAttribBinding(name, attributeLocation, attributeLocation);
+            glVertexArrayBindingDivisor(name, attributeLocation, divisor);
+        }
+        else
+        {
+            /*
+             * The currently-bound array buffer is captured as part of the
+             * state associated with a vertex attribute pointer.  Therefore,
+             * after the call to glVertexAttribPointer, the buffer can be
+             * unbound without affecting the stored state.
+             */
+            glBindVertexArray(name);
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glVertexAttribPointer(attributeLocation, numComponents, dataType, normalized, stride, reinterpret_cast<void const*>(offset));
+            glVertexAttribDivisor(attributeLocation, divisor);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    void VertexArray::UseElementArrayBuffer(GLuint buffer) const
+    {
+        if (HasDirectStateAccess())
+        {
+            glVertexArrayElementBuffer(name, buffer);
+        }
+        else
+        {
+            /*
+             * Unlike the array buffer, this binding is itself vertex array
+             * state, so it must stay bound.
+             */
+            glBindVertexArray(name);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer);
+        }
+    }
+
+}
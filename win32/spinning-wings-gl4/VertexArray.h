@@ -0,0 +1,104 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include "GLStateCache.h"
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// A class to manage an OpenGL vertex array object.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The vertex array records which attributes are enabled, which buffer
+    /// and format each one reads, and the element array buffer.  With
+    /// <see cref="HasDirectStateAccess"/> all of this is set by name.
+    /// Otherwise each setter binds the vertex array and leaves it bound, so
+    /// the caller must not rely on any other vertex array staying bound.
+    /// </para>
+    /// <para>
+    /// While drawing, bind the vertex array with <see cref="Bind"/> before
+    /// calling any setter.  The fallback then only rebinds the vertex array
+    /// that the state cache already knows is bound.
+    /// </para>
+    /// </remarks>
+    class VertexArray
+    {
+    public:
+        /// <summary>
+        /// Constructs a vertex array with no attributes enabled.
+        /// </summary>
+        explicit VertexArray(void);
+
+#pragma region Rule of Five
+
+    public:
+        VertexArray(VertexArray const&) = delete;
+        VertexArray& operator=(VertexArray const&) = delete;
+        VertexArray(VertexArray&&) noexcept = delete;
+        VertexArray& operator=(VertexArray&&) noexcept = delete;
+        virtual ~VertexArray(void) noexcept;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Returns the OpenGL name for the vertex array object.
+        /// </summary>
+        /// <returns>The vertex array object name.</returns>
+        [[nodiscard]]
+        GLuint GetName(void) const;
+
+        /// <summary>
+        /// Binds the vertex array for drawing, unless the state cache shows
+        /// that it already is.
+        /// </summary>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void Bind(silnith::wings::gl::GLStateCache& stateCache) const;
+
+        /// <summary>
+        /// Enables a generic vertex attribute.
+        /// </summary>
+        /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
+        void EnableAttribute(GLuint attributeLocation) const;
+
+        /// <summary>
+        /// Sets the buffer and format that a vertex attribute reads.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Each attribute gets the buffer binding index equal to its own
+        /// location, so attributes never share a binding.
+        /// </para>
+        /// </remarks>
+        /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
+        /// <param name="buffer">The name of the buffer object to read.</param>
+        /// <param name="numComponents">The number of components per value.</param>
+        /// <param name="dataType">The data type of each component.</param>
+        /// <param name="normalized">Whether fixed-point components are normalized.</param>
+        /// <param name="stride">The byte offset between consecutive values.  This must not be zero.</param>
+        /// <param name="offset">The byte offset of the first value within the buffer.</param>
+        /// <param name="divisor">Zero to advance once per vertex, or the number of instances for each value.</param>
+        void UseBufferForAttribute(GLuint attributeLocation, GLuint buffer,
+            GLint numComponents, GLenum dataType, GLboolean normalized,
+            GLsizei stride, GLintptr offset, GLuint divisor) const;
+
+        /// <summary>
+        /// Sets the buffer that indexed draws read their indices from.
+        /// </summary>
+        /// <param name="buffer">The name of the element array buffer.</param>
+        void UseElementArrayBuffer(GLuint buffer) const;
+
+    private:
+        /// <summary>
+        /// The OpenGL name for the vertex array object.
+        /// </summary>
+        GLuint name{ 0 };
+    };
+
+}
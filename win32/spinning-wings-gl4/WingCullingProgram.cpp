@@ -0,0 +1,200 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <cassert>
+
+#include "WingCullingProgram.h"
+
+#include "Program.h"
+
+#include "Buffer.h"
+#include "ComputeShader.h"
+#include "ModelViewProjectionUniformBuffer.h"
+#include "Shader.h"
+#include "WingCurveComputeProgram.h"
+#include "WingGeometry.h"
+#include "WingInstanceBuffer.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::gl4
+{
+
+    namespace
+    {
+        /// <summary>
+        /// The size of a <c>DrawElementsIndirectCommand</c>, which is five
+        /// unsigned integers.
+        /// </summary>
+        GLsizeiptr constexpr drawCommandSize{ 5 * sizeof(GLuint) };
+
+        /// <summary>
+        /// Maps the named uniform block of the program to a binding index.
+        /// </summary>
+        void BindUniformBlock(GLuint programName, GLchar const* blockName, GLuint bindingIndex)
+        {
+            GLuint const blockIndex{ glGetUniformBlockIndex(programName, blockName) };
+            if (blockIndex == GL_INVALID_INDEX)
+            {
+                throw std::runtime_error{ std::string{ blockName } + " is not an active uniform block for the program object." };
+            }
+            glUniformBlockBinding(programName, blockIndex, bindingIndex);
+        }
+    }
+
+    WingCullingProgram::WingCullingProgram(std::shared_ptr<WingGeometry const> wingGeometry, GLsizei capacity)
+        : Program{
+            std::initializer_list<std::shared_ptr<ComputeShader const> >{
+                std::make_shared<ComputeShader const>(std::initializer_list<std::string>{
+                    Shader::computeVersionDeclaration,
+                    R"shaderText(
+layout(local_size_x = 256) in;
+)shaderText",
+                    ModelViewProjectionUniformBuffer::uniformBlockDeclaration,
+                    R"shaderText(
+layout(std140) uniform SectionOffsets {
+    vec2 sectionOffsets[3];
+};
+
+layout(std430, binding = 3) readonly buffer RadiusAngles {
+    float radiusAngles[];
+};
+layout(std430, binding = 6) readonly buffer Anchors {
+    float wingAnchors[];
+};
+
+struct DrawElementsIndirectCommand {
+    uint count;
+    uint instanceCount;
+    uint firstIndex;
+    int baseVertex;
+    uint baseInstance;
+};
+
+layout(std430, binding = 7) writeonly buffer DrawCommands {
+    DrawElementsIndirectCommand commands[];
+};
+
+uniform uint numWings;
+uniform uint numIndices;
+
+/*
+ * The corners of the untransformed wing are (±1, ±1, 0), and the wing
+ * transformation is rigid, so this bounds every wing.  The slack covers the
+ * difference in rounding from the vertex shader.
+ */
+const float boundingRadius = sqrt(2.0) * 1.001;
+
+shared uint visibleCounts[256];
+
+bool isVisible(uint slot) {
+    float radius = radiusAngles[2u * slot + 0u];
+    float angle = radiusAngles[2u * slot + 1u];
+    vec3 anchor = vec3(wingAnchors[3u * slot + 0u],
+                       wingAnchors[3u * slot + 1u],
+                       wingAnchors[3u * slot + 2u]);
+    vec2 accumulatedDeltas = sectionOffsets[int(anchor[2])] - anchor.xy;
+    float theta = radians(angle + accumulatedDeltas[0]);
+    vec4 center = vec4(radius * cos(theta), radius * sin(theta), accumulatedDeltas[1], 1);
+
+    /*
+     * The projection is orthographic, so the view volume is the unit cube
+     * and a sphere maps to an ellipsoid whose extent along each axis is the
+     * radius times the length of that row of the matrix.
+     */
+    mat4 modelViewProjection = projection * view * model;
+    vec4 clip = modelViewProjection * center;
+    mat3 rows = transpose(mat3(modelViewProjection));
+    vec3 extent = boundingRadius * vec3(length(rows[0]), length(rows[1]), length(rows[2]));
+    return all(lessThanEqual(abs(clip.xyz / clip.w) - extent, vec3(1)));
+}
+
+void main() {
+    uint index = gl_LocalInvocationID.x;
+    uint numVisible = 0u;
+
+    for (uint first = 0u; first < numWings; first += 256u) {
+        uint slot = first + index;
+        bool visible = slot < numWings && isVisible(slot);
+
+        /*
+         * An inclusive prefix sum of the visibility within this step gives
+         * each visible wing its position among the commands.
+         */
+        visibleCounts[index] = visible ? 1u : 0u;
+        memoryBarrierShared();
+        barrier();
+        for (uint offset = 1u; offset < 256u; offset *= 2u) {
+            uint sum = visibleCounts[index];
+            if (index >= offset) {
+                sum += visibleCounts[index - offset];
+            }
+            barrier();
+            visibleCounts[index] = sum;
+            memoryBarrierShared();
+            barrier();
+        }
+
+        if (visible) {
+            commands[numVisible + visibleCounts[index] - 1u] = DrawElementsIndirectCommand(numIndices, 1u, 0u, 0, slot);
+        }
+        numVisible += visibleCounts[255];
+        barrier();
+    }
+
+    for (uint command = numVisible + index; command < numWings; command += 256u) {
+        commands[command] = DrawElementsIndirectCommand(0u, 0u, 0u, 0, 0u);
+    }
+}
+)shaderText",
+                }),
+            }
+        },
+        capacity{ capacity },
+        drawCommandBuffer{},
+        numWingsUniformLocation{ getUniformLocation("numWings"s) }
+    {
+        assert(capacity > 0);
+
+        glProgramUniform1ui(GetName(), getUniformLocation("numIndices"s), static_cast<GLuint>(wingGeometry->getNumIndices()));
+        BindUniformBlock(GetName(), "ModelViewProjection", modelViewProjectionBindingIndex);
+        BindUniformBlock(GetName(), "SectionOffsets", sectionOffsetsBindingIndex);
+
+        drawCommandBuffer.AllocateStorage(drawCommandSize * capacity, nullptr, GL_DYNAMIC_COPY);
+    }
+
+    void WingCullingProgram::CullWings(WingInstanceBuffer const& wingInstanceBuffer,
+        WingCurveComputeProgram const& wingCurveComputeProgram,
+        silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        assert(wingInstanceBuffer.getCapacity() == capacity);
+
+        useProgram(stateCache);
+
+        glUniform1ui(numWingsUniformLocation, static_cast<GLuint>(wingInstanceBuffer.getNumWings()));
+
+        wingCurveComputeProgram.UseSectionOffsets(sectionOffsetsBindingIndex);
+        wingInstanceBuffer.UseForShaderStorage(instanceBufferBindingIndex);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, drawCommandBindingIndex, drawCommandBuffer.GetName());
+
+        glDispatchCompute(1, 1, 1);
+
+        /*
+         * The draw commands are read by the indirect draws that follow.
+         */
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+    }
+
+    void WingCullingProgram::UseDrawCommands(void) const
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, drawCommandBuffer.GetName());
+    }
+
+}
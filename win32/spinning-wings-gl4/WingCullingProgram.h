@@ -0,0 +1,137 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <memory>
+
+#include "GLStateCache.h"
+#include "Program.h"
+
+#include "Buffer.h"
+#include "WingCurveComputeProgram.h"
+#include "WingGeometry.h"
+#include "WingInstanceBuffer.h"
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// The GLSL compute program that tests every wing against the view
+    /// volume and writes a draw command for each visible wing.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each wing is bounded by a sphere around its center.  The shader
+    /// transforms the center exactly as the vertex shader of
+    /// <see cref="WingInstancedRenderProgram"/> does, using the same uniform
+    /// blocks, and keeps the wing if the sphere reaches the orthographic
+    /// view volume.  Every visible wing gets one
+    /// <c>DrawElementsIndirectCommand</c> whose <c>baseInstance</c> is its
+    /// slot, so the instanced attributes are unchanged.
+    /// </para>
+    /// <para>
+    /// The commands are compacted in slot order, which is the order the
+    /// instanced draw uses, so culling never changes how overlapping outlines
+    /// blend.  That takes a prefix sum over the visibility of every wing,
+    /// so the program runs as a single work group that steps through the
+    /// slots.  The commands after the last visible wing are empty, so the
+    /// draw count is the number of wings and the CPU never reads the result.
+    /// </para>
+    /// <para>
+    /// This requires OpenGL 4.3, and a <see cref="WingCurveComputeProgram"/>
+    /// for the section offsets.
+    /// </para>
+    /// </remarks>
+    class WingCullingProgram : public Program
+    {
+    public:
+        /// <summary>
+        /// The uniform buffer binding index for the ModelViewProjection matrices.
+        /// </summary>
+        /// <seealso cref="WingInstancedRenderProgram::modelViewProjectionBindingIndex"/>
+        static GLuint constexpr modelViewProjectionBindingIndex{ 0 };
+
+        /// <summary>
+        /// The uniform buffer binding index for the section offsets.
+        /// </summary>
+        /// <seealso cref="WingInstancedRenderProgram::sectionOffsetsBindingIndex"/>
+        static GLuint constexpr sectionOffsetsBindingIndex{ 1 };
+
+        /// <summary>
+        /// The first of four consecutive shader storage binding indices for
+        /// the instance buffers.
+        /// </summary>
+        /// <seealso cref="WingInstanceBuffer::UseForShaderStorage"/>
+        static GLuint constexpr instanceBufferBindingIndex{ 3 };
+
+        /// <summary>
+        /// The shader storage binding index for the draw commands.
+        /// </summary>
+        static GLuint constexpr drawCommandBindingIndex{ 7 };
+
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  The culling program needs the
+        /// wing geometry for its draw commands.
+        /// </summary>
+        WingCullingProgram(void) = delete;
+
+        /// <summary>
+        /// Creates the program and a draw command buffer for the specified
+        /// number of wings.
+        /// </summary>
+        /// <param name="wingGeometry">The untransformed wing.</param>
+        /// <param name="capacity">The capacity of the <see cref="WingInstanceBuffer"/> that will be culled.</param>
+        /// <exception cref="std::runtime_error">If the program fails to compile or link.</exception>
+        explicit WingCullingProgram(std::shared_ptr<WingGeometry const> wingGeometry, GLsizei capacity);
+
+#pragma region Rule of Five
+
+        WingCullingProgram(WingCullingProgram const&) = delete;
+        WingCullingProgram& operator=(WingCullingProgram const&) = delete;
+        WingCullingProgram(WingCullingProgram&&) noexcept = delete;
+        WingCullingProgram& operator=(WingCullingProgram&&) noexcept = delete;
+        virtual ~WingCullingProgram(void) noexcept override = default;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Writes the draw commands for the visible wings.  This is a single
+        /// dispatch, and must be repeated whenever the wings, the section
+        /// offsets, or the projection change.
+        /// </summary>
+        /// <param name="wingInstanceBuffer">The wings to cull.</param>
+        /// <param name="wingCurveComputeProgram">The program holding the section offsets.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void CullWings(WingInstanceBuffer const& wingInstanceBuffer,
+            WingCurveComputeProgram const& wingCurveComputeProgram,
+            silnith::wings::gl::GLStateCache& stateCache) const;
+
+        /// <summary>
+        /// Binds the draw commands as the <c>GL_DRAW_INDIRECT_BUFFER</c>.
+        /// </summary>
+        void UseDrawCommands(void) const;
+
+    private:
+        /// <summary>
+        /// The capacity of the instance buffer, which is the number of draw
+        /// commands.
+        /// </summary>
+        GLsizei const capacity{ 0 };
+
+        /// <summary>
+        /// One <c>DrawElementsIndirectCommand</c> per slot.
+        /// </summary>
+        Buffer const drawCommandBuffer{};
+
+        /// <summary>
+        /// The location of the uniform variable <c>numWings</c>.
+        /// </summary>
+        GLint numWingsUniformLocation{ 0 };
+    };
+
+}
@@ -0,0 +1,340 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "WingCurveComputeProgram.h"
+
+#include "CurveGenerator.h"
+#include "Philox4x32.h"
+#include "Program.h"
+
+#include "Buffer.h"
+#include "ComputeShader.h"
+#include "Shader.h"
+#include "WingInstanceBuffer.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::gl4
+{
+
+    WingCurveComputeProgram::WingCurveComputeProgram(std::array<CurveGenerator<GLfloat> const*, numCurves> const& curves, GLsizei capacity)
+        : Program{
+            std::initializer_list<std::shared_ptr<ComputeShader const> >{
+                std::make_shared<ComputeShader const>(std::initializer_list<std::string>{
+                    Shader::computeVersionDeclaration,
+                    R"shaderText(
+/*
+ * One invocation per curve, in the order of the members of WingParameters.
+ */
+layout(local_size_x = 10) in;
+
+struct Curve {
+    uint keyLow;
+    uint keyHigh;
+    uint streamLow;
+    uint streamHigh;
+    uint blockCounterLow;
+    uint blockCounterHigh;
+    uint wordIndex;
+    uint ticks;
+    uint ticksPerAccelerationChange;
+    uint valueWraps;
+    float minimumValue;
+    float maximumValue;
+    float maximumVelocity;
+    float maximumAcceleration;
+    float value;
+    float velocity;
+    float acceleration;
+};
+
+layout(std430, binding = 0) buffer CurveStates {
+    Curve curves[];
+};
+
+layout(std430, binding = 1) buffer Accumulation {
+    dvec2 accumulated;
+    dvec2 anchors[3];
+    uint wingsInSection;
+    uint section;
+};
+
+layout(std140, binding = 2) writeonly buffer SectionOffsets {
+    vec2 sectionOffsets[3];
+};
+
+layout(std430, binding = 3) writeonly buffer RadiusAngles {
+    float radiusAngles[];
+};
+layout(std430, binding = 4) writeonly buffer RollPitchYaws {
+    float rollPitchYaws[];
+};
+layout(std430, binding = 5) writeonly buffer Colors {
+    float colors[];
+};
+layout(std430, binding = 6) writeonly buffer Anchors {
+    float wingAnchors[];
+};
+
+uniform uint capacity;
+uniform uint firstSlot;
+uniform uint numTicks;
+
+shared float values[10];
+
+/*
+ * Philox4x32-10, identical to Philox4x32::generateBlock.
+ */
+uvec4 generateBlock(uvec4 counter, uvec2 key) {
+    for (int round = 0; round < 10; round++) {
+        uint high0;
+        uint low0;
+        uint high1;
+        uint low1;
+        umulExtended(0xD2511F53u, counter[0], high0, low0);
+        umulExtended(0xCD9E8D57u, counter[2], high1, low1);
+        counter = uvec4(high1 ^ counter[1] ^ key[0],
+                        low1,
+                        high0 ^ counter[3] ^ key[1],
+                        low0);
+        key += uvec2(0x9E3779B9u, 0xBB67AE85u);
+    }
+    return counter;
+}
+
+/*
+ * The next word of the curve's stream, as Philox4x32::operator().
+ * The block is regenerated for each word, since a word is only drawn once
+ * per acceleration change.
+ */
+uint nextWord(inout Curve curve) {
+    uvec4 block = generateBlock(uvec4(curve.blockCounterLow, curve.blockCounterHigh,
+                                      curve.streamLow, curve.streamHigh),
+                                uvec2(curve.keyLow, curve.keyHigh));
+    uint word = block[curve.wordIndex];
+    curve.wordIndex++;
+    if (curve.wordIndex == 4u) {
+        curve.wordIndex = 0u;
+        curve.blockCounterLow++;
+        if (curve.blockCounterLow == 0u) {
+            curve.blockCounterHigh++;
+        }
+    }
+    return word;
+}
+
+/*
+ * A uniform float in [-maximumAcceleration, maximumAcceleration), from one
+ * word, as CurveGenerator::drawAcceleration.
+ */
+float nextAcceleration(inout Curve curve) {
+    precise float canonical = float(nextWord(curve)) * (1.0 / 4294967296.0);
+    if (canonical >= 1.0) {
+        canonical = uintBitsToFloat(0x3F7FFFFFu);
+    }
+    precise float lower = -curve.maximumAcceleration;
+    precise float range = curve.maximumAcceleration - lower;
+    precise float scaled = canonical * range;
+    return scaled + lower;
+}
+
+/*
+ * The same as std::fmod for |x| < 2 * range, which always holds because
+ * the value starts within range of the minimum and the velocity is less
+ * than the range.  Both subtractions are exact.
+ */
+float wrap(float x, float range) {
+    precise float result = x;
+    if (x >= range) {
+        result = x - range;
+    } else if (x <= -range) {
+        result = x + range;
+    }
+    return result;
+}
+
+/*
+ * CurveGenerator::advanceTick
+ */
+void advanceTick(inout Curve curve) {
+    curve.ticks++;
+    if (curve.ticks > curve.ticksPerAccelerationChange) {
+        curve.acceleration = nextAcceleration(curve);
+        curve.ticks = 0u;
+    }
+    precise float velocity = curve.velocity + curve.acceleration;
+    curve.velocity = clamp(velocity, -curve.maximumVelocity, curve.maximumVelocity);
+    precise float value = curve.value + curve.velocity;
+    if (curve.valueWraps != 0u) {
+        precise float range = curve.maximumValue - curve.minimumValue;
+        precise float offset = value - curve.minimumValue;
+        precise float wrapped = wrap(offset, range);
+        curve.value = wrapped + curve.minimumValue;
+    } else {
+        curve.value = clamp(value, curve.minimumValue, curve.maximumValue);
+    }
+}
+
+void main() {
+    uint index = gl_LocalInvocationID.x;
+    Curve curve = curves[index];
+
+    /*
+     * Only the first invocation touches the accumulated deltas, so they
+     * are kept in registers until the end.
+     */
+    dvec2 total = accumulated;
+    dvec2 sectionAnchors[3] = anchors;
+    uint count = wingsInSection;
+    uint current = section;
+
+    for (uint tick = 0u; tick < numTicks; tick++) {
+        advanceTick(curve);
+        values[index] = curve.value;
+        memoryBarrierShared();
+        barrier();
+
+        if (index == 0u) {
+            uint slot = (firstSlot + tick) % capacity;
+            radiusAngles[2u * slot + 0u] = values[0];
+            radiusAngles[2u * slot + 1u] = values[1];
+            rollPitchYaws[3u * slot + 0u] = values[4];
+            rollPitchYaws[3u * slot + 1u] = values[5];
+            rollPitchYaws[3u * slot + 2u] = values[6];
+            colors[3u * slot + 0u] = values[7];
+            colors[3u * slot + 1u] = values[8];
+            colors[3u * slot + 2u] = values[9];
+
+            /*
+             * AccumulatedDeltas::AddWing
+             */
+            if (count == 0u) {
+                current = (current + 1u) % 3u;
+                sectionAnchors[current] = total;
+            }
+            count = (count + 1u == capacity) ? 0u : count + 1u;
+            vec2 anchor = vec2(total - sectionAnchors[current]);
+            wingAnchors[3u * slot + 0u] = anchor[0];
+            wingAnchors[3u * slot + 1u] = anchor[1];
+            wingAnchors[3u * slot + 2u] = float(current);
+            total += dvec2(values[2], values[3]);
+        }
+        barrier();
+    }
+
+    curves[index] = curve;
+    if (index == 0u) {
+        accumulated = total;
+        anchors = sectionAnchors;
+        wingsInSection = count;
+        section = current;
+        for (int i = 0; i < 3; i++) {
+            sectionOffsets[i] = vec2(total - sectionAnchors[i]);
+        }
+    }
+}
+)shaderText",
+                }),
+            }
+        },
+        capacity{ capacity },
+        curveStateBuffer{},
+        accumulationBuffer{},
+        sectionOffsetsBuffer{},
+        firstSlotUniformLocation{ getUniformLocation("firstSlot"s) },
+        numTicksUniformLocation{ getUniformLocation("numTicks"s) }
+    {
+        static_assert(sizeof(CurveState) == 17 * 4);
+        static_assert(sizeof(AccumulationState) == 72);
+        assert(capacity > 0);
+
+        glProgramUniform1ui(GetName(), getUniformLocation("capacity"s), static_cast<GLuint>(capacity));
+
+        /*
+         * Each curve continues from exactly where its CPU generator left off,
+         * including the position in its random stream.
+         */
+        std::array<CurveState, numCurves> curveStates{};
+        for (std::size_t index{ 0 }; index < numCurves; index++)
+        {
+            CurveGenerator<GLfloat> const& curve{ *curves[index] };
+            Philox4x32 const& engine{ curve.getEngine() };
+            std::array<std::uint32_t, 2> const key{ engine.getKey() };
+            std::uint64_t const stream{ engine.getStream() };
+            std::uint64_t const offset{ engine.getOffset() };
+            std::uint64_t const blockCounter{ offset / 4 };
+            curveStates[index] = CurveState{
+                .keyLow = key[0],
+                .keyHigh = key[1],
+                .streamLow = static_cast<std::uint32_t>(stream),
+                .streamHigh = static_cast<std::uint32_t>(stream >> 32),
+                .blockCounterLow = static_cast<std::uint32_t>(blockCounter),
+                .blockCounterHigh = static_cast<std::uint32_t>(blockCounter >> 32),
+                .wordIndex = static_cast<std::uint32_t>(offset % 4),
+                .ticks = curve.getTicks(),
+                .ticksPerAccelerationChange = curve.getTicksPerAccelerationChange(),
+                .valueWraps = curve.isValueWraps() ? 1u : 0u,
+                .minimumValue = curve.getMinimumValue(),
+                .maximumValue = curve.getMaximumValue(),
+                .maximumVelocity = curve.getMaximumVelocity(),
+                .maximumAcceleration = curve.getMaximumAcceleration(),
+                .value = curve.getValue(),
+                .velocity = curve.getVelocity(),
+                .acceleration = curve.getAcceleration(),
+            };
+        }
+        AccumulationState const accumulationState{};
+
+        /*
+         * Only the GPU reads and writes these after this, hence DYNAMIC_COPY.
+         */
+        curveStateBuffer.AllocateStorage(sizeof(curveStates), curveStates.data(), GL_DYNAMIC_COPY);
+        accumulationBuffer.AllocateStorage(sizeof(accumulationState), &accumulationState, GL_DYNAMIC_COPY);
+        std::array<GLfloat, 4 * 3> const sectionOffsets{};
+        sectionOffsetsBuffer.AllocateStorage(sizeof(sectionOffsets), sectionOffsets.data(), GL_DYNAMIC_COPY);
+    }
+
+    void WingCurveComputeProgram::AdvanceCurves(WingInstanceBuffer& wingInstanceBuffer, GLsizei numTicks,
+        silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        assert(wingInstanceBuffer.getCapacity() == capacity);
+
+        GLsizei const firstSlot{ wingInstanceBuffer.ReserveSlots(numTicks) };
+
+        useProgram(stateCache);
+
+        glUniform1ui(firstSlotUniformLocation, static_cast<GLuint>(firstSlot));
+        glUniform1ui(numTicksUniformLocation, static_cast<GLuint>(numTicks));
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, curveStateBindingIndex, curveStateBuffer.GetName());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, accumulationBindingIndex, accumulationBuffer.GetName());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, sectionOffsetsBindingIndex, sectionOffsetsBuffer.GetName());
+        wingInstanceBuffer.UseForShaderStorage(instanceBufferBindingIndex);
+
+        glDispatchCompute(1, 1, 1);
+
+        /*
+         * The next dispatch reads the curve states, and the next frame reads
+         * the instance buffers as vertex attributes and the section offsets
+         * as a uniform block.
+         */
+        glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_UNIFORM_BARRIER_BIT);
+    }
+
+    void WingCurveComputeProgram::UseSectionOffsets(GLuint bindingIndex) const
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, bindingIndex, sectionOffsetsBuffer.GetName());
+    }
+
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "CurveGenerator.h"
+#include "GLStateCache.h"
+#include "Program.h"
+
+#include "Buffer.h"
+#include "WingInstanceBuffer.h"
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// The GLSL compute program that steps the curve generators on the GPU
+    /// and writes each new wing straight into a <see cref="WingInstanceBuffer"/>.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This is the same algorithm as <see cref="CurveGenerator"/>: the
+    /// acceleration is re-rolled every <c>ticksPerAccelerationChange</c>
+    /// ticks, the velocity is clamped, and the value is clamped or wrapped.
+    /// The random numbers come from the same <see cref="Philox4x32"/>
+    /// streams, which are counter-based, so the shader only needs the key,
+    /// stream, and offset of each engine to continue it.  The draw is mapped
+    /// to an acceleration by the same operations as
+    /// <see cref="CurveGenerator::drawAcceleration"/>, which does not depend
+    /// on the standard library, and every arithmetic step is <c>precise</c>,
+    /// so the GPU curves are identical to the CPU curves they were copied from.
+    /// </para>
+    /// <para>
+    /// The shader also does the work of <see cref="AccumulatedDeltas"/>,
+    /// in double precision, writing the anchor of each wing and the section
+    /// offsets.  The section offsets are a uniform block for
+    /// <see cref="WingInstancedRenderProgram"/>, so nothing is read back and
+    /// a tick costs a single dispatch.
+    /// </para>
+    /// <para>
+    /// This requires OpenGL 4.3.
+    /// </para>
+    /// </remarks>
+    class WingCurveComputeProgram : public Program
+    {
+    public:
+        /// <summary>
+        /// The number of curves, one per member of <see cref="WingParameters"/>.
+        /// </summary>
+        static std::size_t constexpr numCurves{ 10 };
+
+        /// <summary>
+        /// The shader storage binding index for the curve states.
+        /// </summary>
+        static GLuint constexpr curveStateBindingIndex{ 0 };
+
+        /// <summary>
+        /// The shader storage binding index for the accumulated deltas.
+        /// </summary>
+        static GLuint constexpr accumulationBindingIndex{ 1 };
+
+        /// <summary>
+        /// The shader storage binding index for the section offsets.
+        /// </summary>
+        static GLuint constexpr sectionOffsetsBindingIndex{ 2 };
+
+        /// <summary>
+        /// The first of four consecutive shader storage binding indices for
+        /// the instance buffers.
+        /// </summary>
+        /// <seealso cref="WingInstanceBuffer::UseForShaderStorage"/>
+        static GLuint constexpr instanceBufferBindingIndex{ 3 };
+
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  The program needs the curves to
+        /// continue.
+        /// </summary>
+        WingCurveComputeProgram(void) = delete;
+
+        /// <summary>
+        /// Creates the program and copies the current state of each curve
+        /// generator into GPU memory.
+        /// </summary>
+        /// <param name="curves">The curve generators, in the order of the members of <see cref="WingParameters"/>.</param>
+        /// <param name="capacity">The capacity of the <see cref="WingInstanceBuffer"/> that will be written.</param>
+        /// <exception cref="std::runtime_error">If the program fails to compile or link.</exception>
+        explicit WingCurveComputeProgram(std::array<CurveGenerator<GLfloat> const*, numCurves> const& curves, GLsizei capacity);
+
+#pragma region Rule of Five
+
+        WingCurveComputeProgram(WingCurveComputeProgram const&) = delete;
+        WingCurveComputeProgram& operator=(WingCurveComputeProgram const&) = delete;
+        WingCurveComputeProgram(WingCurveComputeProgram&&) noexcept = delete;
+        WingCurveComputeProgram& operator=(WingCurveComputeProgram&&) noexcept = delete;
+        virtual ~WingCurveComputeProgram(void) noexcept override = default;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Steps every curve the specified number of times, adding one wing
+        /// per tick to the instance buffer.  This is a single dispatch.
+        /// </summary>
+        /// <param name="wingInstanceBuffer">The instance buffer to write.</param>
+        /// <param name="numTicks">The number of ticks, no more than the capacity of the buffer.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void AdvanceCurves(WingInstanceBuffer& wingInstanceBuffer, GLsizei numTicks,
+            silnith::wings::gl::GLStateCache& stateCache) const;
+
+        /// <summary>
+        /// Binds the section offsets as a uniform buffer.  These contain a
+        /// <c>std140</c> array of three <c>vec2</c>.
+        /// </summary>
+        /// <param name="bindingIndex">The uniform buffer binding index.</param>
+        void UseSectionOffsets(GLuint bindingIndex) const;
+
+    private:
+        /// <summary>
+        /// The state of one curve, matching the <c>Curve</c> struct in the
+        /// shader.  Every member is four bytes, so the <c>std430</c> layout
+        /// has no padding.
+        /// </summary>
+        struct CurveState
+        {
+            std::uint32_t keyLow{ 0 };
+            std::uint32_t keyHigh{ 0 };
+            std::uint32_t streamLow{ 0 };
+            std::uint32_t streamHigh{ 0 };
+            std::uint32_t blockCounterLow{ 0 };
+            std::uint32_t blockCounterHigh{ 0 };
+            std::uint32_t wordIndex{ 0 };
+            std::uint32_t ticks{ 0 };
+            std::uint32_t ticksPerAccelerationChange{ 0 };
+            std::uint32_t valueWraps{ 0 };
+            GLfloat minimumValue{ 0 };
+            GLfloat maximumValue{ 0 };
+            GLfloat maximumVelocity{ 0 };
+            GLfloat maximumAcceleration{ 0 };
+            GLfloat value{ 0 };
+            GLfloat velocity{ 0 };
+            GLfloat acceleration{ 0 };
+        };
+
+        /// <summary>
+        /// The state of <see cref="AccumulatedDeltas"/>, matching the
+        /// <c>Accumulation</c> block in the shader.
+        /// </summary>
+        struct AccumulationState
+        {
+            double accumulatedAngle{ 0 };
+            double accumulatedZ{ 0 };
+            std::array<double, 2 * 3> anchors{};
+            std::uint32_t wingsInSection{ 0 };
+            std::uint32_t section{ 2 };
+        };
+
+        /// <summary>
+        /// The capacity of the instance buffer, which is also the section size
+        /// for the accumulated deltas.
+        /// </summary>
+        GLsizei const capacity{ 0 };
+
+        /// <summary>
+        /// One <see cref="CurveState"/> per curve.
+        /// </summary>
+        Buffer const curveStateBuffer{};
+
+        /// <summary>
+        /// One <see cref="AccumulationState"/>.
+        /// </summary>
+        Buffer const accumulationBuffer{};
+
+        /// <summary>
+        /// The section offsets, written by the shader and read by the render
+        /// program as a uniform block.
+        /// </summary>
+        Buffer const sectionOffsetsBuffer{};
+
+        /// <summary>
+        /// The location of the uniform variable <c>firstSlot</c>.
+        /// </summary>
+        GLint firstSlotUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the uniform variable <c>numTicks</c>.
+        /// </summary>
+        GLint numTicksUniformLocation{ 0 };
+    };
+
+}
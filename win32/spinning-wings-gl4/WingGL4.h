@@ -1,13 +1,12 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <memory>
-
+#include "AccumulatedDeltas.h"
 #include "Color.h"
-#include "ArrayBuffer.h"
-#include "WingTransformFeedback.h"
 
 namespace silnith::wings::gl4
 {
@@ -36,20 +35,20 @@ namespace silnith::wings::gl4
 	{
 	public:
 		/// <summary>
-		/// Default constructor is required by the STL containers.
+		/// Default constructor is required by <see cref="RingBuffer"/>.
 		/// </summary>
 		explicit Wing(void) = default;
 
 		/// <summary>
 		/// Creates a new wing with the provided parameters.
 		/// </summary>
-		/// <param name="deltaAngle">The additional angle around the central axis as the wing recedes into history.</param>
-		/// <param name="deltaZ">The additional height along the central axis as the wing recedes into history.</param>
+		/// <param name="anchor">The wing's anchor into the accumulated delta angle and delta Z.</param>
+		/// <param name="firstVertex">The index of the wing's first vertex within the captured buffers.</param>
 		explicit Wing(
-			std::shared_ptr<WingTransformFeedback const> transformFeedbackObject,
-			GLfloat deltaAngle, GLfloat deltaZ) noexcept
-			: transformFeedbackObject{ transformFeedbackObject },
-			deltaAngle{ deltaAngle }, deltaZ{ deltaZ }
+			AccumulatedDeltas<GLfloat>::Anchor const& anchor,
+			GLint firstVertex) noexcept
+			: anchor{ anchor },
+			firstVertex{ firstVertex }
 		{}
 
 	public:
@@ -61,39 +60,42 @@ namespace silnith::wings::gl4
 
 	public:
 		/// <summary>
-		/// Returns the OpenGL transform feedback object identifier for this wing.
+		/// Returns the wing's anchor into the accumulated delta angle and
+		/// delta Z of all the wings.
 		/// </summary>
-		/// <returns>The OpenGL transform feedback object identifier.</returns>
+		/// <returns>The anchor.</returns>
+		/// <seealso cref="AccumulatedDeltas::getAccumulatedDeltas"/>
 		[[nodiscard]]
-		inline std::shared_ptr<WingTransformFeedback const> getTransformFeedbackObject(void) const noexcept
+		inline AccumulatedDeltas<GLfloat>::Anchor const& getAnchor(void) const noexcept
 		{
-			return transformFeedbackObject;
+			return anchor;
 		}
 
 		/// <summary>
-		/// Returns the additional angle around the central axis that each subsequent wing should be rendered.
+		/// Replaces the anchor, so that the wing and its slot in the transform
+		/// feedback buffer can be reused for a newly-created wing.
 		/// </summary>
-		/// <returns>The additional angle that the wing gains as it recedes into history.</returns>
-		[[nodiscard]]
-		inline GLfloat getDeltaAngle(void) const noexcept
+		/// <param name="anchor">The anchor of the newly-created wing.</param>
+		inline void setAnchor(AccumulatedDeltas<GLfloat>::Anchor const& anchor) noexcept
 		{
-			return deltaAngle;
+			this->anchor = anchor;
 		}
 
 		/// <summary>
-		/// Returns the additional distance up the central axis that each subsequent wing should be rendered.
+		/// Returns the index of the wing's first vertex within the buffer of
+		/// the transform feedback object.  The buffer is shared by all of the
+		/// wings, each in its own slot.  A reused wing keeps its slot.
 		/// </summary>
-		/// <returns>The additional hight that the wing gains as it recedes into history.</returns>
+		/// <returns>The base vertex for drawing the wing.</returns>
 		[[nodiscard]]
-		inline GLfloat getDeltaZ(void) const noexcept
+		inline GLint getFirstVertex(void) const noexcept
 		{
-			return deltaZ;
+			return firstVertex;
 		}
 
 	private:
-		std::shared_ptr<WingTransformFeedback const> transformFeedbackObject{ nullptr };
-		GLfloat const deltaAngle{ 15 };
-		GLfloat const deltaZ{ 0.5 };
+		AccumulatedDeltas<GLfloat>::Anchor anchor{};
+		GLint firstVertex{ 0 };
 	};
 
 }
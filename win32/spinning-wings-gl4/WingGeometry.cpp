@@ -1,6 +1,12 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
+#include <span>
+
+#include <cassert>
+
 #include "WingGeometry.h"
 
 namespace silnith::wings::gl4
@@ -44,24 +50,24 @@ namespace silnith::wings::gl4
         // TODO: Find a way to static_assert that all indices point to valid vertices.
     }
 
-    std::shared_ptr<ArrayBuffer> WingGeometry::CreateBuffer(GLint numComponentsPerVertex) const
+    GLsizei WingGeometry::getNumVertices(void) const
     {
-        return std::make_shared<ArrayBuffer>(numComponentsPerVertex, getNumVertices(), GL_DYNAMIC_COPY);
+        return vertexArrayBuffer.getNumVertices();
     }
 
-    GLsizei WingGeometry::getNumVertices(void) const
+    GLsizei WingGeometry::getNumIndices(void) const
     {
-        return vertexArrayBuffer.getNumVertices();
+        return elementArrayBuffer.getNumIndices();
     }
 
-    void WingGeometry::UseForVertexAttribute(GLuint attributeLocation) const
+    void WingGeometry::UseForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation) const
     {
-        vertexArrayBuffer.UseForVertexAttribute(attributeLocation);
+        vertexArrayBuffer.UseForVertexAttribute(vertexArray, attributeLocation);
     }
 
-    void WingGeometry::UseElementArrayBuffer(void) const
+    void WingGeometry::UseElementArrayBuffer(VertexArray const& vertexArray) const
     {
-        elementArrayBuffer.UseAsElementArray();
+        elementArrayBuffer.UseAsElementArray(vertexArray);
     }
 
     void WingGeometry::RenderAsPoints(void) const
@@ -74,22 +80,74 @@ namespace silnith::wings::gl4
         glDrawArrays(GL_POINTS, 0, vertexArrayBuffer.getNumVertices());
     }
 
-    void WingGeometry::RenderAsPolygons(void) const
+    void WingGeometry::RenderAsPointsInstanced(GLsizei instanceCount) const
+    {
+        /*
+         * Transform feedback captures the vertices of each instance in
+         * order, so instance i lands at vertex i * numVertices.
+         */
+        glDrawArraysInstanced(GL_POINTS, 0, vertexArrayBuffer.getNumVertices(), instanceCount);
+    }
+
+    void WingGeometry::RenderAsPolygons(std::span<GLint const> baseVertices) const
     {
         /*
          * OpenGL 3.2 Core removed the quad primitive type.
          * Triangle fan is the closest approximation.
          */
-        glDrawElements(GL_TRIANGLE_FAN, elementArrayBuffer.getNumIndices(), elementArrayBuffer.getDataType(), elementArrayBuffer.getOffset());
+        MultiDrawFromBaseVertices(GL_TRIANGLE_FAN, baseVertices);
     }
 
-    void WingGeometry::RenderAsOutline(void) const
+    void WingGeometry::RenderAsOutline(std::span<GLint const> baseVertices) const
     {
         /*
          * Since OpenGL 3.2 Core does not support the quad primitive type,
          * we can no longer render as polygons using line mode.
          */
-        glDrawElements(GL_LINE_LOOP, elementArrayBuffer.getNumIndices(), elementArrayBuffer.getDataType(), elementArrayBuffer.getOffset());
+        MultiDrawFromBaseVertices(GL_LINE_LOOP, baseVertices);
+    }
+
+    void WingGeometry::RenderAsPolygonsInstanced(GLsizei instanceCount) const
+    {
+        glDrawElementsInstanced(GL_TRIANGLE_FAN, elementArrayBuffer.getNumIndices(), elementArrayBuffer.getDataType(), elementArrayBuffer.getOffset(), instanceCount);
+    }
+
+    void WingGeometry::RenderAsOutlineInstanced(GLsizei instanceCount) const
+    {
+        glDrawElementsInstanced(GL_LINE_LOOP, elementArrayBuffer.getNumIndices(), elementArrayBuffer.getDataType(), elementArrayBuffer.getOffset(), instanceCount);
+    }
+
+    void WingGeometry::RenderAsPolygonsIndirect(GLsizei drawCount) const
+    {
+        /*
+         * The commands index from the start of the element array, so it must
+         * not be offset within its buffer.
+         */
+        assert(elementArrayBuffer.getOffset() == nullptr);
+        glMultiDrawElementsIndirect(GL_TRIANGLE_FAN, elementArrayBuffer.getDataType(), nullptr, drawCount, 0);
+    }
+
+    void WingGeometry::RenderAsOutlineIndirect(GLsizei drawCount) const
+    {
+        assert(elementArrayBuffer.getOffset() == nullptr);
+        glMultiDrawElementsIndirect(GL_LINE_LOOP, elementArrayBuffer.getDataType(), nullptr, drawCount, 0);
+    }
+
+    void WingGeometry::MultiDrawFromBaseVertices(GLenum mode, std::span<GLint const> baseVertices) const
+    {
+        if (baseVertices.empty())
+        {
+            return;
+        }
+
+        if (indexCounts.size() < baseVertices.size())
+        {
+            indexCounts.resize(baseVertices.size(), elementArrayBuffer.getNumIndices());
+            indexOffsets.resize(baseVertices.size(), elementArrayBuffer.getOffset());
+        }
+
+        glMultiDrawElementsBaseVertex(mode, indexCounts.data(), elementArrayBuffer.getDataType(), indexOffsets.data(),
+            static_cast<GLsizei>(baseVertices.size()), baseVertices.data());
     }
 
 }
@@ -0,0 +1,175 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include <cassert>
+#include <cstddef>
+
+#include "WingInstanceBuffer.h"
+
+#include "AccumulatedDeltas.h"
+#include "BufferArena.h"
+#include "VertexArray.h"
+
+namespace silnith::wings::gl4
+{
+
+    namespace
+    {
+        /// <summary>
+        /// The position of each instance array within the arena.
+        /// </summary>
+        std::size_t constexpr radiusAngleSlice{ 0 };
+        std::size_t constexpr rollPitchYawSlice{ 1 };
+        std::size_t constexpr colorSlice{ 2 };
+        std::size_t constexpr anchorSlice{ 3 };
+
+        /// <summary>
+        /// The number of floats per slot in each instance array, by slice.
+        /// </summary>
+        std::array<GLint, 4> constexpr numComponents{ 2, 3, 3, 3 };
+
+        /// <summary>
+        /// Returns the size in bytes of an instance array.
+        /// </summary>
+        GLsizeiptr constexpr SliceSize(std::size_t slice, GLsizei capacity)
+        {
+            return static_cast<GLsizeiptr>(sizeof(GLfloat)) * numComponents[slice] * capacity;
+        }
+
+        /// <summary>
+        /// Overwrites one slot of an instance array.
+        /// </summary>
+        void ReplaceSlot(BufferArena const& arena, std::size_t slice, GLsizei slot, std::span<GLfloat const> values)
+        {
+            BufferSlice const& bufferSlice{ arena.getSlice(slice) };
+            GLsizeiptr const slotSize{ static_cast<GLsizeiptr>(values.size_bytes()) };
+            assert(slotSize * (slot + 1) <= bufferSlice.size);
+            arena.ReplaceData(bufferSlice.offset + slotSize * slot, slotSize, values.data());
+        }
+    }
+
+    WingInstanceBuffer::WingInstanceBuffer(GLsizei capacity)
+        : capacity{ capacity },
+        numWings{ 0 },
+        newestSlot{ capacity - 1 },
+        arena{ {
+                SliceSize(radiusAngleSlice, capacity),
+                SliceSize(rollPitchYawSlice, capacity),
+                SliceSize(colorSlice, capacity),
+                SliceSize(anchorSlice, capacity),
+            }, GL_DYNAMIC_DRAW },
+        accumulatedDeltas{ static_cast<std::size_t>(capacity) }
+    {
+        assert(capacity > 0);
+    }
+
+    void WingInstanceBuffer::AddWing(GLfloat radius, GLfloat angle,
+        GLfloat deltaAngle, GLfloat deltaZ,
+        GLfloat roll, GLfloat pitch, GLfloat yaw,
+        GLfloat red, GLfloat green, GLfloat blue)
+    {
+        /*
+         * The slots fill in order, so while the ring is filling the occupied
+         * slots are always the first ones.  Once it is full, the slot after
+         * the newest wing holds the oldest wing, which is replaced.
+         */
+        newestSlot = (newestSlot + 1 == capacity) ? 0 : newestSlot + 1;
+        if (numWings < capacity)
+        {
+            numWings++;
+        }
+
+        /*
+         * Adding the wing moves every older wing at once, so nothing but the
+         * new wing's own slot is written.
+         */
+        AccumulatedDeltas<GLfloat>::Anchor const anchor{ accumulatedDeltas.AddWing(deltaAngle, deltaZ) };
+
+        ReplaceSlot(arena, radiusAngleSlice, newestSlot, std::array<GLfloat const, 2>{ radius, angle });
+        ReplaceSlot(arena, rollPitchYawSlice, newestSlot, std::array<GLfloat const, 3>{ roll, pitch, yaw });
+        ReplaceSlot(arena, colorSlice, newestSlot, std::array<GLfloat const, 3>{ red, green, blue });
+        ReplaceSlot(arena, anchorSlice, newestSlot, std::array<GLfloat const, 3>{ anchor.angle, anchor.z, static_cast<GLfloat>(anchor.section) });
+    }
+
+    GLsizei WingInstanceBuffer::ReserveSlots(GLsizei count) noexcept
+    {
+        assert(count > 0);
+        assert(count <= capacity);
+
+        GLsizei const firstSlot{ (newestSlot + 1 == capacity) ? 0 : newestSlot + 1 };
+        newestSlot = (firstSlot + count - 1) % capacity;
+        numWings = std::min(numWings + count, capacity);
+        return firstSlot;
+    }
+
+    void WingInstanceBuffer::Clear(void) noexcept
+    {
+        numWings = 0;
+        newestSlot = capacity - 1;
+        accumulatedDeltas.Clear();
+    }
+
+    void WingInstanceBuffer::UseForInstanceAttributes(VertexArray const& vertexArray,
+        GLuint radiusAngleAttributeLocation,
+        GLuint rollPitchYawAttributeLocation,
+        GLuint colorAttributeLocation,
+        GLuint anchorAttributeLocation,
+        silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        auto const useForInstanceAttribute{ [this, &vertexArray, &stateCache](GLuint attributeLocation, std::size_t slice) -> void
+            {
+                silnith::wings::gl::GLStateCache::VertexAttributePointer const pointer{
+                    .buffer = arena.GetName(),
+                    .size = numComponents[slice],
+                    .type = GL_FLOAT,
+                    .normalized = GL_FALSE,
+                    .stride = static_cast<GLsizei>(sizeof(GLfloat)) * numComponents[slice],
+                    .offset = arena.getSlice(slice).offset,
+                    .divisor = 1,
+                };
+                if (stateCache.ChangeVertexAttribute(vertexArray.GetName(), attributeLocation, pointer))
+                {
+                    vertexArray.UseBufferForAttribute(attributeLocation, pointer.buffer,
+                        pointer.size, pointer.type, pointer.normalized,
+                        pointer.stride, pointer.offset, pointer.divisor);
+                }
+            } };
+
+        useForInstanceAttribute(radiusAngleAttributeLocation, radiusAngleSlice);
+        useForInstanceAttribute(rollPitchYawAttributeLocation, rollPitchYawSlice);
+        useForInstanceAttribute(colorAttributeLocation, colorSlice);
+        useForInstanceAttribute(anchorAttributeLocation, anchorSlice);
+    }
+
+    void WingInstanceBuffer::UseForShaderStorage(GLuint firstBindingIndex) const
+    {
+        for (std::size_t slice : { radiusAngleSlice, rollPitchYawSlice, colorSlice, anchorSlice })
+        {
+            BufferSlice const& bufferSlice{ arena.getSlice(slice) };
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, firstBindingIndex + static_cast<GLuint>(slice),
+                bufferSlice.buffer, bufferSlice.offset, bufferSlice.size);
+        }
+    }
+
+    GLsizei WingInstanceBuffer::getCapacity(void) const noexcept
+    {
+        return capacity;
+    }
+
+    GLsizei WingInstanceBuffer::getNumWings(void) const noexcept
+    {
+        return numWings;
+    }
+
+    std::array<GLfloat, 2 * AccumulatedDeltas<GLfloat>::numSections> WingInstanceBuffer::getSectionOffsets(void) const noexcept
+    {
+        return accumulatedDeltas.getSectionOffsets();
+    }
+
+}
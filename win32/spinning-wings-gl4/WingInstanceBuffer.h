@@ -0,0 +1,201 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <array>
+
+#include "AccumulatedDeltas.h"
+#include "BufferArena.h"
+#include "GLStateCache.h"
+#include "VertexArray.h"
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// The per-wing parameters for rendering every wing with a single
+    /// instanced draw call.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each wing occupies one slot in a fixed set of instance arrays, which
+    /// are slices of a single <see cref="BufferArena"/>.  Setting up all four
+    /// instanced attributes binds one buffer, and the compute programs bind
+    /// ranges of it.  The slots are used as a ring: a new wing takes the slot
+    /// after the newest wing, which is the slot of the oldest wing once the
+    /// ring is full.
+    /// Nothing is ever reallocated, so the capacity can be made very large.
+    /// </para>
+    /// <para>
+    /// The delta angle and delta Z of each wing accumulate from the newest
+    /// wing to the oldest.  Rather than recomputing that sum for every wing,
+    /// each slot stores the wing's <see cref="AccumulatedDeltas::Anchor"/>
+    /// as another instance attribute, written once when the wing is added.
+    /// The vertex shader subtracts it from the section offsets, which are a
+    /// single uniform per frame, so it never needs to know the order of the
+    /// slots.
+    /// </para>
+    /// <para>
+    /// A <see cref="WingCurveComputeProgram"/> can instead write the slots
+    /// directly on the GPU, after <see cref="ReserveSlots"/> advances the
+    /// ring.  It then keeps the anchors and section offsets itself, and
+    /// <see cref="getSectionOffsets"/> is not used.
+    /// </para>
+    /// </remarks>
+    class WingInstanceBuffer
+    {
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  The instance arrays cannot be
+        /// allocated without knowing the number of wings.
+        /// </summary>
+        WingInstanceBuffer(void) = delete;
+
+        /// <summary>
+        /// Allocates instance arrays for the specified number of wings.
+        /// </summary>
+        /// <param name="capacity">The maximum number of wings.</param>
+        explicit WingInstanceBuffer(GLsizei capacity);
+
+#pragma region Rule of Five
+
+    public:
+        WingInstanceBuffer(WingInstanceBuffer const&) = delete;
+        WingInstanceBuffer& operator=(WingInstanceBuffer const&) = delete;
+        WingInstanceBuffer(WingInstanceBuffer&&) noexcept = delete;
+        WingInstanceBuffer& operator=(WingInstanceBuffer&&) noexcept = delete;
+        ~WingInstanceBuffer(void) noexcept = default;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Adds a new wing as the newest wing.  If the ring is full, the
+        /// oldest wing is discarded.
+        /// </summary>
+        /// <param name="radius">The radius of the wing around the central axis.</param>
+        /// <param name="angle">The angle of the wing around the central axis.</param>
+        /// <param name="deltaAngle">The additional angle around the central axis as the wing recedes into history.</param>
+        /// <param name="deltaZ">The additional height along the central axis as the wing recedes into history.</param>
+        /// <param name="roll">The roll of the wing.</param>
+        /// <param name="pitch">The pitch of the wing.</param>
+        /// <param name="yaw">The yaw of the wing.</param>
+        /// <param name="red">The red component of the wing color.</param>
+        /// <param name="green">The green component of the wing color.</param>
+        /// <param name="blue">The blue component of the wing color.</param>
+        void AddWing(GLfloat radius, GLfloat angle,
+            GLfloat deltaAngle, GLfloat deltaZ,
+            GLfloat roll, GLfloat pitch, GLfloat yaw,
+            GLfloat red, GLfloat green, GLfloat blue);
+
+        /// <summary>
+        /// Advances the ring by the specified number of wings without writing
+        /// their slots, for a shader that writes them instead.  If the ring
+        /// is full, the oldest wings are discarded.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The new wings occupy consecutive slots modulo the capacity,
+        /// oldest first.
+        /// </para>
+        /// </remarks>
+        /// <param name="count">The number of new wings, no more than the capacity.</param>
+        /// <returns>The slot of the first, oldest, of the new wings.</returns>
+        GLsizei ReserveSlots(GLsizei count) noexcept;
+
+        /// <summary>
+        /// Discards all of the wings.
+        /// </summary>
+        void Clear(void) noexcept;
+
+        /// <summary>
+        /// Configures the instanced vertex attributes of a vertex array.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The instance arrays never move within the arena, so the attributes
+        /// are only set the first time for each vertex array.
+        /// </para>
+        /// </remarks>
+        /// <param name="vertexArray">The vertex array to modify.</param>
+        /// <param name="radiusAngleAttributeLocation">The location of the <c>vec2</c> radius and angle attribute.</param>
+        /// <param name="rollPitchYawAttributeLocation">The location of the <c>vec3</c> roll, pitch, and yaw attribute.</param>
+        /// <param name="colorAttributeLocation">The location of the <c>vec3</c> color attribute.</param>
+        /// <param name="anchorAttributeLocation">The location of the <c>vec3</c> accumulated deltas anchor attribute.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void UseForInstanceAttributes(VertexArray const& vertexArray,
+            GLuint radiusAngleAttributeLocation,
+            GLuint rollPitchYawAttributeLocation,
+            GLuint colorAttributeLocation,
+            GLuint anchorAttributeLocation,
+            silnith::wings::gl::GLStateCache& stateCache) const;
+
+        /// <summary>
+        /// Binds the instance arrays to consecutive shader storage buffer
+        /// binding points, in the order radius and angle, roll, pitch, and
+        /// yaw, color, and anchor.
+        /// </summary>
+        /// <param name="firstBindingIndex">The binding point for the radius and angle array.</param>
+        void UseForShaderStorage(GLuint firstBindingIndex) const;
+
+        /// <summary>
+        /// Returns the maximum number of wings.
+        /// </summary>
+        /// <returns>The number of slots.</returns>
+        [[nodiscard]]
+        GLsizei getCapacity(void) const noexcept;
+
+        /// <summary>
+        /// Returns the number of wings currently in the ring.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The occupied slots are always the first ones, so this is also the
+        /// instance count for the draw calls.
+        /// </para>
+        /// </remarks>
+        /// <returns>The number of wings to render.</returns>
+        [[nodiscard]]
+        GLsizei getNumWings(void) const noexcept;
+
+        /// <summary>
+        /// Returns the current accumulated delta angle and delta Z relative
+        /// to each section, for the <c>sectionOffsets</c> uniform.
+        /// </summary>
+        /// <returns>Pairs of (delta angle, delta Z), one pair per section.</returns>
+        /// <seealso cref="AccumulatedDeltas::getSectionOffsets"/>
+        [[nodiscard]]
+        std::array<GLfloat, 2 * AccumulatedDeltas<GLfloat>::numSections> getSectionOffsets(void) const noexcept;
+
+    private:
+        /// <summary>
+        /// The maximum number of wings.
+        /// </summary>
+        GLsizei const capacity{ 0 };
+
+        /// <summary>
+        /// The number of wings currently in the ring.
+        /// </summary>
+        GLsizei numWings{ 0 };
+
+        /// <summary>
+        /// The slot of the newest wing.
+        /// </summary>
+        GLsizei newestSlot{ 0 };
+
+        /// <summary>
+        /// The instance arrays, one slice each, in the order radius and
+        /// angle, roll, pitch, and yaw, color, and anchor.
+        /// </summary>
+        BufferArena const arena;
+
+        /// <summary>
+        /// The delta angle and delta Z accumulated by the wings.
+        /// </summary>
+        AccumulatedDeltas<GLfloat> accumulatedDeltas;
+    };
+
+}
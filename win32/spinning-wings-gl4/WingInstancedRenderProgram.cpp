@@ -0,0 +1,395 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <cassert>
+
+#include "WingInstancedRenderProgram.h"
+
+#include "AccumulatedDeltas.h"
+#include "Instrumentation.h"
+#include "Program.h"
+
+#include "WingCullingProgram.h"
+#include "WingCurveComputeProgram.h"
+#include "WingGeometry.h"
+#include "WingInstanceBuffer.h"
+
+#include "RotateVertexShader.h"
+#include "TranslateVertexShader.h"
+#include "VertexShader.h"
+#include "FragmentShader.h"
+#include "Shader.h"
+#include "ModelViewProjectionUniformBuffer.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::gl4
+{
+
+    WingInstancedRenderProgram::WingInstancedRenderProgram(std::shared_ptr<WingGeometry const> wingGeometry,
+        std::shared_ptr<RotateVertexShader const> rotateMatrixShader,
+        std::shared_ptr<TranslateVertexShader const> translateMatrixShader,
+        bool sectionOffsetsInUniformBlock,
+        bool singlePass)
+        : Program{
+            std::initializer_list<std::shared_ptr<VertexShader const> >{
+                std::make_shared<VertexShader const>(std::initializer_list<std::string>{
+                    Shader::versionDeclaration,
+                    ModelViewProjectionUniformBuffer::uniformBlockDeclaration,
+                    R"shaderText(
+uniform bool outline = false;
+uniform vec3 edgeColor = vec3(1, 1, 1);
+
+in vec4 vertex;
+
+in vec2 radiusAngle;
+in vec3 rollPitchYaw;
+in vec3 color;
+in vec3 anchor;
+)shaderText",
+                    sectionOffsetsInUniformBlock
+                    ? R"shaderText(
+layout(std140) uniform SectionOffsets {
+    vec2 sectionOffsets[3];
+};
+)shaderText"s
+                    : R"shaderText(
+uniform vec2 sectionOffsets[3];
+)shaderText"s,
+                    R"shaderText(
+smooth out vec4 varyingColor;
+noperspective out vec2 quadCoordinate;
+
+const vec3 xAxis = vec3(1, 0, 0);
+const vec3 yAxis = vec3(0, 1, 0);
+const vec3 zAxis = vec3(0, 0, 1);
+)shaderText",
+                    rotateMatrixShader->GetDeclaration(),
+                    translateMatrixShader->GetDeclaration(),
+                    R"shaderText(
+void main() {
+    float radius = radiusAngle[0];
+    float angle = radiusAngle[1];
+    float roll = rollPitchYaw[0];
+    float pitch = rollPitchYaw[1];
+    float yaw = rollPitchYaw[2];
+    /*
+     * The accumulated deltas of this wing and every newer wing.
+     * See AccumulatedDeltas for why this is a difference.
+     */
+    vec2 accumulatedDeltas = sectionOffsets[int(anchor[2])] - anchor.xy;
+    float deltaAngle = accumulatedDeltas[0];
+    float dZ = accumulatedDeltas[1];
+
+    mat4 wingTransformation = rotate(angle, zAxis)
+                              * translate(vec3(radius, 0, 0))
+                              * rotate(-yaw, zAxis)
+                              * rotate(-pitch, yAxis)
+                              * rotate(roll, xAxis);
+
+    mat4 modelViewProjection = projection * view * model;
+
+    if (outline) {
+        varyingColor = vec4(edgeColor, 1);
+    } else {
+        varyingColor = vec4(color, 1);
+    }
+    quadCoordinate = vertex.xy;
+    gl_Position = modelViewProjection
+                  * translate(vec3(0, 0, dZ))
+                  * rotate(deltaAngle, zAxis)
+                  * wingTransformation
+                  * vertex;
+}
+)shaderText",
+                }),
+                rotateMatrixShader,
+                translateMatrixShader,
+            },
+            std::initializer_list<std::shared_ptr<FragmentShader const> >{
+                std::make_shared<FragmentShader const>(std::initializer_list<std::string>{
+                    Shader::versionDeclaration,
+                    singlePass
+                    ? R"shaderText(
+uniform vec3 edgeColor = vec3(1, 1, 1);
+
+smooth in vec4 varyingColor;
+noperspective in vec2 quadCoordinate;
+
+out vec4 fragmentColor;
+
+void main() {
+    /*
+     * The edges of the untransformed wing are where either coordinate
+     * reaches one.  Dividing by the length of the screen-space gradient of
+     * each coordinate turns the distance to each edge into pixels.
+     */
+    vec2 unitsPerPixel = vec2(length(vec2(dFdx(quadCoordinate.x), dFdy(quadCoordinate.x))),
+                              length(vec2(dFdx(quadCoordinate.y), dFdy(quadCoordinate.y))));
+    vec2 edgeDistance = (1 - abs(quadCoordinate)) / unitsPerPixel;
+    /*
+     * The outline pass draws a smoothed line one pixel wide centered on the
+     * edge, but only the inside of the wing is rasterized here.  Moving the
+     * line half a pixel inward keeps all of it, so the edges are as bright.
+     */
+    float edgeCoverage = clamp(1.5 - min(edgeDistance.x, edgeDistance.y), 0, 1);
+    fragmentColor = vec4(mix(varyingColor.rgb, edgeColor, edgeCoverage), 1);
+}
+)shaderText"s
+                    : R"shaderText(
+smooth in vec4 varyingColor;
+
+out vec4 fragmentColor;
+
+void main() {
+    fragmentColor = varyingColor;
+}
+)shaderText"s,
+                }),
+            },
+            "fragmentColor"
+        },
+        sectionOffsetsInUniformBlock{ sectionOffsetsInUniformBlock },
+        singlePass{ singlePass },
+        wingGeometry{ wingGeometry },
+        modelViewProjectionUniformBuffer{ nullptr },
+        vertexArray{},
+        outlineUniformLocation{ getUniformLocation("outline"s) },
+        sectionOffsetsUniformLocation{ sectionOffsetsInUniformBlock ? -1 : getUniformLocation("sectionOffsets"s) },
+        vertexAttributeLocation{ getAttributeLocation("vertex"s) },
+        radiusAngleAttributeLocation{ getAttributeLocation("radiusAngle"s) },
+        rollPitchYawAttributeLocation{ getAttributeLocation("rollPitchYaw"s) },
+        colorAttributeLocation{ getAttributeLocation("color"s) },
+        anchorAttributeLocation{ getAttributeLocation("anchor"s) }
+    {
+        vertexArray.EnableAttribute(vertexAttributeLocation);
+        vertexArray.EnableAttribute(radiusAngleAttributeLocation);
+        vertexArray.EnableAttribute(rollPitchYawAttributeLocation);
+        vertexArray.EnableAttribute(colorAttributeLocation);
+        vertexArray.EnableAttribute(anchorAttributeLocation);
+        wingGeometry->UseForVertexAttribute(vertexArray, vertexAttributeLocation);
+        wingGeometry->UseElementArrayBuffer(vertexArray);
+
+        modelViewProjectionUniformBuffer = ModelViewProjectionUniformBuffer::MakeBuffer(GetName(), modelViewProjectionBindingIndex);
+
+        if (sectionOffsetsInUniformBlock)
+        {
+            GLuint const blockIndex{ glGetUniformBlockIndex(GetName(), "SectionOffsets") };
+            if (blockIndex == GL_INVALID_INDEX)
+            {
+                throw std::runtime_error{ "SectionOffsets is not an active uniform block for the program object."s };
+            }
+            glUniformBlockBinding(GetName(), blockIndex, sectionOffsetsBindingIndex);
+        }
+
+        /*
+         * Set up the initial camera position.
+         */
+        glm::mat4 const view{ glm::lookAt(
+            glm::vec3{ 0, 50, 50 },
+            glm::vec3{ 0, 0, 13 },
+            glm::vec3{ 0, 0, 1 }) };
+
+        std::array<GLfloat, 4 * 4> viewMatrix{};
+        GLfloat const* const viewData{ glm::value_ptr(view) };
+        std::copy(viewData, viewData + viewMatrix.size(), viewMatrix.begin());
+
+        modelViewProjectionUniformBuffer->SetViewMatrix(viewMatrix);
+    }
+
+    void WingInstancedRenderProgram::RenderWings(WingInstanceBuffer const& wingInstanceBuffer,
+        silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        assert(!sectionOffsetsInUniformBlock);
+
+        useProgram(stateCache);
+
+        /*
+         * Every wing's accumulated deltas are derived from its own anchor
+         * and these, so this single upload moves all of the wings.
+         */
+        std::array<GLfloat, 2 * AccumulatedDeltas<GLfloat>::numSections> const sectionOffsets{ wingInstanceBuffer.getSectionOffsets() };
+        glUniform2fv(sectionOffsetsUniformLocation, AccumulatedDeltas<GLfloat>::numSections, sectionOffsets.data());
+
+        Draw(wingInstanceBuffer, nullptr, stateCache);
+    }
+
+    void WingInstancedRenderProgram::RenderWings(WingInstanceBuffer const& wingInstanceBuffer,
+        WingCurveComputeProgram const& wingCurveComputeProgram,
+        WingCullingProgram const& wingCullingProgram,
+        silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        assert(sectionOffsetsInUniformBlock);
+
+        useProgram(stateCache);
+
+        /*
+         * The compute program already wrote the section offsets, so they
+         * only need to be bound.
+         */
+        wingCurveComputeProgram.UseSectionOffsets(sectionOffsetsBindingIndex);
+
+        Draw(wingInstanceBuffer, &wingCullingProgram, stateCache);
+    }
+
+    void WingInstancedRenderProgram::Draw(WingInstanceBuffer const& wingInstanceBuffer, WingCullingProgram const* wingCullingProgram,
+        silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        GLsizei const numWings{ wingInstanceBuffer.getNumWings() };
+
+        vertexArray.Bind(stateCache);
+
+        /*
+         * The contents of the instance buffers change as wings are added, but
+         * the buffers themselves do not, so the attributes are only set on
+         * the first frame.
+         */
+        wingInstanceBuffer.UseForInstanceAttributes(vertexArray,
+            radiusAngleAttributeLocation,
+            rollPitchYawAttributeLocation,
+            colorAttributeLocation,
+            anchorAttributeLocation,
+            stateCache);
+
+        if (wingCullingProgram != nullptr)
+        {
+            wingCullingProgram->UseDrawCommands();
+        }
+
+        instrumentation::PhaseTimer fillTimer{ instrumentation::Phase::FillPass };
+        glUniform1i(outlineUniformLocation, GL_FALSE);
+        if (wingCullingProgram != nullptr)
+        {
+            wingGeometry->RenderAsPolygonsIndirect(numWings);
+        }
+        else
+        {
+            wingGeometry->RenderAsPolygonsInstanced(numWings);
+        }
+        fillTimer.Stop();
+
+        /*
+         * In a single pass the fragment shader already blended in the edges,
+         * so there is no second draw and no depth or blend state to change.
+         */
+        if (!singlePass)
+        {
+            instrumentation::PhaseTimer outlineTimer{ instrumentation::Phase::OutlinePass };
+            stateCache.DepthFunc(GL_LEQUAL);
+            stateCache.DepthMask(GL_FALSE);
+            stateCache.Enable(GL_BLEND);
+            glUniform1i(outlineUniformLocation, GL_TRUE);
+            if (wingCullingProgram != nullptr)
+            {
+                wingGeometry->RenderAsOutlineIndirect(numWings);
+            }
+            else
+            {
+                wingGeometry->RenderAsOutlineInstanced(numWings);
+            }
+            stateCache.Disable(GL_BLEND);
+            stateCache.DepthMask(GL_TRUE);
+            stateCache.DepthFunc(GL_LESS);
+            outlineTimer.Stop();
+        }
+
+        if (wingCullingProgram != nullptr)
+        {
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        }
+    }
+
+    void WingInstancedRenderProgram::Ortho(GLfloat const width, GLfloat const height) const
+    {
+        /*
+         * These multipliers account for the aspect ratio of the window, so that
+         * the rendering does not distort.  The conditional is so that the larger
+         * number is always divided by the smaller, resulting in a multiplier no
+         * less than one.  This way, the viewing area is always expanded rather than
+         * contracted, and the expected viewing frustum is never clipped.
+         */
+        GLfloat xmult{ 1.0 };
+        GLfloat ymult{ 1.0 };
+        if (width > height)
+        {
+            xmult = width / height;
+        }
+        else
+        {
+            ymult = height / width;
+        }
+
+        /*
+         * The view frustum was hand-selected to match the parameters to the
+         * curve generators and the initial camera position.
+         */
+        GLfloat constexpr defaultLeft{ -20 };
+        GLfloat constexpr defaultRight{ 20 };
+        GLfloat constexpr defaultBottom{ -20 };
+        GLfloat constexpr defaultTop{ 20 };
+        GLfloat constexpr defaultNear{ 35 };
+        GLfloat constexpr defaultFar{ 105 };
+
+        GLfloat const left{ defaultLeft * xmult };
+        GLfloat const right{ defaultRight * xmult };
+        GLfloat const bottom{ defaultBottom * ymult };
+        GLfloat const top{ defaultTop * ymult };
+        GLfloat const nearZ{ defaultNear };
+        GLfloat const farZ{ defaultFar };
+
+        GLfloat const viewWidth{ right - left };
+        GLfloat const viewHeight{ top - bottom };
+        GLfloat const viewDepth{ farZ - nearZ };
+
+        assert(viewWidth > 0);
+        assert(viewHeight > 0);
+        assert(viewDepth > 0);
+
+        /*
+         * Set up the projection matrix.
+         * The projection matrix is only used for the viewing frustum.
+         * Things like camera position belong in the modelview matrix.
+         */
+        std::array<GLfloat, 4 * 4> const projection{
+            // column 0
+            static_cast<GLfloat>(2) / viewWidth,
+            0,
+            0,
+            0,
+
+            // column 1
+            0,
+            static_cast<GLfloat>(2) / viewHeight,
+            0,
+            0,
+
+            // column 2
+            0,
+            0,
+            static_cast<GLfloat>(-2) / viewDepth,
+            0,
+
+            // column 3
+            -(right + left) / viewWidth,
+            -(top + bottom) / viewHeight,
+            -(farZ + nearZ) / viewDepth,
+            static_cast<GLfloat>(1),
+        };
+
+        modelViewProjectionUniformBuffer->SetProjectionMatrix(projection);
+    }
+
+}
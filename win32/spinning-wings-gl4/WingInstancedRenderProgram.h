@@ -0,0 +1,217 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <memory>
+
+#include "GLStateCache.h"
+#include "Program.h"
+
+#include "WingCullingProgram.h"
+#include "WingCurveComputeProgram.h"
+#include "WingGeometry.h"
+#include "WingInstanceBuffer.h"
+#include "ModelViewProjectionUniformBuffer.h"
+#include "RotateVertexShader.h"
+#include "TranslateVertexShader.h"
+#include "VertexShader.h"
+#include "VertexArray.h"
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// The GLSL program that renders all the wings using instanced draw calls.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Unlike <see cref="WingRenderProgram"/>, this does not use transform
+    /// feedback.  The vertex shader transforms the wing geometry directly
+    /// using the per-wing parameters in a <see cref="WingInstanceBuffer"/>,
+    /// so each rendering pass is a single draw call regardless of the
+    /// number of wings.
+    /// </para>
+    /// <para>
+    /// The section offsets are normally a uniform array uploaded with each
+    /// frame.  When the wings are written by a
+    /// <see cref="WingCurveComputeProgram"/>, they are instead a uniform block
+    /// sourced from its buffer, so they never pass through the CPU.  The
+    /// wings are then drawn with the indirect commands written by a
+    /// <see cref="WingCullingProgram"/>, so wings outside the view are
+    /// skipped entirely.
+    /// </para>
+    /// <para>
+    /// Normally the outlines are a second pass of line loops drawn over the
+    /// filled wings.  In single-pass mode the fragment shader instead
+    /// measures the distance to the edge of the wing in pixels and blends in
+    /// the edge color itself, so each wing is drawn once and the depth and
+    /// blend state never change.  This only draws the half of each outline
+    /// that falls inside its wing, and a wing seen exactly edge-on has no
+    /// outline at all.
+    /// </para>
+    /// </remarks>
+    class WingInstancedRenderProgram : public Program
+    {
+    public:
+        /// <summary>
+        /// The uniform buffer binding index for the ModelViewProjection matrices.
+        /// </summary>
+        /// <seealso cref="WingRenderProgram::modelViewProjectionBindingIndex"/>
+        static GLuint constexpr modelViewProjectionBindingIndex{ 0 };
+
+        /// <summary>
+        /// The uniform buffer binding index for the section offsets, when
+        /// they are a uniform block.
+        /// </summary>
+        static GLuint constexpr sectionOffsetsBindingIndex{ 1 };
+
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  The render program requires the
+        /// wing geometry and utility shaders that are shared between multiple
+        /// programs.
+        /// </summary>
+        WingInstancedRenderProgram(void) = delete;
+
+        /// <summary>
+        /// Creates the render program.
+        /// </summary>
+        /// <param name="wingGeometry">The untransformed wing.</param>
+        /// <param name="rotateMatrixShader">The shader providing <c>rotate</c>.</param>
+        /// <param name="translateMatrixShader">The shader providing <c>translate</c>.</param>
+        /// <param name="sectionOffsetsInUniformBlock">Whether the section offsets come from a <see cref="WingCurveComputeProgram"/>.</param>
+        /// <param name="singlePass">Whether the fragment shader draws the outlines along with the fill.</param>
+        explicit WingInstancedRenderProgram(std::shared_ptr<WingGeometry const> wingGeometry,
+            std::shared_ptr<RotateVertexShader const> rotateMatrixShader,
+            std::shared_ptr<TranslateVertexShader const> translateMatrixShader,
+            bool sectionOffsetsInUniformBlock = false,
+            bool singlePass = false);
+
+#pragma region Rule of Five
+
+        WingInstancedRenderProgram(WingInstancedRenderProgram const&) = delete;
+        WingInstancedRenderProgram& operator=(WingInstancedRenderProgram const&) = delete;
+        WingInstancedRenderProgram(WingInstancedRenderProgram&&) noexcept = delete;
+        WingInstancedRenderProgram& operator=(WingInstancedRenderProgram&&) noexcept = delete;
+        virtual ~WingInstancedRenderProgram(void) noexcept override = default;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Renders all of the wings in the provided instance buffer.
+        /// </summary>
+        /// <param name="wingInstanceBuffer">The wings to render.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void RenderWings(WingInstanceBuffer const& wingInstanceBuffer,
+            silnith::wings::gl::GLStateCache& stateCache) const;
+
+        /// <summary>
+        /// Renders the visible wings in the provided instance buffer, which
+        /// were written by the provided compute program.  The program must
+        /// have been created with the section offsets in a uniform block.
+        /// </summary>
+        /// <param name="wingInstanceBuffer">The wings to render.</param>
+        /// <param name="wingCurveComputeProgram">The program holding the section offsets.</param>
+        /// <param name="wingCullingProgram">The program holding the draw commands for the visible wings.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void RenderWings(WingInstanceBuffer const& wingInstanceBuffer,
+            WingCurveComputeProgram const& wingCurveComputeProgram,
+            WingCullingProgram const& wingCullingProgram,
+            silnith::wings::gl::GLStateCache& stateCache) const;
+
+        /// <summary>
+        /// Sets up the orthographic projection that transforms modelview coordinates
+        /// into normalized device coordinates.
+        /// This takes into account the aspect ratio of the viewport.
+        /// </summary>
+        /// <param name="width">The viewport width.</param>
+        /// <param name="height">The viewport height.</param>
+        void Ortho(GLfloat const width, GLfloat const height) const;
+
+    private:
+        /// <summary>
+        /// Draws the fill and outline passes, or just the one pass in
+        /// single-pass mode.  The program must be in use
+        /// and the section offsets set.
+        /// </summary>
+        /// <param name="wingInstanceBuffer">The wings to render.</param>
+        /// <param name="wingCullingProgram">The program holding the draw commands, or <c>nullptr</c> to draw every wing.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void Draw(WingInstanceBuffer const& wingInstanceBuffer, WingCullingProgram const* wingCullingProgram,
+            silnith::wings::gl::GLStateCache& stateCache) const;
+
+    private:
+        /// <summary>
+        /// Whether the section offsets are a uniform block rather than a
+        /// uniform array.
+        /// </summary>
+        bool const sectionOffsetsInUniformBlock{ false };
+
+        /// <summary>
+        /// Whether the fragment shader draws the outlines, so there is no
+        /// outline pass.
+        /// </summary>
+        bool const singlePass{ false };
+
+        /// <summary>
+        /// A pointer to the wing geometry object.
+        /// </summary>
+        std::shared_ptr<WingGeometry const> wingGeometry{ nullptr };
+
+        /// <summary>
+        /// The uniform buffer for the ModelViewProjection matrices.
+        /// </summary>
+        std::shared_ptr<ModelViewProjectionUniformBuffer> modelViewProjectionUniformBuffer{ nullptr };
+
+        /// <summary>
+        /// The vertex array used for rendering.
+        /// This maintains the state of the enabled vertex attributes and
+        /// their divisors, as well as the binding for the ELEMENT_ARRAY_BUFFER.
+        /// </summary>
+        VertexArray const vertexArray{};
+
+        /// <summary>
+        /// The location of the uniform variable <c>outline</c>.
+        /// </summary>
+        /// <seealso cref="glUniform1i"/>
+        GLint outlineUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the uniform variable <c>sectionOffsets</c>, or
+        /// <c>-1</c> if it is in a uniform block.
+        /// </summary>
+        /// <seealso cref="glUniform2fv"/>
+        /// <seealso cref="WingInstanceBuffer::getSectionOffsets"/>
+        GLint sectionOffsetsUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the vertex attribute <c>vertex</c>.
+        /// </summary>
+        GLuint vertexAttributeLocation{ 0 };
+
+        /// <summary>
+        /// The location of the instanced vertex attribute <c>radiusAngle</c>.
+        /// </summary>
+        GLuint radiusAngleAttributeLocation{ 0 };
+
+        /// <summary>
+        /// The location of the instanced vertex attribute <c>rollPitchYaw</c>.
+        /// </summary>
+        GLuint rollPitchYawAttributeLocation{ 0 };
+
+        /// <summary>
+        /// The location of the instanced vertex attribute <c>color</c>.
+        /// </summary>
+        GLuint colorAttributeLocation{ 0 };
+
+        /// <summary>
+        /// The location of the instanced vertex attribute <c>anchor</c>.
+        /// </summary>
+        GLuint anchorAttributeLocation{ 0 };
+    };
+
+}
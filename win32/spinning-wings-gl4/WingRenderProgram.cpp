@@ -1,4 +1,6 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <glm/glm.hpp>
@@ -6,14 +8,17 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <array>
-#include <deque>
 #include <initializer_list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "WingRenderProgram.h"
 
+#include "AccumulatedDeltas.h"
+#include "Instrumentation.h"
 #include "Program.h"
+#include "RingBuffer.h"
 
 #include "WingGeometry.h"
 #include "WingGL4.h"
@@ -40,12 +45,16 @@ namespace silnith::wings::gl4
                     Shader::versionDeclaration,
                     ModelViewProjectionUniformBuffer::uniformBlockDeclaration,
                     R"shaderText(
-uniform vec2 deltaZ = vec2(15, 0.5);
+uniform vec2 sectionOffsets[3];
+
+uniform bool outline = false;
+uniform vec3 edgeColor = vec3(1, 1, 1);
 
 in vec4 vertex;
 in vec4 color;
+in vec3 anchor;
 
-smooth out vec4 varyingColor;
+flat out vec4 varyingColor;
 
 const vec3 xAxis = vec3(1, 0, 0);
 const vec3 yAxis = vec3(0, 1, 0);
@@ -55,12 +64,21 @@ const vec3 zAxis = vec3(0, 0, 1);
                     translateMatrixShader->GetDeclaration(),
                     R"shaderText(
 void main() {
-    float deltaAngle = deltaZ[0];
-    float dZ = deltaZ[1];
+    /*
+     * The accumulated deltas of this wing and every newer wing.
+     * See AccumulatedDeltas for why this is a difference.
+     */
+    vec2 accumulatedDeltas = sectionOffsets[int(anchor[2])] - anchor.xy;
+    float deltaAngle = accumulatedDeltas[0];
+    float dZ = accumulatedDeltas[1];
 
     mat4 modelViewProjection = projection * view * model;
 
-    varyingColor = color;
+    if (outline) {
+        varyingColor = vec4(edgeColor, 1);
+    } else {
+        varyingColor = color;
+    }
     gl_Position = modelViewProjection
                   * translate(vec3(0, 0, dZ))
                   * rotate(deltaAngle, zAxis)
@@ -75,7 +93,7 @@ void main() {
                 std::make_shared<FragmentShader const>(std::initializer_list<std::string>{
                     Shader::versionDeclaration,
                     R"shaderText(
-smooth in vec4 varyingColor;
+flat in vec4 varyingColor;
 
 out vec4 fragmentColor;
 
@@ -89,18 +107,18 @@ void main() {
         },
         wingGeometry{ wingGeometry },
         modelViewProjectionUniformBuffer{ nullptr },
-        vertexArray{ 0 },
-        deltaZUniformLocation{ getUniformLocation("deltaZ"s) },
+        vertexArray{},
+        sectionOffsetsUniformLocation{ getUniformLocation("sectionOffsets"s) },
+        outlineUniformLocation{ getUniformLocation("outline"s) },
         vertexAttributeLocation{ getAttributeLocation("vertex"s) },
-        colorAttributeLocation{ getAttributeLocation("color"s) }
+        colorAttributeLocation{ getAttributeLocation("color"s) },
+        anchorAttributeLocation{ getAttributeLocation("anchor"s) },
+        baseVertices{}
     {
-        glGenVertexArrays(1, &vertexArray);
-
-        glBindVertexArray(vertexArray);
-        glEnableVertexAttribArray(vertexAttributeLocation);
-        glEnableVertexAttribArray(colorAttributeLocation);
-        wingGeometry->UseElementArrayBuffer();
-        glBindVertexArray(0);
+        vertexArray.EnableAttribute(vertexAttributeLocation);
+        vertexArray.EnableAttribute(colorAttributeLocation);
+        vertexArray.EnableAttribute(anchorAttributeLocation);
+        wingGeometry->UseElementArrayBuffer(vertexArray);
 
         modelViewProjectionUniformBuffer = ModelViewProjectionUniformBuffer::MakeBuffer(GetName(), modelViewProjectionBindingIndex);
 
@@ -137,60 +155,52 @@ void main() {
         modelViewProjectionUniformBuffer->SetViewMatrix(view);
     }
 
-    WingRenderProgram::~WingRenderProgram(void) noexcept
-    {
-        glDeleteVertexArrays(1, &vertexArray);
-    }
-
-    void WingRenderProgram::RenderWings(std::deque<Wing> const& wings) const
+    void WingRenderProgram::RenderWings(RingBuffer<Wing> const& wings,
+        WingTransformFeedback const& wingTransformFeedbackObject,
+        AccumulatedDeltas<GLfloat> const& accumulatedDeltas,
+        silnith::wings::gl::GLStateCache& stateCache) const
     {
-        useProgram();
-
-        glBindVertexArray(vertexArray);
-
-        GLfloat deltaZ{ 0 };
-        GLfloat deltaAngle{ 0 };
-        for (Wing const& wing : wings) {
-            deltaZ += wing.getDeltaZ();
-            deltaAngle += wing.getDeltaAngle();
-
-            glUniform2f(deltaZUniformLocation, deltaAngle, deltaZ);
-
-            std::shared_ptr<WingTransformFeedback const> const wingTransformFeedbackObject{ wing.getTransformFeedbackObject() };
+        useProgram(stateCache);
 
-            wingTransformFeedbackObject->UseVertexBufferForVertexAttribute(vertexAttributeLocation);
+        /*
+         * This moves every wing to its place for this frame.  Each wing then
+         * only needs its own anchor, which never changes and so was captured
+         * along with its vertices.
+         */
+        std::array<GLfloat, 2 * AccumulatedDeltas<GLfloat>::numSections> const sectionOffsets{ accumulatedDeltas.getSectionOffsets() };
+        glUniform2fv(sectionOffsetsUniformLocation, AccumulatedDeltas<GLfloat>::numSections, sectionOffsets.data());
 
-            wingTransformFeedbackObject->UseColorBufferForVertexAttribute(colorAttributeLocation);
+        vertexArray.Bind(stateCache);
 
-            wingGeometry->RenderAsPolygons();
-        }
+        /*
+         * Every wing is a slot of the same buffer, so the attribute pointers
+         * are set once and each wing is drawn from its base vertex.  Nothing
+         * else differs between the wings, so each pass is a single draw.
+         */
+        wingTransformFeedbackObject.UsePositionsForVertexAttribute(vertexArray, vertexAttributeLocation, stateCache);
+        wingTransformFeedbackObject.UseColorsForVertexAttribute(vertexArray, colorAttributeLocation, stateCache);
+        wingTransformFeedbackObject.UseAnchorsForVertexAttribute(vertexArray, anchorAttributeLocation, stateCache);
 
-        deltaZ = 0;
-        deltaAngle = 0;
-        glDepthFunc(GL_LEQUAL);
-        glDepthMask(GL_FALSE);
-        glEnable(GL_BLEND);
+        baseVertices.clear();
         for (Wing const& wing : wings) {
-            deltaZ += wing.getDeltaZ();
-            deltaAngle += wing.getDeltaAngle();
-
-            glUniform2f(deltaZUniformLocation, deltaAngle, deltaZ);
-
-            std::shared_ptr<WingTransformFeedback const> const wingTransformFeedbackObject{ wing.getTransformFeedbackObject() };
-
-            wingTransformFeedbackObject->UseVertexBufferForVertexAttribute(vertexAttributeLocation);
-
-            wingTransformFeedbackObject->UseEdgeColorBufferForVertexAttribute(colorAttributeLocation);
-
-            wingGeometry->RenderAsOutline();
+            baseVertices.push_back(wing.getFirstVertex());
         }
-        glDisable(GL_BLEND);
-        glDepthMask(GL_TRUE);
-        glDepthFunc(GL_LESS);
-
-        glBindVertexArray(0);
 
-        glUseProgram(0);
+        instrumentation::PhaseTimer fillTimer{ instrumentation::Phase::FillPass };
+        wingGeometry->RenderAsPolygons(baseVertices);
+        fillTimer.Stop();
+
+        instrumentation::PhaseTimer outlineTimer{ instrumentation::Phase::OutlinePass };
+        stateCache.DepthFunc(GL_LEQUAL);
+        stateCache.DepthMask(GL_FALSE);
+        stateCache.Enable(GL_BLEND);
+        glUniform1i(outlineUniformLocation, GL_TRUE);
+        wingGeometry->RenderAsOutline(baseVertices);
+        glUniform1i(outlineUniformLocation, GL_FALSE);
+        stateCache.Disable(GL_BLEND);
+        stateCache.DepthMask(GL_TRUE);
+        stateCache.DepthFunc(GL_LESS);
+        outlineTimer.Stop();
     }
 
     void WingRenderProgram::Ortho(GLfloat const width, GLfloat const height) const
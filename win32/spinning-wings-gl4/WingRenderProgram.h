@@ -1,19 +1,26 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
-#include <deque>
 #include <memory>
+#include <vector>
 
+#include "AccumulatedDeltas.h"
+#include "GLStateCache.h"
 #include "Program.h"
+#include "RingBuffer.h"
 
 #include "WingGeometry.h"
 #include "ModelViewProjectionUniformBuffer.h"
 #include "WingGL4.h"
+#include "WingTransformFeedback.h"
 #include "RotateVertexShader.h"
 #include "TranslateVertexShader.h"
 #include "VertexShader.h"
+#include "VertexArray.h"
 
 namespace silnith::wings::gl4
 {
@@ -61,7 +68,7 @@ namespace silnith::wings::gl4
         WingRenderProgram& operator=(WingRenderProgram const&) = delete;
         WingRenderProgram(WingRenderProgram&&) noexcept = delete;
         WingRenderProgram& operator=(WingRenderProgram&&) noexcept = delete;
-        virtual ~WingRenderProgram(void) noexcept override;
+        virtual ~WingRenderProgram(void) noexcept override = default;
 
 #pragma endregion
 
@@ -70,7 +77,13 @@ namespace silnith::wings::gl4
         /// Renders the provided collection of wings.
         /// </summary>
         /// <param name="wings">The wings to render.</param>
-        void RenderWings(std::deque<Wing> const& wings) const;
+        /// <param name="wingTransformFeedbackObject">The transform feedback object holding the captured geometry of every wing.</param>
+        /// <param name="accumulatedDeltas">The delta angle and delta Z accumulated by the wings.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void RenderWings(RingBuffer<Wing> const& wings,
+            WingTransformFeedback const& wingTransformFeedbackObject,
+            AccumulatedDeltas<GLfloat> const& accumulatedDeltas,
+            silnith::wings::gl::GLStateCache& stateCache) const;
 
         /// <summary>
         /// Sets up the orthographic projection that transforms modelview coordinates
@@ -96,20 +109,26 @@ namespace silnith::wings::gl4
         /// before all of the required parameters are known.
         /// </para>
         /// </remarks>
-        std::shared_ptr<ModelViewProjectionUniformBuffer const> modelViewProjectionUniformBuffer{ nullptr };
+        std::shared_ptr<ModelViewProjectionUniformBuffer> modelViewProjectionUniformBuffer{ nullptr };
 
         /// <summary>
         /// The vertex array used for rendering.
         /// This maintains the state of the enabled vertex attributes,
         /// as well as the binding for the ELEMENT_ARRAY_BUFFER.
         /// </summary>
-        GLuint vertexArray{ 0 };
+        VertexArray const vertexArray{};
 
         /// <summary>
-        /// The location of the uniform variable <c>deltaZ</c>.
+        /// The location of the uniform variable <c>sectionOffsets</c>.
         /// </summary>
-        /// <seealso cref="glUniform2f"/>
-        GLint deltaZUniformLocation{ 0 };
+        /// <seealso cref="glUniform2fv"/>
+        /// <seealso cref="AccumulatedDeltas::getSectionOffsets"/>
+        GLint sectionOffsetsUniformLocation{ 0 };
+
+        /// <summary>
+        /// The location of the uniform variable <c>outline</c>.
+        /// </summary>
+        GLint outlineUniformLocation{ 0 };
 
         /// <summary>
         /// The location of the vertex attribute <c>vertex</c>.
@@ -120,6 +139,19 @@ namespace silnith::wings::gl4
         /// The location of the vertex attribute <c>color</c>.
         /// </summary>
         GLuint colorAttributeLocation{ 0 };
+
+        /// <summary>
+        /// The location of the vertex attribute <c>anchor</c>.
+        /// </summary>
+        /// <seealso cref="Wing::getAnchor"/>
+        GLuint anchorAttributeLocation{ 0 };
+
+        /// <summary>
+        /// The base vertex of every wing, in drawing order.  This is rebuilt
+        /// for each frame, but keeps its storage so that drawing does not
+        /// allocate.
+        /// </summary>
+        mutable std::vector<GLint> baseVertices{};
     };
 
 }
@@ -0,0 +1,235 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <array>
+
+#include "AccumulatedDeltas.h"
+#include "Buffer.h"
+
+namespace silnith::wings::gl4
+{
+
+    /// <summary>
+    /// A ring of per-wing parameters that the render program reads directly,
+    /// replacing the transform feedback pass for each new wing.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each wing is a record of <see cref="numComponentsPerWing"/> floats:
+    /// radius, angle, roll, pitch, yaw, red, green, blue, and the accumulated
+    /// delta angle and delta Z of all older wings relative to an anchor.
+    /// Adding a wing writes one record and nothing else.  The buffer is exposed
+    /// to shaders as a buffer texture.
+    /// </para>
+    /// <para>
+    /// The ring holds <see cref="numSections"/> times the number of visible
+    /// wings, divided into equal sections.  A frame only ever reads from two
+    /// adjacent sections, so the third is free to be written while the GPU
+    /// catches up.  A fence is placed after every frame for each section it
+    /// read, and the CPU waits on that fence before it starts overwriting the
+    /// section.  In practice the fence has always signaled long before.
+    /// </para>
+    /// <para>
+    /// When <c>ARB_buffer_storage</c> is available the buffer is mapped once,
+    /// persistently and coherently, and adding a wing is a plain memory copy.
+    /// Otherwise each record is written through an unsynchronized mapping of
+    /// just that record, which the fences make equally safe.  With
+    /// <see cref="HasDirectStateAccess"/> the buffer and its texture are
+    /// created and set up by name, like the other buffers of this renderer.
+    /// </para>
+    /// <para>
+    /// The accumulated deltas are tracked by the same
+    /// <see cref="AccumulatedDeltas"/> that the other pipelines use, with one
+    /// of its sections for each section of the ring.  Each record stores the
+    /// anchor of its wing, and the render program receives the current total
+    /// relative to each section anchor.
+    /// </para>
+    /// </remarks>
+    class WingStreamBuffer : public Buffer
+    {
+#pragma region Static Members
+
+    public:
+        /// <summary>
+        /// The number of sections the ring is divided into.
+        /// </summary>
+        static GLsizei constexpr numSections{ 3 };
+
+        /// <summary>
+        /// The number of floats in the record for each wing.
+        /// </summary>
+        static GLsizei constexpr numComponentsPerWing{ 10 };
+
+        static_assert(numSections == AccumulatedDeltas<GLfloat>::numSections);
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Default constructor is deleted.  The ring cannot be allocated
+        /// without knowing the number of wings.
+        /// </summary>
+        WingStreamBuffer(void) = delete;
+
+        /// <summary>
+        /// Allocates and maps the ring, and creates the buffer texture that
+        /// exposes it to shaders.
+        /// </summary>
+        /// <param name="numWings">The number of wings visible at once.</param>
+        explicit WingStreamBuffer(GLsizei numWings);
+
+#pragma region Rule of Five
+
+    public:
+        WingStreamBuffer(WingStreamBuffer const&) = delete;
+        WingStreamBuffer& operator=(WingStreamBuffer const&) = delete;
+        WingStreamBuffer(WingStreamBuffer&&) noexcept = delete;
+        WingStreamBuffer& operator=(WingStreamBuffer&&) noexcept = delete;
+        virtual ~WingStreamBuffer(void) noexcept override;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Writes the record for a new wing, which becomes the newest wing.
+        /// If the maximum number of wings is visible, the oldest one
+        /// leaves the window.
+        /// </summary>
+        /// <param name="radius">The radius of the wing around the central axis.</param>
+        /// <param name="angle">The angle of the wing around the central axis.</param>
+        /// <param name="deltaAngle">The additional angle around the central axis as the wing recedes into history.</param>
+        /// <param name="deltaZ">The additional height along the central axis as the wing recedes into history.</param>
+        /// <param name="roll">The roll of the wing.</param>
+        /// <param name="pitch">The pitch of the wing.</param>
+        /// <param name="yaw">The yaw of the wing.</param>
+        /// <param name="red">The red component of the wing color.</param>
+        /// <param name="green">The green component of the wing color.</param>
+        /// <param name="blue">The blue component of the wing color.</param>
+        void AddWing(GLfloat radius, GLfloat angle,
+            GLfloat deltaAngle, GLfloat deltaZ,
+            GLfloat roll, GLfloat pitch, GLfloat yaw,
+            GLfloat red, GLfloat green, GLfloat blue);
+
+        /// <summary>
+        /// Places fences for the sections read by the commands issued so far.
+        /// This must be called after every draw call that reads the buffer.
+        /// </summary>
+        void FenceReads(void);
+
+        /// <summary>
+        /// Binds the buffer texture to the <c>GL_TEXTURE_BUFFER</c> target
+        /// of the active texture unit.
+        /// </summary>
+        void UseAsTexture(void) const;
+
+        /// <summary>
+        /// Returns whether the ring is persistently mapped.
+        /// </summary>
+        /// <returns><c>true</c> if the ring is persistently mapped, <c>false</c> if each record is mapped separately.</returns>
+        [[nodiscard]]
+        bool isPersistent(void) const noexcept;
+
+        /// <summary>
+        /// Returns the number of wings currently visible.
+        /// </summary>
+        /// <returns>The instance count for the draw calls.</returns>
+        [[nodiscard]]
+        GLsizei getNumWings(void) const noexcept;
+
+        /// <summary>
+        /// Returns the slot of the newest wing.  The older wings follow it,
+        /// wrapping around the end of the ring.
+        /// </summary>
+        /// <returns>The slot of the newest wing.</returns>
+        [[nodiscard]]
+        GLsizei getFirstSlot(void) const noexcept;
+
+        /// <summary>
+        /// Returns the total number of slots in the ring.
+        /// </summary>
+        /// <returns>The number of slots.</returns>
+        [[nodiscard]]
+        GLsizei getCapacity(void) const noexcept;
+
+        /// <summary>
+        /// Returns the number of slots in each section.
+        /// </summary>
+        /// <returns>The number of slots per section.</returns>
+        [[nodiscard]]
+        GLsizei getSectionSize(void) const noexcept;
+
+        /// <summary>
+        /// Returns the current accumulated delta angle and delta Z, relative
+        /// to the anchor of each section.
+        /// </summary>
+        /// <returns>Pairs of (delta angle, delta Z), one pair per section.</returns>
+        [[nodiscard]]
+        std::array<GLfloat, 2 * numSections> getSectionOffsets(void) const noexcept;
+
+    private:
+        /// <summary>
+        /// Blocks until the GPU has finished every command that read the section.
+        /// </summary>
+        /// <param name="section">The section about to be overwritten.</param>
+        void WaitForSection(GLsizei section);
+
+        /// <summary>
+        /// Copies a record into a slot.
+        /// </summary>
+        /// <param name="slot">The destination slot.</param>
+        /// <param name="record">The record to copy.</param>
+        void WriteRecord(GLsizei slot, std::array<GLfloat, numComponentsPerWing> const& record);
+
+    private:
+        /// <summary>
+        /// The number of slots in each section.  This is the maximum number of visible wings.
+        /// </summary>
+        GLsizei const sectionSize{ 0 };
+
+        /// <summary>
+        /// The total number of slots.
+        /// </summary>
+        GLsizei const capacity{ 0 };
+
+        /// <summary>
+        /// Whether the buffer has immutable storage that is persistently mapped.
+        /// </summary>
+        bool const persistent{ false };
+
+        /// <summary>
+        /// The persistent mapping of the whole buffer, if there is one.
+        /// </summary>
+        GLfloat* mappedRecords{ nullptr };
+
+        /// <summary>
+        /// The buffer texture that exposes the buffer to shaders.
+        /// </summary>
+        GLuint texture{ 0 };
+
+        /// <summary>
+        /// The number of wings currently visible.
+        /// </summary>
+        GLsizei numWings{ 0 };
+
+        /// <summary>
+        /// The slot of the newest wing.
+        /// </summary>
+        GLsizei firstSlot{ 0 };
+
+        /// <summary>
+        /// The fence after the most recent frame that read each section,
+        /// or <c>nullptr</c> if there is nothing to wait for.
+        /// </summary>
+        std::array<GLsync, numSections> fences{};
+
+        /// <summary>
+        /// The delta angle and delta Z accumulated by every wing ever added.
+        /// </summary>
+        AccumulatedDeltas<GLfloat> accumulatedDeltas;
+    };
+
+}
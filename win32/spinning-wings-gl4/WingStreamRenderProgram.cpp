@@ -0,0 +1,287 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+#include <cassert>
+
+#include "WingStreamRenderProgram.h"
+
+#include "Instrumentation.h"
+#include "Program.h"
+#include "RotateVertexShader.h"
+#include "TranslateVertexShader.h"
+#include "VertexShader.h"
+#include "FragmentShader.h"
+#include "Shader.h"
+
+#include "ModelViewProjectionUniformBuffer.h"
+
+#include "WingGeometry.h"
+#include "WingStreamBuffer.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::gl4
+{
+
+    WingStreamRenderProgram::WingStreamRenderProgram(std::shared_ptr<WingGeometry const> wingGeometry,
+        std::shared_ptr<RotateVertexShader const> rotateMatrixShader,
+        std::shared_ptr<TranslateVertexShader const> translateMatrixShader)
+        : Program{
+            std::initializer_list<std::shared_ptr<VertexShader const> >{
+                std::make_shared<VertexShader const>(std::initializer_list<std::string>{
+                    Shader::versionDeclaration,
+                    ModelViewProjectionUniformBuffer::uniformBlockDeclaration,
+                    "const int numComponentsPerWing = "s + std::to_string(WingStreamBuffer::numComponentsPerWing) + ";\n"s,
+                    "const int numSections = "s + std::to_string(WingStreamBuffer::numSections) + ";\n"s,
+                    R"shaderText(
+uniform samplerBuffer wingParameters;
+
+uniform int firstSlot = 0;
+uniform int capacity = 1;
+uniform int sectionSize = 1;
+uniform vec2 sectionOffsets[numSections];
+
+uniform bool outline = false;
+uniform vec3 edgeColor = vec3(1, 1, 1);
+
+in vec4 vertex;
+
+smooth out vec4 varyingColor;
+
+const vec3 xAxis = vec3(1, 0, 0);
+const vec3 yAxis = vec3(0, 1, 0);
+const vec3 zAxis = vec3(0, 0, 1);
+)shaderText",
+                    rotateMatrixShader->GetDeclaration(),
+                    translateMatrixShader->GetDeclaration(),
+                    R"shaderText(
+float parameter(int base, int index) {
+    return texelFetch(wingParameters, base + index).r;
+}
+
+void main() {
+    int slot = (firstSlot + gl_InstanceID) % capacity;
+    int base = slot * numComponentsPerWing;
+
+    float radius = parameter(base, 0);
+    float angle = parameter(base, 1);
+    float roll = parameter(base, 2);
+    float pitch = parameter(base, 3);
+    float yaw = parameter(base, 4);
+    vec3 color = vec3(parameter(base, 5), parameter(base, 6), parameter(base, 7));
+    vec2 olderDeltas = vec2(parameter(base, 8), parameter(base, 9));
+
+    vec2 accumulatedDeltas = sectionOffsets[slot / sectionSize] - olderDeltas;
+    float deltaAngle = accumulatedDeltas[0];
+    float dZ = accumulatedDeltas[1];
+
+    mat4 wingTransformation = rotate(angle, zAxis)
+                              * translate(vec3(radius, 0, 0))
+                              * rotate(-yaw, zAxis)
+                              * rotate(-pitch, yAxis)
+                              * rotate(roll, xAxis);
+
+    mat4 modelViewProjection = projection * view * model;
+
+    if (outline) {
+        varyingColor = vec4(edgeColor, 1);
+    } else {
+        varyingColor = vec4(color, 1);
+    }
+    gl_Position = modelViewProjection
+                  * translate(vec3(0, 0, dZ))
+                  * rotate(deltaAngle, zAxis)
+                  * wingTransformation
+                  * vertex;
+}
+)shaderText",
+                }),
+                rotateMatrixShader,
+                translateMatrixShader,
+            },
+            std::initializer_list<std::shared_ptr<FragmentShader const> >{
+                std::make_shared<FragmentShader const>(std::initializer_list<std::string>{
+                    Shader::versionDeclaration,
+                    R"shaderText(
+smooth in vec4 varyingColor;
+
+out vec4 fragmentColor;
+
+void main() {
+    fragmentColor = varyingColor;
+}
+)shaderText",
+                }),
+            },
+            "fragmentColor"s
+        },
+        wingGeometry{ wingGeometry },
+        firstSlotUniformLocation{ getUniformLocation("firstSlot"s) },
+        capacityUniformLocation{ getUniformLocation("capacity"s) },
+        sectionSizeUniformLocation{ getUniformLocation("sectionSize"s) },
+        sectionOffsetsUniformLocation{ getUniformLocation("sectionOffsets"s) },
+        outlineUniformLocation{ getUniformLocation("outline"s) },
+        vertexAttributeLocation{ getAttributeLocation("vertex"s) }
+    {
+        vertexArray.EnableAttribute(vertexAttributeLocation);
+        wingGeometry->UseForVertexAttribute(vertexArray, vertexAttributeLocation);
+        wingGeometry->UseElementArrayBuffer(vertexArray);
+
+        /*
+         * Samplers are bound to texture units rather than to textures,
+         * and this program only ever uses the one.
+         */
+        glProgramUniform1i(GetName(), getUniformLocation("wingParameters"s), wingParametersTextureUnit);
+
+        modelViewProjectionUniformBuffer = ModelViewProjectionUniformBuffer::MakeBuffer(GetName(), modelViewProjectionBindingIndex);
+
+        /*
+         * Set up the initial camera position.
+         */
+        glm::mat4 const view{ glm::lookAt(
+            glm::vec3{ 0, 50, 50 },
+            glm::vec3{ 0, 0, 13 },
+            glm::vec3{ 0, 0, 1 }) };
+
+        std::array<GLfloat, 4 * 4> viewMatrix{};
+        GLfloat const* const viewData{ glm::value_ptr(view) };
+        std::copy(viewData, viewData + viewMatrix.size(), viewMatrix.begin());
+
+        modelViewProjectionUniformBuffer->SetViewMatrix(viewMatrix);
+    }
+
+    void WingStreamRenderProgram::RenderWings(WingStreamBuffer& wingStreamBuffer, silnith::wings::gl::GLStateCache& stateCache) const
+    {
+        GLsizei const numWings{ wingStreamBuffer.getNumWings() };
+        std::array<GLfloat, 2 * WingStreamBuffer::numSections> const sectionOffsets{ wingStreamBuffer.getSectionOffsets() };
+
+        useProgram(stateCache);
+
+        glActiveTexture(GL_TEXTURE0 + wingParametersTextureUnit);
+        wingStreamBuffer.UseAsTexture();
+
+        glUniform1i(firstSlotUniformLocation, wingStreamBuffer.getFirstSlot());
+        glUniform1i(capacityUniformLocation, wingStreamBuffer.getCapacity());
+        glUniform1i(sectionSizeUniformLocation, wingStreamBuffer.getSectionSize());
+        glUniform2fv(sectionOffsetsUniformLocation, WingStreamBuffer::numSections, sectionOffsets.data());
+
+        vertexArray.Bind(stateCache);
+
+        instrumentation::PhaseTimer fillTimer{ instrumentation::Phase::FillPass };
+        glUniform1i(outlineUniformLocation, GL_FALSE);
+        wingGeometry->RenderAsPolygonsInstanced(numWings);
+        fillTimer.Stop();
+
+        /*
+         * See WingRenderProgram::RenderWings for the reasoning behind the
+         * depth and blending state for the outlines.
+         */
+        instrumentation::PhaseTimer outlineTimer{ instrumentation::Phase::OutlinePass };
+        stateCache.DepthFunc(GL_LEQUAL);
+        stateCache.DepthMask(GL_FALSE);
+        stateCache.Enable(GL_BLEND);
+        glUniform1i(outlineUniformLocation, GL_TRUE);
+        wingGeometry->RenderAsOutlineInstanced(numWings);
+        stateCache.Disable(GL_BLEND);
+        stateCache.DepthMask(GL_TRUE);
+        stateCache.DepthFunc(GL_LESS);
+        outlineTimer.Stop();
+
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+        wingStreamBuffer.FenceReads();
+    }
+
+    void WingStreamRenderProgram::Ortho(GLfloat const width, GLfloat const height) const
+    {
+        /*
+         * These multipliers account for the aspect ratio of the window, so that
+         * the rendering does not distort.  The conditional is so that the larger
+         * number is always divided by the smaller, resulting in a multiplier no
+         * less than one.  This way, the viewing area is always expanded rather than
+         * contracted, and the expected viewing frustum is never clipped.
+         */
+        GLfloat xmult{ 1.0 };
+        GLfloat ymult{ 1.0 };
+        if (width > height)
+        {
+            xmult = width / height;
+        }
+        else
+        {
+            ymult = height / width;
+        }
+
+        /*
+         * The view frustum was hand-selected to match the parameters to the
+         * curve generators and the initial camera position.
+         */
+        GLfloat constexpr defaultLeft{ -20 };
+        GLfloat constexpr defaultRight{ 20 };
+        GLfloat constexpr defaultBottom{ -20 };
+        GLfloat constexpr defaultTop{ 20 };
+        GLfloat constexpr defaultNear{ 35 };
+        GLfloat constexpr defaultFar{ 105 };
+
+        GLfloat const left{ defaultLeft * xmult };
+        GLfloat const right{ defaultRight * xmult };
+        GLfloat const bottom{ defaultBottom * ymult };
+        GLfloat const top{ defaultTop * ymult };
+        GLfloat const nearZ{ defaultNear };
+        GLfloat const farZ{ defaultFar };
+
+        GLfloat const viewWidth{ right - left };
+        GLfloat const viewHeight{ top - bottom };
+        GLfloat const viewDepth{ farZ - nearZ };
+
+        assert(viewWidth > 0);
+        assert(viewHeight > 0);
+        assert(viewDepth > 0);
+
+        /*
+         * Set up the projection matrix.
+         * The projection matrix is only used for the viewing frustum.
+         * Things like camera position belong in the modelview matrix.
+         */
+        std::array<GLfloat, 4 * 4> const projection{
+            // column 0
+            static_cast<GLfloat>(2) / viewWidth,
+            0,
+            0,
+            0,
+
+            // column 1
+            0,
+            static_cast<GLfloat>(2) / viewHeight,
+            0,
+            0,
+
+            // column 2
+            0,
+            0,
+            static_cast<GLfloat>(-2) / viewDepth,
+            0,
+
+            // column 3
+            -(right + left) / viewWidth,
+            -(top + bottom) / viewHeight,
+            -(farZ + nearZ) / viewDepth,
+            static_cast<GLfloat>(1),
+        };
+
+        modelViewProjectionUniformBuffer->SetProjectionMatrix(projection);
+    }
+
+}
@@ -1,43 +1,66 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <memory>
 
 #include "WingTransformFeedback.h"
 
-#include "ArrayBuffer.h"
+#include "DirectStateAccess.h"
+#include "VertexArray.h"
+#include "WingVertexBuffer.h"
 
 namespace silnith::wings::gl4
 {
 
-    WingTransformFeedback::WingTransformFeedback(std::shared_ptr<ArrayBuffer const> vertexBuffer,
-        std::shared_ptr<ArrayBuffer const> colorBuffer,
-        std::shared_ptr<ArrayBuffer const> edgeColorBuffer)
-        : vertexBuffer{ vertexBuffer },
-        colorBuffer{ colorBuffer },
-        edgeColorBuffer{ edgeColorBuffer }
+    WingTransformFeedback::WingTransformFeedback(std::shared_ptr<WingVertexBuffer const> vertexBuffer)
+        : vertexBuffer{ vertexBuffer }
+    {
+        if (HasDirectStateAccess())
+        {
+            glTransformFeedbackBufferBase(GetName(), 0, vertexBuffer->GetName());
+        }
+        else
+        {
+            glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, GetName());
+            glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, vertexBuffer->GetName());
+            glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, 0);
+            glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+        }
+    }
+
+    void WingTransformFeedback::UseForCapture(GLsizei firstVertex, GLsizei numVertices) const
     {
         glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, GetName());
-        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, vertexBuffer->GetName());
-        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 1, colorBuffer->GetName());
-        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 2, edgeColorBuffer->GetName());
-        glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, 0);
-        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+        vertexBuffer->UseForCapture(GetName(), 0, 1, firstVertex, numVertices);
     }
 
-    void WingTransformFeedback::UseVertexBufferForVertexAttribute(GLuint attributeLocation) const
+    void WingTransformFeedback::UsePositionsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation,
+        silnith::wings::gl::GLStateCache& stateCache) const
     {
-        vertexBuffer->UseForVertexAttribute(attributeLocation);
+        if (stateCache.ChangeVertexAttribute(vertexArray.GetName(), attributeLocation, vertexBuffer->GetPositionsPointer()))
+        {
+            vertexBuffer->UsePositionsForVertexAttribute(vertexArray, attributeLocation);
+        }
     }
 
-    void WingTransformFeedback::UseColorBufferForVertexAttribute(GLuint attributeLocation) const
+    void WingTransformFeedback::UseColorsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation,
+        silnith::wings::gl::GLStateCache& stateCache) const
     {
-        colorBuffer->UseForVertexAttribute(attributeLocation);
+        if (stateCache.ChangeVertexAttribute(vertexArray.GetName(), attributeLocation, vertexBuffer->GetColorsPointer()))
+        {
+            vertexBuffer->UseColorsForVertexAttribute(vertexArray, attributeLocation);
+        }
     }
 
-    void WingTransformFeedback::UseEdgeColorBufferForVertexAttribute(GLuint attributeLocation) const
+    void WingTransformFeedback::UseAnchorsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation,
+        silnith::wings::gl::GLStateCache& stateCache) const
     {
-        edgeColorBuffer->UseForVertexAttribute(attributeLocation);
+        if (stateCache.ChangeVertexAttribute(vertexArray.GetName(), attributeLocation, vertexBuffer->GetAnchorsPointer()))
+        {
+            vertexBuffer->UseAnchorsForVertexAttribute(vertexArray, attributeLocation);
+        }
     }
 
 }
@@ -1,20 +1,24 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <memory>
 
+#include "GLStateCache.h"
 #include "TransformFeedback.h"
 
-#include "ArrayBuffer.h"
+#include "VertexArray.h"
+#include "WingVertexBuffer.h"
 
 namespace silnith::wings::gl4
 {
 
     /// <summary>
-    /// A class to encapsulate a transform feedback object and the array
-    /// buffers that it writes into.
+    /// A class to encapsulate a transform feedback object and the vertex
+    /// buffer that it writes into.
     /// </summary>
     /// <remarks>
     /// <para>
@@ -22,6 +26,10 @@ namespace silnith::wings::gl4
     /// used to capture and preserve the wing-specific transformations.
     /// </para>
     /// <para>
+    /// The buffer may hold many wings, one after another.  Each capture
+    /// writes into a range of it.  See <see cref="UseForCapture"/>.
+    /// </para>
+    /// <para>
     /// This requires OpenGL 4.0 or higher.
     /// </para>
     /// </remarks>
@@ -30,20 +38,16 @@ namespace silnith::wings::gl4
     public:
         /// <summary>
         /// Default constructor is deleted.  This object is meaningless without
-        /// the buffers it writes into.
+        /// the buffer it writes into.
         /// </summary>
         WingTransformFeedback(void) = delete;
 
         /// <summary>
         /// Creates a transform feedback object and configures it to write into
-        /// the provided vertex, color, and edge color buffers.
+        /// the provided vertex buffer.
         /// </summary>
-        /// <param name="vertexBuffer">The array buffer to write vertex coordinates into.</param>
-        /// <param name="colorBuffer">The array buffer to write vertex colors into for the wing surface.</param>
-        /// <param name="edgeColorBuffer">The array buffer to write vertex colors into for the wing edges.</param>
-        explicit WingTransformFeedback(std::shared_ptr<ArrayBuffer const> vertexBuffer,
-            std::shared_ptr<ArrayBuffer const> colorBuffer,
-            std::shared_ptr<ArrayBuffer const> edgeColorBuffer);
+        /// <param name="vertexBuffer">The buffer to write packed vertices into.</param>
+        explicit WingTransformFeedback(std::shared_ptr<WingVertexBuffer const> vertexBuffer);
 
 #pragma region Rule of Five
 
@@ -58,41 +62,62 @@ namespace silnith::wings::gl4
 
     public:
         /// <summary>
-        /// Makes the vertex buffer the active buffer for the specified vertex
-        /// attribute location.
+        /// Makes the captured vertex positions the active data for the
+        /// specified vertex attribute location of a vertex array.
         /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The vertex array keeps the attribute pointer, so this does nothing
+        /// if the state cache shows that it is already set.
+        /// </para>
+        /// </remarks>
+        /// <param name="vertexArray">The vertex array to modify.</param>
         /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
-        void UseVertexBufferForVertexAttribute(GLuint attributeLocation) const;
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void UsePositionsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation,
+            silnith::wings::gl::GLStateCache& stateCache) const;
 
         /// <summary>
-        /// Makes the color buffer the active buffer for the specified vertex
-        /// attribute location.
+        /// Makes the captured wing colors the active data for the specified
+        /// vertex attribute location of a vertex array.
         /// </summary>
+        /// <param name="vertexArray">The vertex array to modify.</param>
         /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
-        void UseColorBufferForVertexAttribute(GLuint attributeLocation) const;
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        /// <seealso cref="UsePositionsForVertexAttribute"/>
+        void UseColorsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation,
+            silnith::wings::gl::GLStateCache& stateCache) const;
 
         /// <summary>
-        /// Makes the edge color buffer the active buffer for the specified vertex
-        /// attribute location.
+        /// Makes the captured wing anchors the active data for the specified
+        /// vertex attribute location of a vertex array.
         /// </summary>
+        /// <param name="vertexArray">The vertex array to modify.</param>
         /// <param name="attributeLocation">The index of the generic vertex attribute.</param>
-        void UseEdgeColorBufferForVertexAttribute(GLuint attributeLocation) const;
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        /// <seealso cref="UsePositionsForVertexAttribute"/>
+        void UseAnchorsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation,
+            silnith::wings::gl::GLStateCache& stateCache) const;
 
-    private:
         /// <summary>
-        /// The array buffer that will receive vertex coordinates.
+        /// Binds this transform feedback object, and restricts it to write
+        /// into the specified range of vertices of the buffer and their anchors.
         /// </summary>
-        std::shared_ptr<ArrayBuffer const> vertexBuffer{ nullptr };
-
-        /// <summary>
-        /// The array buffer that will receive color values.
-        /// </summary>
-        std::shared_ptr<ArrayBuffer const> colorBuffer{ nullptr };
+        /// <remarks>
+        /// <para>
+        /// The first vertex captured is written to <paramref name="firstVertex"/>.
+        /// The range remains in effect until this is called again.
+        /// </para>
+        /// </remarks>
+        /// <param name="firstVertex">The index of the first vertex to write.</param>
+        /// <param name="numVertices">The number of vertices to write.</param>
+        void UseForCapture(GLsizei firstVertex, GLsizei numVertices) const;
 
+    private:
         /// <summary>
-        /// The array buffer that will receive edge color values.
+        /// The buffer that will receive the packed vertices.
         /// </summary>
-        std::shared_ptr<ArrayBuffer const> edgeColorBuffer{ nullptr };
+        std::shared_ptr<WingVertexBuffer const> vertexBuffer{ nullptr };
     };
 
 }
@@ -1,9 +1,16 @@
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <initializer_list>
 #include <memory>
+#include <span>
 #include <string>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
 
 #include "WingTransformProgram.h"
 
@@ -13,12 +20,29 @@
 #include "TranslateVertexShader.h"
 #include "VertexShader.h"
 #include "Program.h"
+#include "AccumulatedDeltas.h"
+#include "WingParameters.h"
+
+#include "Buffer.h"
+#include "WingVertexBuffer.h"
 
 using namespace std::literals::string_literals;
 
 namespace silnith::wings::gl4
 {
 
+    /// <summary>
+    /// The number of floats in the parameter record for each wing.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The record is radius and angle, then roll, pitch, and yaw, then red,
+    /// green, and blue, then the anchor angle, Z, and section.  These are the
+    /// four instanced attributes of the vertex shader.
+    /// </para>
+    /// </remarks>
+    static std::size_t constexpr numParametersPerWing{ 11 };
+
     WingTransformProgram::WingTransformProgram(std::shared_ptr<WingGeometry const> wingGeometry,
         std::shared_ptr<RotateVertexShader const> rotateMatrixShader,
         std::shared_ptr<TranslateVertexShader const> translateMatrixShader)
@@ -26,16 +50,20 @@ namespace silnith::wings::gl4
             std::initializer_list<std::shared_ptr<VertexShader const> >{
                 std::make_shared<VertexShader const>(std::initializer_list<std::string>{
                     Shader::versionDeclaration,
+                    WingVertexBuffer::packFunctionDeclaration,
                     R"shaderText(
-uniform vec2 radiusAngle;
-uniform vec3 rollPitchYaw;
-uniform vec3 color;
-uniform vec3 edgeColor = vec3(1, 1, 1);
-
 in vec4 vertex;
 
-smooth out vec3 varyingWingColor;
-smooth out vec3 varyingEdgeColor;
+/*
+ * These advance once per instance, and each instance is one wing.
+ */
+in vec2 radiusAngle;
+in vec3 rollPitchYaw;
+in vec3 color;
+in vec3 anchor;
+
+flat out uvec3 packedVertex;
+flat out vec3 wingAnchor;
 
 const vec3 xAxis = vec3(1, 0, 0);
 const vec3 yAxis = vec3(0, 1, 0);
@@ -51,15 +79,14 @@ void main() {
     float pitch = rollPitchYaw[1];
     float yaw = rollPitchYaw[2];
 
-    varyingWingColor = color;
-    varyingEdgeColor = edgeColor;
-
     mat4 wingTransformation = rotate(angle, zAxis)
                               * translate(vec3(radius, 0, 0))
                               * rotate(-yaw, zAxis)
                               * rotate(-pitch, yAxis)
                               * rotate(roll, xAxis);
-    gl_Position = wingTransformation * vertex;
+    vec4 position = wingTransformation * vertex;
+    packedVertex = packWingVertex(position.xyz, color);
+    wingAnchor = anchor;
 }
 )shaderText",
                 }),
@@ -67,71 +94,93 @@ void main() {
                 translateMatrixShader,
             },
             std::initializer_list<std::string>{
-                "gl_Position"s,
-                "varyingWingColor"s,
-                "varyingEdgeColor"s,
+                "packedVertex"s,
+                "wingAnchor"s,
             }
         },
         wingGeometry{ wingGeometry },
-        vertexArray{ 0 },
-        radiusAngleUniformLocation{ getUniformLocation("radiusAngle"s) },
-        rollPitchYawUniformLocation{ getUniformLocation("rollPitchYaw"s) },
-        colorUniformLocation{ getUniformLocation("color"s) },
-        edgeColorUniformLocation{ getUniformLocation("edgeColor"s) }
+        vertexArray{},
+        parameterBuffer{}
     {
-        glGenVertexArrays(1, &vertexArray);
-
         GLuint const vertexAttributeLocation{ getAttributeLocation("vertex"s) };
-        glBindVertexArray(vertexArray);
-        glEnableVertexAttribArray(vertexAttributeLocation);
-        wingGeometry->UseForVertexAttribute(vertexAttributeLocation);
-        glBindVertexArray(0);
-    }
-
-    WingTransformProgram::~WingTransformProgram(void) noexcept
-    {
-        glDeleteVertexArrays(1, &vertexArray);
+        vertexArray.EnableAttribute(vertexAttributeLocation);
+        wingGeometry->UseForVertexAttribute(vertexArray, vertexAttributeLocation);
+
+        /*
+         * The vertex array refers to the buffer object rather than its
+         * storage, so these stay valid when the buffer is reallocated for
+         * each batch.
+         */
+        GLsizei constexpr stride{ static_cast<GLsizei>(sizeof(GLfloat) * numParametersPerWing) };
+        auto const useForInstanceAttribute{ [this](std::string const& name, GLint numComponents, std::size_t offset) -> void
+            {
+                GLuint const attributeLocation{ getAttributeLocation(name) };
+                vertexArray.EnableAttribute(attributeLocation);
+                vertexArray.UseBufferForAttribute(attributeLocation, parameterBuffer.GetName(),
+                    numComponents, GL_FLOAT, GL_FALSE, stride,
+                    static_cast<GLintptr>(sizeof(GLfloat) * offset), 1);
+            } };
+        useForInstanceAttribute("radiusAngle"s, 2, 0);
+        useForInstanceAttribute("rollPitchYaw"s, 3, 2);
+        useForInstanceAttribute("color"s, 3, 5);
+        useForInstanceAttribute("anchor"s, 3, 8);
     }
 
-    std::shared_ptr<WingTransformFeedback const> WingTransformProgram::CreateTransformFeedback(void) const
+    std::shared_ptr<WingTransformFeedback const> WingTransformProgram::CreateTransformFeedback(GLsizei numWings) const
     {
-        std::shared_ptr<ArrayBuffer const> const wingVertexBuffer{ wingGeometry->CreateBuffer(4) };
-        std::shared_ptr<ArrayBuffer const> const wingColorBuffer{ wingGeometry->CreateBuffer(3) };
-        std::shared_ptr<ArrayBuffer const> const wingEdgeColorBuffer{ wingGeometry->CreateBuffer(3) };
-
         return std::make_shared<WingTransformFeedback const>(
-            wingVertexBuffer,
-            wingColorBuffer,
-            wingEdgeColorBuffer);
+            std::make_shared<WingVertexBuffer const>(wingGeometry->getNumVertices() * numWings));
     }
 
-    void WingTransformProgram::TransformWing(GLfloat radius, GLfloat angle,
-        GLfloat roll, GLfloat pitch, GLfloat yaw,
-        GLfloat red, GLfloat green, GLfloat blue,
-        WingTransformFeedback const& wingTransformFeedbackObject) const
+    void WingTransformProgram::TransformWings(std::span<WingParameters<GLfloat> const> wings,
+        std::span<AccumulatedDeltas<GLfloat>::Anchor const> anchors,
+        GLsizei firstWing,
+        WingTransformFeedback const& wingTransformFeedbackObject,
+        silnith::wings::gl::GLStateCache& stateCache) const
     {
-        useProgram();
-
-        glUniform2f(radiusAngleUniformLocation, radius, angle);
-        glUniform3f(rollPitchYawUniformLocation, roll, pitch, yaw);
-        glUniform3f(colorUniformLocation, red, green, blue);
-        glUniform3f(edgeColorUniformLocation, 1, 1, 1);
-
-        glBindVertexArray(vertexArray);
-
-        glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, wingTransformFeedbackObject.GetName());
+        if (wings.empty())
+        {
+            return;
+        }
+
+        assert(anchors.size() == wings.size());
+
+        GLsizei const numWings{ static_cast<GLsizei>(wings.size()) };
+        GLsizei const numVertices{ wingGeometry->getNumVertices() };
+
+        std::vector<GLfloat> parameters{};
+        parameters.reserve(numParametersPerWing * wings.size());
+        for (std::size_t index{ 0 }; index < wings.size(); index++)
+        {
+            WingParameters<GLfloat> const& wing{ wings[index] };
+            AccumulatedDeltas<GLfloat>::Anchor const& anchor{ anchors[index] };
+            parameters.insert(parameters.end(), {
+                wing.radius, wing.angle,
+                wing.roll, wing.pitch, wing.yaw,
+                wing.red, wing.green, wing.blue,
+                anchor.angle, anchor.z, static_cast<GLfloat>(anchor.section),
+                });
+        }
+
+        /*
+         * Reallocating the whole buffer lets the driver hand out fresh storage
+         * instead of waiting for the previous batch to finish reading it.
+         */
+        parameterBuffer.Reallocate(static_cast<GLsizeiptr>(sizeof(GLfloat) * parameters.size()), parameters.data(), GL_STREAM_DRAW);
+
+        useProgram(stateCache);
+
+        vertexArray.Bind(stateCache);
+
+        wingTransformFeedbackObject.UseForCapture(firstWing * numVertices, numWings * numVertices);
 
         glEnable(GL_RASTERIZER_DISCARD);
         glBeginTransformFeedback(GL_POINTS);
-        wingGeometry->RenderAsPoints();
+        wingGeometry->RenderAsPointsInstanced(numWings);
         glEndTransformFeedback();
         glDisable(GL_RASTERIZER_DISCARD);
 
         glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
-
-        glBindVertexArray(0);
-
-        glUseProgram(0);
     }
 
 }
@@ -1,21 +1,46 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
 #include <memory>
+#include <span>
 
+#include "AccumulatedDeltas.h"
+#include "GLStateCache.h"
 #include "Program.h"
+#include "WingParameters.h"
+
+#include "Buffer.h"
 
 #include "WingGeometry.h"
 #include "WingTransformFeedback.h"
 #include "RotateVertexShader.h"
 #include "TranslateVertexShader.h"
 #include "VertexShader.h"
+#include "VertexArray.h"
 
 namespace silnith::wings::gl4
 {
 
+    /// <summary>
+    /// The GLSL program that transforms each wing and captures the results
+    /// using transform feedback.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Any number of wings are transformed with a single instanced draw, one
+    /// instance per wing.  The parameters of each wing are instanced vertex
+    /// attributes, read from one interleaved record per wing.
+    /// </para>
+    /// <para>
+    /// The transformed vertices are captured in the packed layout of
+    /// <see cref="WingVertexBuffer"/>.  Only the wing color is captured, since
+    /// the edge color is a uniform of the render program.
+    /// </para>
+    /// </remarks>
     class WingTransformProgram : public Program
     {
     public:
@@ -36,38 +61,47 @@ namespace silnith::wings::gl4
         WingTransformProgram& operator=(WingTransformProgram const&) = delete;
         WingTransformProgram(WingTransformProgram&&) noexcept = delete;
         WingTransformProgram& operator=(WingTransformProgram&&) noexcept = delete;
-        virtual ~WingTransformProgram(void) noexcept override;
+        virtual ~WingTransformProgram(void) noexcept override = default;
 
 #pragma endregion
 
     public:
         /// <summary>
         /// Creates and returns a transform feedback object initialized with
-        /// destination buffers of appropriate size for receiving the
-        /// transformed wing geometry.
+        /// a destination buffer of appropriate size for receiving the
+        /// transformed geometry of the specified number of wings.
         /// </summary>
+        /// <param name="numWings">The number of wings the buffer can hold.</param>
         /// <returns>The transform feedback object.</returns>
-        std::shared_ptr<WingTransformFeedback const> CreateTransformFeedback(void) const;
+        std::shared_ptr<WingTransformFeedback const> CreateTransformFeedback(GLsizei numWings) const;
 
         /// <summary>
-        /// Generates the transformed vertex data for a new wing.
-        /// This applies the rotations and translations to put the wing in the
+        /// Generates the transformed vertex data for several new wings.
+        /// This applies the rotations and translations to put each wing in the
         /// correct place, and places the vertex coordinates and colors for the
-        /// wing into the buffers specified by the transform feedback object.
+        /// wings into consecutive slots of the buffer specified by the
+        /// transform feedback object.
         /// </summary>
-        /// <param name="radius">The radius of the wing around the central axis.</param>
-        /// <param name="angle">The angle of the wing around the central axis.</param>
-        /// <param name="roll">The roll of the wing.</param>
-        /// <param name="pitch">The pitch of the wing.</param>
-        /// <param name="yaw">The yaw of the wing.</param>
-        /// <param name="red">The red component of the wing color.</param>
-        /// <param name="green">The green component of the wing color.</param>
-        /// <param name="blue">The blue component of the wing color.</param>
-        /// <param name="wingTransformFeedbackObject">The buffers that will be populated with the transformed wing.</param>
-        void TransformWing(GLfloat radius, GLfloat angle,
-            GLfloat roll, GLfloat pitch, GLfloat yaw,
-            GLfloat red, GLfloat green, GLfloat blue,
-            WingTransformFeedback const& wingTransformFeedbackObject) const;
+        /// <remarks>
+        /// <para>
+        /// The wings are captured in a single transform feedback pass, so
+        /// they must fit in the buffer without wrapping.  A caller that uses
+        /// the buffer as a ring must split a batch where it wraps.
+        /// </para>
+        /// <para>
+        /// The delta angle and delta Z of each wing are not used here.
+        /// </para>
+        /// </remarks>
+        /// <param name="wings">The parameters of each wing.</param>
+        /// <param name="anchors">The anchor of each wing, which is captured along with its vertices.</param>
+        /// <param name="firstWing">The slot in the buffer for the first wing.</param>
+        /// <param name="wingTransformFeedbackObject">The buffer that will be populated with the transformed wings.</param>
+        /// <param name="stateCache">The shadow of the OpenGL state.</param>
+        void TransformWings(std::span<WingParameters<GLfloat> const> wings,
+            std::span<AccumulatedDeltas<GLfloat>::Anchor const> anchors,
+            GLsizei firstWing,
+            WingTransformFeedback const& wingTransformFeedbackObject,
+            silnith::wings::gl::GLStateCache& stateCache) const;
 
     private:
         /// <summary>
@@ -79,31 +113,13 @@ namespace silnith::wings::gl4
         /// The vertex array used for transform feedback.
         /// This maintains the state of the enabled vertex attributes.
         /// </summary>
-        GLuint vertexArray{ 0 };
-
-        /// <summary>
-        /// The location of the uniform variable <c>radiusAngle</c>.
-        /// </summary>
-        /// <seealso cref="glUniform2f"/>
-        GLint const radiusAngleUniformLocation{ 0 };
-
-        /// <summary>
-        /// The location of the uniform variable <c>rollPitchYaw</c>.
-        /// </summary>
-        /// <seealso cref="glUniform3f"/>
-        GLint const rollPitchYawUniformLocation{ 0 };
-
-        /// <summary>
-        /// The location of the uniform variable <c>color</c>.
-        /// </summary>
-        /// <seealso cref="glUniform3f"/>
-        GLint const colorUniformLocation{ 0 };
+        VertexArray const vertexArray{};
 
         /// <summary>
-        /// The location of the uniform variable <c>edgeColor</c>.
+        /// The buffer holding the parameters of the wings being transformed,
+        /// one record per instance.  It is reallocated for every batch.
         /// </summary>
-        /// <seealso cref="glUniform3f"/>
-        GLint const edgeColorUniformLocation{ 0 };
+        Buffer const parameterBuffer{};
     };
 
 }
@@ -0,0 +1,142 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#include <GL/glew.h>
+
+#include <string>
+
+#include <cassert>
+
+#include "WingVertexBuffer.h"
+
+#include "DirectStateAccess.h"
+#include "VertexArray.h"
+
+namespace silnith::wings::gl4
+{
+
+    std::string const WingVertexBuffer::packFunctionDeclaration{
+        R"shaderText(
+/*
+ * Rounds to the nearest half float.  Wing coordinates are well inside the
+ * range of a half float, so anything too small for a normal half is flushed
+ * to zero and overflow is not considered.  A carry out of the mantissa
+ * correctly bumps the exponent.
+ */
+uint packHalf(float value) {
+    uint bits = floatBitsToUint(value);
+    uint sign = (bits >> 16) & 0x8000u;
+    int exponent = int((bits >> 23) & 0xffu) - 127 + 15;
+    if (exponent <= 0) {
+        return sign;
+    }
+    uint magnitude = (uint(exponent) << 10) | ((bits >> 13) & 0x3ffu);
+    return sign | (magnitude + ((bits >> 12) & 1u));
+}
+
+/*
+ * The fourth half of the position is always 1.0, so that the attribute
+ * reads back as a homogeneous coordinate.
+ */
+uvec3 packWingVertex(vec3 position, vec3 color) {
+    return uvec3(packHalf(position.x) | (packHalf(position.y) << 16),
+                 packHalf(position.z) | (0x3c00u << 16),
+                 packUnorm4x8(vec4(color, 1)));
+}
+)shaderText"
+    };
+
+    /// <summary>
+    /// The byte offset of the color within each vertex.
+    /// </summary>
+    static GLsizeiptr constexpr colorOffset{ 4 * 2 };
+
+    WingVertexBuffer::WingVertexBuffer(GLsizei numVertices)
+        : Buffer{},
+        numVertices{ numVertices },
+        anchorsOffset{ static_cast<GLintptr>(vertexSize) * numVertices }
+    {
+        AllocateStorage(static_cast<GLsizeiptr>(vertexSize + anchorSize) * numVertices, nullptr, GL_DYNAMIC_COPY);
+    }
+
+    void WingVertexBuffer::UseForCapture(GLuint transformFeedback, GLuint vertexIndex, GLuint anchorIndex, GLsizei firstVertex, GLsizei numVertices) const
+    {
+        assert(firstVertex >= 0);
+        assert(firstVertex + numVertices <= this->numVertices);
+
+        GLintptr const vertexOffset{ static_cast<GLintptr>(vertexSize) * firstVertex };
+        GLsizeiptr const vertexRangeSize{ static_cast<GLsizeiptr>(vertexSize) * numVertices };
+        GLintptr const anchorOffset{ anchorsOffset + static_cast<GLintptr>(anchorSize) * firstVertex };
+        GLsizeiptr const anchorRangeSize{ static_cast<GLsizeiptr>(anchorSize) * numVertices };
+        if (HasDirectStateAccess())
+        {
+            glTransformFeedbackBufferRange(transformFeedback, vertexIndex, GetName(), vertexOffset, vertexRangeSize);
+            glTransformFeedbackBufferRange(transformFeedback, anchorIndex, GetName(), anchorOffset, anchorRangeSize);
+        }
+        else
+        {
+            glBindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, vertexIndex, GetName(), vertexOffset, vertexRangeSize);
+            glBindBufferRange(GL_TRANSFORM_FEEDBACK_BUFFER, anchorIndex, GetName(), anchorOffset, anchorRangeSize);
+        }
+    }
+
+    void WingVertexBuffer::UsePositionsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation) const
+    {
+        vertexArray.UseBufferForAttribute(attributeLocation, GetName(), 4, GL_HALF_FLOAT, GL_FALSE, vertexSize, 0, 0);
+    }
+
+    void WingVertexBuffer::UseColorsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation) const
+    {
+        vertexArray.UseBufferForAttribute(attributeLocation, GetName(), 4, GL_UNSIGNED_BYTE, GL_TRUE, vertexSize, colorOffset, 0);
+    }
+
+    void WingVertexBuffer::UseAnchorsForVertexAttribute(VertexArray const& vertexArray, GLuint attributeLocation) const
+    {
+        vertexArray.UseBufferForAttribute(attributeLocation, GetName(), 3, GL_FLOAT, GL_FALSE, anchorSize, anchorsOffset, 0);
+    }
+
+    silnith::wings::gl::GLStateCache::VertexAttributePointer WingVertexBuffer::GetPositionsPointer(void) const
+    {
+        return silnith::wings::gl::GLStateCache::VertexAttributePointer{
+            .buffer = GetName(),
+            .size = 4,
+            .type = GL_HALF_FLOAT,
+            .normalized = GL_FALSE,
+            .stride = vertexSize,
+            .offset = 0,
+            .divisor = 0,
+        };
+    }
+
+    silnith::wings::gl::GLStateCache::VertexAttributePointer WingVertexBuffer::GetColorsPointer(void) const
+    {
+        return silnith::wings::gl::GLStateCache::VertexAttributePointer{
+            .buffer = GetName(),
+            .size = 4,
+            .type = GL_UNSIGNED_BYTE,
+            .normalized = GL_TRUE,
+            .stride = vertexSize,
+            .offset = colorOffset,
+            .divisor = 0,
+        };
+    }
+
+    silnith::wings::gl::GLStateCache::VertexAttributePointer WingVertexBuffer::GetAnchorsPointer(void) const
+    {
+        return silnith::wings::gl::GLStateCache::VertexAttributePointer{
+            .buffer = GetName(),
+            .size = 3,
+            .type = GL_FLOAT,
+            .normalized = GL_FALSE,
+            .stride = anchorSize,
+            .offset = anchorsOffset,
+            .divisor = 0,
+        };
+    }
+
+    GLsizei WingVertexBuffer::getNumVertices(void) const
+    {
+        return numVertices;
+    }
+
+}
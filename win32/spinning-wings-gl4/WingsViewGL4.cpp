@@ -6,12 +6,21 @@
 
 #include <array>
 #include <cassert>
-#include <deque>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <sstream>
-
-#include "CurveGenerator.h"
+#include <vector>
+
+#include "AccumulatedDeltas.h"
+#include "GLStateCache.h"
+#include "Instrumentation.h"
+#include "Philox4x32.h"
+#include "RingBuffer.h"
+#include "WingCurves.h"
 #include "WingGL4.h"
+#include "WingParameters.h"
 
 #include "WingGeometry.h"
 
@@ -20,8 +29,15 @@
 #include "ModelViewProjectionUniformBuffer.h"
 #include "WingTransformFeedback.h"
 
+#include "WingInstanceBuffer.h"
+#include "WingStreamBuffer.h"
+
+#include "WingCullingProgram.h"
+#include "WingCurveComputeProgram.h"
 #include "WingTransformProgram.h"
 #include "WingRenderProgram.h"
+#include "WingInstancedRenderProgram.h"
+#include "WingStreamRenderProgram.h"
 
 #include "RotateVertexShader.h"
 #include "TranslateVertexShader.h"
@@ -35,30 +51,187 @@ using namespace std::literals::string_literals;
 namespace silnith::wings::gl4
 {
 
-	std::size_t constexpr numWings{ 40 };
+	std::size_t numWings{ defaultNumWings };
+
+	/// <summary>
+	/// How the wing transformations reach the GPU.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// The instanced and mapped stream pipelines cost the same number of
+	/// driver calls per frame regardless of <see cref="numWings"/>.
+	/// </para>
+	/// </remarks>
+	WingPipeline pipeline{ WingPipeline::Instanced };
 
 	// TODO: Investigate glObjectLabel
 	GLint glMajorVersion{ 1 };
 	GLint glMinorVersion{ 0 };
 
-	std::deque<Wing> wings{};
-
-	CurveGenerator<GLfloat> radiusCurve{ 10.0f, -15.0f, 15.0f, false, 0.1f, 0.01f, 150 };
-	CurveGenerator<GLfloat> angleCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120) };
-	CurveGenerator<GLfloat> deltaAngleCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(15.0f, 0.2f, 0.02f, 80) };
-	CurveGenerator<GLfloat> deltaZCurve{ 0.5f, 0.4f, 0.7f, false, 0.01f, 0.001f, 200 };
-	CurveGenerator<GLfloat> rollCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 1.0f, 0.25f, 80) };
-	CurveGenerator<GLfloat> pitchCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 2.0f, 0.25f, 40) };
-	CurveGenerator<GLfloat> yawCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 1.5f, 0.25f, 50) };
-	CurveGenerator<GLfloat> redCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 95) };
-	CurveGenerator<GLfloat> greenCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 40) };
-	CurveGenerator<GLfloat> blueCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 70) };
+	RingBuffer<Wing> wings{ numWings };
+
+	/// <summary>
+	/// The delta angle and delta Z accumulated by <see cref="wings"/>.
+	/// </summary>
+	AccumulatedDeltas<GLfloat> accumulatedDeltas{ numWings };
+
+	/// <summary>
+	/// The curve generators for all of the parameters that define how a wing moves.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This is a pointer so that <see cref="InitializeOpenGLState"/> can
+	/// replace it for a new seed, since the curves cannot be reassigned.
+	/// </para>
+	/// </remarks>
+	std::unique_ptr<WingCurves> curves{ nullptr };
+
+	/// <summary>
+	/// The untransformed wing, shared by all of the GLSL programs.
+	/// </summary>
+	std::shared_ptr<WingGeometry const> wingGeometry{ nullptr };
 
 	std::unique_ptr<WingTransformProgram> wingTransformProgram{ nullptr };
+
+	/// <summary>
+	/// The transform feedback object that captures every wing in
+	/// <see cref="wings"/>, one slot per wing.
+	/// </summary>
+	std::shared_ptr<WingTransformFeedback const> wingTransformFeedback{ nullptr };
 	std::unique_ptr<WingRenderProgram> wingRenderProgram{ nullptr };
 
+	std::unique_ptr<WingInstanceBuffer> wingInstanceBuffer{ nullptr };
+	std::unique_ptr<WingInstancedRenderProgram> wingInstancedRenderProgram{ nullptr };
+
+	/// <summary>
+	/// The compute program that steps copies of <see cref="curves"/> on the
+	/// GPU and writes into <see cref="wingInstanceBuffer"/>.
+	/// </summary>
+	std::unique_ptr<WingCurveComputeProgram> wingCurveComputeProgram{ nullptr };
+
+	/// <summary>
+	/// The compute program that writes a draw command for each wing in
+	/// <see cref="wingInstanceBuffer"/> that is inside the view.
+	/// </summary>
+	std::unique_ptr<WingCullingProgram> wingCullingProgram{ nullptr };
+
+	std::unique_ptr<WingStreamBuffer> wingStreamBuffer{ nullptr };
+	std::unique_ptr<WingStreamRenderProgram> wingStreamRenderProgram{ nullptr };
+
+	/// <summary>
+	/// The shadow of the OpenGL state that the programs change every frame.
+	/// </summary>
+	std::unique_ptr<silnith::wings::gl::GLStateCache> stateCache{ nullptr };
+
+	/// <summary>
+	/// The time from <see cref="InitializeOpenGLState"/> to the first
+	/// complete frame.
+	/// </summary>
+	std::unique_ptr<instrumentation::FirstFrameTimer const> firstFrameTimer{ nullptr };
+
+	namespace
+	{
+
+		/// <summary>
+		/// Steps every curve once.
+		/// </summary>
+		/// <returns>The parameters of the next wing.</returns>
+		[[nodiscard]]
+		WingParameters<GLfloat> NextWingParameters(void)
+		{
+			return curves->getNextParameters();
+		}
+
+		/// <summary>
+		/// Adds a new wing to the front of <see cref="wings"/> without
+		/// transforming it.  Until the history is full, each wing takes the
+		/// next slot in the transform feedback buffers, after that it reuses
+		/// the slot of the oldest wing.
+		/// </summary>
+		/// <param name="parameters">The parameters of the new wing.</param>
+		/// <returns>The new wing.</returns>
+		Wing const& AddWing(WingParameters<GLfloat> const& parameters)
+		{
+			AccumulatedDeltas<GLfloat>::Anchor const anchor{ accumulatedDeltas.AddWing(parameters.deltaAngle, parameters.deltaZ) };
+			if (wings.full())
+			{
+				/*
+				 * If a wing expires off the end of the list of wings, we can reuse
+				 * the wing and its slot in the transform feedback buffers for the
+				 * newly-created wing.  The old data will be overwritten.
+				 */
+				wings.recycle_front().setAnchor(anchor);
+			}
+			else
+			{
+				/*
+				 * Until the list is full, the wings take the slots in order.
+				 */
+				GLint const firstVertex{ static_cast<GLint>(wings.size()) * wingGeometry->getNumVertices() };
+				wings.emplace_front(anchor, firstVertex);
+			}
+			return wings.front();
+		}
+
+		/// <summary>
+		/// Stores the parameters of a new wing for the pipelines that
+		/// transform the wings while rendering.
+		/// </summary>
+		/// <param name="parameters">The parameters of the new wing.</param>
+		void StoreWingParameters(WingParameters<GLfloat> const& parameters)
+		{
+			switch (pipeline)
+			{
+			case WingPipeline::TransformFeedback:
+			case WingPipeline::Compute:
+				assert(false);
+				break;
+			case WingPipeline::Instanced:
+			case WingPipeline::SinglePass:
+				wingInstanceBuffer->AddWing(parameters.radius, parameters.angle,
+					parameters.deltaAngle, parameters.deltaZ,
+					parameters.roll, parameters.pitch, parameters.yaw,
+					parameters.red, parameters.green, parameters.blue);
+				break;
+			case WingPipeline::MappedStream:
+				wingStreamBuffer->AddWing(parameters.radius, parameters.angle,
+					parameters.deltaAngle, parameters.deltaZ,
+					parameters.roll, parameters.pitch, parameters.yaw,
+					parameters.red, parameters.green, parameters.blue);
+				break;
+			}
+		}
+
+	}
+
 	void InitializeOpenGLState(void)
 	{
+		InitializeOpenGLState(WingPipeline::Instanced);
+	}
+
+	void InitializeOpenGLState(WingPipeline requestedPipeline)
+	{
+		InitializeOpenGLState(requestedPipeline, defaultNumWings, Philox4x32::generateRandomSeed());
+	}
+
+	void InitializeOpenGLState(WingPipeline requestedPipeline, std::size_t requestedNumWings, std::uint64_t seed)
+	{
+		firstFrameTimer = std::make_unique<instrumentation::FirstFrameTimer const>();
+
+		pipeline = requestedPipeline;
+		numWings = requestedNumWings;
+
+		if (pipeline == WingPipeline::Compute && !GLEW_VERSION_4_3)
+		{
+			pipeline = WingPipeline::Instanced;
+		}
+
+		wings = RingBuffer<Wing>{ numWings };
+		accumulatedDeltas = AccumulatedDeltas<GLfloat>{ numWings };
+		curves = std::make_unique<WingCurves>(seed);
+
+		stateCache = std::make_unique<silnith::wings::gl::GLStateCache>();
+
 		glGetIntegerv(GL_MAJOR_VERSION, &glMajorVersion);
 		glGetIntegerv(GL_MINOR_VERSION, &glMinorVersion);
 
@@ -89,83 +262,247 @@ namespace silnith::wings::gl4
 		 * Set up the pieces needed to render one single
 		 * (untransformed, uncolored) wing.
 		 */
-		std::shared_ptr<WingGeometry const> wingGeometry{ std::make_shared<WingGeometry const>() };
+		wingGeometry = std::make_shared<WingGeometry const>();
 
 		std::shared_ptr<RotateVertexShader const> rotateMatrixShader{ std::make_shared<RotateVertexShader const>() };
 		std::shared_ptr<TranslateVertexShader const> translateMatrixShader{ std::make_shared<TranslateVertexShader const>() };
 		std::shared_ptr<VertexShader const> scaleMatrixShader{
 			VertexShader::MakeScaleMatrixShader()
 		};
-		wingTransformProgram = std::make_unique<WingTransformProgram>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+		switch (pipeline)
+		{
+		case WingPipeline::TransformFeedback:
+			wingTransformProgram = std::make_unique<WingTransformProgram>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+			wingTransformFeedback = wingTransformProgram->CreateTransformFeedback(static_cast<GLsizei>(numWings));
+
+			wingRenderProgram = std::make_unique<WingRenderProgram>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+			break;
+		case WingPipeline::Instanced:
+			wingInstanceBuffer = std::make_unique<WingInstanceBuffer>(static_cast<GLsizei>(numWings));
+
+			wingInstancedRenderProgram = std::make_unique<WingInstancedRenderProgram>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+			break;
+		case WingPipeline::SinglePass:
+			/*
+			 * The edges are drawn by the fragment shader inside each wing, so
+			 * nothing needs to be pushed behind them.
+			 */
+			glDisable(GL_POLYGON_OFFSET_FILL);
+
+			wingInstanceBuffer = std::make_unique<WingInstanceBuffer>(static_cast<GLsizei>(numWings));
 
-		wingRenderProgram = std::make_unique<WingRenderProgram>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+			wingInstancedRenderProgram = std::make_unique<WingInstancedRenderProgram>(wingGeometry, rotateMatrixShader, translateMatrixShader, false, true);
+			break;
+		case WingPipeline::MappedStream:
+			wingStreamBuffer = std::make_unique<WingStreamBuffer>(static_cast<GLsizei>(numWings));
+
+			wingStreamRenderProgram = std::make_unique<WingStreamRenderProgram>(wingGeometry, rotateMatrixShader, translateMatrixShader);
+			break;
+		case WingPipeline::Compute:
+			wingInstanceBuffer = std::make_unique<WingInstanceBuffer>(static_cast<GLsizei>(numWings));
+			/*
+			 * The GPU continues the curves from their initial state.  The CPU
+			 * generators are not stepped again.
+			 */
+			wingCurveComputeProgram = std::make_unique<WingCurveComputeProgram>(curves->getInitialGenerators(), static_cast<GLsizei>(numWings));
+			wingCullingProgram = std::make_unique<WingCullingProgram>(wingGeometry, static_cast<GLsizei>(numWings));
+
+			wingInstancedRenderProgram = std::make_unique<WingInstancedRenderProgram>(wingGeometry, rotateMatrixShader, translateMatrixShader, true);
+			break;
+		}
 
 		glReleaseShaderCompiler();
 	}
 
 	void CleanupOpenGLState(void)
 	{
+		/*
+		 * The programs leave their own program and vertex array current
+		 * after drawing, rather than unbinding them every frame.  Unbind
+		 * them here so that deleting them below takes effect immediately.
+		 * The state cache goes first, because OpenGL recycles the names of
+		 * the objects it has seen.
+		 */
+		glBindVertexArray(0);
+		glUseProgram(0);
+		stateCache = nullptr;
+
 		wings.clear();
+		accumulatedDeltas.Clear();
+		curves = nullptr;
 
 		wingTransformProgram = nullptr;
+		wingTransformFeedback = nullptr;
 		wingRenderProgram = nullptr;
+
+		wingInstanceBuffer = nullptr;
+		wingInstancedRenderProgram = nullptr;
+		wingCurveComputeProgram = nullptr;
+		wingCullingProgram = nullptr;
+
+		wingStreamBuffer = nullptr;
+		wingStreamRenderProgram = nullptr;
+
+		wingGeometry = nullptr;
+
+		firstFrameTimer = nullptr;
 	}
 
 	void AdvanceAnimation(void)
 	{
+		if (pipeline == WingPipeline::Compute)
+		{
+			/*
+			 * The curves live on the GPU, so stepping them and storing the
+			 * new wing is a single dispatch.
+			 */
+			instrumentation::PhaseTimer const transformTimer{ instrumentation::Phase::Transform };
+			wingCurveComputeProgram->AdvanceCurves(*wingInstanceBuffer, 1, *stateCache);
+			glFlush();
+			return;
+		}
+
 		/*
 		 * Get the next updated values for all the parameters that define how
 		 * a wing moves.
 		 */
-		GLfloat const radius{ radiusCurve.getNextValue() };
-		GLfloat const angle{ angleCurve.getNextValue() };
-		GLfloat const deltaAngle{ deltaAngleCurve.getNextValue() };
-		GLfloat const deltaZ{ deltaZCurve.getNextValue() };
-		GLfloat const roll{ rollCurve.getNextValue() };
-		GLfloat const pitch{ pitchCurve.getNextValue() };
-		GLfloat const yaw{ yawCurve.getNextValue() };
-		GLfloat const red{ redCurve.getNextValue() };
-		GLfloat const green{ greenCurve.getNextValue() };
-		GLfloat const blue{ blueCurve.getNextValue() };
-
-		std::shared_ptr<WingTransformFeedback const> wingTransformFeedbackObject{ nullptr };
-		if (wings.empty() || wings.size() < numWings)
+		instrumentation::PhaseTimer curveTimer{ instrumentation::Phase::CurveStep };
+		WingParameters<GLfloat> const parameters{ NextWingParameters() };
+		curveTimer.Stop();
+
+		instrumentation::PhaseTimer const transformTimer{ instrumentation::Phase::Transform };
+
+		switch (pipeline)
+		{
+		case WingPipeline::TransformFeedback:
 		{
-			wingTransformFeedbackObject = wingTransformProgram->CreateTransformFeedback();
+			/*
+			 * Run a vertex shader to transform the wing based on its current
+			 * animation state, and capture the transformed geometry using transform
+			 * feedback.
+			 */
+			Wing const& wing{ AddWing(parameters) };
+			wingTransformProgram->TransformWings(std::span<WingParameters<GLfloat> const>{ &parameters, 1 },
+				std::span<AccumulatedDeltas<GLfloat>::Anchor const>{ &wing.getAnchor(), 1 },
+				wing.getFirstVertex() / wingGeometry->getNumVertices(),
+				*wingTransformFeedback, *stateCache);
+			break;
+		}
+		case WingPipeline::Instanced:
+		case WingPipeline::SinglePass:
+			/*
+			 * The vertex shader does the transformation while rendering,
+			 * so the parameters are simply stored.
+			 */
+			StoreWingParameters(parameters);
+			break;
+		case WingPipeline::MappedStream:
+			/*
+			 * This is a single record copied into mapped memory.  Nothing is
+			 * submitted to the GPU, so there is nothing to flush.
+			 */
+			StoreWingParameters(parameters);
+			return;
+		case WingPipeline::Compute:
+			assert(false);
+			break;
 		}
-		else
+
+		glFlush();
+	}
+
+	void WarmStart(void)
+	{
+		assert(wings.empty());
+		assert(!wingInstanceBuffer || wingInstanceBuffer->getNumWings() == 0);
+		assert(!wingStreamBuffer || wingStreamBuffer->getNumWings() == 0);
+
+		instrumentation::PhaseTimer const warmStartTimer{ instrumentation::Phase::WarmStart };
+
+		if (pipeline == WingPipeline::Compute)
 		{
 			/*
-			 * If a wing expires off the end of the list of wings, we can reuse
-			 * the transform feedback object and its buffers for the newly-created wing.
-			 * The old data will be overwritten.
+			 * The shader loops over the ticks, so the whole history is one dispatch.
 			 */
-			wingTransformFeedbackObject = wings.back().getTransformFeedbackObject();
-			wings.pop_back();
+			wingCurveComputeProgram->AdvanceCurves(*wingInstanceBuffer, static_cast<GLsizei>(numWings), *stateCache);
+			glFlush();
+			return;
 		}
 
-		wings.emplace_front(
-			wingTransformFeedbackObject,
-			deltaAngle, deltaZ);
+		std::vector<WingParameters<GLfloat> > history(numWings);
+		for (WingParameters<GLfloat>& parameters : history)
+		{
+			parameters = NextWingParameters();
+		}
 
-		/*
-		 * Run a vertex shader to transform the wing based on its current
-		 * animation state, and capture the transformed geometry using transform
-		 * feedback.
-		 */
-		wingTransformProgram->TransformWing(radius, angle,
-			roll, pitch, yaw,
-			red, green, blue,
-			*wingTransformFeedbackObject);
+		switch (pipeline)
+		{
+		case WingPipeline::TransformFeedback:
+		{
+			/*
+			 * The history starts empty, so the wings take the slots in order
+			 * and the whole history can be captured by one transform feedback pass.
+			 */
+			std::vector<AccumulatedDeltas<GLfloat>::Anchor> anchors{};
+			anchors.reserve(history.size());
+			for (WingParameters<GLfloat> const& parameters : history)
+			{
+				anchors.push_back(AddWing(parameters).getAnchor());
+			}
+			wingTransformProgram->TransformWings(history, anchors, 0, *wingTransformFeedback, *stateCache);
+			break;
+		}
+		case WingPipeline::Instanced:
+		case WingPipeline::SinglePass:
+			for (WingParameters<GLfloat> const& parameters : history)
+			{
+				StoreWingParameters(parameters);
+			}
+			break;
+		case WingPipeline::MappedStream:
+			for (WingParameters<GLfloat> const& parameters : history)
+			{
+				StoreWingParameters(parameters);
+			}
+			return;
+		case WingPipeline::Compute:
+			assert(false);
+			break;
+		}
 
 		glFlush();
 	}
 
 	void DrawFrame(void)
 	{
-		wingRenderProgram->RenderWings(wings);
+		bool complete{ false };
+		switch (pipeline)
+		{
+		case WingPipeline::TransformFeedback:
+			wingRenderProgram->RenderWings(wings, *wingTransformFeedback, accumulatedDeltas, *stateCache);
+			complete = wings.full();
+			break;
+		case WingPipeline::Instanced:
+		case WingPipeline::SinglePass:
+			wingInstancedRenderProgram->RenderWings(*wingInstanceBuffer, *stateCache);
+			complete = static_cast<std::size_t>(wingInstanceBuffer->getNumWings()) == numWings;
+			break;
+		case WingPipeline::MappedStream:
+			wingStreamRenderProgram->RenderWings(*wingStreamBuffer, *stateCache);
+			complete = static_cast<std::size_t>(wingStreamBuffer->getNumWings()) == numWings;
+			break;
+		case WingPipeline::Compute:
+			wingCullingProgram->CullWings(*wingInstanceBuffer, *wingCurveComputeProgram, *stateCache);
+			wingInstancedRenderProgram->RenderWings(*wingInstanceBuffer, *wingCurveComputeProgram, *wingCullingProgram, *stateCache);
+			complete = static_cast<std::size_t>(wingInstanceBuffer->getNumWings()) == numWings;
+			break;
+		}
 
 		glFlush();
+
+		stateCache->EndFrame();
+
+		firstFrameTimer->FrameDrawn(complete);
 	}
 
 	void Resize(GLsizei width, GLsizei height)
@@ -183,7 +520,26 @@ namespace silnith::wings::gl4
 		 */
 		glViewport(x, y, width, height);
 
-		wingRenderProgram->Ortho(static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+		switch (pipeline)
+		{
+		case WingPipeline::TransformFeedback:
+			wingRenderProgram->Ortho(static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+			break;
+		case WingPipeline::Instanced:
+		case WingPipeline::Compute:
+		case WingPipeline::SinglePass:
+			wingInstancedRenderProgram->Ortho(static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+			break;
+		case WingPipeline::MappedStream:
+			wingStreamRenderProgram->Ortho(static_cast<GLfloat>(width), static_cast<GLfloat>(height));
+			break;
+		}
+	}
+
+	silnith::wings::gl::GLStateCache& GetStateCache(void) noexcept
+	{
+		assert(stateCache);
+		return *stateCache;
 	}
 
 }
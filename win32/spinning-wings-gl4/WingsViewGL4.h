@@ -1,16 +1,98 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 #include <GL/glew.h>
 
+#include <cstddef>
+#include <cstdint>
+
+#include "GLStateCache.h"
+
 namespace silnith::wings::gl4
 {
 
+    /// <summary>
+    /// The ways the per-wing transformation can reach the GPU.
+    /// </summary>
+    enum class WingPipeline
+    {
+        /// <summary>
+        /// Each new wing is transformed once using transform feedback, and
+        /// every frame draws each wing from its captured buffers.
+        /// </summary>
+        TransformFeedback,
+
+        /// <summary>
+        /// Each new wing is appended to a set of instanced vertex attribute
+        /// arrays, and every frame draws all of the wings with one instanced
+        /// draw call per pass.
+        /// </summary>
+        Instanced,
+
+        /// <summary>
+        /// Each new wing only writes its parameters into a mapped
+        /// <see cref="WingStreamBuffer"/>, and every frame draws all of the
+        /// wings with one instanced draw call per pass.
+        /// </summary>
+        MappedStream,
+
+        /// <summary>
+        /// The curve generators are stepped by a compute shader, which
+        /// writes each new wing straight into the instanced vertex attribute
+        /// arrays.  Each tick is one dispatch.  Every frame a second dispatch
+        /// culls the wings outside the view, and the rest are drawn with one
+        /// indirect multi-draw call per pass.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This requires OpenGL 4.3.  Without it, <see cref="Instanced"/>
+        /// is used instead.
+        /// </para>
+        /// </remarks>
+        Compute,
+
+        /// <summary>
+        /// The same as <see cref="Instanced"/>, except that the outlines are
+        /// drawn by the fragment shader as part of the fill.  Every frame
+        /// is a single instanced draw call, without polygon offset or
+        /// blending.
+        /// </summary>
+        SinglePass,
+    };
+
+    /// <summary>
+    /// The number of wings animated when none is specified.
+    /// </summary>
+    std::size_t constexpr defaultNumWings{ 40 };
+
     /// <summary>
     /// Configures the OpenGL state machine for rendering the spinning wings animation.
     /// </summary>
     void InitializeOpenGLState(void);
 
+    /// <summary>
+    /// Configures the OpenGL state machine for rendering the spinning wings
+    /// animation using the specified pipeline.
+    /// </summary>
+    /// <param name="pipeline">How the wing transformations reach the GPU.</param>
+    void InitializeOpenGLState(WingPipeline pipeline);
+
+    /// <summary>
+    /// Configures the OpenGL state machine for rendering the spinning wings
+    /// animation using the specified pipeline, number of wings, and seed.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Two animations initialized with the same seed are identical.
+    /// </para>
+    /// </remarks>
+    /// <param name="pipeline">How the wing transformations reach the GPU.</param>
+    /// <param name="numWings">The number of wings to animate.</param>
+    /// <param name="seed">The seed for the curve generators.</param>
+    void InitializeOpenGLState(WingPipeline pipeline, std::size_t numWings, std::uint64_t seed);
+
     /// <summary>
     /// Cleans up any resources allocated by <c>InitializeOpenGLState</c>.
     /// </summary>
@@ -27,6 +109,22 @@ namespace silnith::wings::gl4
     /// </remarks>
     void AdvanceAnimation(void);
 
+    /// <summary>
+    /// Fills the entire wing history at once, so that the first frame drawn
+    /// is already a complete spiral.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This is equivalent to calling <c>AdvanceAnimation</c> once per wing,
+    /// except that with the <see cref="WingPipeline::TransformFeedback"/>
+    /// pipeline every wing is transformed by a single transform feedback
+    /// pass, and with the <see cref="WingPipeline::Compute"/> pipeline every
+    /// wing is generated by a single dispatch.  It must be called after <c>InitializeOpenGLState</c> and before
+    /// the animation is advanced for the first time.
+    /// </para>
+    /// </remarks>
+    void WarmStart(void);
+
     /// <summary>
     /// Renders the current spinning wings animation frame into the current
     /// rendering context.
@@ -57,4 +155,19 @@ namespace silnith::wings::gl4
     /// <param name="height">the new viewport height</param>
     void Resize(GLint x, GLint y, GLsizei width, GLsizei height);
 
+    /// <summary>
+    /// Returns the shadow of the OpenGL state that advancing and drawing the
+    /// animation changes, which counts the state changes that were issued
+    /// and elided.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This must only be called between <c>InitializeOpenGLState</c> and
+    /// <c>CleanupOpenGLState</c>.
+    /// </para>
+    /// </remarks>
+    /// <returns>The state cache.</returns>
+    [[nodiscard]]
+    silnith::wings::gl::GLStateCache& GetStateCache(void) noexcept;
+
 }
@@ -0,0 +1,92 @@
+#pragma once
+
+/*
+ * This header is force-included ahead of every source file in the benchmark
+ * (the /FI compiler option), including the sources it borrows from the other
+ * projects.  It must therefore come before any other OpenGL header.
+ */
+
+#include <cstdint>
+
+namespace silnith::wings::bench
+{
+
+	/// <summary>
+	/// The number of OpenGL calls issued so far by code compiled into the benchmark.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Entry points that GLEW loads at runtime are counted by redefining
+	/// <c>GLEW_GET_FUN</c>, so every function from OpenGL 1.2 onwards is
+	/// counted automatically.  The OpenGL 1.1 entry points are exported
+	/// directly by <c>opengl32.dll</c> or <c>libGL.so</c>, so only the ones
+	/// redefined below are counted.  Calls to GLU, WGL, GLX, and EGL are not
+	/// counted.
+	/// </para>
+	/// </remarks>
+	inline std::uint64_t glCallCount{ 0 };
+
+	/// <summary>
+	/// Counts one OpenGL call.
+	/// </summary>
+	inline void CountGLCall(void) noexcept
+	{
+		glCallCount++;
+	}
+
+}
+
+#define GLEW_GET_FUN(x) (::silnith::wings::bench::CountGLCall(), x)
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#ifdef SILNITH_WINGS_NO_GLEW
+#include <GL/gl.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#define SILNITH_WINGS_COUNTED_GL_CALL(function, ...) (::silnith::wings::bench::CountGLCall(), ::function(__VA_ARGS__))
+
+#define glBegin(...) SILNITH_WINGS_COUNTED_GL_CALL(glBegin, __VA_ARGS__)
+#define glBindTexture(...) SILNITH_WINGS_COUNTED_GL_CALL(glBindTexture, __VA_ARGS__)
+#define glBlendFunc(...) SILNITH_WINGS_COUNTED_GL_CALL(glBlendFunc, __VA_ARGS__)
+#define glCallList(...) SILNITH_WINGS_COUNTED_GL_CALL(glCallList, __VA_ARGS__)
+#define glClear(...) SILNITH_WINGS_COUNTED_GL_CALL(glClear, __VA_ARGS__)
+#define glColor3f(...) SILNITH_WINGS_COUNTED_GL_CALL(glColor3f, __VA_ARGS__)
+#define glColorPointer(...) SILNITH_WINGS_COUNTED_GL_CALL(glColorPointer, __VA_ARGS__)
+#define glDeleteLists(...) SILNITH_WINGS_COUNTED_GL_CALL(glDeleteLists, __VA_ARGS__)
+#define glDeleteTextures(...) SILNITH_WINGS_COUNTED_GL_CALL(glDeleteTextures, __VA_ARGS__)
+#define glDepthFunc(...) SILNITH_WINGS_COUNTED_GL_CALL(glDepthFunc, __VA_ARGS__)
+#define glDepthMask(...) SILNITH_WINGS_COUNTED_GL_CALL(glDepthMask, __VA_ARGS__)
+#define glDisable(...) SILNITH_WINGS_COUNTED_GL_CALL(glDisable, __VA_ARGS__)
+#define glDisableClientState(...) SILNITH_WINGS_COUNTED_GL_CALL(glDisableClientState, __VA_ARGS__)
+#define glDrawArrays(...) SILNITH_WINGS_COUNTED_GL_CALL(glDrawArrays, __VA_ARGS__)
+#define glDrawElements(...) SILNITH_WINGS_COUNTED_GL_CALL(glDrawElements, __VA_ARGS__)
+#define glEnable(...) SILNITH_WINGS_COUNTED_GL_CALL(glEnable, __VA_ARGS__)
+#define glEnableClientState(...) SILNITH_WINGS_COUNTED_GL_CALL(glEnableClientState, __VA_ARGS__)
+#define glEnd(...) SILNITH_WINGS_COUNTED_GL_CALL(glEnd, __VA_ARGS__)
+#define glEndList(...) SILNITH_WINGS_COUNTED_GL_CALL(glEndList, __VA_ARGS__)
+#define glFinish(...) SILNITH_WINGS_COUNTED_GL_CALL(glFinish, __VA_ARGS__)
+#define glFlush(...) SILNITH_WINGS_COUNTED_GL_CALL(glFlush, __VA_ARGS__)
+#define glGenLists(...) SILNITH_WINGS_COUNTED_GL_CALL(glGenLists, __VA_ARGS__)
+#define glGenTextures(...) SILNITH_WINGS_COUNTED_GL_CALL(glGenTextures, __VA_ARGS__)
+#define glGetError(...) SILNITH_WINGS_COUNTED_GL_CALL(glGetError, __VA_ARGS__)
+#define glGetIntegerv(...) SILNITH_WINGS_COUNTED_GL_CALL(glGetIntegerv, __VA_ARGS__)
+#define glGetString(...) SILNITH_WINGS_COUNTED_GL_CALL(glGetString, __VA_ARGS__)
+#define glHint(...) SILNITH_WINGS_COUNTED_GL_CALL(glHint, __VA_ARGS__)
+#define glLineWidth(...) SILNITH_WINGS_COUNTED_GL_CALL(glLineWidth, __VA_ARGS__)
+#define glLoadIdentity(...) SILNITH_WINGS_COUNTED_GL_CALL(glLoadIdentity, __VA_ARGS__)
+#define glMatrixMode(...) SILNITH_WINGS_COUNTED_GL_CALL(glMatrixMode, __VA_ARGS__)
+#define glNewList(...) SILNITH_WINGS_COUNTED_GL_CALL(glNewList, __VA_ARGS__)
+#define glOrtho(...) SILNITH_WINGS_COUNTED_GL_CALL(glOrtho, __VA_ARGS__)
+#define glPolygonMode(...) SILNITH_WINGS_COUNTED_GL_CALL(glPolygonMode, __VA_ARGS__)
+#define glPolygonOffset(...) SILNITH_WINGS_COUNTED_GL_CALL(glPolygonOffset, __VA_ARGS__)
+#define glPopMatrix(...) SILNITH_WINGS_COUNTED_GL_CALL(glPopMatrix, __VA_ARGS__)
+#define glPushMatrix(...) SILNITH_WINGS_COUNTED_GL_CALL(glPushMatrix, __VA_ARGS__)
+#define glRotatef(...) SILNITH_WINGS_COUNTED_GL_CALL(glRotatef, __VA_ARGS__)
+#define glTranslatef(...) SILNITH_WINGS_COUNTED_GL_CALL(glTranslatef, __VA_ARGS__)
+#define glVertex2f(...) SILNITH_WINGS_COUNTED_GL_CALL(glVertex2f, __VA_ARGS__)
+#define glVertexPointer(...) SILNITH_WINGS_COUNTED_GL_CALL(glVertexPointer, __VA_ARGS__)
+#define glViewport(...) SILNITH_WINGS_COUNTED_GL_CALL(glViewport, __VA_ARGS__)
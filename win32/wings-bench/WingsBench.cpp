@@ -0,0 +1,730 @@
+#ifdef SILNITH_WINGS_NO_GLEW
+#include <GL/gl.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#pragma comment (lib, "opengl32.lib")
+#pragma comment (lib, "glu32.lib")
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "GLCallCounter.h"
+
+#include "../wings-platform/AntiAliasing.h"
+#include "../wings-platform/Platform.h"
+
+#include "GLInfo.h"
+#include "GLStateCache.h"
+#include "Instrumentation.h"
+#include "WingsView.h"
+#include "WingsViewBatched.h"
+
+#ifndef SILNITH_WINGS_NO_GLEW
+#include "../spinning-wings-gl2/WingRendererGL10.h"
+#include "../spinning-wings-gl2/WingRendererGL11.h"
+#include "../spinning-wings-gl2/WingRendererGL15.h"
+#include "../spinning-wings-gl2/WingRendererGL15Batched.h"
+#include "../spinning-wings-gl2/WingsViewGL2.h"
+#ifndef SILNITH_WINGS_NO_GLM
+#include "../spinning-wings-gl3/WingsViewGL3.h"
+#include "../spinning-wings-gl4/WingsViewGL4.h"
+#endif
+#endif
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::bench
+{
+
+	namespace
+	{
+
+		/// <summary>
+		/// The common shape of every renderer being compared.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The views for the different versions of OpenGL do not share a base
+		/// class, and the OpenGL 4 one is not a class at all, so each is
+		/// adapted to this.
+		/// </para>
+		/// </remarks>
+		class Scene
+		{
+		public:
+			explicit Scene(void) = default;
+
+#pragma region Rule of Five
+
+		public:
+			Scene(Scene const&) = delete;
+			Scene& operator=(Scene const&) = delete;
+			Scene(Scene&&) noexcept = delete;
+			Scene& operator=(Scene&&) noexcept = delete;
+			virtual ~Scene(void) noexcept = default;
+
+#pragma endregion
+
+		public:
+			virtual void AdvanceAnimation(void) = 0;
+			virtual void DrawFrame(void) = 0;
+			virtual void Resize(GLsizei width, GLsizei height) = 0;
+
+			/// <summary>
+			/// Returns the state changes that the renderer has issued and
+			/// elided since it was created.
+			/// </summary>
+			[[nodiscard]]
+			virtual gl::GLStateCache::Counts GetStateCounts(void) const = 0;
+
+			/// <summary>
+			/// Makes the renderer's state cache forget what it has seen, after
+			/// something else has changed the same state.
+			/// </summary>
+			virtual void InvalidateStateCache(void) = 0;
+		};
+
+		/// <summary>
+		/// Adapts one of the view classes to a <see cref="Scene"/>.
+		/// </summary>
+		template<typename View>
+		class ViewScene : public Scene
+		{
+		public:
+			explicit ViewScene(std::unique_ptr<View> view)
+				: Scene{}, view{ std::move(view) }
+			{}
+
+		public:
+			virtual void AdvanceAnimation(void) override
+			{
+				view->AdvanceAnimation();
+			}
+
+			virtual void DrawFrame(void) override
+			{
+				view->DrawFrame();
+			}
+
+			virtual void Resize(GLsizei width, GLsizei height) override
+			{
+				view->Resize(width, height);
+			}
+
+			virtual gl::GLStateCache::Counts GetStateCounts(void) const override
+			{
+				return view->getStateCache().getCounts();
+			}
+
+			virtual void InvalidateStateCache(void) override
+			{
+				view->getStateCache().Invalidate();
+			}
+
+		private:
+			std::unique_ptr<View> const view;
+		};
+
+#if !defined(SILNITH_WINGS_NO_GLEW) && !defined(SILNITH_WINGS_NO_GLM)
+		/// <summary>
+		/// Adapts the OpenGL 4 functions to a <see cref="Scene"/>.
+		/// </summary>
+		class GL4Scene : public Scene
+		{
+		public:
+			explicit GL4Scene(gl4::WingPipeline pipeline, std::size_t numWings, std::uint64_t seed)
+				: Scene{}
+			{
+				gl4::InitializeOpenGLState(pipeline, numWings, seed);
+			}
+
+			virtual ~GL4Scene(void) noexcept override
+			{
+				gl4::CleanupOpenGLState();
+			}
+
+		public:
+			virtual void AdvanceAnimation(void) override
+			{
+				gl4::AdvanceAnimation();
+			}
+
+			virtual void DrawFrame(void) override
+			{
+				gl4::DrawFrame();
+			}
+
+			virtual void Resize(GLsizei width, GLsizei height) override
+			{
+				gl4::Resize(width, height);
+			}
+
+			virtual gl::GLStateCache::Counts GetStateCounts(void) const override
+			{
+				return gl4::GetStateCache().getCounts();
+			}
+
+			virtual void InvalidateStateCache(void) override
+			{
+				gl4::GetStateCache().Invalidate();
+			}
+		};
+#endif
+
+		/// <summary>
+		/// One of the renderers that can be benchmarked.
+		/// </summary>
+		struct Renderer
+		{
+			/// <summary>
+			/// The name used on the command line and in the results.
+			/// </summary>
+			char const* name;
+
+			/// <summary>
+			/// The kind of rendering context the renderer needs.
+			/// </summary>
+			platform::ContextVersion contextVersion;
+
+			/// <summary>
+			/// Creates the scene.  This is called with the context current.
+			/// </summary>
+			std::function<std::unique_ptr<Scene>(std::size_t numWings, std::uint64_t seed)> makeScene;
+
+			/// <summary>
+			/// Whether the renderer draws the edges in a fragment shader
+			/// instead of as lines.  Such a renderer only supports
+			/// <see cref="platform::AntiAliasing::Shader"/>, and no other
+			/// renderer does.
+			/// </summary>
+			bool shaderEdges{ false };
+		};
+
+		platform::ContextVersion constexpr legacyContext{ 0, 0, false };
+		platform::ContextVersion constexpr gl32CoreContext{ 3, 2, true };
+		platform::ContextVersion constexpr gl41CoreContext{ 4, 1, true };
+		platform::ContextVersion constexpr gl43CoreContext{ 4, 3, true };
+
+#ifndef SILNITH_WINGS_NO_GLEW
+		template<typename WingRenderer, gl2::WingTransform wingTransform = gl2::WingTransform::Precomputed>
+		std::unique_ptr<Scene> MakeGL2Scene(std::size_t numWings, std::uint64_t seed)
+		{
+			return std::make_unique<ViewScene<gl2::WingsViewGL2> >(std::make_unique<gl2::WingsViewGL2>(gl::GLInfo{},
+				std::make_unique<WingRenderer>(),
+				wingTransform,
+				numWings, seed));
+		}
+#endif
+
+		std::vector<Renderer> const renderers{
+			{ "gl1", legacyContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<ViewScene<gl::WingsView> >(std::make_unique<gl::WingsView>(gl::GLInfo{}, numWings, seed));
+				} },
+			{ "gl1-batched", legacyContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<ViewScene<gl::WingsViewBatched> >(std::make_unique<gl::WingsViewBatched>(gl::GLInfo{}, numWings, seed));
+				} },
+#ifndef SILNITH_WINGS_NO_GLEW
+			{ "gl2-gl10", legacyContext, MakeGL2Scene<gl::WingRendererGL10> },
+			{ "gl2-gl11", legacyContext, MakeGL2Scene<gl::WingRendererGL11> },
+			{ "gl2-gl15", legacyContext, MakeGL2Scene<gl::WingRendererGL15> },
+			{ "gl2-shader", legacyContext, MakeGL2Scene<gl::WingRendererGL15, gl2::WingTransform::Shader> },
+			{ "gl2-batched", legacyContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<ViewScene<gl2::WingsViewGL2> >(std::make_unique<gl2::WingsViewGL2>(gl::GLInfo{},
+						std::make_unique<gl::WingRendererGL15Batched>(numWings),
+						numWings, seed));
+				} },
+#ifndef SILNITH_WINGS_NO_GLM
+			{ "gl3-tf", gl32CoreContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<ViewScene<gl3::WingsViewGL3> >(std::make_unique<gl3::WingsViewGL3>(gl3::WingPipeline::TransformFeedback, numWings, seed));
+				} },
+			{ "gl3-stream", gl32CoreContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<ViewScene<gl3::WingsViewGL3> >(std::make_unique<gl3::WingsViewGL3>(gl3::WingPipeline::MappedStream, numWings, seed));
+				} },
+			{ "gl4-tf", gl41CoreContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<GL4Scene>(gl4::WingPipeline::TransformFeedback, numWings, seed);
+				} },
+			{ "gl4-instanced", gl41CoreContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<GL4Scene>(gl4::WingPipeline::Instanced, numWings, seed);
+				} },
+			{ "gl4-stream", gl41CoreContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<GL4Scene>(gl4::WingPipeline::MappedStream, numWings, seed);
+				} },
+			{ "gl4-compute", gl43CoreContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<GL4Scene>(gl4::WingPipeline::Compute, numWings, seed);
+				} },
+			{ "gl4-single-pass", gl41CoreContext, [](std::size_t numWings, std::uint64_t seed) -> std::unique_ptr<Scene>
+				{
+					return std::make_unique<GL4Scene>(gl4::WingPipeline::SinglePass, numWings, seed);
+				}, true },
+#endif
+#endif
+		};
+
+		/// <summary>
+		/// The settings for a benchmark run, parsed from the command line.
+		/// </summary>
+		struct Options
+		{
+			std::size_t frames{ 1000 };
+			std::vector<std::size_t> wingCounts{ 40 };
+			std::uint64_t seed{ 1 };
+			std::vector<std::string> rendererNames{};
+			std::vector<platform::AntiAliasing> antiAliasingModes{ platform::AntiAliasing::LineSmooth, platform::AntiAliasing::Shader };
+			bool antiAliasingRequested{ false };
+			GLsizei width{ 512 };
+			GLsizei height{ 512 };
+			bool json{ false };
+		};
+
+		/// <summary>
+		/// The measurements for one renderer and wing count.
+		/// </summary>
+		struct Result
+		{
+			std::string renderer;
+			platform::AntiAliasing antiAliasing;
+			std::size_t numWings;
+			std::size_t frames;
+			double seconds;
+			double cpuSeconds;
+			std::uint64_t glCalls;
+			gl::GLStateCache::Counts stateChanges;
+		};
+
+		/// <summary>
+		/// Returns whether a renderer can draw with an anti-aliasing mode.
+		/// </summary>
+		[[nodiscard]]
+		bool Supports(Renderer const& renderer, platform::AntiAliasing antiAliasing)
+		{
+			return (antiAliasing == platform::AntiAliasing::Shader) == renderer.shaderEdges;
+		}
+
+		/// <summary>
+		/// Renders a number of frames with one renderer and measures them.
+		/// </summary>
+		/// <param name="renderer">The renderer to benchmark.</param>
+		/// <param name="antiAliasing">The anti-aliasing mode, which the renderer must support.</param>
+		/// <param name="numWings">The number of wings to animate.</param>
+		/// <param name="options">The benchmark settings.</param>
+		/// <returns>The measurements.</returns>
+		Result RunBenchmark(Renderer const& renderer, platform::AntiAliasing antiAliasing, std::size_t numWings, Options const& options)
+		{
+			std::unique_ptr<platform::RenderingContext> const context{ platform::CreateOffscreenContext(renderer.contextVersion, options.width, options.height) };
+
+			std::unique_ptr<Scene> const scene{ renderer.makeScene(numWings, options.seed) };
+			scene->Resize(options.width, options.height);
+
+			platform::ApplyAntiAliasing(antiAliasing);
+			std::unique_ptr<platform::MultisampleFramebuffer> framebuffer{ nullptr };
+			if (antiAliasing == platform::AntiAliasing::Multisample)
+			{
+				framebuffer = std::make_unique<platform::MultisampleFramebuffer>(platform::MultisampleFramebuffer::defaultSamples);
+				framebuffer->Resize(options.width, options.height);
+			}
+
+			/*
+			 * The anti-aliasing set-up does not go through the state cache.
+			 */
+			scene->InvalidateStateCache();
+
+			/*
+			 * Fill the history first, so that every measured frame draws the
+			 * full number of wings and recycles the oldest one.
+			 */
+			for (std::size_t frame{ 0 }; frame < numWings; frame++)
+			{
+				scene->AdvanceAnimation();
+			}
+			glFinish();
+
+			std::uint64_t const glCallsBefore{ glCallCount };
+			gl::GLStateCache::Counts const stateChangesBefore{ scene->GetStateCounts() };
+			double const cpuSecondsBefore{ platform::GetThreadCPUSeconds() };
+			std::chrono::steady_clock::time_point const start{ std::chrono::steady_clock::now() };
+
+			for (std::size_t frame{ 0 }; frame < options.frames; frame++)
+			{
+				scene->AdvanceAnimation();
+				if (framebuffer)
+				{
+					framebuffer->Bind();
+				}
+				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+				scene->DrawFrame();
+				if (framebuffer)
+				{
+					/*
+					 * The resolve is part of the cost of multisampling, so it
+					 * is measured with the frame.
+					 */
+					framebuffer->Resolve();
+				}
+			}
+			std::uint64_t const glCalls{ glCallCount - glCallsBefore };
+			gl::GLStateCache::Counts const stateChangesAfter{ scene->GetStateCounts() };
+			gl::GLStateCache::Counts const stateChanges{
+				.issued = stateChangesAfter.issued - stateChangesBefore.issued,
+				.elided = stateChangesAfter.elided - stateChangesBefore.elided,
+			};
+
+			/*
+			 * Nothing is presented, so wait for the GPU here instead of in
+			 * SwapBuffers.  Otherwise a deep command queue flatters the
+			 * renderers that submit the most work per call.
+			 */
+			glFinish();
+
+			std::chrono::duration<double> const elapsed{ std::chrono::steady_clock::now() - start };
+			double const cpuSeconds{ platform::GetThreadCPUSeconds() - cpuSecondsBefore };
+
+			return Result{ renderer.name, antiAliasing, numWings, options.frames, elapsed.count(), cpuSeconds, glCalls, stateChanges };
+		}
+
+		[[nodiscard]]
+		std::vector<std::string> SplitList(std::string const& list)
+		{
+			std::vector<std::string> items{};
+			std::istringstream stream{ list };
+			std::string item{};
+			while (std::getline(stream, item, ','))
+			{
+				if (!item.empty())
+				{
+					items.push_back(item);
+				}
+			}
+			return items;
+		}
+
+		[[nodiscard]]
+		bool IsSelected(Options const& options, Renderer const& renderer)
+		{
+			if (options.rendererNames.empty())
+			{
+				return true;
+			}
+			for (std::string const& name : options.rendererNames)
+			{
+				if (name == renderer.name)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void PrintUsage(std::ostream& output)
+		{
+			output << "usage: wings-bench [--frames N] [--wings N[,N...]] [--seed N]\n"
+				<< "                   [--renderers NAME[,NAME...]] [--size WIDTHxHEIGHT] [--json]\n"
+				<< "                   [--aa MODE[,MODE...]]\n"
+				<< "\nrenderers:";
+			for (Renderer const& renderer : renderers)
+			{
+				output << ' ' << renderer.name;
+			}
+			output << "\nanti-aliasing modes: none line-smooth msaa shader\n"
+				<< "\nEach renderer is measured with each requested mode that it supports.\n"
+				<< "gl4-single-pass supports only shader, and no other renderer supports it.\n"
+				<< "The Windows programs and the screensaver always use line-smooth.\n";
+		}
+
+		/// <summary>
+		/// Parses the command line.
+		/// </summary>
+		/// <exception cref="std::invalid_argument">If an argument is not understood.</exception>
+		[[nodiscard]]
+		Options ParseOptions(int argc, char* argv[])
+		{
+			Options options{};
+			for (int index{ 1 }; index < argc; index++)
+			{
+				std::string const argument{ argv[index] };
+				auto const nextValue{ [&]() -> std::string
+					{
+						if (index + 1 >= argc)
+						{
+							throw std::invalid_argument{ "Missing value for "s + argument };
+						}
+						return argv[++index];
+					} };
+
+				if (argument == "--frames"s)
+				{
+					options.frames = std::stoull(nextValue());
+				}
+				else if (argument == "--wings"s)
+				{
+					options.wingCounts.clear();
+					for (std::string const& count : SplitList(nextValue()))
+					{
+						options.wingCounts.push_back(std::stoull(count));
+					}
+				}
+				else if (argument == "--seed"s)
+				{
+					options.seed = std::stoull(nextValue());
+				}
+				else if (argument == "--renderers"s)
+				{
+					options.rendererNames = SplitList(nextValue());
+				}
+				else if (argument == "--size"s)
+				{
+					std::string const size{ nextValue() };
+					std::size_t const separator{ size.find('x') };
+					if (separator == std::string::npos)
+					{
+						throw std::invalid_argument{ "Expected WIDTHxHEIGHT: "s + size };
+					}
+					options.width = std::stoi(size.substr(0, separator));
+					options.height = std::stoi(size.substr(separator + 1));
+				}
+				else if (argument == "--json"s)
+				{
+					options.json = true;
+				}
+				else if (argument == "--aa"s)
+				{
+					options.antiAliasingModes.clear();
+					options.antiAliasingRequested = true;
+					for (std::string const& mode : SplitList(nextValue()))
+					{
+						options.antiAliasingModes.push_back(platform::ParseAntiAliasing(mode));
+					}
+				}
+				else
+				{
+					throw std::invalid_argument{ "Unknown argument: "s + argument };
+				}
+			}
+
+			for (std::size_t const numWings : options.wingCounts)
+			{
+				if (numWings == 0)
+				{
+					throw std::invalid_argument{ "The number of wings must be positive."s };
+				}
+			}
+			if (options.antiAliasingModes.empty())
+			{
+				throw std::invalid_argument{ "At least one anti-aliasing mode is required."s };
+			}
+			if (options.frames == 0 || options.width <= 0 || options.height <= 0)
+			{
+				throw std::invalid_argument{ "The frame count and size must be positive."s };
+			}
+			for (std::string const& name : options.rendererNames)
+			{
+				bool known{ false };
+				for (Renderer const& renderer : renderers)
+				{
+					known = known || name == renderer.name;
+				}
+				if (!known)
+				{
+					throw std::invalid_argument{ "Unknown renderer: "s + name };
+				}
+			}
+
+			/*
+			 * Pairs of a renderer and a mode that it does not support are
+			 * skipped, but a renderer or mode that was asked for and would
+			 * never be measured is a mistake.  The default modes cover every
+			 * renderer between them.
+			 */
+			if (options.antiAliasingRequested)
+			{
+				for (platform::AntiAliasing const antiAliasing : options.antiAliasingModes)
+				{
+#ifdef SILNITH_WINGS_NO_GLEW
+					if (antiAliasing == platform::AntiAliasing::Multisample)
+					{
+						throw std::invalid_argument{ "Multisample anti-aliasing needs framebuffer objects, which this build of the benchmark does not have."s };
+					}
+#endif
+					bool supported{ false };
+					for (Renderer const& renderer : renderers)
+					{
+						supported = supported || (IsSelected(options, renderer) && Supports(renderer, antiAliasing));
+					}
+					if (!supported)
+					{
+						throw std::invalid_argument{ "No selected renderer supports "s + platform::GetAntiAliasingName(antiAliasing) + " anti-aliasing."s };
+					}
+				}
+				for (std::string const& name : options.rendererNames)
+				{
+					for (Renderer const& renderer : renderers)
+					{
+						if (name != renderer.name)
+						{
+							continue;
+						}
+						bool supported{ false };
+						for (platform::AntiAliasing const antiAliasing : options.antiAliasingModes)
+						{
+							supported = supported || Supports(renderer, antiAliasing);
+						}
+						if (!supported)
+						{
+							throw std::invalid_argument{ "The "s + name + " renderer supports none of the requested anti-aliasing modes."s };
+						}
+					}
+				}
+			}
+			return options;
+		}
+
+		void WriteCsv(std::ostream& output, std::vector<Result> const& results)
+		{
+			output << "renderer,aa,wings,frames,fps,cpu_us_per_frame,gl_calls_per_frame,state_issued_per_frame,state_elided_per_frame\n";
+			output << std::fixed;
+			for (Result const& result : results)
+			{
+				double const frames{ static_cast<double>(result.frames) };
+				output << result.renderer
+					<< ',' << platform::GetAntiAliasingName(result.antiAliasing)
+					<< ',' << result.numWings
+					<< ',' << result.frames
+					<< ',' << std::setprecision(1) << frames / result.seconds
+					<< ',' << std::setprecision(1) << result.cpuSeconds / frames * 1.0e6
+					<< ',' << std::setprecision(1) << static_cast<double>(result.glCalls) / frames
+					<< ',' << std::setprecision(1) << static_cast<double>(result.stateChanges.issued) / frames
+					<< ',' << std::setprecision(1) << static_cast<double>(result.stateChanges.elided) / frames
+					<< '\n';
+			}
+		}
+
+		void WriteJson(std::ostream& output, Options const& options, std::vector<Result> const& results)
+		{
+			output << "{\n  \"seed\": " << options.seed
+				<< ",\n  \"width\": " << options.width
+				<< ",\n  \"height\": " << options.height
+				<< ",\n  \"results\": [";
+			output << std::fixed;
+			for (std::size_t index{ 0 }; index < results.size(); index++)
+			{
+				Result const& result{ results[index] };
+				double const frames{ static_cast<double>(result.frames) };
+				output << (index == 0 ? "\n" : ",\n")
+					<< "    { \"renderer\": \"" << result.renderer << "\""
+					<< ", \"aa\": \"" << platform::GetAntiAliasingName(result.antiAliasing) << "\""
+					<< ", \"wings\": " << result.numWings
+					<< ", \"frames\": " << result.frames
+					<< ", \"fps\": " << std::setprecision(1) << frames / result.seconds
+					<< ", \"cpu_us_per_frame\": " << std::setprecision(1) << result.cpuSeconds / frames * 1.0e6
+					<< ", \"gl_calls_per_frame\": " << std::setprecision(1) << static_cast<double>(result.glCalls) / frames
+					<< ", \"state_issued_per_frame\": " << std::setprecision(1) << static_cast<double>(result.stateChanges.issued) / frames
+					<< ", \"state_elided_per_frame\": " << std::setprecision(1) << static_cast<double>(result.stateChanges.elided) / frames
+					<< " }";
+			}
+			output << "\n  ]\n}\n";
+		}
+
+	}
+
+}
+
+/// <summary>
+/// Renders the spinning wings offscreen with every renderer and reports how
+/// each one performs.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Every renderer animates the same wings, because the curves are seeded
+/// with the same fixed seed.  The results are written to standard output as
+/// CSV, or as JSON with <c>--json</c>, so that they can be compared between
+/// revisions.  Each renderer is measured once per anti-aliasing mode it
+/// supports, so the modes can be compared on the same machine.  Renderers
+/// that the driver cannot support are reported on standard error and
+/// skipped.
+/// </para>
+/// </remarks>
+/// <returns>Zero on success, one if any renderer failed, two for bad arguments.</returns>
+int main(int argc, char* argv[])
+{
+	using namespace silnith::wings::bench;
+
+	Options options{};
+	try
+	{
+		options = ParseOptions(argc, argv);
+	}
+	catch (std::exception const& e)
+	{
+		std::cerr << e.what() << '\n';
+		PrintUsage(std::cerr);
+		return 2;
+	}
+
+	int exitCode{ 0 };
+	std::vector<Result> results{};
+	for (Renderer const& renderer : renderers)
+	{
+		if (!IsSelected(options, renderer))
+		{
+			continue;
+		}
+		for (silnith::wings::platform::AntiAliasing const antiAliasing : options.antiAliasingModes)
+		{
+			if (!Supports(renderer, antiAliasing))
+			{
+				continue;
+			}
+			for (std::size_t const numWings : options.wingCounts)
+			{
+				try
+				{
+					results.push_back(RunBenchmark(renderer, antiAliasing, numWings, options));
+				}
+				catch (std::exception const& e)
+				{
+					std::cerr << renderer.name << " (" << silnith::wings::platform::GetAntiAliasingName(antiAliasing) << "): " << e.what() << '\n';
+					exitCode = 1;
+				}
+			}
+		}
+	}
+
+	if (options.json)
+	{
+		WriteJson(std::cout, options, results);
+	}
+	else
+	{
+		WriteCsv(std::cout, results);
+	}
+
+	silnith::wings::instrumentation::WriteReport();
+
+	return exitCode;
+}
@@ -0,0 +1,453 @@
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "../wings-platform/Platform.h"
+
+#include "AccumulatedDeltas.h"
+#include "GLStateCache.h"
+#include "WingCurves.h"
+#include "WingParameters.h"
+
+#include "../spinning-wings-gl4/WingCurveComputeProgram.h"
+#include "../spinning-wings-gl4/WingInstanceBuffer.h"
+#include "../spinning-wings-gl4/WingsViewGL4.h"
+
+using namespace std::literals::string_literals;
+
+/*
+ * Tests that compare what the OpenGL views compute on the GPU against a
+ * reference.  Unlike the unit tests in wings-tests, these need a rendering
+ * context, so they are a program of their own that creates an offscreen one.
+ * The test to run is named on the command line, and a failure is reported
+ * by the exit status.
+ */
+namespace silnith::wings::gltests
+{
+
+	namespace
+	{
+
+		/// <summary>
+		/// Throws if a condition does not hold.
+		/// </summary>
+		/// <param name="condition">The condition that must hold.</param>
+		/// <param name="message">What went wrong if it does not.</param>
+		/// <exception cref="std::runtime_error">If <paramref name="condition"/> is <c>false</c>.</exception>
+		void Check(bool condition, std::string const& message)
+		{
+			if (!condition)
+			{
+				throw std::runtime_error{ message };
+			}
+		}
+
+		/// <summary>
+		/// Reads back the range of a buffer bound to an indexed buffer target.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// A buffer bound with <c>glBindBufferBase</c> reports a size of zero,
+		/// and is read in its entirety.
+		/// </para>
+		/// </remarks>
+		/// <param name="bindingTarget">The query for the buffer bound at the index, such as <c>GL_SHADER_STORAGE_BUFFER_BINDING</c>.</param>
+		/// <param name="startTarget">The query for the start of the bound range.</param>
+		/// <param name="sizeTarget">The query for the size of the bound range.</param>
+		/// <param name="bindingIndex">The binding index.</param>
+		/// <returns>The contents of the bound range.</returns>
+		[[nodiscard]]
+		std::vector<GLfloat> ReadBoundRange(GLenum bindingTarget, GLenum startTarget, GLenum sizeTarget, GLuint bindingIndex)
+		{
+			GLint buffer{ 0 };
+			GLint64 start{ 0 };
+			GLint64 size{ 0 };
+			glGetIntegeri_v(bindingTarget, bindingIndex, &buffer);
+			glGetInteger64i_v(startTarget, bindingIndex, &start);
+			glGetInteger64i_v(sizeTarget, bindingIndex, &size);
+
+			glBindBuffer(GL_COPY_READ_BUFFER, static_cast<GLuint>(buffer));
+			if (size == 0)
+			{
+				glGetBufferParameteri64v(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+			}
+			std::vector<GLfloat> contents(static_cast<std::size_t>(size) / sizeof(GLfloat));
+			glGetBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(start), static_cast<GLsizeiptr>(size), contents.data());
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			return contents;
+		}
+
+		/// <summary>
+		/// Throws unless two floats have the same bits.
+		/// </summary>
+		/// <param name="expected">The value computed on the CPU.</param>
+		/// <param name="actual">The value computed on the GPU.</param>
+		/// <param name="what">A description of the value.</param>
+		/// <exception cref="std::runtime_error">If the values differ.</exception>
+		void CheckIdentical(GLfloat expected, GLfloat actual, std::string const& what)
+		{
+			if (std::memcmp(&expected, &actual, sizeof(GLfloat)) != 0)
+			{
+				std::ostringstream message{};
+				message.precision(9);
+				message << what << ": expected " << expected << " but the GPU computed " << actual;
+				throw std::runtime_error{ message.str() };
+			}
+		}
+
+		/// <summary>
+		/// Steps the <see cref="WingCurves"/> on the CPU and copies of them in a
+		/// <see cref="gl4::WingCurveComputeProgram"/>, and checks that every
+		/// slot the compute shader writes is identical to the CPU result.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The curves are those every view uses.  The capacity is larger
+		/// than the longest acceleration segment, so every curve draws several
+		/// accelerations.  The dispatches mix full rings with single ticks, so
+		/// that both the warm start and the per-frame paths are covered, and
+		/// the ring wraps part way through a dispatch.
+		/// </para>
+		/// </remarks>
+		void TestComputeCurvesMatchCPU(void)
+		{
+			GLsizei constexpr capacity{ 256 };
+			std::array<GLsizei, 8> constexpr dispatches{ capacity, 1, 1, 100, capacity, 7, capacity, capacity };
+			std::uint64_t constexpr seed{ 0x5EED };
+
+			std::unique_ptr<platform::RenderingContext> const context{
+				platform::CreateOffscreenContext(platform::ContextVersion{ 4, 3, true }, 16, 16)
+			};
+
+			WingCurves curves{ seed };
+
+			gl::GLStateCache stateCache{};
+			gl4::WingInstanceBuffer wingInstanceBuffer{ capacity };
+			/*
+			 * The program copies the initial state of the generators, so
+			 * stepping the curves below follows the same curves on the CPU.
+			 */
+			gl4::WingCurveComputeProgram const wingCurveComputeProgram{ curves.getInitialGenerators(), capacity };
+
+			AccumulatedDeltas<GLfloat> accumulatedDeltas{ capacity };
+			std::vector<GLfloat> radiusAngles(2 * capacity);
+			std::vector<GLfloat> rollPitchYaws(3 * capacity);
+			std::vector<GLfloat> colors(3 * capacity);
+			std::vector<GLfloat> anchors(3 * capacity);
+
+			std::size_t tick{ 0 };
+			for (GLsizei const numTicks : dispatches)
+			{
+				/*
+				 * The ring starts at the first slot and every tick takes the next.
+				 */
+				GLsizei const firstSlot{ static_cast<GLsizei>(tick % capacity) };
+				wingCurveComputeProgram.AdvanceCurves(wingInstanceBuffer, numTicks, stateCache);
+
+				for (GLsizei index{ 0 }; index < numTicks; index++, tick++)
+				{
+					std::size_t const slot{ static_cast<std::size_t>((firstSlot + index) % capacity) };
+					WingParameters<GLfloat> const parameters{ curves.getNextParameters() };
+					radiusAngles[2 * slot + 0] = parameters.radius;
+					radiusAngles[2 * slot + 1] = parameters.angle;
+					rollPitchYaws[3 * slot + 0] = parameters.roll;
+					rollPitchYaws[3 * slot + 1] = parameters.pitch;
+					rollPitchYaws[3 * slot + 2] = parameters.yaw;
+					colors[3 * slot + 0] = parameters.red;
+					colors[3 * slot + 1] = parameters.green;
+					colors[3 * slot + 2] = parameters.blue;
+
+					AccumulatedDeltas<GLfloat>::Anchor const anchor{ accumulatedDeltas.AddWing(parameters.deltaAngle, parameters.deltaZ) };
+					anchors[3 * slot + 0] = anchor.angle;
+					anchors[3 * slot + 1] = anchor.z;
+					anchors[3 * slot + 2] = static_cast<GLfloat>(anchor.section);
+				}
+
+				/*
+				 * The binding points are only used to find the arrays again.
+				 */
+				glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+				wingInstanceBuffer.UseForShaderStorage(gl4::WingCurveComputeProgram::instanceBufferBindingIndex);
+				wingCurveComputeProgram.UseSectionOffsets(0);
+				std::array<std::vector<GLfloat> const*, 4> const expectedArrays{ &radiusAngles, &rollPitchYaws, &colors, &anchors };
+				std::array<std::string, 4> const arrayNames{ "radius and angle"s, "roll, pitch, and yaw"s, "color"s, "anchor"s };
+				for (std::size_t array{ 0 }; array < expectedArrays.size(); array++)
+				{
+					std::vector<GLfloat> const actual{ ReadBoundRange(GL_SHADER_STORAGE_BUFFER_BINDING, GL_SHADER_STORAGE_BUFFER_START, GL_SHADER_STORAGE_BUFFER_SIZE,
+						gl4::WingCurveComputeProgram::instanceBufferBindingIndex + static_cast<GLuint>(array)) };
+					std::vector<GLfloat> const& expected{ *expectedArrays[array] };
+					Check(actual.size() >= expected.size(), "The "s + arrayNames[array] + " array is too small."s);
+					for (std::size_t index{ 0 }; index < expected.size(); index++)
+					{
+						CheckIdentical(expected[index], actual[index],
+							arrayNames[array] + " element "s + std::to_string(index) + " after tick "s + std::to_string(tick));
+					}
+				}
+
+				/*
+				 * The section offsets are a std140 array of vec2, so each
+				 * element is padded to four floats.
+				 */
+				std::array<GLfloat, 2 * AccumulatedDeltas<GLfloat>::numSections> const expectedOffsets{ accumulatedDeltas.getSectionOffsets() };
+				std::vector<GLfloat> const actualOffsets{ ReadBoundRange(GL_UNIFORM_BUFFER_BINDING, GL_UNIFORM_BUFFER_START, GL_UNIFORM_BUFFER_SIZE, 0) };
+				Check(actualOffsets.size() >= 4 * AccumulatedDeltas<GLfloat>::numSections, "The section offsets are too small."s);
+				for (std::size_t section{ 0 }; section < AccumulatedDeltas<GLfloat>::numSections; section++)
+				{
+					CheckIdentical(expectedOffsets[2 * section + 0], actualOffsets[4 * section + 0], "section "s + std::to_string(section) + " angle offset"s);
+					CheckIdentical(expectedOffsets[2 * section + 1], actualOffsets[4 * section + 1], "section "s + std::to_string(section) + " Z offset"s);
+				}
+			}
+
+			Check(glGetError() == GL_NO_ERROR, "An OpenGL error occurred."s);
+		}
+
+		/// <summary>
+		/// A frame read back from the default framebuffer.
+		/// </summary>
+		struct Image
+		{
+			int width{ 0 };
+			int height{ 0 };
+
+			/// <summary>
+			/// The RGBA pixels, bottom row first.
+			/// </summary>
+			std::vector<GLubyte> pixels{};
+
+			/// <summary>
+			/// Returns whether anything was drawn at a pixel.  The background
+			/// is black.
+			/// </summary>
+			[[nodiscard]]
+			bool IsCovered(int x, int y) const noexcept
+			{
+				std::size_t const index{ 4 * (static_cast<std::size_t>(y) * width + x) };
+				return (pixels[index + 0] | pixels[index + 1] | pixels[index + 2]) != 0;
+			}
+
+			/// <summary>
+			/// Returns the largest difference of any color component between
+			/// the same pixel of two images.
+			/// </summary>
+			[[nodiscard]]
+			int Difference(Image const& other, int x, int y) const noexcept
+			{
+				std::size_t const index{ 4 * (static_cast<std::size_t>(y) * width + x) };
+				int difference{ 0 };
+				for (std::size_t component{ 0 }; component < 3; component++)
+				{
+					difference = std::max(difference, std::abs(pixels[index + component] - other.pixels[index + component]));
+				}
+				return difference;
+			}
+		};
+
+		/// <summary>
+		/// Animates the OpenGL 4 view with a pipeline and reads back the frame.
+		/// </summary>
+		/// <param name="pipeline">The pipeline to draw with.</param>
+		/// <param name="width">The width of the frame.</param>
+		/// <param name="height">The height of the frame.</param>
+		/// <param name="frames">The number of times to advance the animation before drawing.</param>
+		/// <param name="seed">The seed for the curve generators.</param>
+		/// <returns>The frame.</returns>
+		[[nodiscard]]
+		Image RenderGL4Frame(gl4::WingPipeline pipeline, int width, int height, std::size_t frames, std::uint64_t seed)
+		{
+			std::unique_ptr<platform::RenderingContext> const context{
+				platform::CreateOffscreenContext(platform::ContextVersion{ 4, 1, true }, width, height)
+			};
+
+			gl4::InitializeOpenGLState(pipeline, gl4::defaultNumWings, seed);
+			gl4::Resize(width, height);
+			for (std::size_t frame{ 0 }; frame < frames; frame++)
+			{
+				gl4::AdvanceAnimation();
+			}
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			gl4::DrawFrame();
+
+			Image image{ width, height, std::vector<GLubyte>(4 * static_cast<std::size_t>(width) * height) };
+			glPixelStorei(GL_PACK_ALIGNMENT, 1);
+			glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+			Check(glGetError() == GL_NO_ERROR, "An OpenGL error occurred."s);
+
+			gl4::CleanupOpenGLState();
+			return image;
+		}
+
+		/// <summary>
+		/// Returns the fraction of the pixels covered in one image that have
+		/// no covered pixel within a distance in another.
+		/// </summary>
+		/// <param name="image">The image whose covered pixels are checked.</param>
+		/// <param name="other">The image to look for them in.</param>
+		/// <param name="distance">How far a pixel may move.</param>
+		/// <returns>The fraction of the covered pixels that moved further.</returns>
+		[[nodiscard]]
+		double UnmatchedCoverage(Image const& image, Image const& other, int distance)
+		{
+			std::size_t covered{ 0 };
+			std::size_t unmatched{ 0 };
+			for (int y{ 0 }; y < image.height; y++)
+			{
+				for (int x{ 0 }; x < image.width; x++)
+				{
+					if (!image.IsCovered(x, y))
+					{
+						continue;
+					}
+					covered++;
+					bool matched{ false };
+					for (int otherY{ std::max(y - distance, 0) }; otherY <= std::min(y + distance, other.height - 1) && !matched; otherY++)
+					{
+						for (int otherX{ std::max(x - distance, 0) }; otherX <= std::min(x + distance, other.width - 1) && !matched; otherX++)
+						{
+							matched = other.IsCovered(otherX, otherY);
+						}
+					}
+					if (!matched)
+					{
+						unmatched++;
+					}
+				}
+			}
+			return covered == 0 ? 1.0 : static_cast<double>(unmatched) / static_cast<double>(covered);
+		}
+
+		/// <summary>
+		/// Renders the same seeded frame with the two-pass instanced pipeline
+		/// and the single-pass pipeline, and checks that they differ by no
+		/// more than the outlines.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The two pipelines are not expected to match pixel for pixel.  The
+		/// two-pass pipeline draws each outline as a smoothed line centered on
+		/// the edge of the wing, and the single-pass pipeline shades it just
+		/// inside.  So the check is in two parts, each with its own bound.
+		/// First, every pixel either frame covers must have a covered pixel
+		/// within one pixel in the other, which tests the shape and position of
+		/// every wing.  Second, the pixels at least two pixels inside the
+		/// covered area of both frames, which are away from any outline, must
+		/// have the same color to within a small tolerance.
+		/// </para>
+		/// <para>
+		/// With llvmpipe about 0.2% of the covered pixels fail the first part
+		/// and 0.6% of the interior pixels fail the second.  Drawing the next
+		/// frame instead, which moves every wing by one tick, fails 38% and 59%.
+		/// </para>
+		/// </remarks>
+		void TestSinglePassMatchesTwoPass(void)
+		{
+			int constexpr width{ 800 };
+			int constexpr height{ 600 };
+			std::size_t constexpr frames{ 100 };
+			std::uint64_t constexpr seed{ 1 };
+
+			int constexpr coverageDistance{ 1 };
+			double constexpr maximumUnmatchedCoverage{ 0.01 };
+			int constexpr interiorMargin{ 2 };
+			int constexpr colorTolerance{ 8 };
+			double constexpr maximumInteriorMismatch{ 0.02 };
+
+			Image const twoPass{ RenderGL4Frame(gl4::WingPipeline::Instanced, width, height, frames, seed) };
+			Image const singlePass{ RenderGL4Frame(gl4::WingPipeline::SinglePass, width, height, frames, seed) };
+
+			double const unmatchedCoverage{ std::max(
+				UnmatchedCoverage(twoPass, singlePass, coverageDistance),
+				UnmatchedCoverage(singlePass, twoPass, coverageDistance)) };
+			Check(unmatchedCoverage <= maximumUnmatchedCoverage,
+				"The wings of the two frames are in different places: "s + std::to_string(unmatchedCoverage) + " of the covered pixels moved."s);
+
+			std::size_t interior{ 0 };
+			std::size_t mismatched{ 0 };
+			for (int y{ interiorMargin }; y < height - interiorMargin; y++)
+			{
+				for (int x{ interiorMargin }; x < width - interiorMargin; x++)
+				{
+					bool inside{ true };
+					for (int nearY{ y - interiorMargin }; nearY <= y + interiorMargin && inside; nearY++)
+					{
+						for (int nearX{ x - interiorMargin }; nearX <= x + interiorMargin && inside; nearX++)
+						{
+							inside = twoPass.IsCovered(nearX, nearY) && singlePass.IsCovered(nearX, nearY);
+						}
+					}
+					if (inside)
+					{
+						interior++;
+						if (twoPass.Difference(singlePass, x, y) > colorTolerance)
+						{
+							mismatched++;
+						}
+					}
+				}
+			}
+			Check(interior > 0, "Nothing was drawn."s);
+			double const interiorMismatch{ static_cast<double>(mismatched) / static_cast<double>(interior) };
+			Check(interiorMismatch <= maximumInteriorMismatch,
+				"The wings of the two frames are different colors: "s + std::to_string(interiorMismatch) + " of the interior pixels differ."s);
+		}
+
+		/// <summary>
+		/// Every test, by the name used on the command line.
+		/// </summary>
+		std::map<std::string, std::function<void(void)> > const tests{
+			{ "compute-curves"s, TestComputeCurvesMatchCPU },
+			{ "single-pass-image"s, TestSinglePassMatchesTwoPass },
+		};
+
+		void PrintUsage(std::ostream& output)
+		{
+			output << "usage: wings-gl-tests TEST\n"
+				<< "\ntests:";
+			for (auto const& [name, test] : tests)
+			{
+				output << ' ' << name;
+			}
+			output << '\n';
+		}
+
+	}
+
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace silnith::wings::gltests;
+
+	if (argc != 2 || !tests.contains(argv[1]))
+	{
+		PrintUsage(std::cerr);
+		return 2;
+	}
+
+	try
+	{
+		tests.at(argv[1])();
+	}
+	catch (std::exception const& e)
+	{
+		std::cerr << argv[1] << ": " << e.what() << '\n';
+		return 1;
+	}
+
+	std::cout << argv[1] << ": passed\n";
+	return 0;
+}
@@ -0,0 +1,140 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#ifdef SILNITH_WINGS_NO_GLEW
+#include <GL/gl.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "AntiAliasing.h"
+
+#include "Instrumentation.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::platform
+{
+
+	char const* GetAntiAliasingName(AntiAliasing antiAliasing) noexcept
+	{
+		switch (antiAliasing)
+		{
+		case AntiAliasing::None:
+			return "none";
+		case AntiAliasing::LineSmooth:
+			return "line-smooth";
+		case AntiAliasing::Multisample:
+			return "msaa";
+		case AntiAliasing::Shader:
+			return "shader";
+		}
+		return "unknown";
+	}
+
+	AntiAliasing ParseAntiAliasing(std::string const& name)
+	{
+		for (AntiAliasing const antiAliasing : { AntiAliasing::None, AntiAliasing::LineSmooth, AntiAliasing::Multisample, AntiAliasing::Shader })
+		{
+			if (name == GetAntiAliasingName(antiAliasing))
+			{
+				return antiAliasing;
+			}
+		}
+		throw std::invalid_argument{ "Unknown anti-aliasing mode: "s + name };
+	}
+
+	void ApplyAntiAliasing(AntiAliasing antiAliasing)
+	{
+		if (antiAliasing == AntiAliasing::LineSmooth)
+		{
+			glEnable(GL_LINE_SMOOTH);
+			glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+		}
+		else
+		{
+			/*
+			 * Multisample rasterization is enabled by default, and it ignores
+			 * line smoothing anyway.  Turning smoothing off keeps drivers
+			 * that emulate it from doing the work regardless.
+			 */
+			glDisable(GL_LINE_SMOOTH);
+		}
+	}
+
+	MultisampleFramebuffer::MultisampleFramebuffer(GLsizei samples)
+		: samples{ samples }
+	{
+#ifdef SILNITH_WINGS_NO_GLEW
+		throw std::runtime_error{ "Multisampling needs framebuffer objects, which need GLEW."s };
+#else
+		if (!GLEW_VERSION_3_0 && !GLEW_ARB_framebuffer_object)
+		{
+			throw std::runtime_error{ "Multisampling needs OpenGL 3.0 or ARB_framebuffer_object."s };
+		}
+
+		GLint maxSamples{ 0 };
+		glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+		this->samples = std::min(this->samples, static_cast<GLsizei>(maxSamples));
+
+		glGenFramebuffers(1, &framebuffer);
+		glGenRenderbuffers(1, &colorRenderbuffer);
+		glGenRenderbuffers(1, &depthRenderbuffer);
+#endif
+	}
+
+	MultisampleFramebuffer::~MultisampleFramebuffer(void) noexcept
+	{
+#ifndef SILNITH_WINGS_NO_GLEW
+		glDeleteRenderbuffers(1, &depthRenderbuffer);
+		glDeleteRenderbuffers(1, &colorRenderbuffer);
+		glDeleteFramebuffers(1, &framebuffer);
+#endif
+	}
+
+	void MultisampleFramebuffer::Resize(GLsizei width, GLsizei height)
+	{
+		this->width = width;
+		this->height = height;
+#ifndef SILNITH_WINGS_NO_GLEW
+		glBindRenderbuffer(GL_RENDERBUFFER, colorRenderbuffer);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, depthRenderbuffer);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, width, height);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRenderbuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRenderbuffer);
+		GLenum const status{ glCheckFramebufferStatus(GL_FRAMEBUFFER) };
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		if (status != GL_FRAMEBUFFER_COMPLETE)
+		{
+			throw std::runtime_error{ "The multisampled framebuffer is incomplete: "s + std::to_string(status) };
+		}
+#endif
+	}
+
+	void MultisampleFramebuffer::Bind(void) const
+	{
+#ifndef SILNITH_WINGS_NO_GLEW
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+#endif
+	}
+
+	void MultisampleFramebuffer::Resolve(void) const
+	{
+#ifndef SILNITH_WINGS_NO_GLEW
+		instrumentation::PhaseTimer const resolveTimer{ instrumentation::Phase::Resolve };
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+#endif
+	}
+
+}
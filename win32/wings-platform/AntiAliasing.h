@@ -0,0 +1,193 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#ifdef SILNITH_WINGS_NO_GLEW
+#include <GL/gl.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <string>
+
+namespace silnith::wings::platform
+{
+
+	/// <summary>
+	/// The ways the edges of the wings can be anti-aliased.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Every view sets up line smoothing when it is created, because that is
+	/// all the Windows programs can count on.  The other modes are chosen at
+	/// run time by <see cref="ApplyAntiAliasing"/> and, for multisampling, a
+	/// <see cref="MultisampleFramebuffer"/>, so that the cost of each can be
+	/// measured on the machine at hand.
+	/// </para>
+	/// </remarks>
+	enum class AntiAliasing
+	{
+		/// <summary>
+		/// The outlines are drawn as aliased lines.
+		/// </summary>
+		None,
+
+		/// <summary>
+		/// The outlines are drawn with <c>GL_LINE_SMOOTH</c> and blended.
+		/// This is what the views set up on their own.
+		/// </summary>
+		LineSmooth,
+
+		/// <summary>
+		/// The frame is drawn into a multisampled framebuffer and resolved
+		/// into the surface.  The outlines are drawn as aliased lines, since
+		/// multisampling replaces line smoothing.
+		/// </summary>
+		Multisample,
+
+		/// <summary>
+		/// The renderer computes the coverage of the edges in its fragment
+		/// shader.  Only renderers that draw their own edges support this.
+		/// </summary>
+		Shader,
+	};
+
+	/// <summary>
+	/// Returns the name used for an anti-aliasing mode on the command line
+	/// and in reports.
+	/// </summary>
+	/// <param name="antiAliasing">The anti-aliasing mode.</param>
+	/// <returns>The name of the mode.</returns>
+	[[nodiscard]]
+	char const* GetAntiAliasingName(AntiAliasing antiAliasing) noexcept;
+
+	/// <summary>
+	/// Returns the anti-aliasing mode with the given name.
+	/// </summary>
+	/// <param name="name">The name of the mode.</param>
+	/// <returns>The anti-aliasing mode.</returns>
+	/// <exception cref="std::invalid_argument">If the name is not known.</exception>
+	/// <seealso cref="GetAntiAliasingName"/>
+	[[nodiscard]]
+	AntiAliasing ParseAntiAliasing(std::string const& name);
+
+	/// <summary>
+	/// Sets up the line rasterization state for an anti-aliasing mode.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This must be called after the view is created, since the views enable
+	/// line smoothing themselves.  It changes OpenGL state without going
+	/// through the view's <see cref="silnith::wings::gl::GLStateCache"/>, so
+	/// the cache must be invalidated afterwards.
+	/// </para>
+	/// </remarks>
+	/// <param name="antiAliasing">The anti-aliasing mode.</param>
+	void ApplyAntiAliasing(AntiAliasing antiAliasing);
+
+	/// <summary>
+	/// A multisampled color and depth framebuffer the size of the surface,
+	/// for <see cref="AntiAliasing::Multisample"/>.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Each frame is drawn after <see cref="Bind"/> and copied into the
+	/// default framebuffer by <see cref="Resolve"/>.  This needs OpenGL 3.0
+	/// or <c>ARB_framebuffer_object</c>, so it is not available when the
+	/// library is built without GLEW.
+	/// </para>
+	/// <para>
+	/// Creating and resizing the framebuffer change OpenGL state without going
+	/// through the view's <see cref="silnith::wings::gl::GLStateCache"/>, so
+	/// the cache must be invalidated after each.  <see cref="Bind"/> and
+	/// <see cref="Resolve"/> only change the framebuffer bindings, which the
+	/// cache does not track, so they can be called every frame without that.
+	/// </para>
+	/// </remarks>
+	class MultisampleFramebuffer
+	{
+	public:
+		/// <summary>
+		/// The number of samples per pixel when none is specified.
+		/// </summary>
+		static GLsizei constexpr defaultSamples{ 4 };
+
+	public:
+		/// <summary>
+		/// Default constructor is deleted.  The framebuffer needs a number of
+		/// samples.
+		/// </summary>
+		MultisampleFramebuffer(void) = delete;
+
+		/// <summary>
+		/// Creates the framebuffer.  It has no storage until it is resized.
+		/// </summary>
+		/// <param name="samples">The number of samples per pixel.  This is
+		/// reduced to the most the implementation supports.</param>
+		/// <exception cref="std::runtime_error">If the OpenGL implementation does not support framebuffer objects.</exception>
+		explicit MultisampleFramebuffer(GLsizei samples);
+
+#pragma region Rule of Five
+
+	public:
+		MultisampleFramebuffer(MultisampleFramebuffer const&) = delete;
+		MultisampleFramebuffer& operator=(MultisampleFramebuffer const&) = delete;
+		MultisampleFramebuffer(MultisampleFramebuffer&&) noexcept = delete;
+		MultisampleFramebuffer& operator=(MultisampleFramebuffer&&) noexcept = delete;
+		~MultisampleFramebuffer(void) noexcept;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Allocates the storage for a surface of the given size.
+		/// </summary>
+		/// <param name="width">The width of the surface.</param>
+		/// <param name="height">The height of the surface.</param>
+		void Resize(GLsizei width, GLsizei height);
+
+		/// <summary>
+		/// Directs rendering into the multisampled framebuffer.
+		/// </summary>
+		void Bind(void) const;
+
+		/// <summary>
+		/// Copies the multisampled framebuffer into the default framebuffer,
+		/// and directs rendering back to the default framebuffer.
+		/// </summary>
+		void Resolve(void) const;
+
+	private:
+		/// <summary>
+		/// The number of samples per pixel.
+		/// </summary>
+		GLsizei samples{ 0 };
+
+		/// <summary>
+		/// The width of the storage.
+		/// </summary>
+		GLsizei width{ 0 };
+
+		/// <summary>
+		/// The height of the storage.
+		/// </summary>
+		GLsizei height{ 0 };
+
+		/// <summary>
+		/// The framebuffer object.
+		/// </summary>
+		GLuint framebuffer{ 0 };
+
+		/// <summary>
+		/// The multisampled color attachment.
+		/// </summary>
+		GLuint colorRenderbuffer{ 0 };
+
+		/// <summary>
+		/// The multisampled depth attachment.
+		/// </summary>
+		GLuint depthRenderbuffer{ 0 };
+	};
+
+}
@@ -0,0 +1,130 @@
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+#ifndef SILNITH_WINGS_NO_GLEW
+#include <GL/glew.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Platform.h"
+
+#include "Instrumentation.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::platform
+{
+
+	void LoadExtensions(void)
+	{
+#ifndef SILNITH_WINGS_NO_GLEW
+		/*
+		 * Without this GLEW skips entry points that a core profile context
+		 * does not advertise through the legacy extension string.
+		 */
+		glewExperimental = GL_TRUE;
+		GLenum const result{ glewInit() };
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+		/*
+		 * A GLEW built for GLX also tries to load the GLX extensions, which
+		 * fails for an EGL context.  The OpenGL entry points are loaded by
+		 * then, and those are all that is needed.
+		 */
+		if (result == GLEW_ERROR_NO_GLX_DISPLAY)
+		{
+			return;
+		}
+#endif
+		if (result != GLEW_OK)
+		{
+			throw std::runtime_error{ "Failed to initialize GLEW: "s + reinterpret_cast<char const*>(glewGetErrorString(result)) };
+		}
+#endif
+	}
+
+	void RunAnimationLoop(RenderingContext& context,
+		std::chrono::milliseconds updateDelay,
+		std::size_t maxFrames,
+		std::function<void(int width, int height)> const& resize,
+		std::function<void(void)> const& advance,
+		std::function<void(void)> const& draw)
+	{
+		int width{ context.GetWidth() };
+		int height{ context.GetHeight() };
+		resize(width, height);
+
+		std::chrono::steady_clock::time_point nextFrame{ std::chrono::steady_clock::now() };
+		for (std::size_t frame{ 0 }; maxFrames == 0 || frame < maxFrames; frame++)
+		{
+			if (!context.ProcessEvents())
+			{
+				return;
+			}
+
+			if (context.GetWidth() != width || context.GetHeight() != height)
+			{
+				width = context.GetWidth();
+				height = context.GetHeight();
+				resize(width, height);
+			}
+
+			{
+				instrumentation::PhaseTimer const tickTimer{ instrumentation::Phase::Tick };
+				advance();
+			}
+
+			{
+				instrumentation::PhaseTimer const frameTimer{ instrumentation::Phase::Frame };
+				draw();
+			}
+
+			{
+				instrumentation::PhaseTimer const swapTimer{ instrumentation::Phase::Swap };
+				context.SwapBuffers();
+			}
+
+			/*
+			 * Schedule from the later of the deadline and the present, so
+			 * that a slow frame does not cause a burst of catch-up frames.
+			 */
+			nextFrame = std::max(nextFrame + updateDelay, std::chrono::steady_clock::now());
+			std::this_thread::sleep_until(nextFrame);
+		}
+	}
+
+	double GetThreadCPUSeconds(void)
+	{
+#ifdef _WIN32
+		FILETIME creationTime{};
+		FILETIME exitTime{};
+		FILETIME kernelTime{};
+		FILETIME userTime{};
+		GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime);
+
+		auto const toTicks{ [](FILETIME const& fileTime) -> std::uint64_t
+			{
+				return (std::uint64_t{ fileTime.dwHighDateTime } << 32) | fileTime.dwLowDateTime;
+			} };
+		/*
+		 * FILETIME counts in units of 100 nanoseconds.
+		 */
+		return static_cast<double>(toTicks(kernelTime) + toTicks(userTime)) / 1.0e7;
+#else
+		timespec time{};
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+		return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1.0e9;
+#endif
+	}
+
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <cstddef>
+
+namespace silnith::wings::platform
+{
+
+	/// <summary>
+	/// The kind of OpenGL rendering context to request.
+	/// </summary>
+	struct ContextVersion
+	{
+		/// <summary>
+		/// The major version, or zero for a legacy context of whatever version
+		/// the driver provides.
+		/// </summary>
+		int major{ 0 };
+
+		/// <summary>
+		/// The minor version.  Ignored for a legacy context.
+		/// </summary>
+		int minor{ 0 };
+
+		/// <summary>
+		/// Whether to request the core profile.  Ignored for a legacy context.
+		/// </summary>
+		bool core{ false };
+	};
+
+	/// <summary>
+	/// An OpenGL rendering context together with the surface it draws into.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This is everything the views need from the window system.  Each
+	/// platform provides its own implementation: WGL on Windows, and EGL or
+	/// GLX elsewhere.  The context is made current on the calling thread when
+	/// it is created, and released when it is destroyed.
+	/// </para>
+	/// </remarks>
+	class RenderingContext
+	{
+	public:
+		explicit RenderingContext(void) = default;
+
+#pragma region Rule of Five
+
+	public:
+		RenderingContext(RenderingContext const&) = delete;
+		RenderingContext& operator=(RenderingContext const&) = delete;
+		RenderingContext(RenderingContext&&) noexcept = delete;
+		RenderingContext& operator=(RenderingContext&&) noexcept = delete;
+		virtual ~RenderingContext(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Presents the frame that was just drawn.
+		/// </summary>
+		virtual void SwapBuffers(void) = 0;
+
+		/// <summary>
+		/// Handles any window system events that are waiting, without blocking.
+		/// </summary>
+		/// <returns>Whether the surface is still open.  This becomes <c>false</c>
+		/// once the user closes the window.</returns>
+		[[nodiscard]]
+		virtual bool ProcessEvents(void) = 0;
+
+		/// <summary>
+		/// Returns the current width of the surface in pixels.
+		/// </summary>
+		[[nodiscard]]
+		virtual int GetWidth(void) const = 0;
+
+		/// <summary>
+		/// Returns the current height of the surface in pixels.
+		/// </summary>
+		[[nodiscard]]
+		virtual int GetHeight(void) const = 0;
+	};
+
+	/// <summary>
+	/// Creates a rendering context that draws into a surface that is never shown.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// On Windows this is a hidden window.  Elsewhere it is an EGL pbuffer,
+	/// which needs neither a display server nor a GPU, so it works on a
+	/// headless machine with a software driver such as llvmpipe.
+	/// </para>
+	/// </remarks>
+	/// <param name="version">The kind of context to request.</param>
+	/// <param name="width">The width of the surface.</param>
+	/// <param name="height">The height of the surface.</param>
+	/// <returns>The context, already current on the calling thread.</returns>
+	/// <exception cref="std::runtime_error">If the context cannot be created.</exception>
+	[[nodiscard]]
+	std::unique_ptr<RenderingContext> CreateOffscreenContext(ContextVersion version, int width, int height);
+
+	/// <summary>
+	/// Creates a rendering context that draws into a new visible window.
+	/// </summary>
+	/// <param name="version">The kind of context to request.</param>
+	/// <param name="width">The initial width of the window.</param>
+	/// <param name="height">The initial height of the window.</param>
+	/// <param name="title">The window title.</param>
+	/// <returns>The context, already current on the calling thread.</returns>
+	/// <exception cref="std::runtime_error">If the window or context cannot be created.</exception>
+	[[nodiscard]]
+	std::unique_ptr<RenderingContext> CreateWindowContext(ContextVersion version, int width, int height, std::string const& title);
+
+	/// <summary>
+	/// Loads the OpenGL entry points for the current rendering context.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// The context factories call this, so it only needs to be called again
+	/// if a different context is made current.  When the library is built
+	/// without GLEW this does nothing, and only OpenGL 1.1 is available.
+	/// </para>
+	/// </remarks>
+	/// <exception cref="std::runtime_error">If the entry points cannot be loaded.</exception>
+	void LoadExtensions(void);
+
+	/// <summary>
+	/// The delay between animation frames when none is specified.
+	/// This matches the timer used by the Windows programs.
+	/// </summary>
+	std::chrono::milliseconds constexpr defaultUpdateDelay{ 33 };
+
+	/// <summary>
+	/// Runs the animation until the surface is closed or enough frames have
+	/// been drawn.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This takes the place of <c>SetTimer</c> and the <c>GetMessageW</c>
+	/// loop in the Windows programs.  Each frame handles pending events,
+	/// resizes the view if the surface changed size, advances the animation,
+	/// draws it, and swaps the buffers.  Then it sleeps until the next frame
+	/// is due.  A frame that runs late delays the following ones rather than
+	/// causing them to be skipped, just as <c>WM_TIMER</c> messages coalesce.
+	/// </para>
+	/// </remarks>
+	/// <param name="context">The rendering context to draw into.</param>
+	/// <param name="updateDelay">The time between frames.  Zero draws frames
+	/// as quickly as possible.</param>
+	/// <param name="maxFrames">The number of frames to draw, or zero to
+	/// continue until the surface is closed.</param>
+	/// <param name="resize">Called with the surface width and height before
+	/// the first frame and whenever the surface changes size.</param>
+	/// <param name="advance">Called to advance the animation by one frame.</param>
+	/// <param name="draw">Called to draw the current frame.</param>
+	void RunAnimationLoop(RenderingContext& context,
+		std::chrono::milliseconds updateDelay,
+		std::size_t maxFrames,
+		std::function<void(int width, int height)> const& resize,
+		std::function<void(void)> const& advance,
+		std::function<void(void)> const& draw);
+
+	/// <summary>
+	/// Returns the user and kernel time consumed by the calling thread.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Work the driver does on its own threads is not included.
+	/// </para>
+	/// </remarks>
+	/// <returns>The CPU time in seconds.</returns>
+	[[nodiscard]]
+	double GetThreadCPUSeconds(void);
+
+}
@@ -0,0 +1,264 @@
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <cstddef>
+
+#include "Platform.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::platform
+{
+
+	namespace
+	{
+
+		/// <summary>
+		/// A rendering context that draws into an EGL pbuffer.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This prefers the Mesa surfaceless platform, which needs no display
+		/// server at all, and falls back to the default display otherwise.
+		/// </para>
+		/// </remarks>
+		class PbufferContext : public RenderingContext
+		{
+		public:
+			PbufferContext(void) = delete;
+
+			/// <summary>
+			/// Creates the pbuffer and the rendering context, makes the context
+			/// current, and loads the extensions for it.
+			/// </summary>
+			/// <param name="version">The kind of context to request.</param>
+			/// <param name="width">The width of the pbuffer.</param>
+			/// <param name="height">The height of the pbuffer.</param>
+			/// <exception cref="std::runtime_error">If any step fails.</exception>
+			explicit PbufferContext(ContextVersion version, int width, int height);
+
+#pragma region Rule of Five
+
+		public:
+			PbufferContext(PbufferContext const&) = delete;
+			PbufferContext& operator=(PbufferContext const&) = delete;
+			PbufferContext(PbufferContext&&) noexcept = delete;
+			PbufferContext& operator=(PbufferContext&&) noexcept = delete;
+			virtual ~PbufferContext(void) noexcept override;
+
+#pragma endregion
+
+		public:
+			virtual void SwapBuffers(void) override;
+
+			[[nodiscard]]
+			virtual bool ProcessEvents(void) override;
+
+			[[nodiscard]]
+			virtual int GetWidth(void) const override;
+
+			[[nodiscard]]
+			virtual int GetHeight(void) const override;
+
+		private:
+			/// <summary>
+			/// Destroys whatever has been created so far, then throws.
+			/// </summary>
+			[[noreturn]]
+			void Fail(std::string const& message) noexcept(false);
+
+		private:
+			EGLDisplay display{ EGL_NO_DISPLAY };
+			EGLSurface surface{ EGL_NO_SURFACE };
+			::EGLContext context{ EGL_NO_CONTEXT };
+			int const width;
+			int const height;
+		};
+
+		/// <summary>
+		/// Returns whether a space-separated extension string names an extension.
+		/// </summary>
+		[[nodiscard]]
+		bool HasExtension(char const* extensions, std::string_view const extension)
+		{
+			if (extensions == nullptr)
+			{
+				return false;
+			}
+			std::string_view remaining{ extensions };
+			while (!remaining.empty())
+			{
+				std::size_t const separator{ remaining.find(' ') };
+				if (remaining.substr(0, separator) == extension)
+				{
+					return true;
+				}
+				if (separator == std::string_view::npos)
+				{
+					break;
+				}
+				remaining.remove_prefix(separator + 1);
+			}
+			return false;
+		}
+
+		/// <summary>
+		/// Opens the EGL display that needs the least from the system.
+		/// </summary>
+		[[nodiscard]]
+		EGLDisplay OpenDisplay(void)
+		{
+			char const* const clientExtensions{ eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS) };
+			if (HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+			{
+				PFNEGLGETPLATFORMDISPLAYEXTPROC const getPlatformDisplay{ reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT")) };
+				if (getPlatformDisplay != nullptr)
+				{
+					EGLDisplay const display{ getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr) };
+					if (display != EGL_NO_DISPLAY)
+					{
+						return display;
+					}
+				}
+			}
+			return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+		}
+
+		PbufferContext::PbufferContext(ContextVersion version, int width, int height)
+			: RenderingContext{}, width{ width }, height{ height }
+		{
+			display = OpenDisplay();
+			if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+			{
+				throw std::runtime_error{ "Failed to open an EGL display."s };
+			}
+
+			if (!eglBindAPI(EGL_OPENGL_API))
+			{
+				Fail("The EGL implementation does not support desktop OpenGL."s);
+			}
+
+			/*
+			 * This matches silnith::gl::desiredPixelFormat, except that drivers
+			 * rarely offer a 32-bit depth buffer and EGL treats the depth size
+			 * as a minimum.
+			 */
+			EGLint const configAttribs[] = {
+				EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+				EGL_RED_SIZE, 8,
+				EGL_GREEN_SIZE, 8,
+				EGL_BLUE_SIZE, 8,
+				EGL_DEPTH_SIZE, 24,
+				EGL_NONE,
+			};
+			EGLConfig config{ nullptr };
+			EGLint numConfigs{ 0 };
+			if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0)
+			{
+				Fail("Failed to find a suitable EGL config."s);
+			}
+
+			EGLint const surfaceAttribs[] = {
+				EGL_WIDTH, width,
+				EGL_HEIGHT, height,
+				EGL_NONE,
+			};
+			surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+			if (surface == EGL_NO_SURFACE)
+			{
+				Fail("Failed to create an EGL pbuffer."s);
+			}
+
+			if (version.major == 0)
+			{
+				context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+			}
+			else
+			{
+				EGLint const contextAttribs[] = {
+					EGL_CONTEXT_MAJOR_VERSION, version.major,
+					EGL_CONTEXT_MINOR_VERSION, version.minor,
+					EGL_CONTEXT_OPENGL_PROFILE_MASK, version.core ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+					EGL_NONE,
+				};
+				context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+			}
+			if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, surface, surface, context))
+			{
+				if (version.major == 0)
+				{
+					Fail("Failed to create a rendering context."s);
+				}
+				Fail("Failed to create an OpenGL "s + std::to_string(version.major) + "."s + std::to_string(version.minor) + " context."s);
+			}
+
+			try
+			{
+				LoadExtensions();
+			}
+			catch (std::runtime_error const& e)
+			{
+				Fail(e.what());
+			}
+		}
+
+		PbufferContext::~PbufferContext(void) noexcept
+		{
+			eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglDestroyContext(display, context);
+			eglDestroySurface(display, surface);
+			eglTerminate(display);
+		}
+
+		void PbufferContext::Fail(std::string const& message) noexcept(false)
+		{
+			eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			if (context != EGL_NO_CONTEXT)
+			{
+				eglDestroyContext(display, context);
+			}
+			if (surface != EGL_NO_SURFACE)
+			{
+				eglDestroySurface(display, surface);
+			}
+			eglTerminate(display);
+			throw std::runtime_error{ message };
+		}
+
+		void PbufferContext::SwapBuffers(void)
+		{
+			/*
+			 * Swapping a pbuffer has no effect, so this only flushes.
+			 */
+			eglSwapBuffers(display, surface);
+		}
+
+		bool PbufferContext::ProcessEvents(void)
+		{
+			return true;
+		}
+
+		int PbufferContext::GetWidth(void) const
+		{
+			return width;
+		}
+
+		int PbufferContext::GetHeight(void) const
+		{
+			return height;
+		}
+
+	}
+
+	std::unique_ptr<RenderingContext> CreateOffscreenContext(ContextVersion version, int width, int height)
+	{
+		return std::make_unique<PbufferContext>(version, width, height);
+	}
+
+}
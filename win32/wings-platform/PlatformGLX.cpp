@@ -0,0 +1,257 @@
+#ifndef SILNITH_WINGS_NO_GLEW
+#include <GL/glew.h>
+#endif
+#include <GL/glx.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "Platform.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::platform
+{
+
+	namespace
+	{
+
+		/// <summary>
+		/// A rendering context that draws into an X11 window using GLX.
+		/// </summary>
+		class XWindowContext : public RenderingContext
+		{
+		public:
+			XWindowContext(void) = delete;
+
+			/// <summary>
+			/// Opens the display, creates and maps the window, creates the
+			/// rendering context, makes it current, and loads the extensions
+			/// for it.
+			/// </summary>
+			/// <param name="version">The kind of context to request.</param>
+			/// <param name="width">The width of the window.</param>
+			/// <param name="height">The height of the window.</param>
+			/// <param name="title">The window title.</param>
+			/// <exception cref="std::runtime_error">If any step fails.</exception>
+			explicit XWindowContext(ContextVersion version, int width, int height, std::string const& title);
+
+#pragma region Rule of Five
+
+		public:
+			XWindowContext(XWindowContext const&) = delete;
+			XWindowContext& operator=(XWindowContext const&) = delete;
+			XWindowContext(XWindowContext&&) noexcept = delete;
+			XWindowContext& operator=(XWindowContext&&) noexcept = delete;
+			virtual ~XWindowContext(void) noexcept override;
+
+#pragma endregion
+
+		public:
+			virtual void SwapBuffers(void) override;
+
+			[[nodiscard]]
+			virtual bool ProcessEvents(void) override;
+
+			[[nodiscard]]
+			virtual int GetWidth(void) const override;
+
+			[[nodiscard]]
+			virtual int GetHeight(void) const override;
+
+		private:
+			/// <summary>
+			/// Destroys whatever has been created so far, then throws.
+			/// </summary>
+			[[noreturn]]
+			void Fail(std::string const& message) noexcept(false);
+
+		private:
+			Display* display{ nullptr };
+			Colormap colormap{ 0 };
+			Window window{ 0 };
+			GLXContext context{ nullptr };
+			Atom wmDeleteWindow{ 0 };
+			int width;
+			int height;
+			bool closed{ false };
+		};
+
+		XWindowContext::XWindowContext(ContextVersion version, int width, int height, std::string const& title)
+			: RenderingContext{}, width{ width }, height{ height }
+		{
+			display = XOpenDisplay(nullptr);
+			if (display == nullptr)
+			{
+				throw std::runtime_error{ "Failed to open the X display."s };
+			}
+
+			/*
+			 * See silnith::gl::desiredPixelFormat.
+			 */
+			int const configAttribs[] = {
+				GLX_X_RENDERABLE, True,
+				GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+				GLX_RENDER_TYPE, GLX_RGBA_BIT,
+				GLX_DOUBLEBUFFER, True,
+				GLX_RED_SIZE, 8,
+				GLX_GREEN_SIZE, 8,
+				GLX_BLUE_SIZE, 8,
+				GLX_DEPTH_SIZE, 24,
+				None,
+			};
+			int numConfigs{ 0 };
+			GLXFBConfig* const configs{ glXChooseFBConfig(display, DefaultScreen(display), configAttribs, &numConfigs) };
+			if (configs == nullptr || numConfigs == 0)
+			{
+				Fail("Failed to find a suitable GLX framebuffer config."s);
+			}
+			GLXFBConfig const config{ configs[0] };
+			XFree(configs);
+
+			XVisualInfo* const visual{ glXGetVisualFromFBConfig(display, config) };
+			if (visual == nullptr)
+			{
+				Fail("Failed to find a visual for the GLX framebuffer config."s);
+			}
+
+			Window const root{ RootWindow(display, visual->screen) };
+			colormap = XCreateColormap(display, root, visual->visual, AllocNone);
+
+			XSetWindowAttributes windowAttributes{};
+			windowAttributes.colormap = colormap;
+			windowAttributes.event_mask = StructureNotifyMask;
+			window = XCreateWindow(display, root, 0, 0,
+				static_cast<unsigned int>(width), static_cast<unsigned int>(height), 0,
+				visual->depth, InputOutput, visual->visual,
+				CWColormap | CWEventMask, &windowAttributes);
+			XFree(visual);
+			if (window == 0)
+			{
+				Fail("Failed to create the window."s);
+			}
+
+			XStoreName(display, window, title.c_str());
+			wmDeleteWindow = XInternAtom(display, "WM_DELETE_WINDOW", False);
+			XSetWMProtocols(display, window, &wmDeleteWindow, 1);
+
+			if (version.major == 0)
+			{
+				context = glXCreateNewContext(display, config, GLX_RGBA_TYPE, nullptr, True);
+			}
+			else
+			{
+				using CreateContextAttribs = GLXContext(*)(Display*, GLXFBConfig, GLXContext, Bool, int const*);
+				CreateContextAttribs const createContextAttribs{ reinterpret_cast<CreateContextAttribs>(glXGetProcAddressARB(reinterpret_cast<GLubyte const*>("glXCreateContextAttribsARB"))) };
+
+				/*
+				 * See SpinningWingsGL3.cpp and SpinningWingsGL4.cpp.
+				 */
+				int const contextAttribs[] = {
+					GLX_CONTEXT_MAJOR_VERSION_ARB, version.major,
+					GLX_CONTEXT_MINOR_VERSION_ARB, version.minor,
+					GLX_CONTEXT_PROFILE_MASK_ARB, version.core ? GLX_CONTEXT_CORE_PROFILE_BIT_ARB : GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
+					None,
+				};
+				context = createContextAttribs != nullptr ? createContextAttribs(display, config, nullptr, True, contextAttribs) : nullptr;
+			}
+			if (context == nullptr || !glXMakeContextCurrent(display, window, window, context))
+			{
+				if (version.major == 0)
+				{
+					Fail("Failed to create a rendering context."s);
+				}
+				Fail("Failed to create an OpenGL "s + std::to_string(version.major) + "."s + std::to_string(version.minor) + " context."s);
+			}
+
+			try
+			{
+				LoadExtensions();
+			}
+			catch (std::runtime_error const& e)
+			{
+				Fail(e.what());
+			}
+
+			XMapWindow(display, window);
+		}
+
+		XWindowContext::~XWindowContext(void) noexcept
+		{
+			glXMakeContextCurrent(display, None, None, nullptr);
+			glXDestroyContext(display, context);
+			XDestroyWindow(display, window);
+			XFreeColormap(display, colormap);
+			XCloseDisplay(display);
+		}
+
+		void XWindowContext::Fail(std::string const& message) noexcept(false)
+		{
+			if (context != nullptr)
+			{
+				glXMakeContextCurrent(display, None, None, nullptr);
+				glXDestroyContext(display, context);
+			}
+			if (window != 0)
+			{
+				XDestroyWindow(display, window);
+			}
+			if (colormap != 0)
+			{
+				XFreeColormap(display, colormap);
+			}
+			XCloseDisplay(display);
+			throw std::runtime_error{ message };
+		}
+
+		void XWindowContext::SwapBuffers(void)
+		{
+			glXSwapBuffers(display, window);
+		}
+
+		bool XWindowContext::ProcessEvents(void)
+		{
+			while (XPending(display) > 0)
+			{
+				XEvent event{};
+				XNextEvent(display, &event);
+				switch (event.type)
+				{
+				case ConfigureNotify:
+					width = event.xconfigure.width;
+					height = event.xconfigure.height;
+					break;
+				case ClientMessage:
+					if (static_cast<Atom>(event.xclient.data.l[0]) == wmDeleteWindow)
+					{
+						closed = true;
+					}
+					break;
+				default:
+					break;
+				}
+			}
+			return !closed;
+		}
+
+		int XWindowContext::GetWidth(void) const
+		{
+			return width;
+		}
+
+		int XWindowContext::GetHeight(void) const
+		{
+			return height;
+		}
+
+	}
+
+	std::unique_ptr<RenderingContext> CreateWindowContext(ContextVersion version, int width, int height, std::string const& title)
+	{
+		return std::make_unique<XWindowContext>(version, width, height, title);
+	}
+
+}
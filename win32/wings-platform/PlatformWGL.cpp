@@ -0,0 +1,326 @@
+#include <GL/glew.h>
+#include <GL/wglew.h>
+
+#include <Windows.h>
+
+#pragma comment (lib, "opengl32.lib")
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "Platform.h"
+
+#include "WingsPixelFormat.h"
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::platform
+{
+
+	namespace
+	{
+
+		wchar_t constexpr windowClassName[]{ L"WingsPlatformWindow" };
+
+		/// <summary>
+		/// A rendering context that draws into a window, which may or may not be shown.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Each instance creates its own window because a pixel format can
+		/// only be set on a window once.  Some implementations discard
+		/// fragments for pixels of a hidden window under the pixel ownership
+		/// test, so a hidden window measures how quickly the commands are
+		/// submitted and executed rather than true fill rate.
+		/// </para>
+		/// </remarks>
+		class Win32WindowContext : public RenderingContext
+		{
+		public:
+			Win32WindowContext(void) = delete;
+
+			/// <summary>
+			/// Creates the window and the rendering context, makes the context
+			/// current, and loads the extensions for it.
+			/// </summary>
+			/// <param name="version">The kind of context to request.</param>
+			/// <param name="width">The width of the window.</param>
+			/// <param name="height">The height of the window.</param>
+			/// <param name="title">The window title.</param>
+			/// <param name="visible">Whether to show the window.</param>
+			/// <exception cref="std::runtime_error">If any step fails.</exception>
+			explicit Win32WindowContext(ContextVersion version, int width, int height, std::wstring const& title, bool visible);
+
+#pragma region Rule of Five
+
+		public:
+			Win32WindowContext(Win32WindowContext const&) = delete;
+			Win32WindowContext& operator=(Win32WindowContext const&) = delete;
+			Win32WindowContext(Win32WindowContext&&) noexcept = delete;
+			Win32WindowContext& operator=(Win32WindowContext&&) noexcept = delete;
+			virtual ~Win32WindowContext(void) noexcept override;
+
+#pragma endregion
+
+		public:
+			virtual void SwapBuffers(void) override;
+
+			[[nodiscard]]
+			virtual bool ProcessEvents(void) override;
+
+			[[nodiscard]]
+			virtual int GetWidth(void) const override;
+
+			[[nodiscard]]
+			virtual int GetHeight(void) const override;
+
+		private:
+			static LRESULT CALLBACK WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+			/// <summary>
+			/// Destroys whatever has been created so far, then throws.
+			/// </summary>
+			[[noreturn]]
+			void Fail(std::string const& message) noexcept(false);
+
+		private:
+			HWND hWnd{ nullptr };
+			HDC hdc{ nullptr };
+			HGLRC hglrc{ nullptr };
+
+			/// <summary>
+			/// Set once the user asks to close the window.
+			/// </summary>
+			bool closed{ false };
+		};
+
+		/// <summary>
+		/// Registers the window class the first time it is needed.
+		/// </summary>
+		void RegisterWindowClass(HINSTANCE hInstance, WNDPROC windowProc)
+		{
+			static ATOM const windowClass{ [hInstance, windowProc]() -> ATOM
+				{
+					WNDCLASSEXW const windowClassDescription{
+						.cbSize = sizeof(WNDCLASSEXW),
+						.style = CS_OWNDC,
+						.lpfnWndProc = windowProc,
+						.cbClsExtra = 0,
+						.cbWndExtra = 0,
+						.hInstance = hInstance,
+						.hIcon = nullptr,
+						.hCursor = LoadCursorW(nullptr, IDC_ARROW),
+						.hbrBackground = nullptr,
+						.lpszMenuName = nullptr,
+						.lpszClassName = windowClassName,
+						.hIconSm = nullptr,
+					};
+					return RegisterClassExW(&windowClassDescription);
+				}() };
+			if (windowClass == 0)
+			{
+				throw std::runtime_error{ "Failed to register the window class."s };
+			}
+		}
+
+		Win32WindowContext::Win32WindowContext(ContextVersion version, int width, int height, std::wstring const& title, bool visible)
+			: RenderingContext{}
+		{
+			HINSTANCE const hInstance{ GetModuleHandleW(nullptr) };
+
+			RegisterWindowClass(hInstance, WindowProc);
+
+			hWnd = CreateWindowExW(0, windowClassName, title.c_str(),
+				WS_OVERLAPPEDWINDOW | WS_CLIPCHILDREN | WS_CLIPSIBLINGS,
+				CW_USEDEFAULT, CW_USEDEFAULT, width, height,
+				nullptr, nullptr, hInstance, this);
+			if (hWnd == nullptr)
+			{
+				throw std::runtime_error{ "Failed to create the window."s };
+			}
+
+			hdc = GetDC(hWnd);
+
+			int const pixelformat{ ChoosePixelFormat(hdc, &silnith::gl::desiredPixelFormat) };
+			if (pixelformat == 0 || !SetPixelFormat(hdc, pixelformat, &silnith::gl::desiredPixelFormat))
+			{
+				Fail("Failed to set the pixel format."s);
+			}
+
+			HGLRC const legacyGLRC{ wglCreateContext(hdc) };
+			if (legacyGLRC == nullptr || !wglMakeCurrent(hdc, legacyGLRC))
+			{
+				if (legacyGLRC != nullptr)
+				{
+					wglDeleteContext(legacyGLRC);
+				}
+				Fail("Failed to create a rendering context."s);
+			}
+			hglrc = legacyGLRC;
+
+			/*
+			 * GLEW must be initialized before wglCreateContextAttribsARB can
+			 * be called, which requires a context to already be current.
+			 */
+			try
+			{
+				LoadExtensions();
+			}
+			catch (std::runtime_error const& e)
+			{
+				Fail(e.what());
+			}
+
+			if (version.major != 0)
+			{
+				/*
+				 * See SpinningWingsGL3.cpp and SpinningWingsGL4.cpp.  The debug
+				 * flag is deliberately not requested, since it can slow the
+				 * driver down.
+				 */
+				int const attribList[] = {
+					WGL_CONTEXT_MAJOR_VERSION_ARB, version.major,
+					WGL_CONTEXT_MINOR_VERSION_ARB, version.minor,
+					WGL_CONTEXT_PROFILE_MASK_ARB, version.core ? WGL_CONTEXT_CORE_PROFILE_BIT_ARB : WGL_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
+					WGL_CONTEXT_LAYER_PLANE_ARB, 0,
+					0,
+				};
+
+				HGLRC const versionedGLRC{ WGLEW_ARB_create_context ? wglCreateContextAttribsARB(hdc, nullptr, attribList) : nullptr };
+				wglMakeCurrent(nullptr, nullptr);
+				wglDeleteContext(legacyGLRC);
+				hglrc = nullptr;
+				if (versionedGLRC == nullptr || !wglMakeCurrent(hdc, versionedGLRC))
+				{
+					if (versionedGLRC != nullptr)
+					{
+						wglDeleteContext(versionedGLRC);
+					}
+					Fail("Failed to create an OpenGL "s + std::to_string(version.major) + "."s + std::to_string(version.minor) + " context."s);
+				}
+				hglrc = versionedGLRC;
+
+				/*
+				 * The function pointers GLEW loaded for the legacy context are
+				 * not guaranteed to be valid for the new one.
+				 */
+				try
+				{
+					LoadExtensions();
+				}
+				catch (std::runtime_error const& e)
+				{
+					Fail(e.what());
+				}
+			}
+
+			if (visible)
+			{
+				ShowWindow(hWnd, SW_SHOWNORMAL);
+				UpdateWindow(hWnd);
+			}
+		}
+
+		Win32WindowContext::~Win32WindowContext(void) noexcept
+		{
+			wglMakeCurrent(nullptr, nullptr);
+			wglDeleteContext(hglrc);
+			ReleaseDC(hWnd, hdc);
+			DestroyWindow(hWnd);
+		}
+
+		void Win32WindowContext::Fail(std::string const& message) noexcept(false)
+		{
+			if (hglrc != nullptr)
+			{
+				wglMakeCurrent(nullptr, nullptr);
+				wglDeleteContext(hglrc);
+			}
+			if (hdc != nullptr)
+			{
+				ReleaseDC(hWnd, hdc);
+			}
+			DestroyWindow(hWnd);
+			throw std::runtime_error{ message };
+		}
+
+		void Win32WindowContext::SwapBuffers(void)
+		{
+			::SwapBuffers(hdc);
+		}
+
+		bool Win32WindowContext::ProcessEvents(void)
+		{
+			MSG msg{};
+			while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+			{
+				TranslateMessage(&msg);
+				DispatchMessageW(&msg);
+			}
+			return !closed;
+		}
+
+		int Win32WindowContext::GetWidth(void) const
+		{
+			RECT clientRect{};
+			GetClientRect(hWnd, &clientRect);
+			return clientRect.right - clientRect.left;
+		}
+
+		int Win32WindowContext::GetHeight(void) const
+		{
+			RECT clientRect{};
+			GetClientRect(hWnd, &clientRect);
+			return clientRect.bottom - clientRect.top;
+		}
+
+		LRESULT CALLBACK Win32WindowContext::WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+		{
+			if (uMsg == WM_NCCREATE)
+			{
+				CREATESTRUCTW const* const createStruct{ reinterpret_cast<CREATESTRUCTW const*>(lParam) };
+				SetWindowLongPtrW(hWnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(createStruct->lpCreateParams));
+			}
+
+			Win32WindowContext* const context{ reinterpret_cast<Win32WindowContext*>(GetWindowLongPtrW(hWnd, GWLP_USERDATA)) };
+			switch (uMsg)
+			{
+			case WM_CLOSE:
+				/*
+				 * The window is destroyed along with the context, so that
+				 * the context is never left without a surface.
+				 */
+				if (context != nullptr)
+				{
+					context->closed = true;
+				}
+				return 0;
+			case WM_PAINT:
+				/*
+				 * The animation loop redraws continuously, so there is
+				 * nothing to do other than mark the window as valid.
+				 */
+				ValidateRect(hWnd, nullptr);
+				return 0;
+			default:
+				return DefWindowProcW(hWnd, uMsg, wParam, lParam);
+			}
+		}
+
+	}
+
+	std::unique_ptr<RenderingContext> CreateOffscreenContext(ContextVersion version, int width, int height)
+	{
+		return std::make_unique<Win32WindowContext>(version, width, height, L"wings"s, false);
+	}
+
+	std::unique_ptr<RenderingContext> CreateWindowContext(ContextVersion version, int width, int height, std::string const& title)
+	{
+		/*
+		 * The titles are plain ASCII, so widening each character is enough.
+		 */
+		return std::make_unique<Win32WindowContext>(version, width, height, std::wstring{ title.begin(), title.end() }, true);
+	}
+
+}
@@ -19,6 +19,7 @@
 #include <cassert>
 
 #include "GLInfo.h"
+#include "Instrumentation.h"
 #include "WingsPixelFormat.h"
 #include "WingsView.h"
 
@@ -115,7 +116,10 @@ BOOL CALLBACK RenderWingsOnMonitor(HMONITOR hMonitor, HDC hdcMonitor, LPRECT lpr
 
 	glScissor(x, y, width, height);
 
-	wingsView->DrawFrame();
+	{
+		silnith::wings::instrumentation::PhaseTimer const frameTimer{ silnith::wings::instrumentation::Phase::Frame };
+		wingsView->DrawFrame();
+	}
 
 	return TRUE;
 }
@@ -144,7 +148,10 @@ void CALLBACK AdvanceAnimation(HWND hWnd, UINT uMsg, UINT_PTR idEvent, DWORD dwT
 
 	assert(hglrc == wglGetCurrentContext());
 
-	wingsView->AdvanceAnimation();
+	{
+		silnith::wings::instrumentation::PhaseTimer const tickTimer{ silnith::wings::instrumentation::Phase::Tick };
+		wingsView->AdvanceAnimation();
+	}
 
 	HRGN constexpr hRegion{ nullptr };
 	BOOL constexpr eraseBackground{ FALSE };
@@ -251,6 +258,11 @@ LRESULT WINAPI ScreenSaverProcW(HWND hWnd, UINT message, WPARAM wParam, LPARAM l
 		}
 
 		wingsView = std::make_unique<silnith::wings::gl::WingsView>(silnith::wings::gl::GLInfo{});
+		/*
+		 * A screensaver should not spend its first second drawing a partial
+		 * spiral, so the whole history is filled in before the first frame.
+		 */
+		wingsView->WarmStart();
 
 		ReleaseDC(hWnd, hdc);
 
@@ -318,7 +330,10 @@ LRESULT WINAPI ScreenSaverProcW(HWND hWnd, UINT message, WPARAM wParam, LPARAM l
 		LPARAM constexpr dwData{ 0 };
 		EnumDisplayMonitors(hdc, lprcClip, lpfnEnum, dwData);
 
-		SwapBuffers(hdc);
+		{
+			silnith::wings::instrumentation::PhaseTimer const swapTimer{ silnith::wings::instrumentation::Phase::Swap };
+			SwapBuffers(hdc);
+		}
 
 		EndPaint(hWnd, &paintstruct);
 		return 0;
@@ -341,6 +356,8 @@ LRESULT WINAPI ScreenSaverProcW(HWND hWnd, UINT message, WPARAM wParam, LPARAM l
 
 		wglDeleteContext(hglrc);
 
+		silnith::wings::instrumentation::WriteReport();
+
 		return DefScreenSaverProc(hWnd, message, wParam, lParam);
 	}
 	default:
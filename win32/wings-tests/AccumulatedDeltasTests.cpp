@@ -0,0 +1,139 @@
+#include "CppUnitTest.h"
+
+#include <array>
+#include <vector>
+
+#include <cstddef>
+
+#include "AccumulatedDeltas.h"
+#include "RingBuffer.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::tests
+{
+	TEST_CLASS(AccumulatedDeltasTests)
+	{
+	public:
+
+		TEST_METHOD(TestFirstWingAccumulatesOwnDeltas)
+		{
+			AccumulatedDeltas<float> deltas{ 4 };
+			AccumulatedDeltas<float>::Anchor const anchor{ deltas.AddWing(15.0f, 0.5f) };
+
+			std::array<float, 2> const accumulated{ deltas.getAccumulatedDeltas(anchor) };
+			Assert::AreEqual(15.0f, accumulated[0], 0.0f);
+			Assert::AreEqual(0.5f, accumulated[1], 0.0f);
+		}
+
+		TEST_METHOD(TestAddingWingShiftsOlderWings)
+		{
+			AccumulatedDeltas<float> deltas{ 4 };
+			AccumulatedDeltas<float>::Anchor const older{ deltas.AddWing(15.0f, 0.5f) };
+			AccumulatedDeltas<float>::Anchor const newer{ deltas.AddWing(10.0f, 0.25f) };
+
+			std::array<float, 2> const olderAccumulated{ deltas.getAccumulatedDeltas(older) };
+			Assert::AreEqual(25.0f, olderAccumulated[0], 0.0f);
+			Assert::AreEqual(0.75f, olderAccumulated[1], 0.0f);
+
+			std::array<float, 2> const newerAccumulated{ deltas.getAccumulatedDeltas(newer) };
+			Assert::AreEqual(10.0f, newerAccumulated[0], 0.0f);
+			Assert::AreEqual(0.25f, newerAccumulated[1], 0.0f);
+		}
+
+		TEST_METHOD(TestMatchesSummingTheHistory)
+		{
+			std::size_t constexpr numWings{ 7 };
+			AccumulatedDeltas<double> deltas{ numWings };
+			RingBuffer<std::array<double, 2> > history{ numWings };
+			RingBuffer<AccumulatedDeltas<double>::Anchor> anchors{ numWings };
+
+			for (std::size_t tick{ 0 }; tick < 100; tick++)
+			{
+				double const deltaAngle{ 10.0 + static_cast<double>(tick % 5) };
+				double const deltaZ{ 0.25 + static_cast<double>(tick % 3) * 0.125 };
+				history.emplace_front(std::array<double, 2>{ deltaAngle, deltaZ });
+				anchors.emplace_front(deltas.AddWing(deltaAngle, deltaZ));
+
+				double angle{ 0 };
+				double z{ 0 };
+				for (std::size_t index{ 0 }; index < history.size(); index++)
+				{
+					angle += history[index][0];
+					z += history[index][1];
+
+					std::array<double, 2> const accumulated{ deltas.getAccumulatedDeltas(anchors[index]) };
+					Assert::AreEqual(angle, accumulated[0], 1e-9);
+					Assert::AreEqual(z, accumulated[1], 1e-9);
+				}
+			}
+		}
+
+		TEST_METHOD(TestSectionOffsetsMinusAnchorIsAccumulatedDeltas)
+		{
+			AccumulatedDeltas<float> deltas{ 3 };
+			std::vector<AccumulatedDeltas<float>::Anchor> anchors{};
+			for (int tick{ 0 }; tick < 10; tick++)
+			{
+				anchors.push_back(deltas.AddWing(12.0f, 0.5f));
+			}
+
+			std::array<float, 2 * AccumulatedDeltas<float>::numSections> const offsets{ deltas.getSectionOffsets() };
+			for (std::size_t index{ anchors.size() - 3 }; index < anchors.size(); index++)
+			{
+				AccumulatedDeltas<float>::Anchor const& anchor{ anchors[index] };
+				std::array<float, 2> const accumulated{ deltas.getAccumulatedDeltas(anchor) };
+				Assert::AreEqual(accumulated[0], offsets[2 * anchor.section + 0] - anchor.angle, 0.0f);
+				Assert::AreEqual(accumulated[1], offsets[2 * anchor.section + 1] - anchor.z, 0.0f);
+			}
+		}
+
+		TEST_METHOD(TestVisibleWingsSpanTwoSections)
+		{
+			AccumulatedDeltas<float> deltas{ 4 };
+			std::vector<std::size_t> sections{};
+			for (int tick{ 0 }; tick < 12; tick++)
+			{
+				sections.push_back(deltas.AddWing(1.0f, 1.0f).section);
+			}
+
+			Assert::AreEqual(std::size_t{ 0 }, sections[0]);
+			Assert::AreEqual(std::size_t{ 0 }, sections[3]);
+			Assert::AreEqual(std::size_t{ 1 }, sections[4]);
+			Assert::AreEqual(std::size_t{ 2 }, sections[8]);
+			Assert::AreEqual(std::size_t{ 2 }, sections[11]);
+		}
+
+		TEST_METHOD(TestPrecisionAfterLongHistory)
+		{
+			AccumulatedDeltas<float> deltas{ 40 };
+			for (int tick{ 0 }; tick < 1'000'000; tick++)
+			{
+				static_cast<void>(deltas.AddWing(17.0f, 0.4f));
+			}
+			AccumulatedDeltas<float>::Anchor const anchor{ deltas.AddWing(13.0f, 0.3f) };
+
+			std::array<float, 2> const accumulated{ deltas.getAccumulatedDeltas(anchor) };
+			Assert::AreEqual(13.0f, accumulated[0], 1e-4f);
+			Assert::AreEqual(0.3f, accumulated[1], 1e-4f);
+		}
+
+		TEST_METHOD(TestClear)
+		{
+			AccumulatedDeltas<float> deltas{ 2 };
+			static_cast<void>(deltas.AddWing(15.0f, 0.5f));
+			static_cast<void>(deltas.AddWing(15.0f, 0.5f));
+			static_cast<void>(deltas.AddWing(15.0f, 0.5f));
+			deltas.Clear();
+
+			AccumulatedDeltas<float>::Anchor const anchor{ deltas.AddWing(5.0f, 0.25f) };
+
+			Assert::AreEqual(std::size_t{ 0 }, anchor.section);
+			Assert::AreEqual(0.0f, anchor.angle, 0.0f);
+			Assert::AreEqual(0.0f, anchor.z, 0.0f);
+			std::array<float, 2> const accumulated{ deltas.getAccumulatedDeltas(anchor) };
+			Assert::AreEqual(5.0f, accumulated[0], 0.0f);
+			Assert::AreEqual(0.25f, accumulated[1], 0.0f);
+		}
+	};
+}
@@ -0,0 +1,79 @@
+#include "CppUnitTest.h"
+
+#include <bit>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CurveGenerator.h"
+#include "CurveGeneratorBank.h"
+#include "Philox4x32.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::tests
+{
+	TEST_CLASS(CurveGeneratorBankTests)
+	{
+	public:
+
+		TEST_METHOD(TestFloatBankMatchesScalarGenerators)
+		{
+			CurveGenerator<float> angle{ CurveGenerator<float>::createGeneratorForAngles(350.0f, 40.0f, 5.0f, 30, Philox4x32{ 1 }) };
+			CurveGenerator<float> color{ CurveGenerator<float>::createGeneratorForColorComponents(0.5f, 0.3f, 0.1f, 20, Philox4x32{ 2 }) };
+			CurveGenerator<float> radius{ 10.0f, -15.0f, 15.0f, false, 4.0f, 1.0f, 10, Philox4x32{ 3 } };
+			CurveGenerator<float> wide{ 0.0f, -1.0f, 1.0f, true, 0.75f, 0.1f, 7, Philox4x32{ 4 } };
+			CurveGenerator<float> fifth{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 60.0f, 7.0f, 0, Philox4x32{ 5 }) };
+			(void)angle.getNextValue();
+			(void)color.getNextValue();
+			(void)radius.getNextValue();
+			(void)wide.getNextValue();
+			(void)fifth.getNextValue();
+
+			CurveGeneratorBank<float, 5> bank{ angle, color, radius, wide, fifth };
+
+			for (int tick{ 0 }; tick < 500; tick++)
+			{
+				bank.advanceTick();
+				Assert::AreEqual(std::bit_cast<std::uint32_t>(angle.getNextValue()), std::bit_cast<std::uint32_t>(bank.getValue(0)));
+				Assert::AreEqual(std::bit_cast<std::uint32_t>(color.getNextValue()), std::bit_cast<std::uint32_t>(bank.getValue(1)));
+				Assert::AreEqual(std::bit_cast<std::uint32_t>(radius.getNextValue()), std::bit_cast<std::uint32_t>(bank.getValue(2)));
+				Assert::AreEqual(std::bit_cast<std::uint32_t>(wide.getNextValue()), std::bit_cast<std::uint32_t>(bank.getValue(3)));
+				Assert::AreEqual(std::bit_cast<std::uint32_t>(fifth.getNextValue()), std::bit_cast<std::uint32_t>(bank.getValue(4)));
+				Assert::AreEqual(std::bit_cast<std::uint32_t>(angle.getVelocity()), std::bit_cast<std::uint32_t>(bank.getVelocity(0)));
+				Assert::AreEqual(std::bit_cast<std::uint32_t>(wide.getAcceleration()), std::bit_cast<std::uint32_t>(bank.getAcceleration(3)));
+				Assert::AreEqual(angle.getTicks(), bank.getTicks(0));
+			}
+		}
+
+		TEST_METHOD(TestDoubleBankMatchesScalarGenerators)
+		{
+			CurveGenerator<double> angle{ CurveGenerator<double>::createGeneratorForAngles(10.0, 40.0, 5.0, 30, Philox4x32{ 1 }) };
+			CurveGenerator<double> color{ CurveGenerator<double>::createGeneratorForColorComponents(0.5, 0.3, 0.1, 20, Philox4x32{ 2 }) };
+			(void)angle.getNextValue();
+			(void)color.getNextValue();
+
+			CurveGeneratorBank<double, 2> bank{ angle, color };
+
+			for (int tick{ 0 }; tick < 500; tick++)
+			{
+				std::span<double const, 2> const values{ bank.getNextValues() };
+				Assert::AreEqual(std::bit_cast<std::uint64_t>(angle.getNextValue()), std::bit_cast<std::uint64_t>(values[0]));
+				Assert::AreEqual(std::bit_cast<std::uint64_t>(color.getNextValue()), std::bit_cast<std::uint64_t>(values[1]));
+			}
+		}
+
+		TEST_METHOD(TestClampedValueStaysInRange)
+		{
+			CurveGenerator<float> color{ CurveGenerator<float>::createGeneratorForColorComponents(0.5f, 0.3f, 0.1f, 20) };
+			CurveGeneratorBank<float, 1> bank{ color };
+
+			for (int tick{ 0 }; tick < 1000; tick++)
+			{
+				bank.advanceTick();
+				Assert::IsTrue(bank.getValue(0) >= 0.0f);
+				Assert::IsTrue(bank.getValue(0) <= 1.0f);
+			}
+		}
+	};
+}
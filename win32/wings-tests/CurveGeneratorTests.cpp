@@ -0,0 +1,258 @@
+#include "CppUnitTest.h"
+
+#include <algorithm>
+
+#include <cmath>
+#include <cstdint>
+
+#include "CurveGenerator.h"
+#include "Philox4x32.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::tests
+{
+	TEST_CLASS(CurveGeneratorTests)
+	{
+	private:
+		/// <summary>
+		/// An engine that always returns the same word.
+		/// </summary>
+		template<std::uint32_t word>
+		struct ConstantEngine
+		{
+			using result_type = std::uint32_t;
+
+			static constexpr result_type min(void) noexcept
+			{
+				return 0;
+			}
+
+			static constexpr result_type max(void) noexcept
+			{
+				return 0xFFFFFFFFu;
+			}
+
+			result_type operator()(void) noexcept
+			{
+				return word;
+			}
+		};
+
+	public:
+
+		TEST_METHOD(TestSameSeedSameCurve)
+		{
+			CurveGenerator<float> first{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120, Philox4x32{ 7 }) };
+			CurveGenerator<float> second{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120, Philox4x32{ 7 }) };
+
+			for (int tick{ 0 }; tick < 10000; tick++)
+			{
+				Assert::AreEqual(first.getNextValue(), second.getNextValue(), 0.0f);
+			}
+		}
+
+		TEST_METHOD(TestDifferentSeedsDifferentCurves)
+		{
+			CurveGenerator<float> first{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120, Philox4x32{ 7 }) };
+			CurveGenerator<float> second{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120, Philox4x32{ 8 }) };
+
+			(void)first.getNextValue();
+			(void)second.getNextValue();
+
+			Assert::AreNotEqual(first.getAcceleration(), second.getAcceleration());
+		}
+
+		TEST_METHOD(TestAccelerationWithinBounds)
+		{
+			CurveGenerator<double> curve{ 0.0, -1.0, 1.0, false, 0.5, 0.25, 0, Philox4x32{ 3 } };
+
+			for (int tick{ 0 }; tick < 1000; tick++)
+			{
+				(void)curve.getNextValue();
+				Assert::IsTrue(curve.getAcceleration() >= -0.25);
+				Assert::IsTrue(curve.getAcceleration() <= 0.25);
+			}
+		}
+
+		TEST_METHOD(TestDrawAccelerationUsesEngineBits)
+		{
+			Philox4x32 engine{ 5 };
+			Philox4x32 copy{ 5 };
+
+			for (int draw{ 0 }; draw < 1000; draw++)
+			{
+				float const canonical{ std::min(static_cast<float>(copy()) / 4294967296.0f, std::nextafter(1.0f, 0.0f)) };
+				Assert::AreEqual(canonical * 0.5f - 0.25f, CurveGenerator<float>::drawAcceleration(engine, 0.25f), 0.0f);
+			}
+		}
+
+		TEST_METHOD(TestDrawAccelerationExcludesMaximum)
+		{
+			ConstantEngine<0u> lowest{};
+			ConstantEngine<0xFFFFFFFFu> highest{};
+
+			Assert::AreEqual(-0.25f, CurveGenerator<float, ConstantEngine<0u> >::drawAcceleration(lowest, 0.25f), 0.0f);
+			Assert::IsTrue(CurveGenerator<float, ConstantEngine<0xFFFFFFFFu> >::drawAcceleration(highest, 0.25f) < 0.25f);
+		}
+
+		TEST_METHOD(TestAccelerationChangesAfterTicks)
+		{
+			CurveGenerator<float> curve{ CurveGenerator<float>::createGeneratorForColorComponents(0.5f, 0.04f, 0.01f, 3, Philox4x32{ 11 }) };
+
+			(void)curve.getNextValue();
+			Assert::AreEqual(0u, curve.getTicks());
+			float const acceleration{ curve.getAcceleration() };
+
+			(void)curve.getNextValue();
+			(void)curve.getNextValue();
+			(void)curve.getNextValue();
+			Assert::AreEqual(3u, curve.getTicks());
+			Assert::AreEqual(acceleration, curve.getAcceleration(), 0.0f);
+
+			(void)curve.getNextValue();
+			Assert::AreEqual(0u, curve.getTicks());
+		}
+
+		TEST_METHOD(TestAdvanceMatchesSteppingClamped)
+		{
+			CurveGenerator<double> stepped{ 10.0, -15.0, 15.0, false, 0.1, 0.01, 150, Philox4x32{ 21 } };
+			CurveGenerator<double> skipped{ 10.0, -15.0, 15.0, false, 0.1, 0.01, 150, Philox4x32{ 21 } };
+
+			for (std::uint64_t count : { 1ull, 7ull, 150ull, 151ull, 1000ull, 12345ull })
+			{
+				for (std::uint64_t i{ 0 }; i < count; i++)
+				{
+					(void)stepped.getNextValue();
+				}
+				skipped.advance(count);
+
+				Assert::AreEqual(stepped.getTicks(), skipped.getTicks());
+				Assert::AreEqual(stepped.getAcceleration(), skipped.getAcceleration(), 0.0);
+				Assert::AreEqual(stepped.getVelocity(), skipped.getVelocity(), 1e-12);
+				Assert::AreEqual(stepped.getValue(), skipped.getValue(), 1e-9);
+			}
+		}
+
+		TEST_METHOD(TestAdvanceMatchesSteppingColor)
+		{
+			CurveGenerator<double> stepped{ CurveGenerator<double>::createGeneratorForColorComponents(0.0, 0.04, 0.01, 95, Philox4x32{ 5 }) };
+			CurveGenerator<double> skipped{ CurveGenerator<double>::createGeneratorForColorComponents(0.0, 0.04, 0.01, 95, Philox4x32{ 5 }) };
+
+			for (int round{ 0 }; round < 50; round++)
+			{
+				std::uint64_t const count{ static_cast<std::uint64_t>(round * 37 + 1) };
+				for (std::uint64_t i{ 0 }; i < count; i++)
+				{
+					(void)stepped.getNextValue();
+				}
+				skipped.advance(count);
+
+				Assert::AreEqual(stepped.getValue(), skipped.getValue(), 1e-12);
+			}
+		}
+
+		TEST_METHOD(TestAdvanceMatchesSteppingWrapped)
+		{
+			CurveGenerator<double> stepped{ CurveGenerator<double>::createGeneratorForAngles(15.0, 2.0, 0.25, 40, Philox4x32{ 9 }) };
+			CurveGenerator<double> skipped{ CurveGenerator<double>::createGeneratorForAngles(15.0, 2.0, 0.25, 40, Philox4x32{ 9 }) };
+
+			for (int round{ 0 }; round < 50; round++)
+			{
+				std::uint64_t const count{ static_cast<std::uint64_t>(round * 53 + 3) };
+				for (std::uint64_t i{ 0 }; i < count; i++)
+				{
+					(void)stepped.getNextValue();
+				}
+				skipped.advance(count);
+
+				Assert::AreEqual(stepped.getValue(), skipped.getValue(), 1e-9);
+				Assert::AreEqual(stepped.getVelocity(), skipped.getVelocity(), 1e-12);
+			}
+		}
+
+		TEST_METHOD(TestAdvanceMatchesSteppingFloatAngles)
+		{
+			CurveGenerator<float> stepped{ CurveGenerator<float>::createGeneratorForAngles(15.0f, 2.0f, 0.25f, 40, Philox4x32{ 9 }) };
+			CurveGenerator<float> skipped{ CurveGenerator<float>::createGeneratorForAngles(15.0f, 2.0f, 0.25f, 40, Philox4x32{ 9 }) };
+
+			for (std::uint64_t count : { 1ull, 40ull, 41ull, 999ull, 20000ull })
+			{
+				for (std::uint64_t i{ 0 }; i < count; i++)
+				{
+					(void)stepped.getNextValue();
+				}
+				skipped.advance(count);
+
+				Assert::AreEqual(stepped.getTicks(), skipped.getTicks());
+				Assert::AreEqual(stepped.getAcceleration(), skipped.getAcceleration(), 0.0f);
+				Assert::AreEqual(stepped.getVelocity(), skipped.getVelocity(), 1e-4f);
+				Assert::AreEqual(stepped.getValue(), skipped.getValue(), 1e-2f);
+				Assert::AreEqual(stepped.getNextValue(), skipped.getNextValue(), 1e-2f);
+			}
+		}
+
+		TEST_METHOD(TestAdvanceMatchesSteppingFloatClamped)
+		{
+			CurveGenerator<float> stepped{ 10.0f, -15.0f, 15.0f, false, 0.1f, 0.01f, 150, Philox4x32{ 21 } };
+			CurveGenerator<float> skipped{ 10.0f, -15.0f, 15.0f, false, 0.1f, 0.01f, 150, Philox4x32{ 21 } };
+
+			for (std::uint64_t count : { 1ull, 7ull, 150ull, 151ull, 1000ull, 12345ull })
+			{
+				for (std::uint64_t i{ 0 }; i < count; i++)
+				{
+					(void)stepped.getNextValue();
+				}
+				skipped.advance(count);
+
+				Assert::AreEqual(stepped.getTicks(), skipped.getTicks());
+				Assert::AreEqual(stepped.getVelocity(), skipped.getVelocity(), 1e-5f);
+				Assert::AreEqual(stepped.getValue(), skipped.getValue(), 1e-3f);
+			}
+		}
+
+		TEST_METHOD(TestAdvanceNeverWrapsAwayFromStepping)
+		{
+			for (std::uint64_t seed{ 0 }; seed < 200; seed++)
+			{
+				CurveGenerator<float> stepped{ CurveGenerator<float>::createGeneratorForAngles(15.0f, 2.0f, 0.25f, 40, Philox4x32{ seed }) };
+				CurveGenerator<float> skipped{ CurveGenerator<float>::createGeneratorForAngles(15.0f, 2.0f, 0.25f, 40, Philox4x32{ seed }) };
+
+				for (int round{ 0 }; round < 50; round++)
+				{
+					std::uint64_t const count{ static_cast<std::uint64_t>(round * 7 + 1) };
+					for (std::uint64_t i{ 0 }; i < count; i++)
+					{
+						(void)stepped.getNextValue();
+					}
+					skipped.advance(count);
+
+					Assert::AreEqual(stepped.getValue(), skipped.getValue(), 1e-2f);
+				}
+			}
+		}
+
+		TEST_METHOD(TestAdvanceLongSegment)
+		{
+			/*
+			 * Four billion ticks in one segment.  Stepping them would take
+			 * seconds; the closed form takes the same time as one tick.
+			 */
+			CurveGenerator<float> curve{ 0.0f, -1.0f, 1.0f, false, 0.001f, 0.0001f, 4000000000u, Philox4x32{ 3 } };
+			curve.advance(4000000001ull);
+
+			Assert::AreEqual(4000000000u, curve.getTicks());
+			Assert::AreEqual(std::abs(curve.getVelocity()), 0.001f, 0.0f);
+			Assert::AreEqual(std::abs(curve.getValue()), 1.0f, 0.0f);
+		}
+
+		TEST_METHOD(TestAdvanceZeroIsNoOp)
+		{
+			CurveGenerator<float> curve{ CurveGenerator<float>::createGeneratorForAngles(15.0f, 0.2f, 0.02f, 80, Philox4x32{ 1 }) };
+			curve.advance(0);
+
+			Assert::AreEqual(15.0f, curve.getValue(), 0.0f);
+			Assert::AreEqual(80u, curve.getTicks());
+		}
+	};
+}
@@ -0,0 +1,151 @@
+#include "CppUnitTest.h"
+
+#include <cstdint>
+
+#include "GLStateCache.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::gl::tests
+{
+	TEST_CLASS(GLStateCacheTests)
+	{
+	private:
+		static GLStateCache::VertexAttributePointer PointerInto(GLuint buffer)
+		{
+			return GLStateCache::VertexAttributePointer{
+				.buffer = buffer,
+				.size = 4,
+				.type = GL_FLOAT,
+				.normalized = GL_FALSE,
+				.stride = 16,
+				.offset = 0,
+				.divisor = 0,
+			};
+		}
+
+	public:
+
+		TEST_METHOD(TestNewCacheHasNoCounts)
+		{
+			GLStateCache const cache{};
+
+			Assert::AreEqual(std::uint64_t{ 0 }, cache.getCounts().issued);
+			Assert::AreEqual(std::uint64_t{ 0 }, cache.getCounts().elided);
+			Assert::AreEqual(std::uint64_t{ 0 }, cache.getFrameCounts().issued);
+			Assert::AreEqual(std::uint64_t{ 0 }, cache.getFrameCounts().elided);
+		}
+
+		TEST_METHOD(TestFirstProgramIsIssued)
+		{
+			GLStateCache cache{};
+
+			Assert::IsTrue(cache.ChangeProgram(0));
+			Assert::AreEqual(std::uint64_t{ 1 }, cache.getCounts().issued);
+		}
+
+		TEST_METHOD(TestSameProgramIsElided)
+		{
+			GLStateCache cache{};
+
+			Assert::IsTrue(cache.ChangeProgram(3));
+			Assert::IsFalse(cache.ChangeProgram(3));
+			Assert::IsTrue(cache.ChangeProgram(4));
+			Assert::IsTrue(cache.ChangeProgram(3));
+
+			Assert::AreEqual(std::uint64_t{ 3 }, cache.getCounts().issued);
+			Assert::AreEqual(std::uint64_t{ 1 }, cache.getCounts().elided);
+		}
+
+		TEST_METHOD(TestProgramAndVertexArrayAreSeparate)
+		{
+			GLStateCache cache{};
+
+			Assert::IsTrue(cache.ChangeProgram(1));
+			Assert::IsTrue(cache.ChangeVertexArray(1));
+			Assert::IsFalse(cache.ChangeProgram(1));
+			Assert::IsFalse(cache.ChangeVertexArray(1));
+		}
+
+		TEST_METHOD(TestVertexAttributeIsKeptPerVertexArray)
+		{
+			GLStateCache cache{};
+
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, PointerInto(7)));
+			Assert::IsTrue(cache.ChangeVertexAttribute(2, 0, PointerInto(7)));
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 1, PointerInto(7)));
+			Assert::IsFalse(cache.ChangeVertexAttribute(1, 0, PointerInto(7)));
+			Assert::IsFalse(cache.ChangeVertexAttribute(2, 0, PointerInto(7)));
+			Assert::IsFalse(cache.ChangeVertexAttribute(1, 1, PointerInto(7)));
+		}
+
+		TEST_METHOD(TestVertexAttributeWithNewBufferIsIssued)
+		{
+			GLStateCache cache{};
+
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, PointerInto(7)));
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, PointerInto(8)));
+			Assert::IsFalse(cache.ChangeVertexAttribute(1, 0, PointerInto(8)));
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, PointerInto(7)));
+		}
+
+		TEST_METHOD(TestVertexAttributeWithNewLayoutIsIssued)
+		{
+			GLStateCache cache{};
+			GLStateCache::VertexAttributePointer pointer{ PointerInto(7) };
+
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, pointer));
+			pointer.offset = 64;
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, pointer));
+			pointer.stride = 12;
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, pointer));
+			pointer.type = GL_UNSIGNED_BYTE;
+			pointer.normalized = GL_TRUE;
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, pointer));
+			pointer.divisor = 1;
+			Assert::IsTrue(cache.ChangeVertexAttribute(1, 0, pointer));
+			Assert::IsFalse(cache.ChangeVertexAttribute(1, 0, pointer));
+		}
+
+		TEST_METHOD(TestInvalidateForgetsStateButKeepsCounts)
+		{
+			GLStateCache cache{};
+			Assert::IsTrue(cache.ChangeProgram(1));
+			Assert::IsTrue(cache.ChangeVertexArray(2));
+			Assert::IsTrue(cache.ChangeVertexAttribute(2, 0, PointerInto(3)));
+
+			cache.Invalidate();
+
+			Assert::AreEqual(std::uint64_t{ 3 }, cache.getCounts().issued);
+			Assert::IsTrue(cache.ChangeProgram(1));
+			Assert::IsTrue(cache.ChangeVertexArray(2));
+			Assert::IsTrue(cache.ChangeVertexAttribute(2, 0, PointerInto(3)));
+			Assert::AreEqual(std::uint64_t{ 6 }, cache.getCounts().issued);
+			Assert::AreEqual(std::uint64_t{ 0 }, cache.getCounts().elided);
+		}
+
+		TEST_METHOD(TestFrameCountsAreSinceThePreviousFrame)
+		{
+			GLStateCache cache{};
+			Assert::IsTrue(cache.ChangeProgram(1));
+			Assert::IsTrue(cache.ChangeVertexArray(1));
+			cache.EndFrame();
+
+			Assert::AreEqual(std::uint64_t{ 2 }, cache.getFrameCounts().issued);
+			Assert::AreEqual(std::uint64_t{ 0 }, cache.getFrameCounts().elided);
+
+			Assert::IsFalse(cache.ChangeProgram(1));
+			Assert::IsFalse(cache.ChangeVertexArray(1));
+			Assert::IsTrue(cache.ChangeVertexArray(2));
+
+			Assert::AreEqual(std::uint64_t{ 2 }, cache.getFrameCounts().issued);
+
+			cache.EndFrame();
+
+			Assert::AreEqual(std::uint64_t{ 1 }, cache.getFrameCounts().issued);
+			Assert::AreEqual(std::uint64_t{ 2 }, cache.getFrameCounts().elided);
+			Assert::AreEqual(std::uint64_t{ 3 }, cache.getCounts().issued);
+			Assert::AreEqual(std::uint64_t{ 2 }, cache.getCounts().elided);
+		}
+	};
+}
@@ -0,0 +1,165 @@
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Instrumentation.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::instrumentation::tests
+{
+	TEST_CLASS(InstrumentationTests)
+	{
+	public:
+
+		TEST_METHOD(TestSmallValuesHaveExactBuckets)
+		{
+			for (std::uint64_t value{ 0 }; value < 32; value++)
+			{
+				std::size_t const index{ LatencyHistogram::GetBucketIndex(value) };
+
+				Assert::AreEqual(value, LatencyHistogram::GetBucketLowerBound(index));
+				Assert::AreEqual(value, LatencyHistogram::GetBucketUpperBound(index));
+			}
+		}
+
+		TEST_METHOD(TestBucketsContainTheirValues)
+		{
+			for (std::uint64_t value{ 1 }; value < (std::uint64_t{ 1 } << 62); value = value * 3 + 1)
+			{
+				std::size_t const index{ LatencyHistogram::GetBucketIndex(value) };
+
+				Assert::IsTrue(index < LatencyHistogram::numBuckets);
+				Assert::IsTrue(LatencyHistogram::GetBucketLowerBound(index) <= value);
+				Assert::IsTrue(value <= LatencyHistogram::GetBucketUpperBound(index));
+			}
+			Assert::AreEqual(LatencyHistogram::numBuckets - 1, LatencyHistogram::GetBucketIndex(UINT64_MAX));
+		}
+
+		TEST_METHOD(TestBucketsAreContiguous)
+		{
+			for (std::size_t index{ 1 }; index < LatencyHistogram::numBuckets; index++)
+			{
+				Assert::AreEqual(LatencyHistogram::GetBucketUpperBound(index - 1) + 1, LatencyHistogram::GetBucketLowerBound(index));
+			}
+		}
+
+		TEST_METHOD(TestPercentiles)
+		{
+			LatencyHistogram histogram{};
+			for (std::uint64_t value{ 1 }; value <= 1000; value++)
+			{
+				histogram.Record(value * 1000);
+			}
+
+			Assert::AreEqual(std::uint64_t{ 1000 }, histogram.getCount());
+			Assert::AreEqual(std::uint64_t{ 1000000 }, histogram.getMax());
+			Assert::AreEqual(500500.0, histogram.getMean(), 0.001);
+
+			/*
+			 * The buckets are never wider than 1/16th of their values.
+			 */
+			std::uint64_t const p50{ histogram.getValueAtPercentile(50) };
+			Assert::IsTrue(p50 >= 500000);
+			Assert::IsTrue(p50 <= 500000 + 500000 / 16);
+
+			std::uint64_t const p99{ histogram.getValueAtPercentile(99) };
+			Assert::IsTrue(p99 >= 990000);
+			Assert::IsTrue(p99 <= 1000000);
+
+			Assert::AreEqual(std::uint64_t{ 1000000 }, histogram.getValueAtPercentile(100));
+		}
+
+		TEST_METHOD(TestEmptyHistogram)
+		{
+			LatencyHistogram const histogram{};
+
+			Assert::AreEqual(std::uint64_t{ 0 }, histogram.getCount());
+			Assert::AreEqual(std::uint64_t{ 0 }, histogram.getValueAtPercentile(99));
+			Assert::AreEqual(0.0, histogram.getMean(), 0.0);
+		}
+
+		TEST_METHOD(TestMerge)
+		{
+			LatencyHistogram first{};
+			LatencyHistogram second{};
+			first.Record(10);
+			second.Record(20);
+			second.Record(30);
+			first.Merge(second);
+
+			Assert::AreEqual(std::uint64_t{ 3 }, first.getCount());
+			Assert::AreEqual(std::uint64_t{ 30 }, first.getMax());
+			Assert::AreEqual(std::uint64_t{ 20 }, first.getValueAtPercentile(50));
+		}
+
+		TEST_METHOD(TestPhaseTimerRecords)
+		{
+			std::uint64_t const before{ Snapshot()[static_cast<std::size_t>(Phase::Swap)].getCount() };
+
+			{
+				PhaseTimer timer{ Phase::Swap };
+				timer.Stop();
+				timer.Stop();
+			}
+
+			std::uint64_t const after{ Snapshot()[static_cast<std::size_t>(Phase::Swap)].getCount() };
+			Assert::AreEqual(before + 1, after);
+		}
+
+		TEST_METHOD(TestFirstFrameTimerRecordsFirstCompleteFrameOnly)
+		{
+			std::uint64_t const before{ Snapshot()[static_cast<std::size_t>(Phase::FirstFrame)].getCount() };
+
+			FirstFrameTimer const timer{};
+			timer.FrameDrawn(false);
+			timer.FrameDrawn(false);
+			Assert::AreEqual(before, Snapshot()[static_cast<std::size_t>(Phase::FirstFrame)].getCount());
+
+			timer.FrameDrawn(true);
+			timer.FrameDrawn(true);
+			Assert::AreEqual(before + 1, Snapshot()[static_cast<std::size_t>(Phase::FirstFrame)].getCount());
+		}
+
+		TEST_METHOD(TestSnapshotIncludesOtherThreads)
+		{
+			std::uint64_t const before{ Snapshot()[static_cast<std::size_t>(Phase::OutlinePass)].getCount() };
+
+			std::thread recorder{ []()
+				{
+					for (int i{ 0 }; i < 100; i++)
+					{
+						Record(Phase::OutlinePass, std::chrono::microseconds{ i });
+					}
+				} };
+			recorder.join();
+
+			PhaseHistograms const histograms{ Snapshot() };
+			Assert::AreEqual(before + 100, histograms[static_cast<std::size_t>(Phase::OutlinePass)].getCount());
+			Assert::IsTrue(histograms[static_cast<std::size_t>(Phase::OutlinePass)].getMax() >= 99000);
+		}
+
+		TEST_METHOD(TestReportsNameEveryPhase)
+		{
+			PhaseHistograms histograms{};
+			histograms[static_cast<std::size_t>(Phase::Frame)].Record(1500);
+
+			std::string const text{ FormatTextReport(histograms) };
+			std::string const json{ FormatJsonReport(histograms) };
+			for (std::size_t phaseIndex{ 0 }; phaseIndex < numPhases; phaseIndex++)
+			{
+				std::string const name{ GetPhaseName(static_cast<Phase>(phaseIndex)) };
+
+				Assert::IsTrue(text.find(name) != std::string::npos);
+				Assert::IsTrue(json.find("\"" + name + "\"") != std::string::npos);
+			}
+			Assert::IsTrue(text.find("1.5") != std::string::npos);
+			Assert::IsTrue(json.find("\"max\": 1500") != std::string::npos);
+		}
+	};
+}
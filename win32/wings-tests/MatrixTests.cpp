@@ -0,0 +1,106 @@
+#include "CppUnitTest.h"
+
+#include <array>
+
+#include <cstddef>
+
+#include "Matrix.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::tests
+{
+	TEST_CLASS(MatrixTests)
+	{
+	private:
+		static std::array<float, 4> Transform(Matrix const& matrix, std::array<float, 4> const& vertex)
+		{
+			std::array<float, 4> result{};
+			for (std::size_t row{ 0 }; row < 4; row++)
+			{
+				for (std::size_t column{ 0 }; column < 4; column++)
+				{
+					result[row] += matrix[column * 4 + row] * vertex[column];
+				}
+			}
+			return result;
+		}
+
+		static void AssertMatricesEqual(Matrix const& expected, Matrix const& actual)
+		{
+			for (std::size_t index{ 0 }; index < expected.size(); index++)
+			{
+				Assert::AreEqual(expected[index], actual[index], 1e-5f);
+			}
+		}
+
+	public:
+
+		TEST_METHOD(TestMultiplyIdentity)
+		{
+			Matrix const rotation{ Rotate(30, 0, 1, 0) };
+
+			AssertMatricesEqual(rotation, Multiply(identityMatrix, rotation));
+			AssertMatricesEqual(rotation, Multiply(rotation, identityMatrix));
+		}
+
+		TEST_METHOD(TestTranslate)
+		{
+			std::array<float, 4> const vertex{ Transform(Translate(1, 2, 3), { 1, 1, 1, 1 }) };
+
+			Assert::AreEqual(2.0f, vertex[0]);
+			Assert::AreEqual(3.0f, vertex[1]);
+			Assert::AreEqual(4.0f, vertex[2]);
+			Assert::AreEqual(1.0f, vertex[3]);
+		}
+
+		TEST_METHOD(TestRotateAboutZ)
+		{
+			std::array<float, 4> const vertex{ Transform(Rotate(90, 0, 0, 1), { 1, 0, 0, 1 }) };
+
+			Assert::AreEqual(0.0f, vertex[0], 1e-6f);
+			Assert::AreEqual(1.0f, vertex[1], 1e-6f);
+			Assert::AreEqual(0.0f, vertex[2], 1e-6f);
+		}
+
+		TEST_METHOD(TestRotateAboutX)
+		{
+			std::array<float, 4> const vertex{ Transform(Rotate(90, 1, 0, 0), { 0, 1, 0, 1 }) };
+
+			Assert::AreEqual(0.0f, vertex[0], 1e-6f);
+			Assert::AreEqual(0.0f, vertex[1], 1e-6f);
+			Assert::AreEqual(1.0f, vertex[2], 1e-6f);
+		}
+
+		TEST_METHOD(TestMultiplyAppliesRightHandSideFirst)
+		{
+			std::array<float, 4> const vertex{ Transform(Multiply(Rotate(90, 0, 0, 1), Translate(5, 0, 0)), { 0, 0, 0, 1 }) };
+
+			Assert::AreEqual(0.0f, vertex[0], 1e-5f);
+			Assert::AreEqual(5.0f, vertex[1], 1e-5f);
+			Assert::AreEqual(0.0f, vertex[2], 1e-5f);
+		}
+
+		TEST_METHOD(TestWingTransformationPlacesWingAtRadiusAndAngle)
+		{
+			std::array<float, 4> const center{ Transform(WingTransformation(10, 90, 25, 35, 45), { 0, 0, 0, 1 }) };
+
+			Assert::AreEqual(0.0f, center[0], 1e-5f);
+			Assert::AreEqual(10.0f, center[1], 1e-5f);
+			Assert::AreEqual(0.0f, center[2], 1e-5f);
+			Assert::AreEqual(1.0f, center[3], 1e-5f);
+		}
+
+		TEST_METHOD(TestWingTransformationMatchesSequence)
+		{
+			Matrix expected{ identityMatrix };
+			expected = Multiply(expected, Rotate(120, 0, 0, 1));
+			expected = Multiply(expected, Translate(7, 0, 0));
+			expected = Multiply(expected, Rotate(-45, 0, 0, 1));
+			expected = Multiply(expected, Rotate(-35, 0, 1, 0));
+			expected = Multiply(expected, Rotate(25, 1, 0, 0));
+
+			AssertMatricesEqual(expected, WingTransformation(7, 120, 25, 35, 45));
+		}
+	};
+}
@@ -0,0 +1,136 @@
+#include "CppUnitTest.h"
+
+#include <array>
+
+#include <cstdint>
+
+#include "Philox4x32.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::tests
+{
+	TEST_CLASS(Philox4x32Tests)
+	{
+	public:
+
+		/*
+		 * Known-answer vectors from the Random123 reference implementation.
+		 */
+
+		TEST_METHOD(TestKnownAnswerZero)
+		{
+			std::array<std::uint32_t, 4> const block{ Philox4x32::generateBlock({ 0, 0, 0, 0 }, { 0, 0 }) };
+
+			Assert::AreEqual(std::uint32_t{ 0x6627e8d5 }, block[0]);
+			Assert::AreEqual(std::uint32_t{ 0xe169c58d }, block[1]);
+			Assert::AreEqual(std::uint32_t{ 0xbc57ac4c }, block[2]);
+			Assert::AreEqual(std::uint32_t{ 0x9b00dbd8 }, block[3]);
+		}
+
+		TEST_METHOD(TestKnownAnswerOnes)
+		{
+			std::array<std::uint32_t, 4> const block{ Philox4x32::generateBlock(
+				{ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff },
+				{ 0xffffffff, 0xffffffff }) };
+
+			Assert::AreEqual(std::uint32_t{ 0x408f276d }, block[0]);
+			Assert::AreEqual(std::uint32_t{ 0x41c83b0e }, block[1]);
+			Assert::AreEqual(std::uint32_t{ 0xa20bc7c6 }, block[2]);
+			Assert::AreEqual(std::uint32_t{ 0x6d5451fd }, block[3]);
+		}
+
+		TEST_METHOD(TestKnownAnswerPi)
+		{
+			std::array<std::uint32_t, 4> const block{ Philox4x32::generateBlock(
+				{ 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 },
+				{ 0xa4093822, 0x299f31d0 }) };
+
+			Assert::AreEqual(std::uint32_t{ 0xd16cfe09 }, block[0]);
+			Assert::AreEqual(std::uint32_t{ 0x94fdcceb }, block[1]);
+			Assert::AreEqual(std::uint32_t{ 0x5001e420 }, block[2]);
+			Assert::AreEqual(std::uint32_t{ 0x24126ea1 }, block[3]);
+		}
+
+		TEST_METHOD(TestFirstOutputsAreFirstBlock)
+		{
+			Philox4x32 engine{ 0 };
+
+			Assert::AreEqual(std::uint32_t{ 0x6627e8d5 }, engine());
+			Assert::AreEqual(std::uint32_t{ 0xe169c58d }, engine());
+			Assert::AreEqual(std::uint32_t{ 0xbc57ac4c }, engine());
+			Assert::AreEqual(std::uint32_t{ 0x9b00dbd8 }, engine());
+		}
+
+		TEST_METHOD(TestSameSeedSameSequence)
+		{
+			Philox4x32 first{ 12345 };
+			Philox4x32 second{ 12345 };
+
+			for (int i{ 0 }; i < 100; i++)
+			{
+				Assert::AreEqual(first(), second());
+			}
+		}
+
+		TEST_METHOD(TestStreamsDiffer)
+		{
+			Philox4x32 first{ 12345, 0 };
+			Philox4x32 second{ 12345, 1 };
+
+			Assert::AreNotEqual(first(), second());
+		}
+
+		TEST_METHOD(TestDiscardMatchesStepping)
+		{
+			for (unsigned long long count{ 0 }; count < 20; count++)
+			{
+				Philox4x32 stepped{ 99 };
+				Philox4x32 skipped{ 99 };
+				(void)stepped();
+				(void)skipped();
+
+				for (unsigned long long i{ 0 }; i < count; i++)
+				{
+					(void)stepped();
+				}
+				skipped.discard(count);
+
+				Assert::IsTrue(stepped == skipped);
+				Assert::AreEqual(stepped(), skipped());
+			}
+		}
+
+		TEST_METHOD(TestOffsetLocatesNextWord)
+		{
+			Philox4x32 engine{ 0x0123456789abcdef, 3 };
+			for (std::uint64_t expectedOffset{ 0 }; expectedOffset < 20; expectedOffset++)
+			{
+				std::uint64_t const offset{ engine.getOffset() };
+				Assert::AreEqual(expectedOffset, offset);
+
+				std::uint64_t const blockCounter{ offset / 4 };
+				std::uint64_t const stream{ engine.getStream() };
+				std::array<std::uint32_t, 4> const block{ Philox4x32::generateBlock({
+						static_cast<std::uint32_t>(blockCounter),
+						static_cast<std::uint32_t>(blockCounter >> 32),
+						static_cast<std::uint32_t>(stream),
+						static_cast<std::uint32_t>(stream >> 32),
+					}, engine.getKey()) };
+				Assert::AreEqual(block[offset % 4], engine());
+			}
+		}
+
+		TEST_METHOD(TestOffsetAfterDiscard)
+		{
+			for (unsigned long long count{ 0 }; count < 20; count++)
+			{
+				Philox4x32 engine{ 99 };
+				(void)engine();
+				engine.discard(count);
+
+				Assert::AreEqual(std::uint64_t{ 1 + count }, engine.getOffset());
+			}
+		}
+	};
+}
@@ -0,0 +1,138 @@
+#include "CppUnitTest.h"
+
+#include <vector>
+
+#include <cstddef>
+
+#include "RingBuffer.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::tests
+{
+	TEST_CLASS(RingBufferTests)
+	{
+	public:
+
+		TEST_METHOD(TestNewBufferIsEmpty)
+		{
+			RingBuffer<int> buffer{ 3 };
+
+			Assert::IsTrue(buffer.empty());
+			Assert::IsFalse(buffer.full());
+			Assert::AreEqual(std::size_t{ 0 }, buffer.size());
+			Assert::AreEqual(std::size_t{ 3 }, buffer.capacity());
+			Assert::IsTrue(buffer.begin() == buffer.end());
+		}
+
+		TEST_METHOD(TestEmplaceFrontWhileFilling)
+		{
+			RingBuffer<int> buffer{ 3 };
+			buffer.emplace_front(1);
+			buffer.emplace_front(2);
+
+			Assert::AreEqual(std::size_t{ 2 }, buffer.size());
+			Assert::IsFalse(buffer.full());
+			Assert::AreEqual(2, buffer.front());
+			Assert::AreEqual(1, buffer.back());
+			Assert::AreEqual(2, buffer[0]);
+			Assert::AreEqual(1, buffer[1]);
+		}
+
+		TEST_METHOD(TestEmplaceFrontOverwritesBackWhenFull)
+		{
+			RingBuffer<int> buffer{ 3 };
+			for (int i{ 1 }; i <= 5; i++)
+			{
+				buffer.emplace_front(i);
+			}
+
+			Assert::IsTrue(buffer.full());
+			Assert::AreEqual(std::size_t{ 3 }, buffer.size());
+			Assert::AreEqual(5, buffer.front());
+			Assert::AreEqual(3, buffer.back());
+		}
+
+		TEST_METHOD(TestIterationIsFrontToBack)
+		{
+			RingBuffer<int> buffer{ 4 };
+			for (int i{ 1 }; i <= 7; i++)
+			{
+				buffer.emplace_front(i);
+			}
+
+			std::vector<int> values{};
+			for (int const value : buffer)
+			{
+				values.push_back(value);
+			}
+
+			Assert::AreEqual(std::size_t{ 4 }, values.size());
+			Assert::AreEqual(7, values[0]);
+			Assert::AreEqual(6, values[1]);
+			Assert::AreEqual(5, values[2]);
+			Assert::AreEqual(4, values[3]);
+		}
+
+		TEST_METHOD(TestEmplaceFrontFromBack)
+		{
+			RingBuffer<int> buffer{ 2 };
+			buffer.emplace_front(1);
+			buffer.emplace_front(2);
+			buffer.emplace_front(buffer.back() + 10);
+
+			Assert::AreEqual(11, buffer.front());
+			Assert::AreEqual(2, buffer.back());
+		}
+
+		TEST_METHOD(TestRecycleFrontKeepsElement)
+		{
+			RingBuffer<int> buffer{ 3 };
+			buffer.emplace_front(1);
+			buffer.emplace_front(2);
+			buffer.emplace_front(3);
+
+			int& recycled{ buffer.recycle_front() };
+
+			Assert::AreEqual(1, recycled);
+			Assert::AreEqual(1, buffer.front());
+			Assert::AreEqual(2, buffer.back());
+			Assert::AreEqual(std::size_t{ 3 }, buffer.size());
+
+			recycled = 4;
+
+			Assert::AreEqual(4, buffer[0]);
+			Assert::AreEqual(3, buffer[1]);
+			Assert::AreEqual(2, buffer[2]);
+		}
+
+		TEST_METHOD(TestClear)
+		{
+			RingBuffer<int> buffer{ 2 };
+			buffer.emplace_front(1);
+			buffer.emplace_front(2);
+			buffer.emplace_front(3);
+			buffer.clear();
+
+			Assert::IsTrue(buffer.empty());
+			Assert::IsTrue(buffer.begin() == buffer.end());
+
+			buffer.emplace_front(4);
+
+			Assert::AreEqual(std::size_t{ 1 }, buffer.size());
+			Assert::AreEqual(4, buffer.front());
+			Assert::AreEqual(4, buffer.back());
+		}
+
+		TEST_METHOD(TestSingleSlot)
+		{
+			RingBuffer<int> buffer{ 1 };
+			buffer.emplace_front(1);
+			buffer.emplace_front(2);
+
+			Assert::IsTrue(buffer.full());
+			Assert::AreEqual(2, buffer.front());
+			Assert::AreEqual(2, buffer.back());
+		}
+	};
+}
@@ -0,0 +1,171 @@
+#include "CppUnitTest.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Color.h"
+#include "RingBuffer.h"
+#include "SoftwareRasterizer.h"
+#include "Wing.h"
+#include "WingsViewSoftware.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::software::tests
+{
+	TEST_CLASS(SoftwareRasterizerTests)
+	{
+	public:
+
+		TEST_METHOD(TestClearedFramebufferIsTransparentBlack)
+		{
+			SoftwareRasterizer rasterizer{ 8, 4 };
+			rasterizer.Clear();
+
+			Assert::AreEqual(std::size_t{ 8 * 4 * 4 }, rasterizer.getColorBuffer().size());
+			for (std::uint8_t const component : rasterizer.getColorBuffer())
+			{
+				Assert::AreEqual(std::uint8_t{ 0 }, component);
+			}
+			for (float const depth : rasterizer.getDepthBuffer())
+			{
+				Assert::AreEqual(1.0f, depth, 0.0f);
+			}
+		}
+
+		TEST_METHOD(TestEmptyFrameMatchesClearedChecksum)
+		{
+			SoftwareRasterizer cleared{ 16, 16 };
+			SoftwareRasterizer drawn{ 16, 16 };
+			drawn.DrawWings(RingBuffer<Wing<unsigned int, float> >{ 1 });
+
+			Assert::AreEqual(cleared.Checksum(), drawn.Checksum());
+		}
+
+		TEST_METHOD(TestWingCoversCenterWithFillColor)
+		{
+			SoftwareRasterizer rasterizer{ 32, 32 };
+			rasterizer.Ortho(-2, 2, -2, 2, -2, 2);
+
+			RingBuffer<Wing<unsigned int, float> > wings{ 2 };
+			wings.emplace_front(0u,
+				0.0f, 0.0f,
+				0.0f, 0.0f,
+				0.0f, 0.0f, 0.0f,
+				Color<float>{ 1.0f, 0.0f, 0.0f },
+				Color<float>::WHITE);
+			rasterizer.DrawWings(wings);
+
+			std::size_t const center{ (16 * 32 + 16) * 4 };
+			Assert::AreEqual(std::uint8_t{ 255 }, rasterizer.getColorBuffer()[center + 0]);
+			Assert::AreEqual(std::uint8_t{ 0 }, rasterizer.getColorBuffer()[center + 1]);
+			Assert::AreEqual(std::uint8_t{ 0 }, rasterizer.getColorBuffer()[center + 2]);
+			Assert::AreEqual(std::uint8_t{ 255 }, rasterizer.getColorBuffer()[center + 3]);
+		}
+
+		TEST_METHOD(TestWingOutlineDrawnOverFill)
+		{
+			SoftwareRasterizer rasterizer{ 32, 32 };
+			rasterizer.Ortho(-2, 2, -2, 2, -2, 2);
+			rasterizer.PolygonOffset(0.75f, 2.0f);
+
+			RingBuffer<Wing<unsigned int, float> > wings{ 2 };
+			wings.emplace_front(0u,
+				0.0f, 0.0f,
+				0.0f, 0.0f,
+				0.0f, 0.0f, 0.0f,
+				Color<float>{ 1.0f, 0.0f, 0.0f },
+				Color<float>::WHITE);
+			rasterizer.DrawWings(wings);
+
+			/*
+			 * The quad spans [-1, 1], which is window coordinates [8, 24].
+			 * The left edge is at column 8.
+			 */
+			std::size_t const leftEdge{ (16 * 32 + 8) * 4 };
+			Assert::AreEqual(std::uint8_t{ 255 }, rasterizer.getColorBuffer()[leftEdge + 0]);
+			Assert::AreEqual(std::uint8_t{ 255 }, rasterizer.getColorBuffer()[leftEdge + 1]);
+			Assert::AreEqual(std::uint8_t{ 255 }, rasterizer.getColorBuffer()[leftEdge + 2]);
+		}
+
+		TEST_METHOD(TestNearerWingWins)
+		{
+			SoftwareRasterizer rasterizer{ 32, 32 };
+			rasterizer.Ortho(-2, 2, -2, 2, -2, 2);
+
+			/*
+			 * The second wing accumulates the delta Z of both, placing it nearer.
+			 */
+			RingBuffer<Wing<unsigned int, float> > wings{ 2 };
+			wings.emplace_front(0u,
+				0.0f, 0.0f,
+				0.0f, 0.5f,
+				0.0f, 0.0f, 0.0f,
+				Color<float>{ 0.0f, 0.0f, 1.0f },
+				Color<float>::WHITE);
+			wings.emplace_front(0u,
+				0.0f, 0.0f,
+				0.0f, 0.0f,
+				0.0f, 0.0f, 0.0f,
+				Color<float>{ 1.0f, 0.0f, 0.0f },
+				Color<float>::WHITE);
+			rasterizer.DrawWings(wings);
+
+			std::size_t const center{ (16 * 32 + 16) * 4 };
+			Assert::AreEqual(std::uint8_t{ 0 }, rasterizer.getColorBuffer()[center + 0]);
+			Assert::AreEqual(std::uint8_t{ 255 }, rasterizer.getColorBuffer()[center + 2]);
+		}
+
+		TEST_METHOD(TestViewRendersWings)
+		{
+			WingsViewSoftware view{ 64, 48 };
+			view.DrawFrame();
+			std::uint64_t const emptyChecksum{ view.Checksum() };
+
+			for (int i{ 0 }; i < 40; i++)
+			{
+				view.AdvanceAnimation();
+			}
+			view.DrawFrame();
+
+			Assert::AreNotEqual(emptyChecksum, view.Checksum());
+		}
+
+		TEST_METHOD(TestViewSameSeedSameFrames)
+		{
+			WingsViewSoftware first{ 64, 48, 2024 };
+			WingsViewSoftware second{ 64, 48, 2024 };
+
+			for (int i{ 0 }; i < 100; i++)
+			{
+				first.AdvanceAnimation();
+				second.AdvanceAnimation();
+			}
+			first.DrawFrame();
+			second.DrawFrame();
+
+			Assert::AreEqual(first.Checksum(), second.Checksum());
+		}
+
+		TEST_METHOD(TestViewWarmStartMatchesAdvancing)
+		{
+			WingsViewSoftware advanced{ 64, 48, 2024 };
+			WingsViewSoftware warmStarted{ 64, 48, 2024 };
+
+			for (int i{ 0 }; i < 40; i++)
+			{
+				advanced.AdvanceAnimation();
+			}
+			warmStarted.WarmStart();
+			advanced.DrawFrame();
+			warmStarted.DrawFrame();
+			Assert::AreEqual(advanced.Checksum(), warmStarted.Checksum());
+
+			advanced.AdvanceAnimation();
+			warmStarted.AdvanceAnimation();
+			advanced.DrawFrame();
+			warmStarted.DrawFrame();
+			Assert::AreEqual(advanced.Checksum(), warmStarted.Checksum());
+		}
+	};
+}
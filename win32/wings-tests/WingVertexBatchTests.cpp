@@ -0,0 +1,189 @@
+#include "CppUnitTest.h"
+
+#include <array>
+#include <span>
+
+#include <cstddef>
+
+#include "Color.h"
+#include "Matrix.h"
+#include "WingVertexBatch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace silnith::wings::tests
+{
+	TEST_CLASS(WingVertexBatchTests)
+	{
+	private:
+		struct WingParameters
+		{
+			float radius;
+			float angle;
+			float deltaAngle;
+			float deltaZ;
+			float roll;
+			float pitch;
+			float yaw;
+		};
+
+		static std::array<float, 4> Transform(Matrix const& matrix, std::array<float, 4> const& vertex)
+		{
+			std::array<float, 4> result{};
+			for (std::size_t row{ 0 }; row < 4; row++)
+			{
+				for (std::size_t column{ 0 }; column < 4; column++)
+				{
+					result[row] += matrix[column * 4 + row] * vertex[column];
+				}
+			}
+			return result;
+		}
+
+		static WingParameters MakeWing(std::size_t tick)
+		{
+			return WingParameters{
+				10.0f + static_cast<float>(tick % 4),
+				static_cast<float>(tick * 37 % 360),
+				15.0f + static_cast<float>(tick % 3),
+				0.5f + static_cast<float>(tick % 5) * 0.0625f,
+				static_cast<float>(tick * 11 % 360),
+				static_cast<float>(tick * 13 % 360),
+				static_cast<float>(tick * 17 % 360),
+			};
+		}
+
+		static void AddWing(WingVertexBatch& batch, WingParameters const& wing)
+		{
+			batch.AddWing(wing.radius, wing.angle, wing.deltaAngle, wing.deltaZ,
+				wing.roll, wing.pitch, wing.yaw,
+				Color<float>::WHITE, Color<float>::BLACK);
+		}
+
+		/// <summary>
+		/// Asserts that the vertices in a slot, with the frame transformation
+		/// applied, match placing the wing with the matrix stack the way the
+		/// OpenGL 1.1 renderer does.
+		/// </summary>
+		static void AssertSlotMatches(WingVertexBatch const& batch, std::size_t slot,
+			WingParameters const& wing, float angle, float z, float tolerance)
+		{
+			std::array<std::array<float, 4>, 4> constexpr corners{
+				std::array<float, 4>{ 1, 1, 0, 1 },
+				std::array<float, 4>{ -1, 1, 0, 1 },
+				std::array<float, 4>{ -1, -1, 0, 1 },
+				std::array<float, 4>{ 1, -1, 0, 1 },
+			};
+
+			Matrix expected{ Translate(0, 0, z) };
+			expected = Multiply(expected, Rotate(angle, 0, 0, 1));
+			expected = Multiply(expected, WingTransformation(wing.radius, wing.angle, wing.roll, wing.pitch, wing.yaw));
+
+			Matrix frame{ Translate(0, 0, batch.getAccumulatedZ()) };
+			frame = Multiply(frame, Rotate(batch.getAccumulatedAngle(), 0, 0, 1));
+
+			std::span<float const> const vertices{ batch.getVertices() };
+			for (std::size_t corner{ 0 }; corner < WingVertexBatch::verticesPerWing; corner++)
+			{
+				std::size_t const offset{ (slot * WingVertexBatch::verticesPerWing + corner) * WingVertexBatch::vertexSize };
+				std::array<float, 4> const stored{ vertices[offset], vertices[offset + 1], vertices[offset + 2], vertices[offset + 3] };
+				std::array<float, 4> const actual{ Transform(frame, stored) };
+				std::array<float, 4> const wanted{ Transform(expected, corners[corner]) };
+				for (std::size_t component{ 0 }; component < 4; component++)
+				{
+					Assert::AreEqual(wanted[component], actual[component], tolerance);
+				}
+			}
+		}
+
+	public:
+
+		TEST_METHOD(TestEmpty)
+		{
+			WingVertexBatch const batch{ 4 };
+
+			Assert::AreEqual(std::size_t{ 0 }, batch.getNumWings());
+			Assert::IsTrue(batch.getVertices().empty());
+			Assert::IsTrue(batch.getColors().empty());
+			Assert::IsTrue(batch.getEdgeColors().empty());
+		}
+
+		TEST_METHOD(TestSingleWing)
+		{
+			WingVertexBatch batch{ 4 };
+			WingParameters const wing{ MakeWing(1) };
+			AddWing(batch, wing);
+
+			Assert::AreEqual(std::size_t{ 1 }, batch.getNumWings());
+			Assert::AreEqual(std::size_t{ 16 }, batch.getVertices().size());
+			AssertSlotMatches(batch, 0, wing, wing.deltaAngle, wing.deltaZ, 1e-4f);
+		}
+
+		TEST_METHOD(TestColorsRepeatedForEachVertex)
+		{
+			WingVertexBatch batch{ 4 };
+			batch.AddWing(10, 0, 15, 0.5f, 0, 0, 0,
+				Color<float>{ 0.25f, 0.5f, 0.75f }, Color<float>{ 0.125f, 0.375f, 0.625f });
+
+			std::span<float const> const colors{ batch.getColors() };
+			std::span<float const> const edgeColors{ batch.getEdgeColors() };
+			Assert::AreEqual(std::size_t{ 12 }, colors.size());
+			Assert::AreEqual(std::size_t{ 12 }, edgeColors.size());
+			for (std::size_t vertex{ 0 }; vertex < WingVertexBatch::verticesPerWing; vertex++)
+			{
+				Assert::AreEqual(0.25f, colors[vertex * 3 + 0]);
+				Assert::AreEqual(0.5f, colors[vertex * 3 + 1]);
+				Assert::AreEqual(0.75f, colors[vertex * 3 + 2]);
+				Assert::AreEqual(0.125f, edgeColors[vertex * 3 + 0]);
+				Assert::AreEqual(0.375f, edgeColors[vertex * 3 + 1]);
+				Assert::AreEqual(0.625f, edgeColors[vertex * 3 + 2]);
+			}
+		}
+
+		TEST_METHOD(TestMatchesMatrixStackAcrossRebases)
+		{
+			std::size_t constexpr capacity{ 5 };
+			WingVertexBatch batch{ capacity };
+			std::array<WingParameters, capacity> slots{};
+
+			for (std::size_t tick{ 0 }; tick < 23; tick++)
+			{
+				WingParameters const wing{ MakeWing(tick) };
+				AddWing(batch, wing);
+				slots[tick % capacity] = wing;
+
+				std::size_t const numWings{ tick + 1 < capacity ? tick + 1 : capacity };
+				Assert::AreEqual(numWings, batch.getNumWings());
+
+				float angle{ 0 };
+				float z{ 0 };
+				for (std::size_t age{ 0 }; age < numWings; age++)
+				{
+					std::size_t const slot{ (tick + capacity - age) % capacity };
+					angle += slots[slot].deltaAngle;
+					z += slots[slot].deltaZ;
+					AssertSlotMatches(batch, slot, slots[slot], angle, z, 1e-3f);
+				}
+			}
+		}
+
+		TEST_METHOD(TestClear)
+		{
+			WingVertexBatch batch{ 3 };
+			for (std::size_t tick{ 0 }; tick < 5; tick++)
+			{
+				AddWing(batch, MakeWing(tick));
+			}
+			batch.Clear();
+
+			Assert::AreEqual(std::size_t{ 0 }, batch.getNumWings());
+			Assert::AreEqual(0.0f, batch.getAccumulatedAngle());
+			Assert::AreEqual(0.0f, batch.getAccumulatedZ());
+
+			WingParameters const wing{ MakeWing(7) };
+			AddWing(batch, wing);
+			Assert::AreEqual(std::size_t{ 1 }, batch.getNumWings());
+			AssertSlotMatches(batch, 0, wing, wing.deltaAngle, wing.deltaZ, 1e-4f);
+		}
+	};
+}
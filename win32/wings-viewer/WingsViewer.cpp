@@ -0,0 +1,442 @@
+#ifdef SILNITH_WINGS_NO_GLEW
+#include <GL/gl.h>
+#else
+#include <GL/glew.h>
+#endif
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../wings-platform/AntiAliasing.h"
+#include "../wings-platform/Platform.h"
+
+#include "GLInfo.h"
+#include "GLStateCache.h"
+#include "Instrumentation.h"
+#include "Philox4x32.h"
+#include "WingsView.h"
+#include "WingsViewBatched.h"
+
+#ifndef SILNITH_WINGS_NO_GLEW
+#include "../spinning-wings-gl2/WingRendererGL15Batched.h"
+#include "../spinning-wings-gl2/WingsViewGL2.h"
+#ifndef SILNITH_WINGS_NO_GLM
+#include "../spinning-wings-gl3/WingsViewGL3.h"
+#include "../spinning-wings-gl4/WingsViewGL4.h"
+#endif
+#endif
+
+using namespace std::literals::string_literals;
+
+namespace silnith::wings::viewer
+{
+
+	namespace
+	{
+
+		/// <summary>
+		/// The settings for the viewer, parsed from the command line.
+		/// </summary>
+		struct Options
+		{
+			std::string renderer{ "gl1" };
+			std::size_t numWings{ 40 };
+			std::optional<std::uint64_t> seed{};
+			std::size_t frames{ 0 };
+			std::chrono::milliseconds updateDelay{ platform::defaultUpdateDelay };
+			int width{ 800 };
+			int height{ 600 };
+			bool offscreen{ false };
+			bool warmStart{ false };
+			std::optional<platform::AntiAliasing> antiAliasing{};
+		};
+
+		void PrintUsage(std::ostream& output)
+		{
+			output << "usage: wings-viewer [--renderer NAME] [--wings N] [--seed N] [--frames N]\n"
+				<< "                    [--delay MILLISECONDS] [--size WIDTHxHEIGHT] [--offscreen]\n"
+				<< "                    [--warm-start] [--aa none|line-smooth|msaa|shader]\n"
+				<< "\nrenderers: gl1 gl1-batched";
+#ifndef SILNITH_WINGS_NO_GLEW
+			output << " gl2 gl2-batched";
+#ifndef SILNITH_WINGS_NO_GLM
+			output << " gl3 gl4 gl4-compute gl4-single-pass";
+#endif
+#endif
+			output << '\n'
+				<< "\nanti-aliasing: gl4-single-pass supports only shader, and no other renderer\n"
+				<< "supports it.  The default is the renderer's own mode.  The Windows programs\n"
+				<< "and the screensaver have no such option; they always use line-smooth.\n";
+		}
+
+		/// <summary>
+		/// Returns whether a renderer draws the wing edges in a fragment
+		/// shader instead of as lines.  Such a renderer only supports
+		/// <see cref="platform::AntiAliasing::Shader"/>, and no other renderer
+		/// does.
+		/// </summary>
+		/// <param name="renderer">The name of the renderer.</param>
+		/// <returns>Whether the renderer draws its own edges.</returns>
+		[[nodiscard]]
+		bool DrawsShaderEdges(std::string const& renderer)
+		{
+			return renderer == "gl4-single-pass"s;
+		}
+
+		/// <summary>
+		/// Parses the command line.
+		/// </summary>
+		/// <exception cref="std::invalid_argument">If an argument is not understood.</exception>
+		[[nodiscard]]
+		Options ParseOptions(int argc, char* argv[])
+		{
+			Options options{};
+			for (int index{ 1 }; index < argc; index++)
+			{
+				std::string const argument{ argv[index] };
+				auto const nextValue{ [&]() -> std::string
+					{
+						if (index + 1 >= argc)
+						{
+							throw std::invalid_argument{ "Missing value for "s + argument };
+						}
+						return argv[++index];
+					} };
+
+				if (argument == "--renderer"s)
+				{
+					options.renderer = nextValue();
+				}
+				else if (argument == "--wings"s)
+				{
+					options.numWings = std::stoull(nextValue());
+				}
+				else if (argument == "--seed"s)
+				{
+					options.seed = std::stoull(nextValue());
+				}
+				else if (argument == "--frames"s)
+				{
+					options.frames = std::stoull(nextValue());
+				}
+				else if (argument == "--delay"s)
+				{
+					options.updateDelay = std::chrono::milliseconds{ std::stoll(nextValue()) };
+				}
+				else if (argument == "--size"s)
+				{
+					std::string const size{ nextValue() };
+					std::size_t const separator{ size.find('x') };
+					if (separator == std::string::npos)
+					{
+						throw std::invalid_argument{ "Expected WIDTHxHEIGHT: "s + size };
+					}
+					options.width = std::stoi(size.substr(0, separator));
+					options.height = std::stoi(size.substr(separator + 1));
+				}
+				else if (argument == "--offscreen"s)
+				{
+					options.offscreen = true;
+				}
+				else if (argument == "--warm-start"s)
+				{
+					options.warmStart = true;
+				}
+				else if (argument == "--aa"s)
+				{
+					options.antiAliasing = platform::ParseAntiAliasing(nextValue());
+				}
+				else
+				{
+					throw std::invalid_argument{ "Unknown argument: "s + argument };
+				}
+			}
+
+			if (options.numWings == 0)
+			{
+				throw std::invalid_argument{ "The number of wings must be positive."s };
+			}
+			if (options.updateDelay.count() < 0 || options.width <= 0 || options.height <= 0)
+			{
+				throw std::invalid_argument{ "The delay must not be negative, and the size must be positive."s };
+			}
+			if (options.antiAliasing)
+			{
+				platform::AntiAliasing const antiAliasing{ *options.antiAliasing };
+				if (DrawsShaderEdges(options.renderer) && antiAliasing != platform::AntiAliasing::Shader)
+				{
+					throw std::invalid_argument{ "The "s + options.renderer + " renderer draws its edges in a shader, so it only supports shader anti-aliasing."s };
+				}
+				if (!DrawsShaderEdges(options.renderer) && antiAliasing == platform::AntiAliasing::Shader)
+				{
+					throw std::invalid_argument{ "Shader anti-aliasing is only supported by the gl4-single-pass renderer."s };
+				}
+#ifdef SILNITH_WINGS_NO_GLEW
+				if (antiAliasing == platform::AntiAliasing::Multisample)
+				{
+					throw std::invalid_argument{ "Multisample anti-aliasing needs framebuffer objects, which this build of the viewer does not have."s };
+				}
+#endif
+			}
+			return options;
+		}
+
+		[[nodiscard]]
+		std::unique_ptr<platform::RenderingContext> CreateContext(Options const& options, platform::ContextVersion version)
+		{
+			if (options.offscreen)
+			{
+				return platform::CreateOffscreenContext(version, options.width, options.height);
+			}
+			return platform::CreateWindowContext(version, options.width, options.height, "Spinning Wings"s);
+		}
+
+		/// <summary>
+		/// Returns the anti-aliasing mode to use for the renderer.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// <see cref="ParseOptions"/> has already rejected any mode that the
+		/// renderer does not support.
+		/// </para>
+		/// </remarks>
+		/// <param name="options">The viewer settings.</param>
+		/// <returns>The requested mode, or the renderer's own if none was requested.</returns>
+		[[nodiscard]]
+		platform::AntiAliasing ChooseAntiAliasing(Options const& options)
+		{
+			platform::AntiAliasing const nativeAntiAliasing{ DrawsShaderEdges(options.renderer) ? platform::AntiAliasing::Shader : platform::AntiAliasing::LineSmooth };
+			return options.antiAliasing.value_or(nativeAntiAliasing);
+		}
+
+		/// <summary>
+		/// Runs the animation loop with the requested anti-aliasing.  The view
+		/// must already be set up.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Setting up the anti-aliasing changes OpenGL state without going
+		/// through the view's state cache, so the cache is invalidated after
+		/// each step of it.
+		/// </para>
+		/// </remarks>
+		void RunAnimationLoop(platform::RenderingContext& context, Options const& options, platform::AntiAliasing antiAliasing,
+			gl::GLStateCache& stateCache,
+			std::function<void(int width, int height)> const& resize,
+			std::function<void(void)> const& advance,
+			std::function<void(void)> const& draw)
+		{
+			platform::ApplyAntiAliasing(antiAliasing);
+			std::unique_ptr<platform::MultisampleFramebuffer> const framebuffer{
+				antiAliasing == platform::AntiAliasing::Multisample
+				? std::make_unique<platform::MultisampleFramebuffer>(platform::MultisampleFramebuffer::defaultSamples)
+				: nullptr
+			};
+			stateCache.Invalidate();
+			platform::RunAnimationLoop(context, options.updateDelay, options.frames,
+				[&framebuffer, &stateCache, &resize](int width, int height) -> void
+				{
+					if (framebuffer)
+					{
+						framebuffer->Resize(width, height);
+						stateCache.Invalidate();
+					}
+					resize(width, height);
+				},
+				advance,
+				[&framebuffer, &draw]() -> void
+				{
+					if (framebuffer)
+					{
+						framebuffer->Bind();
+					}
+					glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+					draw();
+					if (framebuffer)
+					{
+						framebuffer->Resolve();
+					}
+				});
+		}
+
+		/// <summary>
+		/// Runs the animation loop for one of the view classes.
+		/// </summary>
+		template<typename View>
+		void Animate(platform::RenderingContext& context, View& view, Options const& options)
+		{
+			platform::AntiAliasing const antiAliasing{ ChooseAntiAliasing(options) };
+			if (options.warmStart)
+			{
+				view.WarmStart();
+			}
+			RunAnimationLoop(context, options, antiAliasing, view.getStateCache(),
+				[&view](int width, int height) -> void
+				{
+					view.Resize(width, height);
+				},
+				[&view]() -> void
+				{
+					view.AdvanceAnimation();
+				},
+				[&view]() -> void
+				{
+					view.DrawFrame();
+				});
+		}
+
+#if !defined(SILNITH_WINGS_NO_GLEW) && !defined(SILNITH_WINGS_NO_GLM)
+		/// <summary>
+		/// Creates the rendering context for the OpenGL 4 functions, and
+		/// animates them using the specified pipeline.
+		/// </summary>
+		void AnimateGL4(Options const& options, platform::ContextVersion version, gl4::WingPipeline pipeline, std::uint64_t seed)
+		{
+			platform::AntiAliasing const antiAliasing{ ChooseAntiAliasing(options) };
+			std::unique_ptr<platform::RenderingContext> const context{ CreateContext(options, version) };
+			gl4::InitializeOpenGLState(pipeline, options.numWings, seed);
+			if (options.warmStart)
+			{
+				gl4::WarmStart();
+			}
+			RunAnimationLoop(*context, options, antiAliasing, gl4::GetStateCache(),
+				[](int width, int height) -> void
+				{
+					gl4::Resize(width, height);
+				},
+				gl4::AdvanceAnimation,
+				gl4::DrawFrame);
+			gl4::CleanupOpenGLState();
+		}
+#endif
+
+		/// <summary>
+		/// Creates the rendering context and view for the requested renderer,
+		/// and animates it.
+		/// </summary>
+		/// <exception cref="std::invalid_argument">If the renderer is not known.</exception>
+		/// <exception cref="std::runtime_error">If the context cannot be created.</exception>
+		void Run(Options const& options)
+		{
+			std::uint64_t const seed{ options.seed.value_or(Philox4x32::generateRandomSeed()) };
+
+			if (options.renderer == "gl1"s)
+			{
+				std::unique_ptr<platform::RenderingContext> const context{ CreateContext(options, platform::ContextVersion{ 0, 0, false }) };
+				gl::WingsView view{ gl::GLInfo{}, options.numWings, seed };
+				Animate(*context, view, options);
+				return;
+			}
+			if (options.renderer == "gl1-batched"s)
+			{
+				std::unique_ptr<platform::RenderingContext> const context{ CreateContext(options, platform::ContextVersion{ 0, 0, false }) };
+				gl::WingsViewBatched view{ gl::GLInfo{}, options.numWings, seed };
+				Animate(*context, view, options);
+				return;
+			}
+#ifndef SILNITH_WINGS_NO_GLEW
+			if (options.renderer == "gl2"s)
+			{
+				std::unique_ptr<platform::RenderingContext> const context{ CreateContext(options, platform::ContextVersion{ 0, 0, false }) };
+				gl::GLInfo const glInfo{};
+				gl2::WingsViewGL2 view{ glInfo, gl2::WingsViewGL2::MakeWingRenderer(glInfo), options.numWings, seed };
+				Animate(*context, view, options);
+				return;
+			}
+			if (options.renderer == "gl2-batched"s)
+			{
+				std::unique_ptr<platform::RenderingContext> const context{ CreateContext(options, platform::ContextVersion{ 0, 0, false }) };
+				gl2::WingsViewGL2 view{ gl::GLInfo{}, std::make_unique<gl::WingRendererGL15Batched>(options.numWings), options.numWings, seed };
+				Animate(*context, view, options);
+				return;
+			}
+#ifndef SILNITH_WINGS_NO_GLM
+			if (options.renderer == "gl3"s)
+			{
+				std::unique_ptr<platform::RenderingContext> const context{ CreateContext(options, platform::ContextVersion{ 3, 2, true }) };
+				gl3::WingsViewGL3 view{ gl3::WingPipeline::TransformFeedback, options.numWings, seed };
+				Animate(*context, view, options);
+				return;
+			}
+			if (options.renderer == "gl4"s)
+			{
+				AnimateGL4(options, platform::ContextVersion{ 4, 1, true }, gl4::WingPipeline::Instanced, seed);
+				return;
+			}
+			if (options.renderer == "gl4-compute"s)
+			{
+				AnimateGL4(options, platform::ContextVersion{ 4, 3, true }, gl4::WingPipeline::Compute, seed);
+				return;
+			}
+			if (options.renderer == "gl4-single-pass"s)
+			{
+				AnimateGL4(options, platform::ContextVersion{ 4, 1, true }, gl4::WingPipeline::SinglePass, seed);
+				return;
+			}
+#endif
+#endif
+			throw std::invalid_argument{ "Unknown renderer: "s + options.renderer };
+		}
+
+	}
+
+}
+
+/// <summary>
+/// Shows the spinning wings animation using the portable platform layer.
+/// </summary>
+/// <remarks>
+/// <para>
+/// This drives the same views as the Windows programs, but through
+/// <c>silnith::wings::platform</c> instead of a window procedure, so that it
+/// runs wherever the platform layer does.  With <c>--offscreen</c> and
+/// <c>--frames</c> it needs no display at all, which makes it convenient to
+/// run under a profiler.
+/// </para>
+/// </remarks>
+/// <returns>Zero on success, one if the animation could not run, two for bad arguments.</returns>
+int main(int argc, char* argv[])
+{
+	using namespace silnith::wings::viewer;
+
+	Options options{};
+	try
+	{
+		options = ParseOptions(argc, argv);
+	}
+	catch (std::exception const& e)
+	{
+		std::cerr << e.what() << '\n';
+		PrintUsage(std::cerr);
+		return 2;
+	}
+
+	try
+	{
+		Run(options);
+	}
+	catch (std::invalid_argument const& e)
+	{
+		std::cerr << e.what() << '\n';
+		PrintUsage(std::cerr);
+		return 2;
+	}
+	catch (std::exception const& e)
+	{
+		std::cerr << e.what() << '\n';
+		return 1;
+	}
+
+	silnith::wings::instrumentation::WriteReport();
+
+	return 0;
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+
+#include <cassert>
+#include <cstddef>
+
+namespace silnith::wings
+{
+
+	/// <summary>
+	/// Tracks the delta angle and delta Z accumulated by a history of wings,
+	/// so that drawing a wing never requires walking the wings newer than it.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Each wing is drawn rotated about the Z axis and translated along it by
+	/// the sum of its own deltas and those of every newer wing.  Rotation about
+	/// Z and translation along Z commute, so that sum is simply the total of
+	/// every delta ever added, minus the total at the moment the wing was
+	/// added.  Adding a wing therefore records one number pair for the new
+	/// wing and changes a single running total, which shifts every older wing
+	/// at once.
+	/// </para>
+	/// <para>
+	/// The running total grows without bound, and a single-precision
+	/// difference of two large totals would lose the small deltas entirely.
+	/// So the total is kept in double precision, and the history is divided
+	/// into <see cref="numSections"/> sections of <c>sectionSize</c> wings
+	/// each.  Every section has an anchor, the running total when its first
+	/// wing was added, and each wing's <see cref="Anchor"/> is stored relative
+	/// to the anchor of its section.  Each frame the renderer receives the
+	/// current total relative to each section anchor from
+	/// <see cref="getSectionOffsets"/>, and subtracts the wing's anchor from
+	/// the offset for its section.  Both are small numbers.
+	/// </para>
+	/// <para>
+	/// The most recent <c>sectionSize</c> wings span at most two adjacent
+	/// sections, so the third section is never referenced by a visible wing
+	/// when it is reused.
+	/// </para>
+	/// </remarks>
+	/// <typeparam name="F">The floating-point type handed to the renderer.</typeparam>
+	template<std::floating_point F>
+	class AccumulatedDeltas
+	{
+#pragma region Static Members
+
+	public:
+		/// <summary>
+		/// The number of sections the history is divided into.
+		/// </summary>
+		static std::size_t constexpr numSections{ 3 };
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// What a renderer needs to remember about a single wing.  This never
+		/// changes for the lifetime of the wing.
+		/// </summary>
+		struct Anchor
+		{
+			/// <summary>
+			/// The delta angle of all older wings, relative to the section anchor.
+			/// </summary>
+			F angle{ 0 };
+
+			/// <summary>
+			/// The delta Z of all older wings, relative to the section anchor.
+			/// </summary>
+			F z{ 0 };
+
+			/// <summary>
+			/// The section the wing belongs to.
+			/// </summary>
+			std::size_t section{ 0 };
+		};
+
+	public:
+		/// <summary>
+		/// Default constructor is deleted.  The section size must be known.
+		/// </summary>
+		AccumulatedDeltas(void) = delete;
+
+		/// <summary>
+		/// Creates an empty history.
+		/// </summary>
+		/// <param name="sectionSize">The number of wings in each section.
+		/// This must be at least the number of wings visible at once.</param>
+		explicit AccumulatedDeltas(std::size_t sectionSize) noexcept
+			: sectionSize{ sectionSize }
+		{
+			assert(sectionSize > 0);
+		}
+
+#pragma region Rule of Five
+
+	public:
+		AccumulatedDeltas(AccumulatedDeltas const&) = default;
+		AccumulatedDeltas& operator=(AccumulatedDeltas const&) = default;
+		AccumulatedDeltas(AccumulatedDeltas&&) noexcept = default;
+		AccumulatedDeltas& operator=(AccumulatedDeltas&&) noexcept = default;
+		~AccumulatedDeltas(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Adds a new wing, which becomes the newest wing.
+		/// </summary>
+		/// <param name="deltaAngle">The additional angle around the central axis as the wing recedes into history.</param>
+		/// <param name="deltaZ">The additional height along the central axis as the wing recedes into history.</param>
+		/// <returns>The anchor to store for the new wing.</returns>
+		Anchor AddWing(F deltaAngle, F deltaZ) noexcept
+		{
+			if (numWings % sectionSize == 0)
+			{
+				section = (section + 1) % numSections;
+				anchors[2 * section + 0] = accumulatedAngle;
+				anchors[2 * section + 1] = accumulatedZ;
+			}
+			numWings++;
+
+			/*
+			 * The anchor holds the deltas of the older wings only.  Subtracting
+			 * it from the current total yields the deltas from this wing onwards.
+			 */
+			Anchor const anchor{
+				static_cast<F>(accumulatedAngle - anchors[2 * section + 0]),
+				static_cast<F>(accumulatedZ - anchors[2 * section + 1]),
+				section,
+			};
+
+			accumulatedAngle += deltaAngle;
+			accumulatedZ += deltaZ;
+
+			return anchor;
+		}
+
+		/// <summary>
+		/// Forgets every wing.
+		/// </summary>
+		void Clear(void) noexcept
+		{
+			numWings = 0;
+			section = numSections - 1;
+			accumulatedAngle = 0;
+			accumulatedZ = 0;
+			anchors = {};
+		}
+
+		/// <summary>
+		/// Returns the current accumulated delta angle and delta Z, relative
+		/// to the anchor of each section.
+		/// </summary>
+		/// <returns>Pairs of (delta angle, delta Z), one pair per section.</returns>
+		[[nodiscard]]
+		std::array<F, 2 * numSections> getSectionOffsets(void) const noexcept
+		{
+			std::array<F, 2 * numSections> offsets{};
+			for (std::size_t index{ 0 }; index < numSections; index++)
+			{
+				offsets[2 * index + 0] = static_cast<F>(accumulatedAngle - anchors[2 * index + 0]);
+				offsets[2 * index + 1] = static_cast<F>(accumulatedZ - anchors[2 * index + 1]);
+			}
+			return offsets;
+		}
+
+		/// <summary>
+		/// Returns the accumulated delta angle and delta Z for a wing.  This
+		/// is the calculation the shaders perform.
+		/// </summary>
+		/// <param name="anchor">The anchor returned when the wing was added.</param>
+		/// <returns>The pair (delta angle, delta Z).</returns>
+		[[nodiscard]]
+		std::array<F, 2> getAccumulatedDeltas(Anchor const& anchor) const noexcept
+		{
+			return {
+				static_cast<F>(accumulatedAngle - anchors[2 * anchor.section + 0]) - anchor.angle,
+				static_cast<F>(accumulatedZ - anchors[2 * anchor.section + 1]) - anchor.z,
+			};
+		}
+
+	private:
+		/// <summary>
+		/// The number of wings in each section.
+		/// </summary>
+		std::size_t sectionSize{ 1 };
+
+		/// <summary>
+		/// The number of wings ever added.
+		/// </summary>
+		std::size_t numWings{ 0 };
+
+		/// <summary>
+		/// The section the newest wing belongs to.  This starts at the last
+		/// section so that the first wing begins the first section.
+		/// </summary>
+		std::size_t section{ numSections - 1 };
+
+		/// <summary>
+		/// The total delta angle of every wing ever added.
+		/// </summary>
+		double accumulatedAngle{ 0 };
+
+		/// <summary>
+		/// The total delta Z of every wing ever added.
+		/// </summary>
+		double accumulatedZ{ 0 };
+
+		/// <summary>
+		/// The accumulated delta angle and delta Z at the moment each section was started.
+		/// </summary>
+		std::array<double, 2 * numSections> anchors{};
+	};
+
+}
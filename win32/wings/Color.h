@@ -103,9 +103,9 @@ namespace silnith::wings
 		static Color<T> const WHITE;
 
 	private:
-		T const red{ 0 };
-		T const green{ 0 };
-		T const blue{ 0 };
+		T red{ 0 };
+		T green{ 0 };
+		T blue{ 0 };
 	};
 
 	template<std::floating_point T>
@@ -2,9 +2,14 @@
 
 #include <algorithm>
 #include <concepts>
+#include <limits>
 #include <random>
+#include <type_traits>
 
 #include <cmath>
+#include <cstdint>
+
+#include "Philox4x32.h"
 
 namespace silnith::wings
 {
@@ -12,12 +17,37 @@ namespace silnith::wings
 	/// <summary>
 	/// A class that produces a sequence of numbers that slowly shift within predefined boundaries.
 	/// </summary>
-	template<std::floating_point T>
+	/// <remarks>
+	/// <para>
+	/// The random engine is only consulted when the acceleration changes.
+	/// Each generator owns its engine, so two generators constructed with
+	/// identically-seeded engines produce identical curves.
+	/// </para>
+	/// </remarks>
+	template<std::floating_point T, std::uniform_random_bit_generator Engine = Philox4x32>
 	class CurveGenerator
 	{
 #pragma region Static Members
 
 	public:
+		/// <summary>
+		/// Returns a new engine seeded from <c>std::random_device</c>.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This is what generators use when they are not given an engine,
+		/// so that the animation is different every time the program runs.
+		/// </para>
+		/// </remarks>
+		/// <returns>a randomly-seeded engine</returns>
+		[[nodiscard]]
+		static Engine createRandomlySeededEngine(void)
+		{
+			std::random_device randomDevice{};
+			std::seed_seq seedSequence{ randomDevice(), randomDevice(), randomDevice(), randomDevice() };
+			return Engine{ seedSequence };
+		}
+
 		/// <summary>
 		/// Returns a CurveGenerator for angles.
 		/// </summary>
@@ -32,9 +62,29 @@ namespace silnith::wings
 		/// <param name="ticksPerAccelerationChange">the number of values to generate before the acceleration changes</param>
 		/// <returns>a CurveGenerator that returns values that can be used as angles</returns>
 		[[nodiscard]]
-		static CurveGenerator<T> createGeneratorForAngles(T initialValue, T maximumVelocity, T maximumAcceleration, unsigned int ticksPerAccelerationChange)
+		static CurveGenerator<T, Engine> createGeneratorForAngles(T initialValue, T maximumVelocity, T maximumAcceleration, unsigned int ticksPerAccelerationChange)
+		{
+			return CurveGenerator<T, Engine>{ initialValue, 0, 360, true, maximumVelocity, maximumAcceleration, ticksPerAccelerationChange };
+		}
+
+		/// <summary>
+		/// Returns a CurveGenerator for angles that draws from the provided engine.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The values will be in the range <c>[0, 360)</c>, and will wrap.
+		/// </para>
+		/// </remarks>
+		/// <param name="initialValue">the initial angle</param>
+		/// <param name="maximumVelocity">the maximum angle change per tick</param>
+		/// <param name="maximumAcceleration">the maximum acceleration</param>
+		/// <param name="ticksPerAccelerationChange">the number of values to generate before the acceleration changes</param>
+		/// <param name="engine">the random engine, which is copied</param>
+		/// <returns>a CurveGenerator that returns values that can be used as angles</returns>
+		[[nodiscard]]
+		static CurveGenerator<T, Engine> createGeneratorForAngles(T initialValue, T maximumVelocity, T maximumAcceleration, unsigned int ticksPerAccelerationChange, Engine const& engine)
 		{
-			return CurveGenerator<T>{ initialValue, 0, 360, true, maximumVelocity, maximumAcceleration, ticksPerAccelerationChange };
+			return CurveGenerator<T, Engine>{ initialValue, 0, 360, true, maximumVelocity, maximumAcceleration, ticksPerAccelerationChange, engine };
 		}
 
 		/// <summary>
@@ -46,9 +96,60 @@ namespace silnith::wings
 		/// <param name="ticksPerAccelerationChange">the number of values to generate before the acceleration changes</param>
 		/// <returns>a CurveGenerator that returns values specific for color components</returns>
 		[[nodiscard]]
-		static CurveGenerator<T> createGeneratorForColorComponents(T initialValue, T maximumVelocity, T maximumAcceleration, unsigned int ticksPerAccelerationChange)
+		static CurveGenerator<T, Engine> createGeneratorForColorComponents(T initialValue, T maximumVelocity, T maximumAcceleration, unsigned int ticksPerAccelerationChange)
+		{
+			return CurveGenerator<T, Engine>{ initialValue, 0, 1, false, maximumVelocity, maximumAcceleration, ticksPerAccelerationChange };
+		}
+
+		/// <summary>
+		/// Returns a CurveGenerator for color component values that draws from the provided engine.
+		/// </summary>
+		/// <param name="initialValue">the initial color (component) value</param>
+		/// <param name="maximumVelocity">the maximum color (component) change per tick</param>
+		/// <param name="maximumAcceleration">the maximum acceleration</param>
+		/// <param name="ticksPerAccelerationChange">the number of values to generate before the acceleration changes</param>
+		/// <param name="engine">the random engine, which is copied</param>
+		/// <returns>a CurveGenerator that returns values specific for color components</returns>
+		[[nodiscard]]
+		static CurveGenerator<T, Engine> createGeneratorForColorComponents(T initialValue, T maximumVelocity, T maximumAcceleration, unsigned int ticksPerAccelerationChange, Engine const& engine)
+		{
+			return CurveGenerator<T, Engine>{ initialValue, 0, 1, false, maximumVelocity, maximumAcceleration, ticksPerAccelerationChange, engine };
+		}
+
+		/// <summary>
+		/// Draws a new acceleration from a single output of the engine.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The output is scaled to a canonical value in <c>[0, 1)</c> and then
+		/// to the range, the same two steps as
+		/// <c>std::uniform_real_distribution</c>.  That distribution is not used
+		/// because its algorithm is left to each standard library, and the
+		/// curves must be the same on every platform for a seed to reproduce an
+		/// animation.  The compute shader in <c>WingCurveComputeProgram</c>
+		/// performs exactly these operations to continue the curves on the GPU.
+		/// </para>
+		/// <para>
+		/// With a 32-bit engine the division is by a power of two, so the
+		/// canonical value is exact for <c>double</c> and correctly rounded for
+		/// <c>float</c>.  Rounding can produce exactly one, which is replaced by
+		/// the largest value below one.
+		/// </para>
+		/// </remarks>
+		/// <param name="engine">the random engine to draw from</param>
+		/// <param name="maximumAcceleration">the maximum magnitude of the acceleration</param>
+		/// <returns>an acceleration in the range <c>[-maximumAcceleration, maximumAcceleration)</c></returns>
+		[[nodiscard]]
+		static T drawAcceleration(Engine& engine, T maximumAcceleration)
 		{
-			return CurveGenerator<T>{ initialValue, 0, 1, false, maximumVelocity, maximumAcceleration, ticksPerAccelerationChange };
+			T const engineRange{ static_cast<T>(Engine::max() - Engine::min()) + T{ 1 } };
+			T canonical{ static_cast<T>(engine() - Engine::min()) / engineRange };
+			if (canonical >= T{ 1 })
+			{
+				canonical = std::nextafter(T{ 1 }, T{ 0 });
+			}
+			T const lower{ -maximumAcceleration };
+			return canonical * (maximumAcceleration - lower) + lower;
 		}
 
 #pragma endregion
@@ -57,7 +158,7 @@ namespace silnith::wings
 		CurveGenerator(void) = delete;
 
 		/// <summary>
-		/// Creates a new curve generator.
+		/// Creates a new curve generator with a randomly-seeded engine.
 		/// </summary>
 		/// <param name="initialValue">the initial value of the curve</param>
 		/// <param name="minimumValue">the minimum value of the curve</param>
@@ -68,8 +169,28 @@ namespace silnith::wings
 		/// <param name="ticksPerAccelerationChange">the number of values to generate before the acceleration changes</param>
 		explicit CurveGenerator(T initialValue, T minimumValue, T maximumValue, bool valueWraps,
 			T maximumVelocity, T maximumAcceleration, unsigned int ticksPerAccelerationChange)
+			: CurveGenerator{ initialValue, minimumValue, maximumValue, valueWraps,
+				maximumVelocity, maximumAcceleration, ticksPerAccelerationChange,
+				createRandomlySeededEngine() }
+		{}
+
+		/// <summary>
+		/// Creates a new curve generator that draws from the provided engine.
+		/// </summary>
+		/// <param name="initialValue">the initial value of the curve</param>
+		/// <param name="minimumValue">the minimum value of the curve</param>
+		/// <param name="maximumValue">the maximum value of the curve</param>
+		/// <param name="valueWraps">whether curve values map from the maximum value to the minimum value</param>
+		/// <param name="maximumVelocity">the maximum velocity, or slope of the curve</param>
+		/// <param name="maximumAcceleration">the maximum acceleration for curve changes</param>
+		/// <param name="ticksPerAccelerationChange">the number of values to generate before the acceleration changes</param>
+		/// <param name="engine">the random engine, which is copied</param>
+		explicit CurveGenerator(T initialValue, T minimumValue, T maximumValue, bool valueWraps,
+			T maximumVelocity, T maximumAcceleration, unsigned int ticksPerAccelerationChange,
+			Engine const& engine)
 			: minimumValue{ minimumValue }, maximumValue{ maximumValue }, valueWraps{ valueWraps },
 			maximumVelocity{ maximumVelocity }, maximumAcceleration{ maximumAcceleration }, ticksPerAccelerationChange{ ticksPerAccelerationChange },
+			engine{ engine },
 			value{ initialValue }
 		{}
 
@@ -185,6 +306,16 @@ namespace silnith::wings
 			return ticks;
 		}
 
+		/// <summary>
+		/// Returns the random engine in its current state.
+		/// </summary>
+		/// <returns>the engine used to choose new accelerations</returns>
+		[[nodiscard]]
+		inline Engine const& getEngine(void) const noexcept
+		{
+			return engine;
+		}
+
 		/// <summary>
 		/// Advances the tick count, applies velocity and acceleration, and returns the next value for the random curve.
 		/// </summary>
@@ -196,6 +327,60 @@ namespace silnith::wings
 			return getValue();
 		}
 
+		/// <summary>
+		/// Advances the curve as if <see cref="getNextValue"/> had been called
+		/// <paramref name="count"/> times.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Within one acceleration segment the velocity is a clamped linear ramp,
+		/// so the sum of the velocities over any stretch where the velocity keeps
+		/// the same sign has a closed form.  Clamping or wrapping the value once
+		/// at the end of such a stretch gives the same result as doing so every
+		/// tick.  Each segment therefore takes constant time, no matter how many
+		/// ticks it spans.  The engine is consulted exactly as often as when
+		/// stepping, once per segment, because the sum of every segment depends
+		/// on its acceleration.
+		/// </para>
+		/// <para>
+		/// The tick count, acceleration, and engine state match stepping exactly.
+		/// The sums are computed in at least double precision, while stepping
+		/// rounds every tick, so the value and velocity of a segment agree with
+		/// stepping to within <see cref="getSegmentTolerance"/>.  The one place
+		/// that difference could matter is a wrap: a value within rounding of a
+		/// multiple of the range could land a full range away from the stepped
+		/// one.  A segment whose value comes within the tolerance of a wrap is
+		/// therefore stepped tick by tick instead, which is exact.  Over many
+		/// segments the differences accumulate, since each segment starts from
+		/// the state the previous one left.
+		/// </para>
+		/// </remarks>
+		/// <param name="count">the number of ticks to advance</param>
+		void advance(std::uint64_t count)
+		{
+			while (count > 0)
+			{
+				if (ticks >= ticksPerAccelerationChange)
+				{
+					/*
+					 * The next tick starts a new segment.
+					 */
+					acceleration = drawAcceleration(engine, maximumAcceleration);
+					std::uint64_t const steps{ std::min(count, std::uint64_t{ ticksPerAccelerationChange } + 1) };
+					advanceWithinSegment(steps);
+					ticks = static_cast<unsigned int>(steps - 1);
+					count -= steps;
+				}
+				else
+				{
+					std::uint64_t const steps{ std::min(count, std::uint64_t{ ticksPerAccelerationChange - ticks }) };
+					advanceWithinSegment(steps);
+					ticks += static_cast<unsigned int>(steps);
+					count -= steps;
+				}
+			}
+		}
+
 	private:
 		T const minimumValue;
 		T const maximumValue;
@@ -204,9 +389,9 @@ namespace silnith::wings
 		T const maximumVelocity;
 		T const maximumAcceleration;
 		unsigned int const ticksPerAccelerationChange;
-		std::uniform_real_distribution<T> const distributor{ -maximumAcceleration, maximumAcceleration };
 
 	private:
+		Engine engine;
 		T value{ 0 };
 		T velocity{ 0 };
 		T acceleration{ 0 };
@@ -238,18 +423,207 @@ namespace silnith::wings
 		{
 			if (++ticks > ticksPerAccelerationChange)
 			{
-				acceleration = distributor(randomDevice);
+				acceleration = drawAcceleration(engine, maximumAcceleration);
 				ticks = 0;
 			}
 			setVelocity(velocity + acceleration);
 			setValue(value + velocity);
 		}
 
-	private:
-		static std::random_device randomDevice;
-	};
+		/// <summary>
+		/// Applies the current acceleration for the given number of ticks without
+		/// changing it, using the closed form unless a wrap is too close to call.
+		/// </summary>
+		void advanceWithinSegment(std::uint64_t steps)
+		{
+			if (!advanceWithinSegmentInClosedForm(steps))
+			{
+				stepWithinSegment(steps);
+			}
+		}
+
+		/// <summary>
+		/// Applies the current acceleration for the given number of ticks one
+		/// tick at a time, exactly as <see cref="advanceTick"/> does.
+		/// </summary>
+		void stepWithinSegment(std::uint64_t steps)
+		{
+			for (std::uint64_t step{ 0 }; step < steps; step++)
+			{
+				setVelocity(velocity + acceleration);
+				setValue(value + velocity);
+			}
+		}
+
+		/// <summary>
+		/// The type the closed form is computed in.
+		/// </summary>
+		using Wide = std::common_type_t<T, double>;
+
+		/// <summary>
+		/// Applies the current acceleration for the given number of ticks without
+		/// changing it, using the closed form for the sum of the velocities.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The unclamped velocity after <c>k</c> ticks is <c>v0 + k * a</c>.  It
+		/// may first have the opposite sign of the acceleration, then the same
+		/// sign, and finally saturate at the maximum velocity in the direction of
+		/// the acceleration.  Each of these stretches has a velocity of constant
+		/// sign.  Clamping the velocity is continuous, so the tick on which it
+		/// saturates only needs to be right to within rounding.
+		/// </para>
+		/// </remarks>
+		/// <returns><c>false</c>, without changing anything, if the value comes
+		/// within <see cref="getSegmentTolerance"/> of a wrap</returns>
+		[[nodiscard]]
+		bool advanceWithinSegmentInClosedForm(std::uint64_t steps)
+		{
+			Wide const initialVelocity{ velocity };
+			Wide const ramp{ acceleration };
+			Wide const tolerance{ getSegmentTolerance(steps) };
+			Wide newValue{ value };
+			Wide newVelocity{ initialVelocity };
+
+			auto const applyVelocitySum{ [this, tolerance, &newValue](Wide sum) -> bool
+				{
+					return applyVelocitySumOfStretch(newValue, sum, tolerance);
+				} };
+
+			if (ramp == 0)
+			{
+				if (!applyVelocitySum(static_cast<Wide>(steps) * initialVelocity))
+				{
+					return false;
+				}
+			}
+			else
+			{
+				Wide const bound{ ramp > 0 ? Wide{ maximumVelocity } : -Wide{ maximumVelocity } };
+				std::uint64_t const saturatedTick{ firstTickReaching(initialVelocity, ramp, bound, steps) };
+				std::uint64_t crossingTick{ 1 };
+				if ((initialVelocity < 0) != (ramp < 0) && initialVelocity != 0)
+				{
+					crossingTick = std::min(firstTickReaching(initialVelocity, ramp, 0, steps), saturatedTick);
+				}
+
+				if (!applyVelocitySum(sumOfRamp(initialVelocity, ramp, 1, crossingTick))
+					|| !applyVelocitySum(sumOfRamp(initialVelocity, ramp, crossingTick, saturatedTick)))
+				{
+					return false;
+				}
+				if (saturatedTick <= steps)
+				{
+					if (!applyVelocitySum(static_cast<Wide>(steps - saturatedTick + 1) * bound))
+					{
+						return false;
+					}
+					newVelocity = bound;
+				}
+				else
+				{
+					newVelocity = std::clamp(initialVelocity + static_cast<Wide>(steps) * ramp, -Wide{ maximumVelocity }, Wide{ maximumVelocity });
+				}
+			}
 
-	template<std::floating_point T>
-	std::random_device CurveGenerator<T>::randomDevice{ "default" };
+			value = static_cast<T>(newValue);
+			velocity = static_cast<T>(newVelocity);
+			return true;
+		}
+
+		/// <summary>
+		/// Returns how far the closed form of a segment may be from stepping it.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Stepping rounds the value once per tick, to the spacing of numbers
+		/// near the largest value, and rounds the velocity once per tick, which
+		/// moves the value on every following tick.  The bound is four times the
+		/// sum of both over the segment.
+		/// </para>
+		/// </remarks>
+		/// <param name="steps">the number of ticks in the segment</param>
+		/// <returns>the largest difference between the closed form and stepping</returns>
+		[[nodiscard]]
+		Wide getSegmentTolerance(std::uint64_t steps) const noexcept
+		{
+			T const largestValue{ std::max(std::abs(minimumValue), std::abs(maximumValue)) };
+			Wide const valueSpacing{ std::nextafter(largestValue, std::numeric_limits<T>::infinity()) - largestValue };
+			Wide const velocitySpacing{ std::nextafter(maximumVelocity, std::numeric_limits<T>::infinity()) - maximumVelocity };
+			Wide const ticks{ static_cast<Wide>(steps) };
+			return 4 * ticks * (valueSpacing + ticks * velocitySpacing);
+		}
+
+		/// <summary>
+		/// Returns the first tick <c>k</c> in <c>[1, steps + 1]</c> for which
+		/// <c>v0 + k * a</c> reaches the target, in the direction of the acceleration.
+		/// </summary>
+		[[nodiscard]]
+		static std::uint64_t firstTickReaching(Wide initialVelocity, Wide ramp, Wide target, std::uint64_t steps)
+		{
+			Wide const ticksToTarget{ std::ceil((target - initialVelocity) / ramp) };
+			Wide const limit{ static_cast<Wide>(steps) + 1 };
+			return static_cast<std::uint64_t>(std::clamp(ticksToTarget, Wide{ 1 }, limit));
+		}
+
+		/// <summary>
+		/// Returns the sum of <c>v0 + k * a</c> for <c>k</c> in <c>[first, last)</c>.
+		/// </summary>
+		[[nodiscard]]
+		static Wide sumOfRamp(Wide initialVelocity, Wide ramp, std::uint64_t first, std::uint64_t last)
+		{
+			if (last <= first)
+			{
+				return 0;
+			}
+			Wide const count{ static_cast<Wide>(last - first) };
+			Wide const sumOfTicks{ static_cast<Wide>(first + last - 1) * count / 2 };
+			return count * initialVelocity + sumOfTicks * ramp;
+		}
+
+		/// <summary>
+		/// Applies the total of a stretch of velocities that all have the same sign.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// A clamped value that runs into a boundary stays there until the velocity
+		/// changes sign, and a wrapped value only wraps on the side it is moving
+		/// towards, so one clamp or wrap of the total is the same as one per tick.
+		/// <c>std::fmod</c> is only discontinuous at the nonzero multiples of the
+		/// range, so those are the only places rounding can change the result by
+		/// more than the tolerance.
+		/// </para>
+		/// </remarks>
+		/// <param name="newValue">the value, which is updated</param>
+		/// <param name="sum">the sum of the velocities of the stretch</param>
+		/// <param name="tolerance">how far the value may be from stepping</param>
+		/// <returns><c>false</c> if the value comes within the tolerance of a wrap</returns>
+		[[nodiscard]]
+		bool applyVelocitySumOfStretch(Wide& newValue, Wide sum, Wide tolerance) const
+		{
+			if (sum == 0)
+			{
+				return true;
+			}
+			Wide const unwrapped{ newValue + sum };
+			if (valueWraps)
+			{
+				Wide const range{ Wide{ maximumValue } - Wide{ minimumValue } };
+				Wide const offset{ unwrapped - Wide{ minimumValue } };
+				Wide const distance{ std::abs(offset) };
+				Wide const remainder{ std::fmod(distance, range) };
+				if (distance >= range - tolerance && (remainder <= tolerance || range - remainder <= tolerance))
+				{
+					return false;
+				}
+				newValue = std::fmod(offset, range) + Wide{ minimumValue };
+			}
+			else
+			{
+				newValue = std::clamp(unwrapped, Wide{ minimumValue }, Wide{ maximumValue });
+			}
+			return true;
+		}
+	};
 
 }
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <random>
+#include <span>
+#include <type_traits>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "CurveGenerator.h"
+#include "Philox4x32.h"
+
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SILNITH_WINGS_CURVE_BANK_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace silnith::wings
+{
+
+	/// <summary>
+	/// A fixed-size group of curves that are advanced together.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// The state of every curve is stored in structure-of-arrays form so that the
+	/// velocity and value updates for all curves can be computed with SIMD
+	/// instructions.  The results are bit-identical to advancing the same number
+	/// of <see cref="CurveGenerator"/> objects one at a time.  Each curve keeps a
+	/// copy of the random engine of the generator it was created from.
+	/// </para>
+	/// <para>
+	/// Single-precision curves use SSE2 when it is available, which is always the
+	/// case for x64 builds.  Other configurations use an equivalent scalar loop.
+	/// </para>
+	/// </remarks>
+	template<std::floating_point T, std::size_t N, std::uniform_random_bit_generator Engine = Philox4x32>
+	class CurveGeneratorBank
+	{
+	public:
+		CurveGeneratorBank(void) = delete;
+
+		/// <summary>
+		/// Creates a new bank that continues from the current state of the provided curve generators.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The parameters, value, velocity, acceleration, tick count, and engine of each
+		/// generator are copied.  The generators themselves are not modified.
+		/// </para>
+		/// </remarks>
+		/// <param name="generators">the curve generators, one per curve in the bank</param>
+		template<typename... Generators>
+			requires (sizeof...(Generators) == N) && (std::same_as<Generators, CurveGenerator<T, Engine> > && ...)
+		explicit CurveGeneratorBank(Generators const&... generators)
+		{
+			std::size_t index{ 0 };
+			(copyFrom(index++, generators), ...);
+		}
+
+#pragma region Rule of Five
+
+	public:
+		CurveGeneratorBank(CurveGeneratorBank const&) = delete;
+		CurveGeneratorBank& operator=(CurveGeneratorBank const&) = delete;
+		CurveGeneratorBank(CurveGeneratorBank&&) noexcept = delete;
+		CurveGeneratorBank& operator=(CurveGeneratorBank&&) noexcept = delete;
+		virtual ~CurveGeneratorBank(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Returns the number of curves in the bank.
+		/// </summary>
+		/// <returns>the number of curves</returns>
+		[[nodiscard]]
+		static constexpr std::size_t size(void) noexcept
+		{
+			return N;
+		}
+
+		/// <summary>
+		/// Returns the current values of all the curves.
+		/// </summary>
+		/// <returns>the current curve values</returns>
+		[[nodiscard]]
+		inline std::span<T const, N> getValues(void) const noexcept
+		{
+			return std::span<T const, N>{ values.data(), N };
+		}
+
+		/// <summary>
+		/// Returns the current value of one curve.
+		/// </summary>
+		/// <param name="index">the index of the curve</param>
+		/// <returns>the current curve value</returns>
+		[[nodiscard]]
+		inline T getValue(std::size_t index) const noexcept
+		{
+			return values[index];
+		}
+
+		/// <summary>
+		/// Returns the current velocity of one curve.
+		/// </summary>
+		/// <param name="index">the index of the curve</param>
+		/// <returns>the current curve velocity</returns>
+		[[nodiscard]]
+		inline T getVelocity(std::size_t index) const noexcept
+		{
+			return velocities[index];
+		}
+
+		/// <summary>
+		/// Returns the current acceleration of one curve.
+		/// </summary>
+		/// <param name="index">the index of the curve</param>
+		/// <returns>the current curve acceleration</returns>
+		[[nodiscard]]
+		inline T getAcceleration(std::size_t index) const noexcept
+		{
+			return accelerations[index];
+		}
+
+		/// <summary>
+		/// Returns the number of values generated by one curve since its acceleration last changed.
+		/// </summary>
+		/// <param name="index">the index of the curve</param>
+		/// <returns>the number of curve values since the last change in acceleration</returns>
+		[[nodiscard]]
+		inline unsigned int getTicks(std::size_t index) const noexcept
+		{
+			return ticks[index];
+		}
+
+		/// <summary>
+		/// Advances every curve by one tick and returns the new values.
+		/// </summary>
+		/// <returns>the next value of every curve</returns>
+		[[nodiscard]]
+		std::span<T const, N> getNextValues(void)
+		{
+			advanceTick();
+			return getValues();
+		}
+
+		/// <summary>
+		/// Advances the tick count of every curve, which may trigger changes in acceleration.
+		/// Then applies the accelerations to the velocities, and the velocities to the values.
+		/// </summary>
+		void advanceTick(void)
+		{
+			/*
+			 * Acceleration changes are rare, so they are handled one curve at a time.
+			 */
+			for (std::size_t i{ 0 }; i < N; i++)
+			{
+				if (++ticks[i] > ticksPerAccelerationChange[i])
+				{
+					accelerations[i] = CurveGenerator<T, Engine>::drawAcceleration(engines[i], maximumAccelerations[i]);
+					ticks[i] = 0;
+				}
+			}
+
+#if defined(SILNITH_WINGS_CURVE_BANK_SSE2)
+			if constexpr (std::is_same_v<T, float>)
+			{
+				advanceFloatLanes();
+			}
+			else
+#endif
+			{
+				advanceScalarLanes();
+			}
+		}
+
+	private:
+		/// <summary>
+		/// The number of curves rounded up to a multiple of the SIMD width.
+		/// The extra lanes are inert.
+		/// </summary>
+		static constexpr std::size_t paddedSize{ (N + 3) / 4 * 4 };
+
+		void copyFrom(std::size_t index, CurveGenerator<T, Engine> const& generator)
+		{
+			minimumValues[index] = generator.getMinimumValue();
+			maximumValues[index] = generator.getMaximumValue();
+			wrapMasks[index] = generator.isValueWraps() ? ~std::uint32_t{ 0 } : std::uint32_t{ 0 };
+			maximumVelocities[index] = generator.getMaximumVelocity();
+			ticksPerAccelerationChange[index] = generator.getTicksPerAccelerationChange();
+			maximumAccelerations[index] = generator.getMaximumAcceleration();
+
+			values[index] = generator.getValue();
+			velocities[index] = generator.getVelocity();
+			accelerations[index] = generator.getAcceleration();
+			ticks[index] = generator.getTicks();
+			engines[index] = generator.getEngine();
+		}
+
+		/// <summary>
+		/// The scalar equivalent of <c>CurveGenerator::setValue</c>.
+		/// </summary>
+		void setValue(std::size_t index, T _value)
+		{
+			if (wrapMasks[index] != 0)
+			{
+				values[index] = std::fmod(_value - minimumValues[index], maximumValues[index] - minimumValues[index]) + minimumValues[index];
+			}
+			else
+			{
+				values[index] = std::clamp(_value, minimumValues[index], maximumValues[index]);
+			}
+		}
+
+		/// <summary>
+		/// Applies the accelerations and velocities one curve at a time.
+		/// </summary>
+		void advanceScalarLanes(void)
+		{
+			for (std::size_t i{ 0 }; i < N; i++)
+			{
+				velocities[i] = std::clamp(velocities[i] + accelerations[i], -maximumVelocities[i], maximumVelocities[i]);
+				setValue(i, values[i] + velocities[i]);
+			}
+		}
+
+#if defined(SILNITH_WINGS_CURVE_BANK_SSE2)
+		/// <summary>
+		/// Applies the accelerations and velocities four curves at a time.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// <c>_mm_min_ps</c> and <c>_mm_max_ps</c> return their second operand when
+		/// the inputs compare equal, so the operand order below reproduces
+		/// <c>std::clamp</c> exactly, including the sign of zero.
+		/// </para>
+		/// <para>
+		/// The wrapping values only ever move by less than the range per tick, so
+		/// <c>fmod</c> reduces to at most one subtraction of the range.  By Sterbenz's
+		/// lemma that subtraction is exact, as is <c>fmod</c>, so the results are
+		/// identical.  Any lane outside that domain falls back to <c>std::fmod</c>.
+		/// </para>
+		/// </remarks>
+		void advanceFloatLanes(void)
+		{
+			__m128 const signMask{ _mm_set1_ps(-0.0f) };
+			for (std::size_t i{ 0 }; i < paddedSize; i += 4)
+			{
+				__m128 const maximumVelocity{ _mm_load_ps(&maximumVelocities[i]) };
+				__m128 const minimumVelocity{ _mm_xor_ps(maximumVelocity, signMask) };
+				__m128 const unclampedVelocity{ _mm_add_ps(_mm_load_ps(&velocities[i]), _mm_load_ps(&accelerations[i])) };
+				__m128 const velocity{ _mm_max_ps(minimumVelocity, _mm_min_ps(maximumVelocity, unclampedVelocity)) };
+				_mm_store_ps(&velocities[i], velocity);
+
+				__m128 const minimum{ _mm_load_ps(&minimumValues[i]) };
+				__m128 const maximum{ _mm_load_ps(&maximumValues[i]) };
+				__m128 const unclampedValue{ _mm_add_ps(_mm_load_ps(&values[i]), velocity) };
+				__m128 const clampedValue{ _mm_max_ps(minimum, _mm_min_ps(maximum, unclampedValue)) };
+
+				__m128 const range{ _mm_sub_ps(maximum, minimum) };
+				__m128 const offset{ _mm_sub_ps(unclampedValue, minimum) };
+				__m128 const magnitude{ _mm_andnot_ps(signMask, offset) };
+				__m128 const signedRange{ _mm_or_ps(range, _mm_and_ps(offset, signMask)) };
+				__m128 const overflow{ _mm_cmpge_ps(magnitude, range) };
+				/*
+				 * The result of fmod has the sign of the dividend, even when it is zero.
+				 */
+				__m128 const difference{ _mm_sub_ps(offset, _mm_and_ps(overflow, signedRange)) };
+				__m128 const reduced{ _mm_or_ps(difference, _mm_and_ps(offset, signMask)) };
+				__m128 const wrappedValue{ _mm_add_ps(reduced, minimum) };
+
+				__m128 const wraps{ _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<__m128i const*>(&wrapMasks[i]))) };
+				_mm_store_ps(&values[i], _mm_or_ps(_mm_and_ps(wraps, wrappedValue), _mm_andnot_ps(wraps, clampedValue)));
+
+				/*
+				 * Lanes where the offset is at least twice the range (or not a
+				 * number) need the general remainder.
+				 */
+				__m128 const inDomain{ _mm_cmplt_ps(magnitude, _mm_add_ps(range, range)) };
+				int const fallback{ _mm_movemask_ps(_mm_andnot_ps(inDomain, wraps)) };
+				if (fallback != 0)
+				{
+					alignas(16) std::array<float, 4> unclampedValues{};
+					_mm_store_ps(unclampedValues.data(), unclampedValue);
+					for (std::size_t lane{ 0 }; lane < 4; lane++)
+					{
+						if ((fallback & (1 << lane)) != 0)
+						{
+							setValue(i + lane, unclampedValues[lane]);
+						}
+					}
+				}
+			}
+		}
+#endif
+
+	private:
+		alignas(16) std::array<T, paddedSize> minimumValues{};
+		alignas(16) std::array<T, paddedSize> maximumValues{};
+		alignas(16) std::array<T, paddedSize> maximumVelocities{};
+		/// <summary>
+		/// All bits set for curves whose values wrap, and clear for curves whose values are clamped.
+		/// </summary>
+		alignas(16) std::array<std::uint32_t, paddedSize> wrapMasks{};
+		std::array<unsigned int, paddedSize> ticksPerAccelerationChange{};
+		std::array<T, N> maximumAccelerations{};
+
+		alignas(16) std::array<T, paddedSize> values{};
+		alignas(16) std::array<T, paddedSize> velocities{};
+		alignas(16) std::array<T, paddedSize> accelerations{};
+		std::array<unsigned int, paddedSize> ticks{};
+		std::array<Engine, N> engines{};
+	};
+
+}
@@ -1,5 +1,9 @@
+#ifdef _WIN32
 #include <Windows.h>
 #include <gl/GL.h>
+#else
+#include <GL/gl.h>
+#endif
 
 #include <string>
 #include <sstream>
@@ -1,7 +1,11 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
 #include <gl/GL.h>
+#else
+#include <GL/gl.h>
+#endif
 
 #include <string>
 
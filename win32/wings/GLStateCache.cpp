@@ -0,0 +1,162 @@
+#ifdef _WIN32
+#include <Windows.h>
+#include <gl/GL.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include <cstdint>
+
+#include "GLStateCache.h"
+
+namespace silnith::wings::gl
+{
+
+	void GLStateCache::Enable(GLenum capability)
+	{
+		Shadow<bool>* const shadow{ FindCapability(capability) };
+		if (shadow == nullptr)
+		{
+			counts.issued++;
+			glEnable(capability);
+		}
+		else if (Change(*shadow, true))
+		{
+			glEnable(capability);
+		}
+	}
+
+	void GLStateCache::Disable(GLenum capability)
+	{
+		Shadow<bool>* const shadow{ FindCapability(capability) };
+		if (shadow == nullptr)
+		{
+			counts.issued++;
+			glDisable(capability);
+		}
+		else if (Change(*shadow, false))
+		{
+			glDisable(capability);
+		}
+	}
+
+	void GLStateCache::DepthFunc(GLenum function)
+	{
+		if (Change(depthFunc, function))
+		{
+			glDepthFunc(function);
+		}
+	}
+
+	void GLStateCache::DepthMask(GLboolean flag)
+	{
+		if (Change(depthMask, flag))
+		{
+			glDepthMask(flag);
+		}
+	}
+
+	void GLStateCache::PolygonMode(GLenum mode)
+	{
+		if (Change(polygonMode, mode))
+		{
+			glPolygonMode(GL_FRONT_AND_BACK, mode);
+		}
+	}
+
+	bool GLStateCache::ChangeProgram(GLuint program) noexcept
+	{
+		return Change(this->program, program);
+	}
+
+	bool GLStateCache::ChangeVertexArray(GLuint vertexArray) noexcept
+	{
+		return Change(this->vertexArray, vertexArray);
+	}
+
+	bool GLStateCache::ChangeVertexAttribute(GLuint vertexArray, GLuint attributeLocation, VertexAttributePointer const& pointer)
+	{
+		std::vector<VertexAttribute>::iterator const attribute{ std::find_if(vertexAttributes.begin(), vertexAttributes.end(),
+			[vertexArray, attributeLocation](VertexAttribute const& attribute) noexcept -> bool
+			{
+				return attribute.vertexArray == vertexArray && attribute.attributeLocation == attributeLocation;
+			}) };
+		if (attribute == vertexAttributes.end())
+		{
+			vertexAttributes.emplace_back(VertexAttribute{ vertexArray, attributeLocation, pointer });
+		}
+		else if (attribute->pointer == pointer)
+		{
+			counts.elided++;
+			return false;
+		}
+		else
+		{
+			attribute->pointer = pointer;
+		}
+		counts.issued++;
+		return true;
+	}
+
+	void GLStateCache::Invalidate(void) noexcept
+	{
+		blend.known = false;
+		depthTest.known = false;
+		depthFunc.known = false;
+		depthMask.known = false;
+		polygonMode.known = false;
+		program.known = false;
+		vertexArray.known = false;
+		vertexAttributes.clear();
+	}
+
+	void GLStateCache::EndFrame(void) noexcept
+	{
+		frameCounts = Counts{
+			.issued = counts.issued - countsAtFrameStart.issued,
+			.elided = counts.elided - countsAtFrameStart.elided,
+		};
+		countsAtFrameStart = counts;
+	}
+
+	GLStateCache::Counts GLStateCache::getCounts(void) const noexcept
+	{
+		return counts;
+	}
+
+	GLStateCache::Counts GLStateCache::getFrameCounts(void) const noexcept
+	{
+		return frameCounts;
+	}
+
+	template<typename T>
+	bool GLStateCache::Change(Shadow<T>& shadow, T value) noexcept
+	{
+		if (shadow.known && shadow.value == value)
+		{
+			counts.elided++;
+			return false;
+		}
+		shadow.value = value;
+		shadow.known = true;
+		counts.issued++;
+		return true;
+	}
+
+	GLStateCache::Shadow<bool>* GLStateCache::FindCapability(GLenum capability) noexcept
+	{
+		switch (capability)
+		{
+		case GL_BLEND:
+			return &blend;
+		case GL_DEPTH_TEST:
+			return &depthTest;
+		default:
+			return nullptr;
+		}
+	}
+
+}
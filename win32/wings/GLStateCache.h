@@ -0,0 +1,291 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <gl/GL.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <vector>
+
+#include <cstdint>
+
+namespace silnith::wings::gl
+{
+
+	/// <summary>
+	/// A shadow copy of the OpenGL state that the render loops change every
+	/// frame, used to drop calls that would not change anything.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Every value starts out unknown, so the first request for each is always
+	/// passed on.  After that, a request for the value the cache last saw is
+	/// elided.  The cache only knows about changes made through it, so any code
+	/// that changes the same state behind its back must call
+	/// <see cref="Invalidate"/> afterwards.  One cache belongs to one context.
+	/// </para>
+	/// <para>
+	/// The depth, blend, and polygon state are part of OpenGL 1.1, so the cache
+	/// makes those calls itself.  Programs, vertex arrays, and vertex attribute
+	/// pointers are only reachable through entry points that GLEW loads, which
+	/// this library does not use.  For those the cache only answers whether the
+	/// call is needed, and the caller makes it.
+	/// </para>
+	/// <para>
+	/// Both kinds of request are counted, as issued or elided.  The counts for
+	/// each frame are kept separately by <see cref="EndFrame"/>.
+	/// </para>
+	/// </remarks>
+	class GLStateCache
+	{
+	public:
+		/// <summary>
+		/// The numbers of requests that the cache passed on and dropped.
+		/// </summary>
+		struct Counts
+		{
+			/// <summary>
+			/// The number of requests that changed the state, and so were
+			/// passed on to OpenGL.
+			/// </summary>
+			std::uint64_t issued{ 0 };
+
+			/// <summary>
+			/// The number of requests for state that was already current.
+			/// </summary>
+			std::uint64_t elided{ 0 };
+		};
+
+		/// <summary>
+		/// Where and how a vertex attribute reads its data, as given to
+		/// <c>glVertexAttribPointer</c> and <c>glVertexAttribDivisor</c>.
+		/// </summary>
+		struct VertexAttributePointer
+		{
+			/// <summary>
+			/// The OpenGL name of the buffer object that holds the attribute.
+			/// </summary>
+			GLuint buffer{ 0 };
+
+			/// <summary>
+			/// The number of components of the attribute.
+			/// </summary>
+			GLint size{ 0 };
+
+			/// <summary>
+			/// The data type of each component.
+			/// </summary>
+			GLenum type{ 0 };
+
+			/// <summary>
+			/// Whether integer components are normalized to [0, 1] or [-1, 1].
+			/// </summary>
+			GLboolean normalized{ GL_FALSE };
+
+			/// <summary>
+			/// The number of bytes between consecutive elements.
+			/// </summary>
+			GLsizei stride{ 0 };
+
+			/// <summary>
+			/// The byte offset of the first element within the buffer.
+			/// </summary>
+			std::intptr_t offset{ 0 };
+
+			/// <summary>
+			/// The instance divisor, or zero to advance the attribute per vertex.
+			/// </summary>
+			GLuint divisor{ 0 };
+
+			[[nodiscard]]
+			bool operator==(VertexAttributePointer const&) const noexcept = default;
+		};
+
+	public:
+		GLStateCache(void) = default;
+
+#pragma region Rule of Five
+
+	public:
+		GLStateCache(GLStateCache const&) = delete;
+		GLStateCache& operator=(GLStateCache const&) = delete;
+		GLStateCache(GLStateCache&&) noexcept = delete;
+		GLStateCache& operator=(GLStateCache&&) noexcept = delete;
+		~GLStateCache(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Enables a capability, unless it is already enabled.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Only <c>GL_BLEND</c> and <c>GL_DEPTH_TEST</c> are tracked.  Any other
+		/// capability is always passed on.
+		/// </para>
+		/// </remarks>
+		/// <param name="capability">The capability to enable.</param>
+		void Enable(GLenum capability);
+
+		/// <summary>
+		/// Disables a capability, unless it is already disabled.
+		/// </summary>
+		/// <param name="capability">The capability to disable.</param>
+		/// <seealso cref="Enable"/>
+		void Disable(GLenum capability);
+
+		/// <summary>
+		/// Sets the depth comparison function, unless it is already set.
+		/// </summary>
+		/// <param name="function">The depth comparison function.</param>
+		void DepthFunc(GLenum function);
+
+		/// <summary>
+		/// Enables or disables writing to the depth buffer, unless it is
+		/// already so.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Remember that <c>glClear</c> does not clear the depth buffer while
+		/// writing to it is disabled.
+		/// </para>
+		/// </remarks>
+		/// <param name="flag">Whether depth writes are enabled.</param>
+		void DepthMask(GLboolean flag);
+
+		/// <summary>
+		/// Sets the polygon rasterization mode for both front and back faces,
+		/// unless it is already set.
+		/// </summary>
+		/// <param name="mode">The polygon mode.</param>
+		void PolygonMode(GLenum mode);
+
+		/// <summary>
+		/// Records that a program is about to be made current, and returns
+		/// whether the caller must actually call <c>glUseProgram</c>.
+		/// </summary>
+		/// <param name="program">The OpenGL name of the program object, or zero.</param>
+		/// <returns><c>true</c> if the program is not already current.</returns>
+		[[nodiscard]]
+		bool ChangeProgram(GLuint program) noexcept;
+
+		/// <summary>
+		/// Records that a vertex array object is about to be bound, and
+		/// returns whether the caller must actually call <c>glBindVertexArray</c>.
+		/// </summary>
+		/// <param name="vertexArray">The OpenGL name of the vertex array object, or zero.</param>
+		/// <returns><c>true</c> if the vertex array object is not already bound.</returns>
+		[[nodiscard]]
+		bool ChangeVertexArray(GLuint vertexArray) noexcept;
+
+		/// <summary>
+		/// Records that a vertex attribute of a vertex array object is about
+		/// to be pointed at a buffer object, and returns whether the caller
+		/// must actually set the pointer.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The pointer is part of the vertex array object, so it stays set
+		/// while other vertex array objects are bound.  The whole pointer is
+		/// compared, so pointing the same attribute at a different part of the
+		/// same buffer is passed on.
+		/// </para>
+		/// <para>
+		/// OpenGL recycles the names of deleted objects, and a new vertex
+		/// array object has no pointers set.  Call <see cref="Invalidate"/>
+		/// after deleting a vertex array or buffer object that the cache has
+		/// seen, or discard the cache along with them.
+		/// </para>
+		/// </remarks>
+		/// <param name="vertexArray">The OpenGL name of the vertex array object.</param>
+		/// <param name="attributeLocation">The vertex attribute location.</param>
+		/// <param name="pointer">The buffer and layout that the attribute is to use.</param>
+		/// <returns><c>true</c> if the attribute does not already use the pointer.</returns>
+		[[nodiscard]]
+		bool ChangeVertexAttribute(GLuint vertexArray, GLuint attributeLocation, VertexAttributePointer const& pointer);
+
+		/// <summary>
+		/// Forgets all of the state, so that the next request for each value
+		/// is passed on.  The counts are kept.
+		/// </summary>
+		void Invalidate(void) noexcept;
+
+		/// <summary>
+		/// Marks the end of a frame.  The counts since the previous call
+		/// become the counts returned by <see cref="getFrameCounts"/>.
+		/// </summary>
+		void EndFrame(void) noexcept;
+
+		/// <summary>
+		/// Returns the counts of every request since the cache was created.
+		/// </summary>
+		/// <returns>The total counts.</returns>
+		[[nodiscard]]
+		Counts getCounts(void) const noexcept;
+
+		/// <summary>
+		/// Returns the counts of the requests made during the last complete frame.
+		/// </summary>
+		/// <returns>The counts between the last two calls to <see cref="EndFrame"/>.</returns>
+		[[nodiscard]]
+		Counts getFrameCounts(void) const noexcept;
+
+	private:
+		/// <summary>
+		/// A value of OpenGL state, which may not be known yet.
+		/// </summary>
+		template<typename T>
+		struct Shadow
+		{
+			T value{};
+			bool known{ false };
+		};
+
+		/// <summary>
+		/// The pointer that one vertex attribute of one vertex array object uses.
+		/// </summary>
+		struct VertexAttribute
+		{
+			GLuint vertexArray{ 0 };
+			GLuint attributeLocation{ 0 };
+			VertexAttributePointer pointer{};
+		};
+
+		/// <summary>
+		/// Updates a shadow value and counts the request.
+		/// </summary>
+		/// <returns><c>true</c> if the value changed.</returns>
+		template<typename T>
+		[[nodiscard]]
+		bool Change(Shadow<T>& shadow, T value) noexcept;
+
+		/// <summary>
+		/// Returns the shadow of a tracked capability, or <c>nullptr</c>.
+		/// </summary>
+		[[nodiscard]]
+		Shadow<bool>* FindCapability(GLenum capability) noexcept;
+
+	private:
+		Shadow<bool> blend{};
+		Shadow<bool> depthTest{};
+		Shadow<GLenum> depthFunc{};
+		Shadow<GLboolean> depthMask{};
+		Shadow<GLenum> polygonMode{};
+		Shadow<GLuint> program{};
+		Shadow<GLuint> vertexArray{};
+
+		/// <summary>
+		/// The vertex attribute pointers set so far.  There are only a handful,
+		/// so a linear search is the fastest lookup.
+		/// </summary>
+		std::vector<VertexAttribute> vertexAttributes{};
+
+		Counts counts{};
+		Counts countsAtFrameStart{};
+		Counts frameCounts{};
+	};
+
+}
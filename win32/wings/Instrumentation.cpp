@@ -0,0 +1,374 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Instrumentation.h"
+
+namespace silnith::wings::instrumentation
+{
+
+	namespace
+	{
+
+		/// <summary>
+		/// The counters written by a single thread.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Only the owning thread ever writes to these, so an increment is a
+		/// relaxed load followed by a relaxed store.  The atomics are only
+		/// there so that <see cref="Snapshot"/> can read them from another
+		/// thread without a data race.
+		/// </para>
+		/// </remarks>
+		struct ThreadCounters
+		{
+			std::array<std::array<std::atomic<std::uint64_t>, LatencyHistogram::numBuckets>, numPhases> counts{};
+			std::array<std::atomic<std::uint64_t>, numPhases> max{};
+			std::array<std::atomic<std::uint64_t>, numPhases> sum{};
+		};
+
+		/// <summary>
+		/// The counters of every thread that has ever recorded anything.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The registry shares ownership of the counters, so that the
+		/// durations recorded by a thread are still reported after the
+		/// thread exits.
+		/// </para>
+		/// </remarks>
+		class Registry
+		{
+		public:
+			[[nodiscard]]
+			static Registry& GetInstance(void)
+			{
+				static Registry instance{};
+				return instance;
+			}
+
+			[[nodiscard]]
+			std::shared_ptr<ThreadCounters> Register(void)
+			{
+				std::shared_ptr<ThreadCounters> counters{ std::make_shared<ThreadCounters>() };
+				std::scoped_lock const lock{ mutex };
+				threads.push_back(counters);
+				return counters;
+			}
+
+			[[nodiscard]]
+			std::vector<std::shared_ptr<ThreadCounters const> > GetThreads(void)
+			{
+				std::scoped_lock const lock{ mutex };
+				return { threads.begin(), threads.end() };
+			}
+
+		private:
+			std::mutex mutex{};
+			std::vector<std::shared_ptr<ThreadCounters> > threads{};
+		};
+
+		[[nodiscard]]
+		ThreadCounters& GetThreadCounters(void)
+		{
+			thread_local std::shared_ptr<ThreadCounters> const counters{ Registry::GetInstance().Register() };
+			return *counters;
+		}
+
+		inline void Increment(std::atomic<std::uint64_t>& counter, std::uint64_t amount) noexcept
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// The number of buckets per power of two above the linear range.
+		/// </summary>
+		std::size_t constexpr subBucketCount{ std::size_t{ 1 } << (LatencyHistogram::precisionBits - 1) };
+
+		/// <summary>
+		/// The number of values that get a bucket of their own.
+		/// </summary>
+		std::size_t constexpr linearBucketCount{ std::size_t{ 1 } << LatencyHistogram::precisionBits };
+
+	}
+
+	char const* GetPhaseName(Phase phase) noexcept
+	{
+		switch (phase)
+		{
+		case Phase::Tick:
+			return "tick";
+		case Phase::CurveStep:
+			return "curve_step";
+		case Phase::Transform:
+			return "transform";
+		case Phase::Frame:
+			return "frame";
+		case Phase::FillPass:
+			return "fill_pass";
+		case Phase::OutlinePass:
+			return "outline_pass";
+		case Phase::Resolve:
+			return "resolve";
+		case Phase::Swap:
+			return "swap";
+		case Phase::WarmStart:
+			return "warm_start";
+		case Phase::FirstFrame:
+			return "first_frame";
+		}
+		return "unknown";
+	}
+
+	std::size_t LatencyHistogram::GetBucketIndex(std::uint64_t value) noexcept
+	{
+		if (value < linearBucketCount)
+		{
+			return static_cast<std::size_t>(value);
+		}
+
+		/*
+		 * Keep the top precisionBits bits of the value.  The leading bit is
+		 * always set, so the mantissa is in [subBucketCount, linearBucketCount).
+		 */
+		unsigned int const shift{ static_cast<unsigned int>(std::bit_width(value)) - precisionBits };
+		std::size_t const mantissa{ static_cast<std::size_t>(value >> shift) };
+		return shift * subBucketCount + mantissa;
+	}
+
+	std::uint64_t LatencyHistogram::GetBucketLowerBound(std::size_t index) noexcept
+	{
+		assert(index < numBuckets);
+
+		if (index < linearBucketCount)
+		{
+			return index;
+		}
+
+		unsigned int const shift{ static_cast<unsigned int>(index / subBucketCount - 1) };
+		std::uint64_t const mantissa{ index % subBucketCount + subBucketCount };
+		return mantissa << shift;
+	}
+
+	std::uint64_t LatencyHistogram::GetBucketUpperBound(std::size_t index) noexcept
+	{
+		assert(index < numBuckets);
+
+		if (index + 1 == numBuckets)
+		{
+			return UINT64_MAX;
+		}
+		return GetBucketLowerBound(index + 1) - 1;
+	}
+
+	void LatencyHistogram::Record(std::uint64_t value) noexcept
+	{
+		counts[GetBucketIndex(value)]++;
+		count++;
+		max = std::max(max, value);
+		sum += value;
+	}
+
+	void LatencyHistogram::AddToBucket(std::size_t index, std::uint64_t bucketCount) noexcept
+	{
+		assert(index < numBuckets);
+
+		counts[index] += bucketCount;
+		count += bucketCount;
+	}
+
+	void LatencyHistogram::Merge(LatencyHistogram const& other) noexcept
+	{
+		for (std::size_t index{ 0 }; index < numBuckets; index++)
+		{
+			counts[index] += other.counts[index];
+		}
+		count += other.count;
+		max = std::max(max, other.max);
+		sum += other.sum;
+	}
+
+	std::uint64_t LatencyHistogram::getCount(void) const noexcept
+	{
+		return count;
+	}
+
+	std::uint64_t LatencyHistogram::getMax(void) const noexcept
+	{
+		return max;
+	}
+
+	double LatencyHistogram::getMean(void) const noexcept
+	{
+		if (count == 0)
+		{
+			return 0;
+		}
+		return static_cast<double>(sum) / static_cast<double>(count);
+	}
+
+	std::uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const noexcept
+	{
+		if (count == 0)
+		{
+			return 0;
+		}
+
+		double const clamped{ std::clamp(percentile, 0.0, 100.0) };
+		std::uint64_t const rank{ std::max(std::uint64_t{ 1 },
+			static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count)))) };
+
+		std::uint64_t cumulative{ 0 };
+		for (std::size_t index{ 0 }; index < numBuckets; index++)
+		{
+			cumulative += counts[index];
+			if (cumulative >= rank)
+			{
+				return std::min(GetBucketUpperBound(index), max);
+			}
+		}
+		return max;
+	}
+
+	void LatencyHistogram::setMax(std::uint64_t value) noexcept
+	{
+		max = value;
+	}
+
+	void LatencyHistogram::setSum(std::uint64_t value) noexcept
+	{
+		sum = value;
+	}
+
+	void Record(Phase phase, std::chrono::nanoseconds duration) noexcept
+	{
+		std::size_t const phaseIndex{ static_cast<std::size_t>(phase) };
+		assert(phaseIndex < numPhases);
+
+		std::uint64_t const value{ static_cast<std::uint64_t>(std::max(duration.count(), std::chrono::nanoseconds::rep{ 0 })) };
+
+		ThreadCounters& counters{ GetThreadCounters() };
+		Increment(counters.counts[phaseIndex][LatencyHistogram::GetBucketIndex(value)], 1);
+		Increment(counters.sum[phaseIndex], value);
+		if (value > counters.max[phaseIndex].load(std::memory_order_relaxed))
+		{
+			counters.max[phaseIndex].store(value, std::memory_order_relaxed);
+		}
+	}
+
+	PhaseHistograms Snapshot(void)
+	{
+		PhaseHistograms histograms{};
+		for (std::shared_ptr<ThreadCounters const> const& counters : Registry::GetInstance().GetThreads())
+		{
+			for (std::size_t phaseIndex{ 0 }; phaseIndex < numPhases; phaseIndex++)
+			{
+				LatencyHistogram thread{};
+				for (std::size_t index{ 0 }; index < LatencyHistogram::numBuckets; index++)
+				{
+					std::uint64_t const bucketCount{ counters->counts[phaseIndex][index].load(std::memory_order_relaxed) };
+					if (bucketCount != 0)
+					{
+						thread.AddToBucket(index, bucketCount);
+					}
+				}
+				thread.setMax(counters->max[phaseIndex].load(std::memory_order_relaxed));
+				thread.setSum(counters->sum[phaseIndex].load(std::memory_order_relaxed));
+
+				histograms[phaseIndex].Merge(thread);
+			}
+		}
+		return histograms;
+	}
+
+	std::string FormatTextReport(PhaseHistograms const& histograms)
+	{
+		auto const microseconds{ [](std::uint64_t nanoseconds) -> double
+			{
+				return static_cast<double>(nanoseconds) / 1000.0;
+			} };
+
+		std::ostringstream report{};
+		report << std::left << std::setw(14) << "phase"
+			<< std::right << std::setw(10) << "count"
+			<< std::setw(12) << "p50 (us)"
+			<< std::setw(12) << "p99 (us)"
+			<< std::setw(12) << "max (us)"
+			<< '\n';
+		report << std::fixed << std::setprecision(1);
+		for (std::size_t phaseIndex{ 0 }; phaseIndex < numPhases; phaseIndex++)
+		{
+			LatencyHistogram const& histogram{ histograms[phaseIndex] };
+			report << std::left << std::setw(14) << GetPhaseName(static_cast<Phase>(phaseIndex))
+				<< std::right << std::setw(10) << histogram.getCount()
+				<< std::setw(12) << microseconds(histogram.getValueAtPercentile(50))
+				<< std::setw(12) << microseconds(histogram.getValueAtPercentile(99))
+				<< std::setw(12) << microseconds(histogram.getMax())
+				<< '\n';
+		}
+		return report.str();
+	}
+
+	std::string FormatJsonReport(PhaseHistograms const& histograms)
+	{
+		std::ostringstream report{};
+		report << "{\n  \"unit\": \"ns\",\n  \"phases\": [";
+		report << std::fixed << std::setprecision(1);
+		for (std::size_t phaseIndex{ 0 }; phaseIndex < numPhases; phaseIndex++)
+		{
+			LatencyHistogram const& histogram{ histograms[phaseIndex] };
+			report << (phaseIndex == 0 ? "\n" : ",\n")
+				<< "    { \"name\": \"" << GetPhaseName(static_cast<Phase>(phaseIndex)) << "\""
+				<< ", \"count\": " << histogram.getCount()
+				<< ", \"mean\": " << histogram.getMean()
+				<< ", \"p50\": " << histogram.getValueAtPercentile(50)
+				<< ", \"p99\": " << histogram.getValueAtPercentile(99)
+				<< ", \"max\": " << histogram.getMax()
+				<< " }";
+		}
+		report << "\n  ]\n}\n";
+		return report.str();
+	}
+
+	bool WriteReport(void)
+	{
+#pragma warning(suppress: 4996)
+		char const* const path{ std::getenv(reportPathVariable) };
+		if (path == nullptr || *path == '\0')
+		{
+			return false;
+		}
+
+		std::string const reportPath{ path };
+		std::string const jsonExtension{ ".json" };
+		bool const json{ reportPath.size() >= jsonExtension.size()
+			&& reportPath.compare(reportPath.size() - jsonExtension.size(), jsonExtension.size(), jsonExtension) == 0 };
+
+		PhaseHistograms const histograms{ Snapshot() };
+
+		std::ofstream output{ reportPath, std::ios::out | std::ios::trunc };
+		if (!output)
+		{
+			return false;
+		}
+		output << (json ? FormatJsonReport(histograms) : FormatTextReport(histograms));
+		return static_cast<bool>(output);
+	}
+
+}
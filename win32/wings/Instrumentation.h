@@ -0,0 +1,418 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace silnith::wings::instrumentation
+{
+
+	/// <summary>
+	/// The phases of the animation that are timed.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Every phase measures CPU time on the calling thread.  The GL phases
+	/// measure how long it takes to submit the commands, not how long the GPU
+	/// takes to execute them, except that <see cref="Phase::Swap"/> often
+	/// absorbs the latter because the driver blocks there.
+	/// </para>
+	/// </remarks>
+	enum class Phase : std::size_t
+	{
+		/// <summary>
+		/// One complete call to <c>AdvanceAnimation</c>.
+		/// </summary>
+		Tick,
+
+		/// <summary>
+		/// Stepping all of the curve generators once.
+		/// </summary>
+		CurveStep,
+
+		/// <summary>
+		/// Turning the new curve values into a transformed wing, whether
+		/// that is a display list, a transform feedback pass, or a buffer write.
+		/// </summary>
+		Transform,
+
+		/// <summary>
+		/// One complete call to <c>DrawFrame</c>.
+		/// </summary>
+		Frame,
+
+		/// <summary>
+		/// Drawing the solid bodies of the wings.
+		/// </summary>
+		FillPass,
+
+		/// <summary>
+		/// Drawing the outlines of the wings.
+		/// </summary>
+		OutlinePass,
+
+		/// <summary>
+		/// Copying a multisampled framebuffer into the surface.
+		/// </summary>
+		Resolve,
+
+		/// <summary>
+		/// Presenting the back buffer.
+		/// </summary>
+		Swap,
+
+		/// <summary>
+		/// Filling the entire wing history at once, before the first frame.
+		/// </summary>
+		WarmStart,
+
+		/// <summary>
+		/// From the construction of a view until the end of the first frame
+		/// that shows every wing.  This is recorded at most once per view.
+		/// </summary>
+		FirstFrame,
+	};
+
+	/// <summary>
+	/// The number of values in <see cref="Phase"/>.
+	/// </summary>
+	std::size_t constexpr numPhases{ static_cast<std::size_t>(Phase::FirstFrame) + 1 };
+
+	/// <summary>
+	/// Returns the name used for a phase in the reports.
+	/// </summary>
+	/// <param name="phase">The phase.</param>
+	/// <returns>A short lower-case name.</returns>
+	[[nodiscard]]
+	char const* GetPhaseName(Phase phase) noexcept;
+
+	/// <summary>
+	/// A histogram of durations with bounded relative error, in the manner
+	/// of HdrHistogram.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Durations are counted in nanoseconds.  Values below
+	/// 2<sup><see cref="precisionBits"/></sup> each get their own bucket.
+	/// Above that, every power of two is split into
+	/// 2<sup><see cref="precisionBits"/> - 1</sup> equal buckets, so a
+	/// bucket never spans more than about 6% of its value.  The whole range
+	/// of a 64-bit count of nanoseconds fits in under a thousand buckets, and
+	/// recording a value is a bit scan and an increment.
+	/// </para>
+	/// <para>
+	/// This class is not synchronized.  It is the form the data takes once
+	/// it has been collected from the recording threads.
+	/// </para>
+	/// </remarks>
+	class LatencyHistogram
+	{
+#pragma region Static Members
+
+	public:
+		/// <summary>
+		/// The number of significant bits kept for each value.
+		/// </summary>
+		static unsigned int constexpr precisionBits{ 5 };
+
+		/// <summary>
+		/// The number of buckets needed to cover every 64-bit value.
+		/// </summary>
+		static std::size_t constexpr numBuckets{ (std::size_t{ 1 } << precisionBits) + (64 - precisionBits) * (std::size_t{ 1 } << (precisionBits - 1)) };
+
+		/// <summary>
+		/// Returns the bucket that counts a value.
+		/// </summary>
+		/// <param name="value">A duration in nanoseconds.</param>
+		/// <returns>The bucket index.</returns>
+		[[nodiscard]]
+		static std::size_t GetBucketIndex(std::uint64_t value) noexcept;
+
+		/// <summary>
+		/// Returns the smallest value counted by a bucket.
+		/// </summary>
+		/// <param name="index">The bucket index.</param>
+		/// <returns>The lowest value in the bucket.</returns>
+		[[nodiscard]]
+		static std::uint64_t GetBucketLowerBound(std::size_t index) noexcept;
+
+		/// <summary>
+		/// Returns the largest value counted by a bucket.
+		/// </summary>
+		/// <param name="index">The bucket index.</param>
+		/// <returns>The highest value in the bucket.</returns>
+		[[nodiscard]]
+		static std::uint64_t GetBucketUpperBound(std::size_t index) noexcept;
+
+#pragma endregion
+
+	public:
+		LatencyHistogram(void) noexcept = default;
+
+#pragma region Rule of Five
+
+	public:
+		LatencyHistogram(LatencyHistogram const&) = default;
+		LatencyHistogram& operator=(LatencyHistogram const&) = default;
+		LatencyHistogram(LatencyHistogram&&) noexcept = default;
+		LatencyHistogram& operator=(LatencyHistogram&&) noexcept = default;
+		~LatencyHistogram(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Counts one duration.
+		/// </summary>
+		/// <param name="value">The duration in nanoseconds.</param>
+		void Record(std::uint64_t value) noexcept;
+
+		/// <summary>
+		/// Counts a number of durations that fall into the same bucket.
+		/// </summary>
+		/// <param name="index">The bucket index.</param>
+		/// <param name="count">The number of durations.</param>
+		void AddToBucket(std::size_t index, std::uint64_t count) noexcept;
+
+		/// <summary>
+		/// Adds all of the counts from another histogram into this one.
+		/// </summary>
+		/// <param name="other">The histogram to add.</param>
+		void Merge(LatencyHistogram const& other) noexcept;
+
+		/// <summary>
+		/// Returns the number of durations counted.
+		/// </summary>
+		/// <returns>The total count.</returns>
+		[[nodiscard]]
+		std::uint64_t getCount(void) const noexcept;
+
+		/// <summary>
+		/// Returns the largest duration counted.  Unlike the percentiles, this is exact.
+		/// </summary>
+		/// <returns>The maximum in nanoseconds, or zero if the histogram is empty.</returns>
+		[[nodiscard]]
+		std::uint64_t getMax(void) const noexcept;
+
+		/// <summary>
+		/// Returns the mean of the durations counted.
+		/// </summary>
+		/// <returns>The mean in nanoseconds, or zero if the histogram is empty.</returns>
+		[[nodiscard]]
+		double getMean(void) const noexcept;
+
+		/// <summary>
+		/// Returns the duration that the given percentage of the counted
+		/// durations do not exceed.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The result is the upper bound of the bucket containing the
+		/// percentile, but never more than <see cref="getMax"/>.
+		/// </para>
+		/// </remarks>
+		/// <param name="percentile">The percentile, in the range [0, 100].</param>
+		/// <returns>The duration in nanoseconds, or zero if the histogram is empty.</returns>
+		[[nodiscard]]
+		std::uint64_t getValueAtPercentile(double percentile) const noexcept;
+
+		/// <summary>
+		/// Sets the largest duration counted.  This is for rebuilding a
+		/// histogram from buckets that were counted elsewhere.
+		/// </summary>
+		/// <param name="value">The maximum in nanoseconds.</param>
+		void setMax(std::uint64_t value) noexcept;
+
+		/// <summary>
+		/// Sets the sum of the durations counted.  This is for rebuilding a
+		/// histogram from buckets that were counted elsewhere.
+		/// </summary>
+		/// <param name="value">The sum in nanoseconds.</param>
+		void setSum(std::uint64_t value) noexcept;
+
+	private:
+		std::array<std::uint64_t, numBuckets> counts{};
+		std::uint64_t count{ 0 };
+		std::uint64_t max{ 0 };
+		std::uint64_t sum{ 0 };
+	};
+
+	/// <summary>
+	/// The histograms for every phase, merged from every thread.
+	/// </summary>
+	using PhaseHistograms = std::array<LatencyHistogram, numPhases>;
+
+	/// <summary>
+	/// Counts one duration for a phase on the calling thread.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Each thread records into its own set of counters, which are registered
+	/// once the first time the thread records anything.  After that, recording
+	/// takes no locks and performs no atomic read-modify-write operations, since
+	/// no other thread ever writes to the counters.
+	/// </para>
+	/// </remarks>
+	/// <param name="phase">The phase that was timed.</param>
+	/// <param name="duration">How long it took.</param>
+	void Record(Phase phase, std::chrono::nanoseconds duration) noexcept;
+
+	/// <summary>
+	/// Collects the counters from every thread that has recorded anything.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This may be called while other threads are recording.  Each bucket is
+	/// read atomically, but the buckets are not read all at the same instant.
+	/// </para>
+	/// </remarks>
+	/// <returns>The merged histograms.</returns>
+	[[nodiscard]]
+	PhaseHistograms Snapshot(void);
+
+	/// <summary>
+	/// Formats the count, p50, p99, and max of each phase as an aligned table.
+	/// Durations are in microseconds.
+	/// </summary>
+	/// <param name="histograms">The histograms to report.</param>
+	/// <returns>The report, one line per phase after a header line.</returns>
+	[[nodiscard]]
+	std::string FormatTextReport(PhaseHistograms const& histograms);
+
+	/// <summary>
+	/// Formats the count, mean, p50, p99, and max of each phase as a JSON
+	/// document.  Durations are in nanoseconds.
+	/// </summary>
+	/// <param name="histograms">The histograms to report.</param>
+	/// <returns>The report.</returns>
+	[[nodiscard]]
+	std::string FormatJsonReport(PhaseHistograms const& histograms);
+
+	/// <summary>
+	/// The name of the environment variable that holds the report path
+	/// for <see cref="WriteReport"/>.
+	/// </summary>
+	char constexpr reportPathVariable[]{ "WINGS_INSTRUMENTATION_REPORT" };
+
+	/// <summary>
+	/// Writes a report of everything recorded so far, if it was requested.
+	/// Call this when the program exits.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// The report is only written if the environment variable named by
+	/// <see cref="reportPathVariable"/> is set.  If its value ends with
+	/// <c>.json</c> the report is JSON, otherwise it is the text table.
+	/// </para>
+	/// </remarks>
+	/// <returns><c>true</c> if a report was written.</returns>
+	bool WriteReport(void);
+
+	/// <summary>
+	/// Times a phase from construction until <see cref="Stop"/> is called
+	/// or the timer is destroyed, whichever comes first.
+	/// </summary>
+	class PhaseTimer
+	{
+	public:
+		PhaseTimer(void) = delete;
+
+		/// <summary>
+		/// Starts timing.
+		/// </summary>
+		/// <param name="phase">The phase being timed.</param>
+		explicit PhaseTimer(Phase phase) noexcept
+			: phase{ phase }, start{ std::chrono::steady_clock::now() }
+		{}
+
+#pragma region Rule of Five
+
+	public:
+		PhaseTimer(PhaseTimer const&) = delete;
+		PhaseTimer& operator=(PhaseTimer const&) = delete;
+		PhaseTimer(PhaseTimer&&) noexcept = delete;
+		PhaseTimer& operator=(PhaseTimer&&) noexcept = delete;
+		~PhaseTimer(void) noexcept
+		{
+			Stop();
+		}
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Stops timing and records the duration.  Subsequent calls do nothing.
+		/// </summary>
+		void Stop(void) noexcept
+		{
+			if (running)
+			{
+				running = false;
+				Record(phase, std::chrono::steady_clock::now() - start);
+			}
+		}
+
+	private:
+		Phase const phase;
+		std::chrono::steady_clock::time_point const start;
+		bool running{ true };
+	};
+
+	/// <summary>
+	/// Times <see cref="Phase::FirstFrame"/> from construction until the
+	/// first frame that shows the complete wing history.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// A view owns one of these and reports every frame it draws.  Frames
+	/// drawn while the history is still filling are ignored, so without a
+	/// warm start this measures the time to fill the history one tick at a
+	/// time.  Since drawing a frame does not change the view, reporting one
+	/// does not change the timer either, as far as callers can tell.
+	/// </para>
+	/// </remarks>
+	class FirstFrameTimer
+	{
+	public:
+		/// <summary>
+		/// Starts timing.
+		/// </summary>
+		FirstFrameTimer(void) noexcept
+			: start{ std::chrono::steady_clock::now() }
+		{}
+
+#pragma region Rule of Five
+
+	public:
+		FirstFrameTimer(FirstFrameTimer const&) = delete;
+		FirstFrameTimer& operator=(FirstFrameTimer const&) = delete;
+		FirstFrameTimer(FirstFrameTimer&&) noexcept = delete;
+		FirstFrameTimer& operator=(FirstFrameTimer&&) noexcept = delete;
+		~FirstFrameTimer(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Reports that a frame was drawn.  The first time the frame is
+		/// complete, the duration since construction is recorded.
+		/// </summary>
+		/// <param name="complete">Whether the frame showed every wing.</param>
+		void FrameDrawn(bool complete) const noexcept
+		{
+			if (complete && running)
+			{
+				running = false;
+				Record(Phase::FirstFrame, std::chrono::steady_clock::now() - start);
+			}
+		}
+
+	private:
+		std::chrono::steady_clock::time_point const start;
+		mutable bool running{ true };
+	};
+
+}
@@ -0,0 +1,64 @@
+#include <numbers>
+
+#include <cmath>
+#include <cstddef>
+
+#include "Matrix.h"
+
+namespace silnith::wings
+{
+
+	Matrix Multiply(Matrix const& lhs, Matrix const& rhs) noexcept
+	{
+		Matrix result{};
+		for (std::size_t column{ 0 }; column < 4; column++)
+		{
+			for (std::size_t row{ 0 }; row < 4; row++)
+			{
+				float sum{ 0 };
+				for (std::size_t k{ 0 }; k < 4; k++)
+				{
+					sum += lhs[k * 4 + row] * rhs[column * 4 + k];
+				}
+				result[column * 4 + row] = sum;
+			}
+		}
+		return result;
+	}
+
+	Matrix Translate(float x, float y, float z) noexcept
+	{
+		return Matrix{
+			1, 0, 0, 0,
+			0, 1, 0, 0,
+			0, 0, 1, 0,
+			x, y, z, 1,
+		};
+	}
+
+	Matrix Rotate(float angle, float x, float y, float z) noexcept
+	{
+		float const radians{ angle * std::numbers::pi_v<float> / 180.0f };
+		float const c{ std::cos(radians) };
+		float const s{ std::sin(radians) };
+		float const ic{ 1 - c };
+		return Matrix{
+			x * x * ic + c, y * x * ic + z * s, x * z * ic - y * s, 0,
+			x * y * ic - z * s, y * y * ic + c, y * z * ic + x * s, 0,
+			x * z * ic + y * s, y * z * ic - x * s, z * z * ic + c, 0,
+			0, 0, 0, 1,
+		};
+	}
+
+	Matrix WingTransformation(float radius, float angle,
+		float roll, float pitch, float yaw) noexcept
+	{
+		Matrix transformation{ Rotate(angle, 0, 0, 1) };
+		transformation = Multiply(transformation, Translate(radius, 0, 0));
+		transformation = Multiply(transformation, Rotate(-yaw, 0, 0, 1));
+		transformation = Multiply(transformation, Rotate(-pitch, 0, 1, 0));
+		transformation = Multiply(transformation, Rotate(roll, 1, 0, 0));
+		return transformation;
+	}
+
+}
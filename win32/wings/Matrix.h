@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+
+namespace silnith::wings
+{
+
+	/// <summary>
+	/// A 4x4 matrix stored in column-major order, the same layout used by OpenGL.
+	/// </summary>
+	using Matrix = std::array<float, 16>;
+
+	/// <summary>
+	/// The identity matrix.
+	/// </summary>
+	Matrix constexpr identityMatrix{
+		1, 0, 0, 0,
+		0, 1, 0, 0,
+		0, 0, 1, 0,
+		0, 0, 0, 1,
+	};
+
+	/// <summary>
+	/// Returns the product of two matrices, equivalent to loading <paramref name="lhs"/>
+	/// and then calling <c>glMultMatrixf</c> with <paramref name="rhs"/>.
+	/// </summary>
+	/// <param name="lhs">The left-hand matrix.</param>
+	/// <param name="rhs">The right-hand matrix.</param>
+	/// <returns>The product <c>lhs * rhs</c>.</returns>
+	[[nodiscard]]
+	Matrix Multiply(Matrix const& lhs, Matrix const& rhs) noexcept;
+
+	/// <summary>
+	/// Equivalent to <c>glTranslatef</c>.
+	/// </summary>
+	/// <param name="x">The X translation.</param>
+	/// <param name="y">The Y translation.</param>
+	/// <param name="z">The Z translation.</param>
+	/// <returns>The translation matrix.</returns>
+	[[nodiscard]]
+	Matrix Translate(float x, float y, float z) noexcept;
+
+	/// <summary>
+	/// Equivalent to <c>glRotatef</c> with a normalized axis.
+	/// </summary>
+	/// <param name="angle">The angle of rotation, in degrees.</param>
+	/// <param name="x">The X component of the axis of rotation.</param>
+	/// <param name="y">The Y component of the axis of rotation.</param>
+	/// <param name="z">The Z component of the axis of rotation.</param>
+	/// <returns>The rotation matrix.</returns>
+	[[nodiscard]]
+	Matrix Rotate(float angle, float x, float y, float z) noexcept;
+
+	/// <summary>
+	/// Returns the transformation that places a single wing relative to the
+	/// central axis.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This is the sequence of transformations that the OpenGL 1.1 renderer
+	/// compiles into the display list for each wing.  It is fixed for the
+	/// lifetime of the wing, and does not include the accumulated deltas.
+	/// </para>
+	/// </remarks>
+	/// <param name="radius">The radius of the wing around the central axis.</param>
+	/// <param name="angle">The angle of the wing around the central axis.</param>
+	/// <param name="roll">The roll of the wing.</param>
+	/// <param name="pitch">The pitch of the wing.</param>
+	/// <param name="yaw">The yaw of the wing.</param>
+	/// <returns>The wing transformation matrix.</returns>
+	[[nodiscard]]
+	Matrix WingTransformation(float radius, float angle,
+		float roll, float pitch, float yaw) noexcept;
+
+}
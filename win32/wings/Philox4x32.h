@@ -0,0 +1,285 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <limits>
+#include <random>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace silnith::wings
+{
+
+	/// <summary>
+	/// The Philox4x32-10 counter-based pseudo-random number engine.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Each block of four outputs is a pure function of a 64-bit key and a 128-bit
+	/// counter, computed with ten rounds of multiplication and exclusive-or.
+	/// This makes the engine cheap to seed, cheap to copy, and able to skip
+	/// ahead by any number of outputs in constant time.  It never calls into
+	/// the operating system.
+	/// </para>
+	/// <para>
+	/// The key is the seed.  The upper half of the counter selects one of
+	/// 2<sup>64</sup> independent streams for that seed, and the lower half
+	/// counts blocks within the stream.
+	/// </para>
+	/// <para>
+	/// See Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC11.
+	/// </para>
+	/// </remarks>
+	class Philox4x32
+	{
+	public:
+		using result_type = std::uint32_t;
+
+		/// <summary>
+		/// The seed used when none is specified.
+		/// </summary>
+		static constexpr std::uint64_t default_seed{ 0 };
+
+		[[nodiscard]]
+		static constexpr result_type min(void) noexcept
+		{
+			return std::numeric_limits<result_type>::min();
+		}
+
+		[[nodiscard]]
+		static constexpr result_type max(void) noexcept
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		/// <summary>
+		/// Returns a seed drawn from <c>std::random_device</c>.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This is for callers that want a different animation every time the
+		/// program runs, but still want to know which seed produced it.
+		/// </para>
+		/// </remarks>
+		/// <returns>a random seed</returns>
+		[[nodiscard]]
+		static std::uint64_t generateRandomSeed(void)
+		{
+			std::random_device randomDevice{};
+			return (std::uint64_t{ randomDevice() } << 32) | randomDevice();
+		}
+
+		/// <summary>
+		/// Computes one block of output for the given counter and key.
+		/// </summary>
+		/// <param name="counter">the four counter words</param>
+		/// <param name="key">the two key words</param>
+		/// <returns>four pseudo-random words</returns>
+		[[nodiscard]]
+		static constexpr std::array<std::uint32_t, 4> generateBlock(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key) noexcept
+		{
+			for (int round{ 0 }; round < 10; round++)
+			{
+				std::uint64_t const product0{ std::uint64_t{ 0xD2511F53 } * counter[0] };
+				std::uint64_t const product1{ std::uint64_t{ 0xCD9E8D57 } * counter[2] };
+				counter = {
+					static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+					static_cast<std::uint32_t>(product1),
+					static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+					static_cast<std::uint32_t>(product0),
+				};
+				key[0] += 0x9E3779B9;
+				key[1] += 0xBB67AE85;
+			}
+			return counter;
+		}
+
+	public:
+		Philox4x32(void) noexcept
+			: Philox4x32{ default_seed }
+		{}
+
+		/// <summary>
+		/// Creates an engine for the first stream of the given seed.
+		/// </summary>
+		/// <param name="seed">the seed</param>
+		explicit Philox4x32(std::uint64_t seed) noexcept
+			: Philox4x32{ seed, 0 }
+		{}
+
+		/// <summary>
+		/// Creates an engine for one of the independent streams of the given seed.
+		/// </summary>
+		/// <param name="seed">the seed</param>
+		/// <param name="stream">the stream identifier</param>
+		explicit Philox4x32(std::uint64_t seed, std::uint64_t stream) noexcept
+		{
+			this->seed(seed, stream);
+		}
+
+		/// <summary>
+		/// Creates an engine seeded from a seed sequence, such as <c>std::seed_seq</c>.
+		/// </summary>
+		/// <param name="seedSequence">the seed sequence</param>
+		template<typename SeedSequence>
+			requires requires (SeedSequence& sequence, std::uint32_t* words) { sequence.generate(words, words); }
+		explicit Philox4x32(SeedSequence& seedSequence)
+		{
+			std::array<std::uint32_t, 2> words{};
+			seedSequence.generate(words.begin(), words.end());
+			seed((std::uint64_t{ words[1] } << 32) | words[0], 0);
+		}
+
+#pragma region Rule of Five
+
+	public:
+		Philox4x32(Philox4x32 const&) noexcept = default;
+		Philox4x32& operator=(Philox4x32 const&) noexcept = default;
+		Philox4x32(Philox4x32&&) noexcept = default;
+		Philox4x32& operator=(Philox4x32&&) noexcept = default;
+		~Philox4x32(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Restarts the engine at the beginning of one of the streams of the given seed.
+		/// </summary>
+		/// <param name="seed">the seed</param>
+		/// <param name="stream">the stream identifier</param>
+		void seed(std::uint64_t seed, std::uint64_t stream = 0) noexcept
+		{
+			key = { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+			this->stream = stream;
+			blockCounter = 0;
+			index = 4;
+		}
+
+		/// <summary>
+		/// Returns the next pseudo-random word.
+		/// </summary>
+		/// <returns>a uniformly-distributed 32-bit value</returns>
+		result_type operator()(void) noexcept
+		{
+			if (index == 4)
+			{
+				refill();
+			}
+			return block[index++];
+		}
+
+		/// <summary>
+		/// Advances the engine as if <c>operator()</c> had been called <paramref name="count"/> times.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This takes constant time regardless of the count.
+		/// </para>
+		/// </remarks>
+		/// <param name="count">the number of outputs to skip</param>
+		void discard(unsigned long long count) noexcept
+		{
+			std::size_t const available{ 4 - index };
+			if (count <= available)
+			{
+				index += static_cast<std::size_t>(count);
+				return;
+			}
+
+			count -= available;
+			blockCounter += count / 4;
+			index = 4;
+			std::size_t const remainder{ static_cast<std::size_t>(count % 4) };
+			if (remainder != 0)
+			{
+				refill();
+				index = remainder;
+			}
+		}
+
+		/// <summary>
+		/// Returns the key, in the order the words are passed to <see cref="generateBlock"/>.
+		/// </summary>
+		/// <returns>the low and high words of the seed</returns>
+		[[nodiscard]]
+		constexpr std::array<std::uint32_t, 2> getKey(void) const noexcept
+		{
+			return key;
+		}
+
+		/// <summary>
+		/// Returns the stream identifier.
+		/// </summary>
+		/// <returns>the stream identifier</returns>
+		[[nodiscard]]
+		constexpr std::uint64_t getStream(void) const noexcept
+		{
+			return stream;
+		}
+
+		/// <summary>
+		/// Returns the number of words generated since the engine was seeded.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Word <c>n</c> of a stream is word <c>n % 4</c> of the block for
+		/// counter <c>n / 4</c>, so this is enough for another implementation
+		/// of the same algorithm, for example a shader, to continue the stream.
+		/// </para>
+		/// </remarks>
+		/// <returns>the number of outputs consumed, including any skipped by <c>discard</c></returns>
+		[[nodiscard]]
+		constexpr std::uint64_t getOffset(void) const noexcept
+		{
+			if (index == 4)
+			{
+				return blockCounter * 4;
+			}
+			return (blockCounter - 1) * 4 + index;
+		}
+
+		[[nodiscard]]
+		friend bool operator==(Philox4x32 const& lhs, Philox4x32 const& rhs) noexcept
+		{
+			return lhs.key == rhs.key
+				&& lhs.stream == rhs.stream
+				&& lhs.blockCounter == rhs.blockCounter
+				&& lhs.index == rhs.index;
+		}
+
+	private:
+		void refill(void) noexcept
+		{
+			block = generateBlock({
+					static_cast<std::uint32_t>(blockCounter),
+					static_cast<std::uint32_t>(blockCounter >> 32),
+					static_cast<std::uint32_t>(stream),
+					static_cast<std::uint32_t>(stream >> 32),
+				}, key);
+			blockCounter++;
+			index = 0;
+		}
+
+	private:
+		std::array<std::uint32_t, 2> key{};
+		std::uint64_t stream{ 0 };
+
+		/// <summary>
+		/// The counter value for the next block to be generated.
+		/// </summary>
+		std::uint64_t blockCounter{ 0 };
+
+		/// <summary>
+		/// The most recently generated block.
+		/// </summary>
+		std::array<std::uint32_t, 4> block{};
+
+		/// <summary>
+		/// The index of the next word in <see cref="block"/> to return.
+		/// If this is four, the block has been used up.
+		/// </summary>
+		std::size_t index{ 4 };
+	};
+
+}
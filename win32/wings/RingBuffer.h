@@ -0,0 +1,400 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cassert>
+#include <cstddef>
+
+namespace silnith::wings
+{
+
+	/// <summary>
+	/// A fixed-capacity sequence that adds elements at the front and silently
+	/// drops them off the back.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This replaces the <c>std::deque</c> that each view used to hold its
+	/// history of wings.  All storage is allocated once, when the buffer is
+	/// constructed, and is contiguous.  Adding an element moves the head index
+	/// backwards by one slot and assigns into that slot, so once the buffer is
+	/// full every new element overwrites the oldest one.
+	/// </para>
+	/// <para>
+	/// Iteration runs from the newest element to the oldest.  That is
+	/// ascending address order, apart from at most one wrap back to the
+	/// beginning of the storage.
+	/// </para>
+	/// </remarks>
+	template<std::semiregular T>
+	class RingBuffer
+	{
+	public:
+		/// <summary>
+		/// A forward iterator over the elements, from front to back.
+		/// </summary>
+		template<bool Const>
+		class Iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<Const, T const*, T*>;
+			using reference = std::conditional_t<Const, T const&, T&>;
+
+		public:
+			Iterator(void) noexcept = default;
+
+			explicit Iterator(pointer begin, pointer end, pointer current, std::size_t remaining) noexcept
+				: begin{ begin }, end{ end }, current{ current }, remaining{ remaining }
+			{}
+
+			/// <summary>
+			/// A mutable iterator converts to a constant iterator.
+			/// </summary>
+			operator Iterator<true>(void) const noexcept
+			{
+				return Iterator<true>{ begin, end, current, remaining };
+			}
+
+			[[nodiscard]]
+			reference operator*(void) const noexcept
+			{
+				return *current;
+			}
+
+			[[nodiscard]]
+			pointer operator->(void) const noexcept
+			{
+				return current;
+			}
+
+			Iterator& operator++(void) noexcept
+			{
+				if (++current == end)
+				{
+					current = begin;
+				}
+				remaining--;
+				return *this;
+			}
+
+			Iterator operator++(int) noexcept
+			{
+				Iterator const previous{ *this };
+				++*this;
+				return previous;
+			}
+
+			/// <summary>
+			/// Two iterators over the same buffer are equal when they have the
+			/// same number of elements left to visit.
+			/// </summary>
+			[[nodiscard]]
+			friend bool operator==(Iterator const& lhs, Iterator const& rhs) noexcept
+			{
+				return lhs.remaining == rhs.remaining;
+			}
+
+		private:
+			pointer begin{ nullptr };
+			pointer end{ nullptr };
+			pointer current{ nullptr };
+			std::size_t remaining{ 0 };
+		};
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using reference = T&;
+		using const_reference = T const&;
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+
+	public:
+		RingBuffer(void) = delete;
+
+		/// <summary>
+		/// Allocates storage for the specified number of elements.
+		/// </summary>
+		/// <param name="capacity">the maximum number of elements the buffer will hold</param>
+		explicit RingBuffer(size_type capacity)
+			: storage(capacity)
+		{
+			assert(capacity > 0);
+		}
+
+#pragma region Rule of Five
+
+	public:
+		RingBuffer(RingBuffer const&) = default;
+		RingBuffer& operator=(RingBuffer const&) = default;
+		RingBuffer(RingBuffer&&) noexcept = default;
+		RingBuffer& operator=(RingBuffer&&) noexcept = default;
+		~RingBuffer(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Returns the number of elements in the buffer.
+		/// </summary>
+		/// <returns>the number of elements</returns>
+		[[nodiscard]]
+		inline size_type size(void) const noexcept
+		{
+			return count;
+		}
+
+		/// <summary>
+		/// Returns the maximum number of elements the buffer can hold.
+		/// </summary>
+		/// <returns>the capacity of the buffer</returns>
+		[[nodiscard]]
+		inline size_type capacity(void) const noexcept
+		{
+			return storage.size();
+		}
+
+		/// <summary>
+		/// Returns whether the buffer holds no elements.
+		/// </summary>
+		/// <returns><c>true</c> if the buffer is empty</returns>
+		[[nodiscard]]
+		inline bool empty(void) const noexcept
+		{
+			return count == 0;
+		}
+
+		/// <summary>
+		/// Returns whether the buffer is at capacity, so that adding another
+		/// element will overwrite the element at the back.
+		/// </summary>
+		/// <returns><c>true</c> if the buffer is full</returns>
+		[[nodiscard]]
+		inline bool full(void) const noexcept
+		{
+			return count == storage.size();
+		}
+
+		/// <summary>
+		/// Returns the newest element.
+		/// </summary>
+		/// <returns>the element at the front</returns>
+		[[nodiscard]]
+		inline reference front(void) noexcept
+		{
+			assert(!empty());
+			return storage[head];
+		}
+
+		/// <summary>
+		/// Returns the newest element.
+		/// </summary>
+		/// <returns>the element at the front</returns>
+		[[nodiscard]]
+		inline const_reference front(void) const noexcept
+		{
+			assert(!empty());
+			return storage[head];
+		}
+
+		/// <summary>
+		/// Returns the oldest element.  This is the element that the next
+		/// call to <see cref="emplace_front"/> will overwrite if the buffer is full.
+		/// </summary>
+		/// <returns>the element at the back</returns>
+		[[nodiscard]]
+		inline reference back(void) noexcept
+		{
+			assert(!empty());
+			return storage[physicalIndex(count - 1)];
+		}
+
+		/// <summary>
+		/// Returns the oldest element.  This is the element that the next
+		/// call to <see cref="emplace_front"/> will overwrite if the buffer is full.
+		/// </summary>
+		/// <returns>the element at the back</returns>
+		[[nodiscard]]
+		inline const_reference back(void) const noexcept
+		{
+			assert(!empty());
+			return storage[physicalIndex(count - 1)];
+		}
+
+		/// <summary>
+		/// Returns the element at the specified position, counting from the front.
+		/// </summary>
+		/// <param name="index">the position of the element</param>
+		/// <returns>the element</returns>
+		[[nodiscard]]
+		inline reference operator[](size_type index) noexcept
+		{
+			assert(index < count);
+			return storage[physicalIndex(index)];
+		}
+
+		/// <summary>
+		/// Returns the element at the specified position, counting from the front.
+		/// </summary>
+		/// <param name="index">the position of the element</param>
+		/// <returns>the element</returns>
+		[[nodiscard]]
+		inline const_reference operator[](size_type index) const noexcept
+		{
+			assert(index < count);
+			return storage[physicalIndex(index)];
+		}
+
+		/// <summary>
+		/// Adds a new element at the front.  If the buffer is full, the element
+		/// at the back is overwritten.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The new element is constructed from the arguments and move-assigned
+		/// into its slot.  No memory is allocated by the buffer.
+		/// </para>
+		/// </remarks>
+		/// <param name="args">the arguments for the constructor of the element</param>
+		/// <returns>the new element</returns>
+		template<typename... Args>
+			requires std::constructible_from<T, Args...>
+		reference emplace_front(Args&&... args)
+		{
+			/*
+			 * The arguments may refer to the element that is about to be
+			 * overwritten, so the new element is constructed first.
+			 */
+			T element{ std::forward<Args>(args)... };
+			reference slot{ claimFront() };
+			slot = std::move(element);
+			return slot;
+		}
+
+		/// <summary>
+		/// Moves the element at the back of a full buffer to the front, without
+		/// modifying it.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This is for elements that own resources which can be reused.  The caller
+		/// is expected to update the returned element in place, rather than
+		/// constructing a new element and destroying the old one.
+		/// </para>
+		/// </remarks>
+		/// <returns>the element now at the front</returns>
+		reference recycle_front(void) noexcept
+		{
+			assert(full());
+			return claimFront();
+		}
+
+		/// <summary>
+		/// Removes all of the elements.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Every slot is reset to a default-constructed element, so that any
+		/// resources held by the old elements are released.  The storage itself
+		/// is kept.
+		/// </para>
+		/// </remarks>
+		void clear(void)
+		{
+			std::fill(storage.begin(), storage.end(), T{});
+			head = 0;
+			count = 0;
+		}
+
+		[[nodiscard]]
+		iterator begin(void) noexcept
+		{
+			return makeIterator<false>(storage.data(), count);
+		}
+
+		[[nodiscard]]
+		iterator end(void) noexcept
+		{
+			return makeIterator<false>(storage.data(), 0);
+		}
+
+		[[nodiscard]]
+		const_iterator begin(void) const noexcept
+		{
+			return makeIterator<true>(storage.data(), count);
+		}
+
+		[[nodiscard]]
+		const_iterator end(void) const noexcept
+		{
+			return makeIterator<true>(storage.data(), 0);
+		}
+
+		[[nodiscard]]
+		const_iterator cbegin(void) const noexcept
+		{
+			return begin();
+		}
+
+		[[nodiscard]]
+		const_iterator cend(void) const noexcept
+		{
+			return end();
+		}
+
+	private:
+		/// <summary>
+		/// Converts a position counted from the front into an index into the storage.
+		/// </summary>
+		[[nodiscard]]
+		inline size_type physicalIndex(size_type index) const noexcept
+		{
+			size_type const physical{ head + index };
+			return physical < storage.size() ? physical : physical - storage.size();
+		}
+
+		/// <summary>
+		/// Moves the head back by one slot and returns that slot.
+		/// </summary>
+		reference claimFront(void) noexcept
+		{
+			head = (head == 0 ? storage.size() : head) - 1;
+			if (count < storage.size())
+			{
+				count++;
+			}
+			return storage[head];
+		}
+
+		template<bool Const, typename Pointer>
+		[[nodiscard]]
+		Iterator<Const> makeIterator(Pointer data, size_type remaining) const noexcept
+		{
+			return Iterator<Const>{ data, data + storage.size(), data + head, remaining };
+		}
+
+	private:
+		/// <summary>
+		/// The slots for the elements.  This is sized once and never reallocated.
+		/// </summary>
+		std::vector<T> storage;
+
+		/// <summary>
+		/// The index into <see cref="storage"/> of the element at the front.
+		/// </summary>
+		size_type head{ 0 };
+
+		/// <summary>
+		/// The number of slots that hold elements.
+		/// </summary>
+		size_type count{ 0 };
+	};
+
+}
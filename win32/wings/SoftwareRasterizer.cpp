@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "SoftwareRasterizer.h"
+
+#include "Color.h"
+#include "Matrix.h"
+
+namespace silnith::wings::software
+{
+
+	namespace
+	{
+		/// <summary>
+		/// The minimum resolvable difference of a 24-bit depth buffer.
+		/// </summary>
+		float constexpr minimumResolvableDepth{ 1.0f / 16777216.0f };
+
+		std::array<std::uint8_t, 4> ToRGBA(Color<float> const& color) noexcept
+		{
+			auto const toByte{ [](float component) noexcept -> std::uint8_t
+				{
+					return static_cast<std::uint8_t>(std::clamp(component, 0.0f, 1.0f) * 255.0f + 0.5f);
+				} };
+			return { toByte(color.getRed()), toByte(color.getGreen()), toByte(color.getBlue()), 255 };
+		}
+
+		/// <summary>
+		/// Twice the signed area of the triangle <c>(a, b, p)</c>.
+		/// </summary>
+		float EdgeFunction(float ax, float ay, float bx, float by, float px, float py) noexcept
+		{
+			return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+		}
+	}
+
+	SoftwareRasterizer::SoftwareRasterizer(std::size_t width, std::size_t height)
+		: projection{ identityMatrix }, view{ identityMatrix }
+	{
+		Resize(width, height);
+	}
+
+	void SoftwareRasterizer::Resize(std::size_t _width, std::size_t _height)
+	{
+		width = _width;
+		height = _height;
+		colorBuffer.assign(width * height * 4, 0);
+		depthBuffer.assign(width * height, 1.0f);
+	}
+
+	void SoftwareRasterizer::LookAt(float eyeX, float eyeY, float eyeZ,
+		float centerX, float centerY, float centerZ,
+		float upX, float upY, float upZ)
+	{
+		float fx{ centerX - eyeX };
+		float fy{ centerY - eyeY };
+		float fz{ centerZ - eyeZ };
+		float const fLength{ std::sqrt(fx * fx + fy * fy + fz * fz) };
+		fx /= fLength;
+		fy /= fLength;
+		fz /= fLength;
+
+		/*
+		 * s = f x up
+		 */
+		float sx{ fy * upZ - fz * upY };
+		float sy{ fz * upX - fx * upZ };
+		float sz{ fx * upY - fy * upX };
+		float const sLength{ std::sqrt(sx * sx + sy * sy + sz * sz) };
+		sx /= sLength;
+		sy /= sLength;
+		sz /= sLength;
+
+		/*
+		 * u = s x f
+		 */
+		float const ux{ sy * fz - sz * fy };
+		float const uy{ sz * fx - sx * fz };
+		float const uz{ sx * fy - sy * fx };
+
+		Matrix const rotation{
+			sx, ux, -fx, 0,
+			sy, uy, -fy, 0,
+			sz, uz, -fz, 0,
+			0, 0, 0, 1,
+		};
+		view = Multiply(rotation, Translate(-eyeX, -eyeY, -eyeZ));
+	}
+
+	void SoftwareRasterizer::Ortho(float left, float right, float bottom, float top, float nearVal, float farVal)
+	{
+		projection = Matrix{
+			2 / (right - left), 0, 0, 0,
+			0, 2 / (top - bottom), 0, 0,
+			0, 0, -2 / (farVal - nearVal), 0,
+			-(right + left) / (right - left), -(top + bottom) / (top - bottom), -(farVal + nearVal) / (farVal - nearVal), 1,
+		};
+	}
+
+	void SoftwareRasterizer::PolygonOffset(float factor, float units) noexcept
+	{
+		polygonOffsetFactor = factor;
+		polygonOffsetUnits = units;
+	}
+
+	void SoftwareRasterizer::Clear(void)
+	{
+		std::fill(colorBuffer.begin(), colorBuffer.end(), std::uint8_t{ 0 });
+		std::fill(depthBuffer.begin(), depthBuffer.end(), 1.0f);
+	}
+
+	std::uint64_t SoftwareRasterizer::Checksum(void) const noexcept
+	{
+		std::uint64_t hash{ 0xcbf29ce484222325 };
+		for (std::uint8_t const byte : colorBuffer)
+		{
+			hash ^= byte;
+			hash *= 0x100000001b3;
+		}
+		return hash;
+	}
+
+	void SoftwareRasterizer::TransformWing(float deltaZ, float deltaAngle,
+		float radius, float angle,
+		float roll, float pitch, float yaw)
+	{
+		/*
+		 * The wing transformation, preceded by the accumulated deltas and
+		 * the camera.
+		 */
+		Matrix modelViewProjection{ Multiply(projection, view) };
+		modelViewProjection = Multiply(modelViewProjection, Translate(0, 0, deltaZ));
+		modelViewProjection = Multiply(modelViewProjection, Rotate(deltaAngle, 0, 0, 1));
+		modelViewProjection = Multiply(modelViewProjection, WingTransformation(radius, angle, roll, pitch, yaw));
+
+		std::array<std::array<float, 2>, 4> constexpr corners{ {
+			{ 1, 1 },
+			{ -1, 1 },
+			{ -1, -1 },
+			{ 1, -1 },
+		} };
+
+		float const halfWidth{ static_cast<float>(width) / 2 };
+		float const halfHeight{ static_cast<float>(height) / 2 };
+
+		Quad& quad{ transformedWings.emplace_back() };
+		for (std::size_t i{ 0 }; i < corners.size(); i++)
+		{
+			float const x{ corners[i][0] };
+			float const y{ corners[i][1] };
+			float const clipX{ modelViewProjection[0] * x + modelViewProjection[4] * y + modelViewProjection[12] };
+			float const clipY{ modelViewProjection[1] * x + modelViewProjection[5] * y + modelViewProjection[13] };
+			float const clipZ{ modelViewProjection[2] * x + modelViewProjection[6] * y + modelViewProjection[14] };
+			float const clipW{ modelViewProjection[3] * x + modelViewProjection[7] * y + modelViewProjection[15] };
+
+			/*
+			 * The projection is orthographic, so W is always one and no
+			 * perspective division or frustum clipping is required.
+			 */
+			quad[i].x = (clipX / clipW + 1) * halfWidth;
+			quad[i].y = (clipY / clipW + 1) * halfHeight;
+			quad[i].z = (clipZ / clipW + 1) / 2;
+		}
+	}
+
+	void SoftwareRasterizer::FillQuad(Quad const& quad, Color<float> const& color)
+	{
+		std::array<std::uint8_t, 4> const rgba{ ToRGBA(color) };
+		/*
+		 * The same triangulation as GL_TRIANGLE_FAN.
+		 */
+		FillTriangle(quad[0], quad[1], quad[2], rgba);
+		FillTriangle(quad[0], quad[2], quad[3], rgba);
+	}
+
+	void SoftwareRasterizer::FillTriangle(WindowVertex const& v0, WindowVertex const& v1, WindowVertex const& v2,
+		std::array<std::uint8_t, 4> const& rgba)
+	{
+		float const area{ EdgeFunction(v0.x, v0.y, v1.x, v1.y, v2.x, v2.y) };
+		if (area == 0)
+		{
+			return;
+		}
+
+		/*
+		 * The polygon offset is computed from the depth slope of the triangle,
+		 * as specified for glPolygonOffset.
+		 */
+		float const dzdx{ ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area };
+		float const dzdy{ ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area };
+		float const offset{ polygonOffsetFactor * std::max(std::abs(dzdx), std::abs(dzdy))
+			+ polygonOffsetUnits * minimumResolvableDepth };
+
+		float const minX{ std::max(std::floor(std::min({ v0.x, v1.x, v2.x })), 0.0f) };
+		float const maxX{ std::min(std::ceil(std::max({ v0.x, v1.x, v2.x })), static_cast<float>(width)) };
+		float const minY{ std::max(std::floor(std::min({ v0.y, v1.y, v2.y })), 0.0f) };
+		float const maxY{ std::min(std::ceil(std::max({ v0.y, v1.y, v2.y })), static_cast<float>(height)) };
+		if (minX >= maxX || minY >= maxY)
+		{
+			return;
+		}
+
+		std::size_t const startX{ static_cast<std::size_t>(minX) };
+		std::size_t const endX{ static_cast<std::size_t>(maxX) };
+		std::size_t const startY{ static_cast<std::size_t>(minY) };
+		std::size_t const endY{ static_cast<std::size_t>(maxY) };
+
+		for (std::size_t y{ startY }; y < endY; y++)
+		{
+			float const py{ static_cast<float>(y) + 0.5f };
+			for (std::size_t x{ startX }; x < endX; x++)
+			{
+				float const px{ static_cast<float>(x) + 0.5f };
+				float const w0{ EdgeFunction(v1.x, v1.y, v2.x, v2.y, px, py) / area };
+				float const w1{ EdgeFunction(v2.x, v2.y, v0.x, v0.y, px, py) / area };
+				float const w2{ EdgeFunction(v0.x, v0.y, v1.x, v1.y, px, py) / area };
+				if (w0 < 0 || w1 < 0 || w2 < 0)
+				{
+					continue;
+				}
+
+				float const z{ w0 * v0.z + w1 * v1.z + w2 * v2.z };
+				if (z < 0 || z > 1)
+				{
+					continue;
+				}
+
+				float const offsetZ{ std::clamp(z + offset, 0.0f, 1.0f) };
+				std::size_t const index{ y * width + x };
+				if (offsetZ < depthBuffer[index])
+				{
+					depthBuffer[index] = offsetZ;
+					WritePixel(index, rgba);
+				}
+			}
+		}
+	}
+
+	void SoftwareRasterizer::OutlineQuad(Quad const& quad, Color<float> const& color)
+	{
+		std::array<std::uint8_t, 4> const rgba{ ToRGBA(color) };
+		for (std::size_t i{ 0 }; i < quad.size(); i++)
+		{
+			DrawLine(quad[i], quad[(i + 1) % quad.size()], rgba);
+		}
+	}
+
+	void SoftwareRasterizer::DrawLine(WindowVertex const& start, WindowVertex const& end,
+		std::array<std::uint8_t, 4> const& rgba)
+	{
+		float const dx{ end.x - start.x };
+		float const dy{ end.y - start.y };
+		float const dz{ end.z - start.z };
+		std::size_t const steps{ static_cast<std::size_t>(std::ceil(std::max(std::abs(dx), std::abs(dy)))) };
+		for (std::size_t step{ 0 }; step <= steps; step++)
+		{
+			float const t{ steps == 0 ? 0.0f : static_cast<float>(step) / static_cast<float>(steps) };
+			float const x{ std::floor(start.x + t * dx) };
+			float const y{ std::floor(start.y + t * dy) };
+			float const z{ start.z + t * dz };
+			if (x < 0 || y < 0 || x >= static_cast<float>(width) || y >= static_cast<float>(height) || z < 0 || z > 1)
+			{
+				continue;
+			}
+
+			/*
+			 * The outline pass uses a "less than or equal" depth test and does
+			 * not write depth, the same as the OpenGL renderers.
+			 */
+			std::size_t const index{ static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x) };
+			if (z <= depthBuffer[index])
+			{
+				WritePixel(index, rgba);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::WritePixel(std::size_t index, std::array<std::uint8_t, 4> const& rgba) noexcept
+	{
+		std::copy(rgba.begin(), rgba.end(), colorBuffer.begin() + static_cast<std::ptrdiff_t>(index * 4));
+	}
+
+}
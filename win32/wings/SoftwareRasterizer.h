@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <span>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Color.h"
+#include "Matrix.h"
+#include "RingBuffer.h"
+#include "Wing.h"
+
+namespace silnith::wings::software
+{
+
+	/// <summary>
+	/// A CPU-only rasterizer that renders the spinning wings into an in-memory
+	/// framebuffer without any graphics driver.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This mirrors the fixed-function pipeline used by the OpenGL versions.
+	/// Every wing is drawn as a filled quad with a depth test, and then every
+	/// wing is drawn again as an outline.  The filled quads are pushed back
+	/// using polygon offset so that the outlines do not Z-fight with the bodies.
+	/// The outlines are not smoothed, so no blending is performed.
+	/// </para>
+	/// <para>
+	/// The color buffer is RGBA with eight bits per component, and the depth
+	/// buffer is single-precision floating point in the range <c>[0, 1]</c>.
+	/// Rows are stored bottom to top, the same as <c>glReadPixels</c>.
+	/// </para>
+	/// </remarks>
+	class SoftwareRasterizer
+	{
+	public:
+		SoftwareRasterizer(void) = delete;
+
+		/// <summary>
+		/// Creates a new rasterizer with a framebuffer of the given size.
+		/// The projection and view matrices are initialized to the identity.
+		/// </summary>
+		/// <param name="width">the framebuffer width in pixels</param>
+		/// <param name="height">the framebuffer height in pixels</param>
+		explicit SoftwareRasterizer(std::size_t width, std::size_t height);
+
+#pragma region Rule of Five
+
+	public:
+		SoftwareRasterizer(SoftwareRasterizer const&) = delete;
+		SoftwareRasterizer& operator=(SoftwareRasterizer const&) = delete;
+		SoftwareRasterizer(SoftwareRasterizer&&) noexcept = delete;
+		SoftwareRasterizer& operator=(SoftwareRasterizer&&) noexcept = delete;
+		virtual ~SoftwareRasterizer(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Reallocates the framebuffer for a new size.  The contents are cleared.
+		/// </summary>
+		/// <param name="width">the new framebuffer width in pixels</param>
+		/// <param name="height">the new framebuffer height in pixels</param>
+		void Resize(std::size_t width, std::size_t height);
+
+		/// <summary>
+		/// Replaces the view matrix with one that looks from the eye point towards the center point.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This is equivalent to <c>gluLookAt</c>.
+		/// </para>
+		/// </remarks>
+		void LookAt(float eyeX, float eyeY, float eyeZ,
+			float centerX, float centerY, float centerZ,
+			float upX, float upY, float upZ);
+
+		/// <summary>
+		/// Replaces the projection matrix with an orthographic projection.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This is equivalent to <c>glLoadIdentity</c> followed by <c>glOrtho</c>.
+		/// </para>
+		/// </remarks>
+		void Ortho(float left, float right, float bottom, float top, float nearVal, float farVal);
+
+		/// <summary>
+		/// Sets the scale and units used to push filled polygons back in depth.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This is equivalent to <c>glPolygonOffset</c> with <c>GL_POLYGON_OFFSET_FILL</c> enabled.
+		/// The resolvable depth difference is that of a 24-bit depth buffer.
+		/// </para>
+		/// </remarks>
+		/// <param name="factor">the scale factor applied to the maximum depth slope of each polygon</param>
+		/// <param name="units">the number of minimum resolvable depth units to add</param>
+		void PolygonOffset(float factor, float units) noexcept;
+
+		/// <summary>
+		/// Clears the color buffer to transparent black and the depth buffer to the far plane.
+		/// </summary>
+		void Clear(void);
+
+		/// <summary>
+		/// Renders all of the wings, first as filled polygons and then as outlines.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The first wing in the sequence is the most recent.  Each successive wing
+		/// accumulates the delta angle and delta Z of the wings before it, exactly
+		/// as the OpenGL renderers do.
+		/// </para>
+		/// </remarks>
+		/// <param name="wings">the wings to render</param>
+		template<std::integral ID>
+		void DrawWings(RingBuffer<Wing<ID, float> > const& wings)
+		{
+			transformedWings.clear();
+
+			float deltaZ{ 0 };
+			float deltaAngle{ 0 };
+			for (Wing<ID, float> const& wing : wings)
+			{
+				deltaZ += wing.getDeltaZ();
+				deltaAngle += wing.getDeltaAngle();
+
+				TransformWing(deltaZ, deltaAngle,
+					wing.getRadius(), wing.getAngle(),
+					wing.getRoll(), wing.getPitch(), wing.getYaw());
+				FillQuad(transformedWings.back(), wing.getColor());
+			}
+
+			std::size_t index{ 0 };
+			for (Wing<ID, float> const& wing : wings)
+			{
+				OutlineQuad(transformedWings[index++], wing.getEdgeColor());
+			}
+		}
+
+		/// <summary>
+		/// Returns the width of the framebuffer.
+		/// </summary>
+		/// <returns>the framebuffer width in pixels</returns>
+		[[nodiscard]]
+		inline std::size_t getWidth(void) const noexcept
+		{
+			return width;
+		}
+
+		/// <summary>
+		/// Returns the height of the framebuffer.
+		/// </summary>
+		/// <returns>the framebuffer height in pixels</returns>
+		[[nodiscard]]
+		inline std::size_t getHeight(void) const noexcept
+		{
+			return height;
+		}
+
+		/// <summary>
+		/// Returns the color buffer.  Each pixel is four bytes in the order red, green, blue, alpha.
+		/// </summary>
+		/// <returns>the color buffer contents</returns>
+		[[nodiscard]]
+		inline std::span<std::uint8_t const> getColorBuffer(void) const noexcept
+		{
+			return colorBuffer;
+		}
+
+		/// <summary>
+		/// Returns the depth buffer.
+		/// </summary>
+		/// <returns>the depth buffer contents</returns>
+		[[nodiscard]]
+		inline std::span<float const> getDepthBuffer(void) const noexcept
+		{
+			return depthBuffer;
+		}
+
+		/// <summary>
+		/// Computes a 64-bit FNV-1a hash of the color buffer.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This is intended for comparing rendered frames against known-good results.
+		/// </para>
+		/// </remarks>
+		/// <returns>the checksum of the current color buffer contents</returns>
+		[[nodiscard]]
+		std::uint64_t Checksum(void) const noexcept;
+
+	private:
+		/// <summary>
+		/// A vertex after projection and viewport transformation.
+		/// </summary>
+		struct WindowVertex
+		{
+			float x{ 0 };
+			float y{ 0 };
+			float z{ 0 };
+		};
+
+		using Quad = std::array<WindowVertex, 4>;
+
+		/// <summary>
+		/// Transforms the corners of one wing into window coordinates
+		/// and appends them to <see cref="transformedWings"/>.
+		/// </summary>
+		void TransformWing(float deltaZ, float deltaAngle,
+			float radius, float angle,
+			float roll, float pitch, float yaw);
+
+		void FillQuad(Quad const& quad, Color<float> const& color);
+
+		void FillTriangle(WindowVertex const& v0, WindowVertex const& v1, WindowVertex const& v2,
+			std::array<std::uint8_t, 4> const& rgba);
+
+		void OutlineQuad(Quad const& quad, Color<float> const& color);
+
+		void DrawLine(WindowVertex const& start, WindowVertex const& end,
+			std::array<std::uint8_t, 4> const& rgba);
+
+		void WritePixel(std::size_t index, std::array<std::uint8_t, 4> const& rgba) noexcept;
+
+	private:
+		std::size_t width{ 0 };
+		std::size_t height{ 0 };
+
+		std::vector<std::uint8_t> colorBuffer{};
+		std::vector<float> depthBuffer{};
+
+		Matrix projection{};
+		Matrix view{};
+
+		float polygonOffsetFactor{ 0 };
+		float polygonOffsetUnits{ 0 };
+
+		/// <summary>
+		/// The window coordinates of every wing in the current frame.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// The wings are transformed once during the fill pass and the results
+		/// are reused for the outline pass.  The storage is retained between
+		/// frames so that it is not reallocated.
+		/// </para>
+		/// </remarks>
+		std::vector<Quad> transformedWings{};
+	};
+
+}
@@ -185,16 +185,16 @@ namespace silnith::wings
 		}
 
 	private:
-		ID const displayList{ 0 };
-		T const radius{ 10 };
-		T const angle{ 0 };
-		T const deltaAngle{ 15 };
-		T const deltaZ{ 0.5 };
-		T const roll{ 0 };
-		T const pitch{ 0 };
-		T const yaw{ 0 };
-		Color<T> const color{ Color<T>::BLACK };
-		Color<T> const edgeColor{ Color<T>::WHITE };
+		ID displayList{ 0 };
+		T radius{ 10 };
+		T angle{ 0 };
+		T deltaAngle{ 15 };
+		T deltaZ{ 0.5 };
+		T roll{ 0 };
+		T pitch{ 0 };
+		T yaw{ 0 };
+		Color<T> color{ Color<T>::BLACK };
+		Color<T> edgeColor{ Color<T>::WHITE };
 	};
 
 }
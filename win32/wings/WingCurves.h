@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CurveGenerator.h"
+#include "CurveGeneratorBank.h"
+#include "Philox4x32.h"
+#include "WingParameters.h"
+
+namespace silnith::wings
+{
+
+	/// <summary>
+	/// The curve generators for all of the parameters that define how a wing moves.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Every view holds one of these, so that every view created with the same
+	/// seed produces the same animation.  Each curve uses a different stream of
+	/// the seed.
+	/// </para>
+	/// <para>
+	/// The generators are copied into a <see cref="CurveGeneratorBank"/> when this
+	/// is created, and the bank steps every curve in one call.  The generators
+	/// themselves never change, so they keep their initial state for anything
+	/// that continues the curves elsewhere, such as a compute shader.
+	/// </para>
+	/// <para>
+	/// The values are single precision, which is what every renderer uses,
+	/// including the OpenGL ones since <c>GLfloat</c> is <c>float</c>.
+	/// </para>
+	/// </remarks>
+	class WingCurves
+	{
+	public:
+		/// <summary>
+		/// The number of curves, one per member of <see cref="WingParameters"/>.
+		/// </summary>
+		static std::size_t constexpr numCurves{ WingParameters<float>::numCurves };
+
+	public:
+		WingCurves(void) = delete;
+
+		/// <summary>
+		/// Creates the curves for the specified seed.
+		/// </summary>
+		/// <param name="seed">the seed for the curve generators</param>
+		explicit WingCurves(std::uint64_t seed) noexcept
+			: seed{ seed }
+		{}
+
+#pragma region Rule of Five
+
+	public:
+		WingCurves(WingCurves const&) = delete;
+		WingCurves& operator=(WingCurves const&) = delete;
+		WingCurves(WingCurves&&) noexcept = delete;
+		WingCurves& operator=(WingCurves&&) noexcept = delete;
+		~WingCurves(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Steps every curve and returns the parameters for the next wing.
+		/// </summary>
+		/// <returns>the parameters for the next wing</returns>
+		[[nodiscard]]
+		WingParameters<float> getNextParameters(void)
+		{
+			return WingParameters<float>::FromCurveValues(curveBank.getNextValues());
+		}
+
+		/// <summary>
+		/// Returns the seed for the curve generators.
+		/// </summary>
+		/// <returns>the seed that reproduces these curves</returns>
+		[[nodiscard]]
+		std::uint64_t getSeed(void) const noexcept
+		{
+			return seed;
+		}
+
+		/// <summary>
+		/// Returns the curve generators in their initial state, in the order
+		/// of the members of <see cref="WingParameters"/>.
+		/// </summary>
+		/// <returns>the curve generators</returns>
+		[[nodiscard]]
+		std::array<CurveGenerator<float> const*, numCurves> getInitialGenerators(void) const noexcept
+		{
+			return {
+				&radiusCurve, &angleCurve, &deltaAngleCurve, &deltaZCurve,
+				&rollCurve, &pitchCurve, &yawCurve,
+				&redCurve, &greenCurve, &blueCurve,
+			};
+		}
+
+	private:
+		/// <summary>
+		/// The seed for the curve generators.
+		/// </summary>
+		std::uint64_t const seed;
+
+		/// <summary>
+		/// The curve generator for the distance of the wing from the central axis.
+		/// </summary>
+		CurveGenerator<float> const radiusCurve{ 10.0f, -15.0f, 15.0f, false, 0.1f, 0.01f, 150, Philox4x32{ seed, 0 } };
+
+		/// <summary>
+		/// The curve generator for the angle that the wing is rotated around the central axis.
+		/// </summary>
+		CurveGenerator<float> const angleCurve{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120, Philox4x32{ seed, 1 }) };
+
+		/// <summary>
+		/// The curve generator for the additional angle added to each successive "shadow" of the wing.
+		/// </summary>
+		CurveGenerator<float> const deltaAngleCurve{ CurveGenerator<float>::createGeneratorForAngles(15.0f, 0.2f, 0.02f, 80, Philox4x32{ seed, 2 }) };
+
+		/// <summary>
+		/// The curve generator for the distance "up" the central axis that each wing shadow is moved.
+		/// </summary>
+		CurveGenerator<float> const deltaZCurve{ 0.5f, 0.4f, 0.7f, false, 0.01f, 0.001f, 200, Philox4x32{ seed, 3 } };
+
+		/// <summary>
+		/// The curve generator for the roll of the wing.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// Roll, pitch, and yaw taken together define how the wing is twisted
+		/// "in place" wherever it is around the central axis.
+		/// </para>
+		/// </remarks>
+		CurveGenerator<float> const rollCurve{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 1.0f, 0.25f, 80, Philox4x32{ seed, 4 }) };
+
+		/// <summary>
+		/// The curve generator for the pitch of the wing.
+		/// </summary>
+		/// <seealso cref="rollCurve"/>
+		CurveGenerator<float> const pitchCurve{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 2.0f, 0.25f, 40, Philox4x32{ seed, 5 }) };
+
+		/// <summary>
+		/// The curve generator for the yaw of the wing.
+		/// </summary>
+		/// <seealso cref="rollCurve"/>
+		CurveGenerator<float> const yawCurve{ CurveGenerator<float>::createGeneratorForAngles(0.0f, 1.5f, 0.25f, 50, Philox4x32{ seed, 6 }) };
+
+		/// <summary>
+		/// The curve generator for the red component of the wing color.
+		/// </summary>
+		CurveGenerator<float> const redCurve{ CurveGenerator<float>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 95, Philox4x32{ seed, 7 }) };
+
+		/// <summary>
+		/// The curve generator for the green component of the wing color.
+		/// </summary>
+		CurveGenerator<float> const greenCurve{ CurveGenerator<float>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 40, Philox4x32{ seed, 8 }) };
+
+		/// <summary>
+		/// The curve generator for the blue component of the wing color.
+		/// </summary>
+		CurveGenerator<float> const blueCurve{ CurveGenerator<float>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 70, Philox4x32{ seed, 9 }) };
+
+		/// <summary>
+		/// The curves above, stepped together.
+		/// </summary>
+		CurveGeneratorBank<float, numCurves> curveBank{
+			radiusCurve, angleCurve, deltaAngleCurve, deltaZCurve,
+			rollCurve, pitchCurve, yawCurve,
+			redCurve, greenCurve, blueCurve,
+		};
+	};
+
+}
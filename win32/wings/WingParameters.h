@@ -0,0 +1,114 @@
+#pragma once
+
+#include <concepts>
+#include <span>
+
+#include <cstddef>
+
+namespace silnith::wings
+{
+
+	/// <summary>
+	/// The values of every curve generator for a single wing.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// This is one tick of the animation: everything needed to transform a
+	/// new wing and to advance the accumulated deltas.  It exists so that
+	/// several wings can be handed to a renderer at once, for example
+	/// <c>gl3::WingTransformProgram::TransformWings</c>.
+	/// </para>
+	/// <para>
+	/// All angles are in degrees.  Color components are in the range
+	/// <c>[0, 1]</c>.
+	/// </para>
+	/// </remarks>
+	template<std::floating_point T>
+	struct WingParameters
+	{
+		/// <summary>
+		/// The number of curves that define a wing, one per member.
+		/// </summary>
+		static constexpr std::size_t numCurves{ 10 };
+
+		/// <summary>
+		/// Gathers the values of the curves that define a wing, in the order
+		/// that the members are declared.
+		/// </summary>
+		/// <remarks>
+		/// <para>
+		/// This is the order of the curves in the <c>CurveGeneratorBank</c>
+		/// that each view steps.
+		/// </para>
+		/// </remarks>
+		/// <param name="values">The curve values, starting with the radius and ending with the blue component.</param>
+		/// <returns>The parameters of the wing.</returns>
+		[[nodiscard]]
+		static constexpr WingParameters FromCurveValues(std::span<T const, numCurves> values) noexcept
+		{
+			return WingParameters{
+				.radius = values[0],
+				.angle = values[1],
+				.deltaAngle = values[2],
+				.deltaZ = values[3],
+				.roll = values[4],
+				.pitch = values[5],
+				.yaw = values[6],
+				.red = values[7],
+				.green = values[8],
+				.blue = values[9],
+			};
+		}
+
+		/// <summary>
+		/// The radius of the wing around the central axis.
+		/// </summary>
+		T radius{ 0 };
+
+		/// <summary>
+		/// The angle of the wing around the central axis.
+		/// </summary>
+		T angle{ 0 };
+
+		/// <summary>
+		/// The additional angle around the central axis as the wing recedes into history.
+		/// </summary>
+		T deltaAngle{ 0 };
+
+		/// <summary>
+		/// The additional height along the central axis as the wing recedes into history.
+		/// </summary>
+		T deltaZ{ 0 };
+
+		/// <summary>
+		/// The roll of the wing.
+		/// </summary>
+		T roll{ 0 };
+
+		/// <summary>
+		/// The pitch of the wing.
+		/// </summary>
+		T pitch{ 0 };
+
+		/// <summary>
+		/// The yaw of the wing.
+		/// </summary>
+		T yaw{ 0 };
+
+		/// <summary>
+		/// The red component of the wing color.
+		/// </summary>
+		T red{ 0 };
+
+		/// <summary>
+		/// The green component of the wing color.
+		/// </summary>
+		T green{ 0 };
+
+		/// <summary>
+		/// The blue component of the wing color.
+		/// </summary>
+		T blue{ 0 };
+	};
+
+}
@@ -0,0 +1,195 @@
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include "WingVertexBatch.h"
+
+#include "Color.h"
+#include "Matrix.h"
+
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SILNITH_WINGS_VERTEX_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace silnith::wings
+{
+
+	namespace
+	{
+		/// <summary>
+		/// Reduces an accumulated angle to a single revolution before it is
+		/// converted to single precision.
+		/// </summary>
+		float ReduceAngle(double angle) noexcept
+		{
+			return static_cast<float>(std::fmod(angle, 360.0));
+		}
+	}
+
+	WingVertexBatch::WingVertexBatch(std::size_t capacity)
+		: capacity{ capacity },
+		numWings{ 0 },
+		newestSlot{ capacity - 1 },
+		vertices(capacity * verticesPerWing * vertexSize),
+		colors(capacity * verticesPerWing * colorSize),
+		edgeColors(capacity * verticesPerWing * colorSize)
+	{
+		assert(capacity > 0);
+	}
+
+	void WingVertexBatch::AddWing(float radius, float angle,
+		float deltaAngle, float deltaZ,
+		float roll, float pitch, float yaw,
+		Color<float> const& color,
+		Color<float> const& edgeColor)
+	{
+		if (wingsSinceRebase == capacity)
+		{
+			Rebase();
+		}
+		wingsSinceRebase++;
+
+		newestSlot = (newestSlot + 1 == capacity) ? 0 : newestSlot + 1;
+		if (numWings < capacity)
+		{
+			numWings++;
+		}
+
+		/*
+		 * The deltas of the older wings are undone here, so that applying
+		 * the totals each frame leaves exactly the deltas of this wing and
+		 * the wings that come after it.
+		 */
+		Matrix transformation{ Translate(0, 0, -static_cast<float>(accumulatedZ)) };
+		transformation = Multiply(transformation, Rotate(-ReduceAngle(accumulatedAngle), 0, 0, 1));
+		transformation = Multiply(transformation, WingTransformation(radius, angle, roll, pitch, yaw));
+
+		accumulatedAngle += deltaAngle;
+		accumulatedZ += deltaZ;
+
+		/*
+		 * The corners of the untransformed wing are (±1, ±1, 0, 1), so each
+		 * transformed corner is the translation column plus or minus the
+		 * first two columns.
+		 */
+		float* const vertex{ vertices.data() + newestSlot * verticesPerWing * vertexSize };
+#if defined(SILNITH_WINGS_VERTEX_BATCH_SSE2)
+		__m128 const xColumn{ _mm_loadu_ps(&transformation[0]) };
+		__m128 const yColumn{ _mm_loadu_ps(&transformation[4]) };
+		__m128 const translation{ _mm_loadu_ps(&transformation[12]) };
+		__m128 const positiveX{ _mm_add_ps(translation, xColumn) };
+		__m128 const negativeX{ _mm_sub_ps(translation, xColumn) };
+		_mm_storeu_ps(vertex + 0 * vertexSize, _mm_add_ps(positiveX, yColumn));
+		_mm_storeu_ps(vertex + 1 * vertexSize, _mm_add_ps(negativeX, yColumn));
+		_mm_storeu_ps(vertex + 2 * vertexSize, _mm_sub_ps(negativeX, yColumn));
+		_mm_storeu_ps(vertex + 3 * vertexSize, _mm_sub_ps(positiveX, yColumn));
+#else
+		for (std::size_t component{ 0 }; component < vertexSize; component++)
+		{
+			float const positiveX{ transformation[12 + component] + transformation[component] };
+			float const negativeX{ transformation[12 + component] - transformation[component] };
+			float const y{ transformation[4 + component] };
+			vertex[0 * vertexSize + component] = positiveX + y;
+			vertex[1 * vertexSize + component] = negativeX + y;
+			vertex[2 * vertexSize + component] = negativeX - y;
+			vertex[3 * vertexSize + component] = positiveX - y;
+		}
+#endif
+
+		std::size_t const colorIndex{ newestSlot * verticesPerWing * colorSize };
+		for (std::size_t i{ 0 }; i < verticesPerWing; i++)
+		{
+			colors[colorIndex + i * colorSize + 0] = color.getRed();
+			colors[colorIndex + i * colorSize + 1] = color.getGreen();
+			colors[colorIndex + i * colorSize + 2] = color.getBlue();
+			edgeColors[colorIndex + i * colorSize + 0] = edgeColor.getRed();
+			edgeColors[colorIndex + i * colorSize + 1] = edgeColor.getGreen();
+			edgeColors[colorIndex + i * colorSize + 2] = edgeColor.getBlue();
+		}
+	}
+
+	void WingVertexBatch::Clear(void) noexcept
+	{
+		numWings = 0;
+		newestSlot = capacity - 1;
+		wingsSinceRebase = 0;
+		accumulatedAngle = 0;
+		accumulatedZ = 0;
+	}
+
+	std::size_t WingVertexBatch::getNumWings(void) const noexcept
+	{
+		return numWings;
+	}
+
+	std::span<float const> WingVertexBatch::getVertices(void) const noexcept
+	{
+		return std::span<float const>{ vertices.data(), numWings * verticesPerWing * vertexSize };
+	}
+
+	std::span<float const> WingVertexBatch::getColors(void) const noexcept
+	{
+		return std::span<float const>{ colors.data(), numWings * verticesPerWing * colorSize };
+	}
+
+	std::span<float const> WingVertexBatch::getEdgeColors(void) const noexcept
+	{
+		return std::span<float const>{ edgeColors.data(), numWings * verticesPerWing * colorSize };
+	}
+
+	float WingVertexBatch::getAccumulatedAngle(void) const noexcept
+	{
+		return ReduceAngle(accumulatedAngle);
+	}
+
+	float WingVertexBatch::getAccumulatedZ(void) const noexcept
+	{
+		return static_cast<float>(accumulatedZ);
+	}
+
+	void WingVertexBatch::Rebase(void) noexcept
+	{
+		/*
+		 * This is the same rotation and translation the renderer would apply
+		 * this frame, folded into the stored vertices.
+		 */
+		float const radians{ ReduceAngle(accumulatedAngle) * std::numbers::pi_v<float> / 180.0f };
+		float const c{ std::cos(radians) };
+		float const s{ std::sin(radians) };
+		float const z{ static_cast<float>(accumulatedZ) };
+
+		std::size_t const numVertices{ numWings * verticesPerWing };
+		float* vertex{ vertices.data() };
+#if defined(SILNITH_WINGS_VERTEX_BATCH_SSE2)
+		__m128 const cosines{ _mm_setr_ps(c, c, 1, 1) };
+		__m128 const sines{ _mm_setr_ps(-s, s, 0, 0) };
+		__m128 const translation{ _mm_setr_ps(0, 0, z, 0) };
+		for (std::size_t i{ 0 }; i < numVertices; i++, vertex += vertexSize)
+		{
+			__m128 const original{ _mm_loadu_ps(vertex) };
+			__m128 const swapped{ _mm_shuffle_ps(original, original, _MM_SHUFFLE(3, 2, 0, 1)) };
+			__m128 const rotated{ _mm_add_ps(_mm_mul_ps(original, cosines), _mm_mul_ps(swapped, sines)) };
+			_mm_storeu_ps(vertex, _mm_add_ps(rotated, translation));
+		}
+#else
+		for (std::size_t i{ 0 }; i < numVertices; i++, vertex += vertexSize)
+		{
+			float const x{ vertex[0] };
+			float const y{ vertex[1] };
+			vertex[0] = x * c - y * s;
+			vertex[1] = x * s + y * c;
+			vertex[2] += z;
+		}
+#endif
+
+		accumulatedAngle = 0;
+		accumulatedZ = 0;
+		wingsSinceRebase = 0;
+	}
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <cstddef>
+
+#include "Color.h"
+
+namespace silnith::wings
+{
+
+	/// <summary>
+	/// The vertices and colors of every wing, already transformed, in arrays
+	/// that can be drawn with a single call.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Each wing is transformed on the CPU once, when it is added, instead of
+	/// through a display list or the matrix stack every frame.  The wings
+	/// occupy slots in a ring, four vertices per slot, so adding a wing only
+	/// writes its own slot.  The occupied slots are always the first ones.
+	/// </para>
+	/// <para>
+	/// The accumulated delta angle and delta Z still change every frame for
+	/// every wing.  Rotation about Z and translation along Z commute, so every
+	/// wing's vertices are stored relative to a common origin, and the
+	/// difference between the current totals and that origin is the single
+	/// transformation the renderer applies each frame.  See
+	/// <see cref="getAccumulatedAngle"/> and <see cref="getAccumulatedZ"/>.
+	/// To keep that difference small, the origin moves up to the current totals
+	/// once every <c>capacity</c> wings, and the stored vertices are moved to
+	/// match.  That costs one pass over the arrays per <c>capacity</c> wings.
+	/// </para>
+	/// <para>
+	/// Vertices have four components with W always one, so that each vertex
+	/// fills one SSE2 register.  SSE2 is used when it is available, which is
+	/// always the case for x64 builds.  Other configurations use an equivalent
+	/// scalar loop.
+	/// </para>
+	/// </remarks>
+	class WingVertexBatch
+	{
+#pragma region Static Members
+
+	public:
+		/// <summary>
+		/// The number of vertices in each wing.
+		/// </summary>
+		static std::size_t constexpr verticesPerWing{ 4 };
+
+		/// <summary>
+		/// The number of components in each vertex: X, Y, Z, and W.
+		/// </summary>
+		static std::size_t constexpr vertexSize{ 4 };
+
+		/// <summary>
+		/// The number of components in each color: red, green, and blue.
+		/// </summary>
+		static std::size_t constexpr colorSize{ 3 };
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Default constructor is deleted.  The arrays cannot be allocated
+		/// without knowing the number of wings.
+		/// </summary>
+		WingVertexBatch(void) = delete;
+
+		/// <summary>
+		/// Allocates the arrays for the specified number of wings.
+		/// </summary>
+		/// <param name="capacity">The maximum number of wings.</param>
+		explicit WingVertexBatch(std::size_t capacity);
+
+#pragma region Rule of Five
+
+	public:
+		WingVertexBatch(WingVertexBatch const&) = default;
+		WingVertexBatch& operator=(WingVertexBatch const&) = default;
+		WingVertexBatch(WingVertexBatch&&) noexcept = default;
+		WingVertexBatch& operator=(WingVertexBatch&&) noexcept = default;
+		~WingVertexBatch(void) noexcept = default;
+
+#pragma endregion
+
+	public:
+		/// <summary>
+		/// Adds a new wing as the newest wing.  If the arrays are full, the
+		/// oldest wing is discarded.
+		/// </summary>
+		/// <param name="radius">The radius of the wing around the central axis.</param>
+		/// <param name="angle">The angle of the wing around the central axis.</param>
+		/// <param name="deltaAngle">The additional angle around the central axis as the wing recedes into history.</param>
+		/// <param name="deltaZ">The additional height along the central axis as the wing recedes into history.</param>
+		/// <param name="roll">The roll of the wing.</param>
+		/// <param name="pitch">The pitch of the wing.</param>
+		/// <param name="yaw">The yaw of the wing.</param>
+		/// <param name="color">The color of the wing.</param>
+		/// <param name="edgeColor">The color of the wing outline.</param>
+		void AddWing(float radius, float angle,
+			float deltaAngle, float deltaZ,
+			float roll, float pitch, float yaw,
+			Color<float> const& color,
+			Color<float> const& edgeColor);
+
+		/// <summary>
+		/// Discards all of the wings.
+		/// </summary>
+		void Clear(void) noexcept;
+
+		/// <summary>
+		/// Returns the number of wings currently in the arrays.
+		/// </summary>
+		/// <returns>The number of wings to render.</returns>
+		[[nodiscard]]
+		std::size_t getNumWings(void) const noexcept;
+
+		/// <summary>
+		/// Returns the vertices of the occupied slots.
+		/// </summary>
+		/// <returns><see cref="verticesPerWing"/> vertices of <see cref="vertexSize"/> components for each wing.</returns>
+		[[nodiscard]]
+		std::span<float const> getVertices(void) const noexcept;
+
+		/// <summary>
+		/// Returns the colors of the occupied slots, one for every vertex.
+		/// </summary>
+		/// <returns><see cref="verticesPerWing"/> colors of <see cref="colorSize"/> components for each wing.</returns>
+		[[nodiscard]]
+		std::span<float const> getColors(void) const noexcept;
+
+		/// <summary>
+		/// Returns the edge colors of the occupied slots, one for every vertex.
+		/// </summary>
+		/// <returns><see cref="verticesPerWing"/> colors of <see cref="colorSize"/> components for each wing.</returns>
+		[[nodiscard]]
+		std::span<float const> getEdgeColors(void) const noexcept;
+
+		/// <summary>
+		/// Returns the angle about the Z axis by which every stored vertex must
+		/// be rotated this frame.
+		/// </summary>
+		/// <returns>The angle in degrees.</returns>
+		[[nodiscard]]
+		float getAccumulatedAngle(void) const noexcept;
+
+		/// <summary>
+		/// Returns the distance along the Z axis by which every stored vertex
+		/// must be translated this frame.  This is applied after
+		/// <see cref="getAccumulatedAngle"/>, although the two commute.
+		/// </summary>
+		/// <returns>The distance.</returns>
+		[[nodiscard]]
+		float getAccumulatedZ(void) const noexcept;
+
+	private:
+		/// <summary>
+		/// Moves the origin to the current totals, and moves every stored
+		/// vertex to match.
+		/// </summary>
+		void Rebase(void) noexcept;
+
+	private:
+		/// <summary>
+		/// The maximum number of wings.
+		/// </summary>
+		std::size_t capacity{ 1 };
+
+		/// <summary>
+		/// The number of wings currently in the arrays.
+		/// </summary>
+		std::size_t numWings{ 0 };
+
+		/// <summary>
+		/// The slot of the newest wing.
+		/// </summary>
+		std::size_t newestSlot{ 0 };
+
+		/// <summary>
+		/// The number of wings added since the origin last moved.
+		/// </summary>
+		std::size_t wingsSinceRebase{ 0 };
+
+		/// <summary>
+		/// The total delta angle of every wing added, relative to the origin.
+		/// </summary>
+		double accumulatedAngle{ 0 };
+
+		/// <summary>
+		/// The total delta Z of every wing added, relative to the origin.
+		/// </summary>
+		double accumulatedZ{ 0 };
+
+		/// <summary>
+		/// The vertices of each wing, by slot.
+		/// </summary>
+		std::vector<float> vertices{};
+
+		/// <summary>
+		/// The color of each vertex, by slot.
+		/// </summary>
+		std::vector<float> colors{};
+
+		/// <summary>
+		/// The edge color of each vertex, by slot.
+		/// </summary>
+		std::vector<float> edgeColors{};
+	};
+
+}
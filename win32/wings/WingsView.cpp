@@ -1,23 +1,39 @@
+#ifdef _WIN32
 #include <Windows.h>
 #include <gl/GL.h>
 #include <gl/GLU.h>
+#else
+#include <GL/gl.h>
+#include <GL/glu.h>
+#endif
 
-#include <deque>
 #include <string>
 #include <sstream>
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 #include "WingsView.h"
 
 #include "Color.h"
-#include "CurveGenerator.h"
+#include "Instrumentation.h"
+#include "Philox4x32.h"
+#include "RingBuffer.h"
 #include "Wing.h"
+#include "WingCurves.h"
+#include "WingParameters.h"
 
 namespace silnith::wings::gl
 {
 
 	WingsView::WingsView(GLInfo const& glInfo) :
+		WingsView{ glInfo, defaultNumWings, Philox4x32::generateRandomSeed() }
+	{}
+
+	WingsView::WingsView(GLInfo const& glInfo, std::size_t numWings, std::uint64_t seed) :
+		numWings{ numWings },
+		curves{ seed },
 		enablePolygonOffset{ glInfo.isAtLeastVersion(1, 1) },
 		wingDisplayList{ glGenLists(1) }
 	{
@@ -77,7 +93,7 @@ namespace silnith::wings::gl
 
 	WingsView::~WingsView(void) noexcept
 	{
-		for (std::deque<Wing<GLuint, GLfloat> >::const_reference wing : wings)
+		for (RingBuffer<Wing<GLuint, GLfloat> >::const_reference wing : wings)
 		{
 			GLuint const displayList{ wing.getGLDisplayList() };
 			glDeleteLists(displayList, 1);
@@ -92,16 +108,11 @@ namespace silnith::wings::gl
 		 * Get the next updated values for all the parameters that define how
 		 * a wing moves.
 		 */
-		GLfloat const radius{ radiusCurve.getNextValue() };
-		GLfloat const angle{ angleCurve.getNextValue() };
-		GLfloat const deltaAngle{ deltaAngleCurve.getNextValue() };
-		GLfloat const deltaZ{ deltaZCurve.getNextValue() };
-		GLfloat const roll{ rollCurve.getNextValue() };
-		GLfloat const pitch{ pitchCurve.getNextValue() };
-		GLfloat const yaw{ yawCurve.getNextValue() };
-		GLfloat const red{ redCurve.getNextValue() };
-		GLfloat const green{ greenCurve.getNextValue() };
-		GLfloat const blue{ blueCurve.getNextValue() };
+		instrumentation::PhaseTimer curveTimer{ instrumentation::Phase::CurveStep };
+		WingParameters<GLfloat> const parameters{ NextWingParameters() };
+		curveTimer.Stop();
+
+		instrumentation::PhaseTimer const transformTimer{ instrumentation::Phase::Transform };
 
 		/// <summary>
 		/// The display list for the new wing.
@@ -119,11 +130,7 @@ namespace silnith::wings::gl
 		/// </para>
 		/// </remarks>
 		GLuint displayList{ 0 };
-		if (wings.empty() || wings.size() < numWings)
-		{
-			displayList = glGenLists(1);
-		}
-		else
+		if (wings.full())
 		{
 			/*
 			 * If a wing expires off the end of the list of wings, we can reuse
@@ -131,14 +138,45 @@ namespace silnith::wings::gl
 			 * data will be overwritten.
 			 */
 			displayList = wings.back().getGLDisplayList();
-			wings.pop_back();
 		}
+		else
+		{
+			displayList = glGenLists(1);
+		}
+
+		AddWing(displayList, parameters);
+	}
+
+	void WingsView::WarmStart(void)
+	{
+		assert(wings.empty());
+
+		instrumentation::PhaseTimer const warmStartTimer{ instrumentation::Phase::WarmStart };
+
+		/*
+		 * The display lists are allocated as one contiguous range.  Each wing
+		 * still owns exactly one of them, so the destructor and the reuse in
+		 * AdvanceAnimation do not need to know how they were allocated.
+		 */
+		GLuint const firstDisplayList{ glGenLists(static_cast<GLsizei>(numWings)) };
+		for (std::size_t i{ 0 }; i < numWings; i++)
+		{
+			AddWing(firstDisplayList + static_cast<GLuint>(i), NextWingParameters());
+		}
+	}
 
+	WingParameters<GLfloat> WingsView::NextWingParameters(void)
+	{
+		return curves.getNextParameters();
+	}
+
+	void WingsView::AddWing(GLuint displayList, WingParameters<GLfloat> const& parameters)
+	{
 		wings.emplace_front(displayList,
-			radius, angle,
-			deltaAngle, deltaZ,
-			roll, pitch, yaw,
-			Color<GLfloat>{ red, green, blue },
+			parameters.radius, parameters.angle,
+			parameters.deltaAngle, parameters.deltaZ,
+			parameters.roll, parameters.pitch, parameters.yaw,
+			Color<GLfloat>{ parameters.red, parameters.green, parameters.blue },
 			Color<GLfloat>::WHITE);
 
 		/*
@@ -149,11 +187,11 @@ namespace silnith::wings::gl
 		 */
 		glNewList(displayList, GL_COMPILE);
 		glPushMatrix();
-		glRotatef(angle, 0, 0, 1);
-		glTranslatef(radius, 0, 0);
-		glRotatef(-yaw, 0, 0, 1);
-		glRotatef(-pitch, 0, 1, 0);
-		glRotatef(roll, 1, 0, 0);
+		glRotatef(parameters.angle, 0, 0, 1);
+		glTranslatef(parameters.radius, 0, 0);
+		glRotatef(-parameters.yaw, 0, 0, 1);
+		glRotatef(-parameters.pitch, 0, 1, 0);
+		glRotatef(parameters.roll, 1, 0, 0);
 		glCallList(wingDisplayList);
 		glPopMatrix();
 		glEndList();
@@ -164,8 +202,9 @@ namespace silnith::wings::gl
 		/*
 		 * First, draw the solid wings using their solid color.
 		 */
+		instrumentation::PhaseTimer fillTimer{ instrumentation::Phase::FillPass };
 		glPushMatrix();
-		for (std::deque<Wing<GLuint, GLfloat> >::const_reference wing : wings) {
+		for (RingBuffer<Wing<GLuint, GLfloat> >::const_reference wing : wings) {
 			/*
 			 * Allow the delta transformations to accumulate as we go through the list
 			 * of wings.
@@ -178,6 +217,7 @@ namespace silnith::wings::gl
 			glCallList(wing.getGLDisplayList());
 		}
 		glPopMatrix();
+		fillTimer.Stop();
 
 #if defined(GL_VERSION_1_1)
 		if (enablePolygonOffset)
@@ -194,12 +234,13 @@ namespace silnith::wings::gl
 			 * And corners where lines adjoin will allow overlapping partial fragments to
 			 * blend together rather than displace each other.
 			 */
-			glDepthFunc(GL_LEQUAL);
-			glDepthMask(GL_FALSE);
-			glEnable(GL_BLEND);
-			glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+			instrumentation::PhaseTimer const outlineTimer{ instrumentation::Phase::OutlinePass };
+			stateCache.DepthFunc(GL_LEQUAL);
+			stateCache.DepthMask(GL_FALSE);
+			stateCache.Enable(GL_BLEND);
+			stateCache.PolygonMode(GL_LINE);
 			glPushMatrix();
-			for (std::deque<Wing<GLuint, GLfloat> >::const_reference wing : wings) {
+			for (RingBuffer<Wing<GLuint, GLfloat> >::const_reference wing : wings) {
 				glTranslatef(0, 0, wing.getDeltaZ());
 				glRotatef(wing.getDeltaAngle(), 0, 0, 1);
 
@@ -208,14 +249,18 @@ namespace silnith::wings::gl
 				glCallList(wing.getGLDisplayList());
 			}
 			glPopMatrix();
-			glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-			glDisable(GL_BLEND);
-			glDepthMask(GL_TRUE);
-			glDepthFunc(GL_LESS);
+			stateCache.PolygonMode(GL_FILL);
+			stateCache.Disable(GL_BLEND);
+			stateCache.DepthMask(GL_TRUE);
+			stateCache.DepthFunc(GL_LESS);
 		}
 #endif
 
 		glFlush();
+
+		stateCache.EndFrame();
+
+		firstFrameTimer.FrameDrawn(wings.full());
 	}
 
 	void WingsView::Resize(GLsizei width, GLsizei height) const
@@ -275,4 +320,14 @@ namespace silnith::wings::gl
 		glMatrixMode(GL_MODELVIEW);
 	}
 
+	GLStateCache const& WingsView::getStateCache(void) const noexcept
+	{
+		return stateCache;
+	}
+
+	GLStateCache& WingsView::getStateCache(void) noexcept
+	{
+		return stateCache;
+	}
+
 }
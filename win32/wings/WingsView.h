@@ -1,15 +1,22 @@
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
 #include <gl/GL.h>
-
-#include <deque>
+#else
+#include <GL/gl.h>
+#endif
 
 #include <cstddef>
+#include <cstdint>
 
-#include "CurveGenerator.h"
 #include "GLInfo.h"
+#include "GLStateCache.h"
+#include "Instrumentation.h"
+#include "RingBuffer.h"
 #include "Wing.h"
+#include "WingCurves.h"
+#include "WingParameters.h"
 
 namespace silnith::wings::gl
 {
@@ -36,6 +43,20 @@ namespace silnith::wings::gl
         /// <param name="glInfo">The queryable OpenGL information.</param>
         explicit WingsView(GLInfo const& glInfo);
 
+        /// <summary>
+        /// Initializes the spinning wings with a specific number of wings and
+        /// a fixed seed for the curve generators.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Two views created with the same seed produce identical animations.
+        /// </para>
+        /// </remarks>
+        /// <param name="glInfo">The queryable OpenGL information.</param>
+        /// <param name="numWings">The number of wings to animate.</param>
+        /// <param name="seed">The seed for the curve generators.</param>
+        explicit WingsView(GLInfo const& glInfo, std::size_t numWings, std::uint64_t seed);
+
 #pragma region Rule of Five
 
     public:
@@ -59,6 +80,20 @@ namespace silnith::wings::gl
         /// </remarks>
         void AdvanceAnimation(void);
 
+        /// <summary>
+        /// Fills the entire wing history at once, so that the first frame
+        /// drawn is already a complete spiral.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This is equivalent to calling <see cref="AdvanceAnimation"/> once
+        /// per wing, except that the display lists for all of the wings are
+        /// allocated with a single call.  It must be called before the
+        /// animation is advanced for the first time.
+        /// </para>
+        /// </remarks>
+        void WarmStart(void);
+
         /// <summary>
         /// Renders the current spinning wings animation frame into the current
         /// rendering context.
@@ -101,110 +136,96 @@ namespace silnith::wings::gl
         /// <param name="height">the new viewport height</param>
         void Resize(GLint x, GLint y, GLsizei width, GLsizei height) const;
 
-    private:
         /// <summary>
-        /// The number of wings to animate.
+        /// Returns the shadow of the OpenGL state that drawing changes, which
+        /// counts the state changes that were issued and elided.
         /// </summary>
-        std::size_t const numWings{ 40 };
+        /// <returns>The state cache.</returns>
+        [[nodiscard]]
+        GLStateCache const& getStateCache(void) const noexcept;
 
         /// <summary>
-        /// Whether the GL supports the polygon offset feature.
+        /// Returns the shadow of the OpenGL state that drawing changes, so
+        /// that code changing the same state can invalidate it.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// This feature prevents Z-fighting between the polygon surface and
-        /// the wire outline of each wing.  If it is supported, then the wire
-        /// outlines will be rendered.  The outlines will also have smoothing
-        /// enabled, which requires fragment blending.
-        /// </para>
-        /// </remarks>
-        bool const enablePolygonOffset{ false };
+        /// <returns>The state cache.</returns>
+        [[nodiscard]]
+        GLStateCache& getStateCache(void) noexcept;
 
+    public:
         /// <summary>
-        /// The GL call list for a single quad, which is used to render every
-        /// wing.
+        /// The number of wings animated when none is specified.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// This will be called once per wing.  If the polygon offset feature
-        /// is supported and wire outlines are rendered, this will be called
-        /// twice per wing.
-        /// </para>
-        /// </remarks>
-        GLuint const wingDisplayList{ 0 };
+        static std::size_t constexpr defaultNumWings{ 40 };
 
+    private:
         /// <summary>
-        /// The sequence of transformed wings.
+        /// Steps every curve once.
         /// </summary>
-        std::deque<Wing<GLuint, GLfloat> > wings{};
+        /// <returns>The parameters of the next wing.</returns>
+        [[nodiscard]]
+        WingParameters<GLfloat> NextWingParameters(void);
 
         /// <summary>
-        /// The curve generator for the distance of the wing from the central axis.
+        /// Adds a new wing to the front of the history and compiles its
+        /// transformation into a display list.
         /// </summary>
-        CurveGenerator<GLfloat> radiusCurve{ 10.0f, -15.0f, 15.0f, false, 0.1f, 0.01f, 150 };
+        /// <param name="displayList">The display list to compile.  It must not be used by any other wing.</param>
+        /// <param name="parameters">The parameters of the new wing.</param>
+        void AddWing(GLuint displayList, WingParameters<GLfloat> const& parameters);
 
+    private:
         /// <summary>
-        /// The curve generator for the angle that the wing is rotated around the central axis.
+        /// The time from construction to the first complete frame.  This is
+        /// declared first so that it includes the construction of every other member.
         /// </summary>
-        CurveGenerator<GLfloat> angleCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 2.0f, 0.05f, 120) };
+        instrumentation::FirstFrameTimer const firstFrameTimer{};
 
         /// <summary>
-        /// The curve generator for the additional angle added to each successive "shadow" of the wing.
+        /// The number of wings to animate.
         /// </summary>
-        CurveGenerator<GLfloat> deltaAngleCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(15.0f, 0.2f, 0.02f, 80) };
+        std::size_t const numWings{ defaultNumWings };
 
         /// <summary>
-        /// The curve generator for the distance "up" the central axis that each wing shadow is moved.
+        /// The curve generators for all of the parameters that define how a wing moves.
         /// </summary>
-        CurveGenerator<GLfloat> deltaZCurve{ 0.5f, 0.4f, 0.7f, false, 0.01f, 0.001f, 200 };
+        WingCurves curves;
 
         /// <summary>
-        /// The curve generator for the roll of the wing.
+        /// The shadow of the OpenGL state that <see cref="DrawFrame"/> changes.
         /// </summary>
-        /// <remarks>
-        /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
-        /// </para>
-        /// </remarks>
-        CurveGenerator<GLfloat> rollCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 1.0f, 0.25f, 80) };
+        mutable GLStateCache stateCache{};
 
         /// <summary>
-        /// The curve generator for the pitch of the wing.
+        /// Whether the GL supports the polygon offset feature.
         /// </summary>
         /// <remarks>
         /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
+        /// This feature prevents Z-fighting between the polygon surface and
+        /// the wire outline of each wing.  If it is supported, then the wire
+        /// outlines will be rendered.  The outlines will also have smoothing
+        /// enabled, which requires fragment blending.
         /// </para>
         /// </remarks>
-        CurveGenerator<GLfloat> pitchCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 2.0f, 0.25f, 40) };
+        bool const enablePolygonOffset{ false };
 
         /// <summary>
-        /// The curve generator for the yaw of the wing.
+        /// The GL call list for a single quad, which is used to render every
+        /// wing.
         /// </summary>
         /// <remarks>
         /// <para>
-        /// Roll, pitch, and yaw taken together define how the wing is twisted
-        /// "in place" wherever it is around the central axis.
+        /// This will be called once per wing.  If the polygon offset feature
+        /// is supported and wire outlines are rendered, this will be called
+        /// twice per wing.
         /// </para>
         /// </remarks>
-        CurveGenerator<GLfloat> yawCurve{ CurveGenerator<GLfloat>::createGeneratorForAngles(0.0f, 1.5f, 0.25f, 50) };
-
-        /// <summary>
-        /// The curve generator for the red component of the wing color.
-        /// </summary>
-        CurveGenerator<GLfloat> redCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 95) };
-
-        /// <summary>
-        /// The curve generator for the green component of the wing color.
-        /// </summary>
-        CurveGenerator<GLfloat> greenCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 40) };
+        GLuint const wingDisplayList{ 0 };
 
         /// <summary>
-        /// The curve generator for the blue component of the wing color.
+        /// The sequence of transformed wings.
         /// </summary>
-        CurveGenerator<GLfloat> blueCurve{ CurveGenerator<GLfloat>::createGeneratorForColorComponents(0.0f, 0.04f, 0.01f, 70) };
+        RingBuffer<Wing<GLuint, GLfloat> > wings{ numWings };
     };
 
 }
@@ -0,0 +1,228 @@
+#ifdef _WIN32
+#include <Windows.h>
+#include <gl/GL.h>
+#include <gl/GLU.h>
+#else
+#include <GL/gl.h>
+#include <GL/glu.h>
+#endif
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "WingsViewBatched.h"
+
+#include "Color.h"
+#include "Instrumentation.h"
+#include "Philox4x32.h"
+#include "WingCurves.h"
+#include "WingParameters.h"
+#include "WingVertexBatch.h"
+
+namespace silnith::wings::gl
+{
+
+	WingsViewBatched::WingsViewBatched(GLInfo const& glInfo) :
+		WingsViewBatched{ glInfo, defaultNumWings, Philox4x32::generateRandomSeed() }
+	{}
+
+	WingsViewBatched::WingsViewBatched(GLInfo const&, std::size_t numWings, std::uint64_t seed) :
+		numWings{ numWings },
+		curves{ seed }
+	{
+		/*
+		 * Depth testing is a basic requirement when using a depth buffer.
+		 */
+		glEnable(GL_DEPTH_TEST);
+		glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+
+		/*
+		 * The edge of each wing is rendered using polygon offset to reduce
+		 * Z-fighting with the body.  Vertex arrays require OpenGL 1.1, so
+		 * polygon offset is always available.
+		 */
+		glPolygonOffset(-0.75, -2);
+		glEnable(GL_POLYGON_OFFSET_LINE);
+
+		/*
+		 * The wing edges are rendered with smoothing enabled (antialiasing).
+		 * This generates multiple fragments per line step with alpha values
+		 * less than one, so blending is required for it to look correct.
+		 */
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		glEnable(GL_LINE_SMOOTH);
+		glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
+		glLineWidth(1.0);
+
+		/*
+		 * Set up the initial camera position.
+		 */
+		glLoadIdentity();
+		gluLookAt(0, 50, 50,
+			0, 0, 13,
+			0, 0, 1);
+	}
+
+	void WingsViewBatched::AdvanceAnimation(void)
+	{
+		/*
+		 * Get the next updated values for all the parameters that define how
+		 * a wing moves.
+		 */
+		instrumentation::PhaseTimer curveTimer{ instrumentation::Phase::CurveStep };
+		WingParameters<GLfloat> const parameters{ NextWingParameters() };
+		curveTimer.Stop();
+
+		instrumentation::PhaseTimer const transformTimer{ instrumentation::Phase::Transform };
+		AddWing(parameters);
+	}
+
+	void WingsViewBatched::WarmStart(void)
+	{
+		assert(batch.getNumWings() == 0);
+
+		instrumentation::PhaseTimer const warmStartTimer{ instrumentation::Phase::WarmStart };
+		for (std::size_t i{ 0 }; i < numWings; i++)
+		{
+			AddWing(NextWingParameters());
+		}
+	}
+
+	WingParameters<GLfloat> WingsViewBatched::NextWingParameters(void)
+	{
+		return curves.getNextParameters();
+	}
+
+	void WingsViewBatched::AddWing(WingParameters<GLfloat> const& parameters)
+	{
+		batch.AddWing(parameters.radius, parameters.angle,
+			parameters.deltaAngle, parameters.deltaZ,
+			parameters.roll, parameters.pitch, parameters.yaw,
+			Color<GLfloat>{ parameters.red, parameters.green, parameters.blue },
+			Color<GLfloat>::WHITE);
+	}
+
+	void WingsViewBatched::DrawFrame(void) const
+	{
+		GLsizei const numVertices{ static_cast<GLsizei>(batch.getNumWings() * WingVertexBatch::verticesPerWing) };
+
+		/*
+		 * Every stored vertex already includes the transformation of its own
+		 * wing, so the accumulated deltas are the only transformation left.
+		 * They are the same for every wing, so they go on the matrix stack.
+		 */
+		glPushMatrix();
+		glTranslatef(0, 0, batch.getAccumulatedZ());
+		glRotatef(batch.getAccumulatedAngle(), 0, 0, 1);
+
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+		glVertexPointer(static_cast<GLint>(WingVertexBatch::vertexSize), GL_FLOAT, 0, batch.getVertices().data());
+
+		/*
+		 * First, draw the solid wings using their solid color.
+		 */
+		instrumentation::PhaseTimer fillTimer{ instrumentation::Phase::FillPass };
+		glColorPointer(static_cast<GLint>(WingVertexBatch::colorSize), GL_FLOAT, 0, batch.getColors().data());
+		glDrawArrays(GL_QUADS, 0, numVertices);
+		fillTimer.Stop();
+
+		/*
+		 * Second, draw the wing outlines using the outline color.
+		 * See WingsView::DrawFrame for the reasoning behind the depth and
+		 * blending state.
+		 */
+		instrumentation::PhaseTimer outlineTimer{ instrumentation::Phase::OutlinePass };
+		stateCache.DepthFunc(GL_LEQUAL);
+		stateCache.DepthMask(GL_FALSE);
+		stateCache.Enable(GL_BLEND);
+		stateCache.PolygonMode(GL_LINE);
+		glColorPointer(static_cast<GLint>(WingVertexBatch::colorSize), GL_FLOAT, 0, batch.getEdgeColors().data());
+		glDrawArrays(GL_QUADS, 0, numVertices);
+		stateCache.PolygonMode(GL_FILL);
+		stateCache.Disable(GL_BLEND);
+		stateCache.DepthMask(GL_TRUE);
+		stateCache.DepthFunc(GL_LESS);
+		outlineTimer.Stop();
+
+		glDisableClientState(GL_COLOR_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glPopMatrix();
+
+		glFlush();
+
+		stateCache.EndFrame();
+
+		firstFrameTimer.FrameDrawn(batch.getNumWings() == numWings);
+	}
+
+	void WingsViewBatched::Resize(GLsizei width, GLsizei height) const
+	{
+		Resize(0, 0, width, height);
+	}
+
+	void WingsViewBatched::Resize(GLint x, GLint y, GLsizei width, GLsizei height) const
+	{
+		/*
+		 * The projection matrix transforms the fragment coordinates to the
+		 * scale of [-1, 1], called "normalized device coordinates".
+		 * The viewport transforms those into the coordinates expected by the
+		 * windowing system.
+		 */
+		glViewport(x, y, width, height);
+
+		/*
+		 * The view frustum was hand-selected to match the parameters to the
+		 * curve generators and the initial gluLookAt().
+		 */
+		GLdouble constexpr defaultLeft{ -20 };
+		GLdouble constexpr defaultRight{ 20 };
+		GLdouble constexpr defaultBottom{ -20 };
+		GLdouble constexpr defaultTop{ 20 };
+		GLdouble constexpr defaultNear{ 35 };
+		GLdouble constexpr defaultFar{ 105 };
+
+		/*
+		 * These multipliers account for the aspect ratio of the window, so that
+		 * the rendering does not distort.  The conditional is so that the larger
+		 * number is always divided by the smaller, resulting in a multiplier no
+		 * less than one.  This way, the viewing area is always expanded rather than
+		 * contracted, and the expected viewing frustum is never clipped.
+		 */
+		GLdouble xmult{ 1.0 };
+		GLdouble ymult{ 1.0 };
+		if (width > height)
+		{
+			xmult = static_cast<GLdouble>(width) / static_cast<GLdouble>(height);
+		}
+		else
+		{
+			ymult = static_cast<GLdouble>(height) / static_cast<GLdouble>(width);
+		}
+
+		/*
+		 * Set up the projection matrix.
+		 * The projection matrix is only used for the viewing frustum.
+		 * Things like camera position belong in the modelview matrix.
+		 */
+		glMatrixMode(GL_PROJECTION);
+		glLoadIdentity();
+		glOrtho(defaultLeft * xmult, defaultRight * xmult,
+			defaultBottom * ymult, defaultTop * ymult,
+			defaultNear, defaultFar);
+		glMatrixMode(GL_MODELVIEW);
+	}
+
+	GLStateCache const& WingsViewBatched::getStateCache(void) const noexcept
+	{
+		return stateCache;
+	}
+
+	GLStateCache& WingsViewBatched::getStateCache(void) noexcept
+	{
+		return stateCache;
+	}
+
+}
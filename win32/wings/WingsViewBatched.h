@@ -0,0 +1,203 @@
+#pragma once
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <gl/GL.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+#include "GLInfo.h"
+#include "GLStateCache.h"
+#include "Instrumentation.h"
+#include "WingCurves.h"
+#include "WingParameters.h"
+#include "WingVertexBatch.h"
+
+namespace silnith::wings::gl
+{
+    /// <summary>
+    /// An object to encapsulate all of the logic and data for initializing,
+    /// animating, and rendering the 3D view of the spinning wings, drawing
+    /// every wing with a single call per pass.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This produces the same animation as <see cref="WingsView"/>, but
+    /// instead of compiling a display list for every new wing and walking the
+    /// matrix stack for every wing every frame, each wing is transformed once
+    /// on the CPU into a <see cref="WingVertexBatch"/>.  The fills are then
+    /// drawn with one <c>glDrawArrays</c> call from client-side vertex and
+    /// color arrays, and the outlines with one more.
+    /// </para>
+    /// <para>
+    /// Client-side vertex arrays were introduced with OpenGL 1.1, so this
+    /// requires at least that version.  This requires that the OpenGL state
+    /// machine already be initialized and ready for use.  It should be
+    /// destroyed before the GL rendering context is released.
+    /// </para>
+    /// </remarks>
+    /// <seealso cref="WingsView"/>
+    class WingsViewBatched
+    {
+    public:
+        WingsViewBatched(void) = delete;
+
+        /// <summary>
+        /// Initializes the spinning wings.  This allocates the arrays for
+        /// the wings and sets up the necessary GL features.
+        /// </summary>
+        /// <param name="glInfo">The queryable OpenGL information.</param>
+        explicit WingsViewBatched(GLInfo const& glInfo);
+
+        /// <summary>
+        /// Initializes the spinning wings with a specific number of wings and
+        /// a fixed seed for the curve generators.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// A view created with the same seed as a <see cref="WingsView"/>
+        /// produces an identical animation.
+        /// </para>
+        /// </remarks>
+        /// <param name="glInfo">The queryable OpenGL information.</param>
+        /// <param name="numWings">The number of wings to animate.</param>
+        /// <param name="seed">The seed for the curve generators.</param>
+        explicit WingsViewBatched(GLInfo const& glInfo, std::size_t numWings, std::uint64_t seed);
+
+#pragma region Rule of Five
+
+    public:
+        WingsViewBatched(WingsViewBatched const&) = delete;
+        WingsViewBatched& operator=(WingsViewBatched const&) = delete;
+        WingsViewBatched(WingsViewBatched&&) noexcept = delete;
+        WingsViewBatched& operator=(WingsViewBatched&&) noexcept = delete;
+        ~WingsViewBatched(void) noexcept = default;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Advances the spinning wings animation by one frame.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This only touches the CPU-side arrays, so it does not require a
+        /// current rendering context.
+        /// </para>
+        /// </remarks>
+        void AdvanceAnimation(void);
+
+        /// <summary>
+        /// Fills the entire wing history at once, so that the first frame
+        /// drawn is already a complete spiral.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// This is equivalent to calling <see cref="AdvanceAnimation"/> once
+        /// per wing.  It must be called before the animation is advanced for
+        /// the first time.
+        /// </para>
+        /// </remarks>
+        /// <seealso cref="WingsView::WarmStart"/>
+        void WarmStart(void);
+
+        /// <summary>
+        /// Renders the current spinning wings animation frame into the current
+        /// rendering context.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Be certain to call this with a valid device context and rendering context.
+        /// In practice this means between calls to <c>BeginPaint</c> and <c>EndPaint</c>
+        /// after receiving a message of type <c>WM_PAINT</c>.  Remember to also call
+        /// <c>SwapBuffers</c> afterwards.
+        /// </para>
+        /// </remarks>
+        void DrawFrame(void) const;
+
+        /// <summary>
+        /// Updates the OpenGL rendering context for the new viewport size.
+        /// </summary>
+        /// <param name="width">the new viewport width</param>
+        /// <param name="height">the new viewport height</param>
+        /// <seealso cref="WingsView::Resize(GLsizei, GLsizei)"/>
+        void Resize(GLsizei width, GLsizei height) const;
+
+        /// <summary>
+        /// Updates the OpenGL rendering context for the new viewport size.
+        /// </summary>
+        /// <param name="x">the new viewport starting X coordinate</param>
+        /// <param name="y">the new viewport starting Y coordinate</param>
+        /// <param name="width">the new viewport width</param>
+        /// <param name="height">the new viewport height</param>
+        /// <seealso cref="WingsView::Resize(GLint, GLint, GLsizei, GLsizei)"/>
+        void Resize(GLint x, GLint y, GLsizei width, GLsizei height) const;
+
+        /// <summary>
+        /// Returns the shadow of the OpenGL state that drawing changes, which
+        /// counts the state changes that were issued and elided.
+        /// </summary>
+        /// <returns>The state cache.</returns>
+        [[nodiscard]]
+        GLStateCache const& getStateCache(void) const noexcept;
+
+        /// <summary>
+        /// Returns the shadow of the OpenGL state that drawing changes, so
+        /// that code changing the same state can invalidate it.
+        /// </summary>
+        /// <returns>The state cache.</returns>
+        [[nodiscard]]
+        GLStateCache& getStateCache(void) noexcept;
+
+    public:
+        /// <summary>
+        /// The number of wings animated when none is specified.
+        /// </summary>
+        static std::size_t constexpr defaultNumWings{ 40 };
+
+    private:
+        /// <summary>
+        /// Steps every curve once.
+        /// </summary>
+        /// <returns>The parameters of the next wing.</returns>
+        [[nodiscard]]
+        WingParameters<GLfloat> NextWingParameters(void);
+
+        /// <summary>
+        /// Transforms a new wing into the batch.
+        /// </summary>
+        /// <param name="parameters">The parameters of the new wing.</param>
+        void AddWing(WingParameters<GLfloat> const& parameters);
+
+    private:
+        /// <summary>
+        /// The time from construction to the first complete frame.
+        /// </summary>
+        instrumentation::FirstFrameTimer const firstFrameTimer{};
+
+        /// <summary>
+        /// The number of wings to animate.
+        /// </summary>
+        std::size_t const numWings{ defaultNumWings };
+
+        /// <summary>
+        /// The curve generators for all of the parameters that define how a wing moves.
+        /// </summary>
+        WingCurves curves;
+
+        /// <summary>
+        /// The shadow of the OpenGL state that <see cref="DrawFrame"/> changes.
+        /// </summary>
+        mutable GLStateCache stateCache{};
+
+        /// <summary>
+        /// The transformed vertices and colors of every wing.
+        /// </summary>
+        WingVertexBatch batch{ numWings };
+    };
+
+}
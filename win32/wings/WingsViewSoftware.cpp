@@ -0,0 +1,99 @@
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "WingsViewSoftware.h"
+
+#include "Color.h"
+#include "Philox4x32.h"
+#include "RingBuffer.h"
+#include "SoftwareRasterizer.h"
+#include "Wing.h"
+#include "WingCurves.h"
+#include "WingParameters.h"
+
+namespace silnith::wings::software
+{
+
+	WingsViewSoftware::WingsViewSoftware(std::size_t width, std::size_t height)
+		: WingsViewSoftware{ width, height, Philox4x32::generateRandomSeed() }
+	{}
+
+	WingsViewSoftware::WingsViewSoftware(std::size_t width, std::size_t height, std::uint64_t seed)
+		: curves{ seed }, rasterizer{ width, height }
+	{
+		/*
+		 * The OpenGL 1.1 renderer pulls the outlines forward, the OpenGL 3.2
+		 * renderer pushes the polygons back.  The effect is the same.
+		 */
+		rasterizer.PolygonOffset(0.75f, 2.0f);
+
+		/*
+		 * Set up the initial camera position.
+		 */
+		rasterizer.LookAt(0, 50, 50,
+			0, 0, 13,
+			0, 0, 1);
+
+		Resize(width, height);
+	}
+
+	void WingsViewSoftware::AdvanceAnimation(void)
+	{
+		WingParameters<float> const parameters{ curves.getNextParameters() };
+
+		wings.emplace_front(0u,
+			parameters.radius, parameters.angle,
+			parameters.deltaAngle, parameters.deltaZ,
+			parameters.roll, parameters.pitch, parameters.yaw,
+			Color<float>{ parameters.red, parameters.green, parameters.blue },
+			Color<float>::WHITE);
+	}
+
+	void WingsViewSoftware::WarmStart(void)
+	{
+		assert(wings.empty());
+
+		while (!wings.full())
+		{
+			AdvanceAnimation();
+		}
+	}
+
+	void WingsViewSoftware::DrawFrame(void)
+	{
+		rasterizer.Clear();
+		rasterizer.DrawWings(wings);
+	}
+
+	void WingsViewSoftware::Resize(std::size_t width, std::size_t height)
+	{
+		rasterizer.Resize(width, height);
+
+		/*
+		 * The same viewing volume as the OpenGL renderers.
+		 */
+		float constexpr defaultLeft{ -20 };
+		float constexpr defaultRight{ 20 };
+		float constexpr defaultBottom{ -20 };
+		float constexpr defaultTop{ 20 };
+		float constexpr defaultNear{ 35 };
+		float constexpr defaultFar{ 105 };
+
+		float xmult{ 1.0f };
+		float ymult{ 1.0f };
+		if (width > height)
+		{
+			xmult = static_cast<float>(width) / static_cast<float>(height);
+		}
+		else
+		{
+			ymult = static_cast<float>(height) / static_cast<float>(width);
+		}
+
+		rasterizer.Ortho(defaultLeft * xmult, defaultRight * xmult,
+			defaultBottom * ymult, defaultTop * ymult,
+			defaultNear, defaultFar);
+	}
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "RingBuffer.h"
+#include "SoftwareRasterizer.h"
+#include "Wing.h"
+#include "WingCurves.h"
+#include "WingParameters.h"
+
+namespace silnith::wings::software
+{
+    /// <summary>
+    /// An object to encapsulate all of the logic and data for animating
+    /// and rendering the spinning wings without a graphics driver.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This is the software counterpart to the OpenGL views.  It uses the same
+    /// curve generators and the same wing history, and renders each frame into
+    /// the framebuffer of a <see cref="SoftwareRasterizer"/>.
+    /// </para>
+    /// </remarks>
+    class WingsViewSoftware
+    {
+    public:
+        WingsViewSoftware(void) = delete;
+
+        /// <summary>
+        /// Initializes the spinning wings with a random seed and allocates the framebuffer.
+        /// </summary>
+        /// <param name="width">the framebuffer width in pixels</param>
+        /// <param name="height">the framebuffer height in pixels</param>
+        explicit WingsViewSoftware(std::size_t width, std::size_t height);
+
+        /// <summary>
+        /// Initializes the spinning wings and allocates the framebuffer.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// Two views created with the same seed produce identical animations.
+        /// </para>
+        /// </remarks>
+        /// <param name="width">the framebuffer width in pixels</param>
+        /// <param name="height">the framebuffer height in pixels</param>
+        /// <param name="seed">the seed for the curve generators</param>
+        explicit WingsViewSoftware(std::size_t width, std::size_t height, std::uint64_t seed);
+
+#pragma region Rule of Five
+
+    public:
+        WingsViewSoftware(WingsViewSoftware const&) = delete;
+        WingsViewSoftware& operator=(WingsViewSoftware const&) = delete;
+        WingsViewSoftware(WingsViewSoftware&&) noexcept = delete;
+        WingsViewSoftware& operator=(WingsViewSoftware&&) noexcept = delete;
+        ~WingsViewSoftware(void) noexcept = default;
+
+#pragma endregion
+
+    public:
+        /// <summary>
+        /// Advances the spinning wings animation by one frame.
+        /// </summary>
+        void AdvanceAnimation(void);
+
+        /// <summary>
+        /// Fills the entire wing history at once, so that the first frame
+        /// drawn is already a complete spiral.  This is equivalent to calling
+        /// <see cref="AdvanceAnimation"/> once per wing.
+        /// </summary>
+        void WarmStart(void);
+
+        /// <summary>
+        /// Renders the current spinning wings animation frame into the framebuffer.
+        /// </summary>
+        void DrawFrame(void);
+
+        /// <summary>
+        /// Reallocates the framebuffer and adjusts the projection to account
+        /// for the aspect ratio.
+        /// </summary>
+        /// <param name="width">the new framebuffer width</param>
+        /// <param name="height">the new framebuffer height</param>
+        void Resize(std::size_t width, std::size_t height);
+
+        /// <summary>
+        /// Returns the seed used for the curve generators.
+        /// </summary>
+        /// <returns>the seed that reproduces this animation</returns>
+        [[nodiscard]]
+        inline std::uint64_t getSeed(void) const noexcept
+        {
+            return curves.getSeed();
+        }
+
+        /// <summary>
+        /// Returns the rasterizer that holds the most recently rendered frame.
+        /// </summary>
+        /// <returns>the rasterizer</returns>
+        [[nodiscard]]
+        inline SoftwareRasterizer const& getRasterizer(void) const noexcept
+        {
+            return rasterizer;
+        }
+
+        /// <summary>
+        /// Returns the checksum of the most recently rendered frame.
+        /// </summary>
+        /// <returns>the checksum of the color buffer</returns>
+        [[nodiscard]]
+        inline std::uint64_t Checksum(void) const noexcept
+        {
+            return rasterizer.Checksum();
+        }
+
+    private:
+        /// <summary>
+        /// The number of wings to animate.
+        /// </summary>
+        std::size_t const numWings{ 40 };
+
+        /// <summary>
+        /// The curve generators for all of the parameters that define how a wing moves.
+        /// </summary>
+        WingCurves curves;
+
+        /// <summary>
+        /// The framebuffer and rendering pipeline.
+        /// </summary>
+        SoftwareRasterizer rasterizer;
+
+        /// <summary>
+        /// The sequence of transformed wings.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// There are no display lists, so the identifier of every wing is zero.
+        /// </para>
+        /// </remarks>
+        RingBuffer<Wing<unsigned int, float> > wings{ numWings };
+    };
+
+}